@@ -0,0 +1,195 @@
+#include "mapped_file.h"
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() :
+    m_data(nullptr),
+    m_size(0)
+#ifdef _WIN32
+    ,
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(nullptr)
+#endif
+{
+}
+
+MappedFile::MappedFile(const char * fileName) :
+    MappedFile()
+{
+    Open(fileName);
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char * fileName)
+{
+    Close();
+    if (fileName == nullptr || fileName[0] == '\0')
+    {
+        return false;
+    }
+
+    m_file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+    m_data = (uint8_t *)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+    m_size = fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+
+void MappedFile::Advise(uint64_t offset, uint64_t size, Access access) const
+{
+    if (m_data == nullptr || offset >= m_size || access != Access::WillNeed)
+    {
+        return;
+    }
+    // Windows only has a prefetch hint, the access pattern hints have no equivalent on a view
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = m_data + offset;
+    range.NumberOfBytes = (SIZE_T)(size < m_size - offset ? size : m_size - offset);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+bool MappedFile::Open(const char * fileName)
+{
+    Close();
+    if (fileName == nullptr || fileName[0] == '\0')
+    {
+        return false;
+    }
+
+    int fd = open(fileName, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    // The mapping keeps its own reference to the file
+    void * data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    m_data = (uint8_t *)data;
+    m_size = (uint64_t)fileStat.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        munmap(m_data, (size_t)m_size);
+        m_data = nullptr;
+    }
+    m_size = 0;
+}
+
+void MappedFile::Advise(uint64_t offset, uint64_t size, Access access) const
+{
+    if (m_data == nullptr || offset >= m_size)
+    {
+        return;
+    }
+    if (size > m_size - offset)
+    {
+        size = m_size - offset;
+    }
+
+    // madvise needs a page aligned start
+    const uint64_t pageMask = (uint64_t)sysconf(_SC_PAGESIZE) - 1;
+    const uint64_t start = offset & ~pageMask;
+    size += offset - start;
+
+    int advice = MADV_NORMAL;
+    switch (access)
+    {
+    case Access::Sequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+    case Access::WillNeed:
+        advice = MADV_WILLNEED;
+        break;
+    case Access::Random:
+        advice = MADV_RANDOM;
+        break;
+    default:
+        break;
+    }
+    madvise(m_data + start, (size_t)size, advice);
+}
+
+#endif
+
+bool MappedFile::IsOpen() const
+{
+    return m_data != nullptr;
+}
+
+const uint8_t * MappedFile::Data() const
+{
+    return m_data;
+}
+
+uint64_t MappedFile::Size() const
+{
+    return m_size;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+
+class MappedFile
+{
+public:
+    enum class Access
+    {
+        Normal,
+        Sequential,
+        WillNeed,
+        Random,
+    };
+
+    MappedFile();
+    MappedFile(const char * fileName);
+    ~MappedFile();
+
+    bool Open(const char * fileName);
+    void Close();
+
+    bool IsOpen() const;
+    const uint8_t * Data() const;
+    uint64_t Size() const;
+
+    // Hint how a range of the mapping is about to be accessed
+    void Advise(uint64_t offset, uint64_t size, Access access) const;
+
+private:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    uint8_t * m_data;
+    uint64_t m_size;
+#ifdef _WIN32
+    void * m_file;
+    void * m_mapping;
+#endif
+};
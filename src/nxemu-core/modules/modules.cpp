@@ -139,6 +139,15 @@ void Modules::CreateModules(void)
     }
 }
 
+bool Modules::ReplayGpuCapture(const char * capturePath, const char * reportPath)
+{
+    if (m_videoModule.get() == nullptr)
+    {
+        return false;
+    }
+    return m_videoModule->ReplayGpuCapture(capturePath, reportPath);
+}
+
 ISystemloader * Modules::Systemloader(void)
 {
     return m_systemLoader;
@@ -21,6 +21,7 @@ public:
     void StartEmulation(void);
     void StopEmulation(void);
     void FlushSettings(void);
+    bool ReplayGpuCapture(const char * capturePath, const char * reportPath);
 
     ISystemloader * Systemloader();
     IVideo * Video(void);
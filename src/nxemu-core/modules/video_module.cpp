@@ -2,7 +2,8 @@
 
 VideoModule::VideoModule() :
     m_CreateVideo(dummyCreateVideo),
-    m_DestroyVideo(dummyDestroyVideo)
+    m_DestroyVideo(dummyDestroyVideo),
+    m_ReplayGpuCapture(dummyReplayGpuCapture)
 {
 }
 
@@ -10,12 +11,14 @@ void VideoModule::UnloadModule(void)
 {
     m_CreateVideo = dummyCreateVideo;
     m_DestroyVideo = dummyDestroyVideo;
+    m_ReplayGpuCapture = dummyReplayGpuCapture;
 }
 
 bool VideoModule::LoadFunctions(void)
 {
     m_CreateVideo = (tyCreateVideo)DynamicLibraryGetProc(m_lib, "CreateVideo");
     m_DestroyVideo = (tyDestroyVideo)DynamicLibraryGetProc(m_lib, "DestroyVideo");
+    m_ReplayGpuCapture = (tyReplayGpuCapture)DynamicLibraryGetProc(m_lib, "ReplayGpuCapture");
 
     bool res = true;
     if (m_CreateVideo == nullptr)
@@ -28,6 +31,11 @@ bool VideoModule::LoadFunctions(void)
         m_DestroyVideo = dummyDestroyVideo;
         res = false;
     }
+    if (m_ReplayGpuCapture == nullptr)
+    {
+        // Optional export, older modules can not replay captures
+        m_ReplayGpuCapture = dummyReplayGpuCapture;
+    }
     return res;
 }
 
@@ -44,3 +52,8 @@ IVideo * VideoModule::dummyCreateVideo(IRenderWindow & /*RenderWindow*/, ISwitch
 void VideoModule::dummyDestroyVideo(IVideo * /*Video*/)
 {
 }
+
+bool VideoModule::dummyReplayGpuCapture(const char * /*capturePath*/, const char * /*reportPath*/)
+{
+    return false;
+}
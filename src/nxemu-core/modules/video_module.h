@@ -8,6 +8,7 @@ class VideoModule :
 public:
     typedef IVideo *(CALL * tyCreateVideo)(IRenderWindow & RenderWindow, ISwitchSystem & System);
     typedef void(CALL * tyDestroyVideo)(IVideo * Video);
+    typedef bool(CALL * tyReplayGpuCapture)(const char * capturePath, const char * reportPath);
 
     VideoModule();
     ~VideoModule() = default;
@@ -20,6 +21,10 @@ public:
     {
         m_DestroyVideo(Video);
     }
+    bool ReplayGpuCapture(const char * capturePath, const char * reportPath) const
+    {
+        return m_ReplayGpuCapture(capturePath, reportPath);
+    }
 
 protected:
     void UnloadModule(void);
@@ -32,7 +37,9 @@ private:
 
     static IVideo * CALL dummyCreateVideo(IRenderWindow & RenderWindow, ISwitchSystem & System);
     static void CALL dummyDestroyVideo(IVideo * Video);
+    static bool CALL dummyReplayGpuCapture(const char * capturePath, const char * reportPath);
 
     tyCreateVideo m_CreateVideo;
     tyDestroyVideo m_DestroyVideo;
+    tyReplayGpuCapture m_ReplayGpuCapture;
 };
\ No newline at end of file
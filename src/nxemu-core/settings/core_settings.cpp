@@ -24,6 +24,9 @@ struct CoreSettingsDefaults
     static constexpr bool defaultRomLoading = false;
     static constexpr bool defaultEmulationRunning = false;
     static constexpr bool defaultDisplayedFrames = false;
+    static constexpr int32_t defaultBenchmarkFrames = 0;
+    static constexpr const char * defaultBenchmarkReport = "";
+    static constexpr bool defaultBenchmarkComplete = false;
 
     static Path GetDefaultModuleDir();
 };
@@ -73,6 +76,9 @@ void LoadCoreSetting(void)
     settings.SetDefaultBool(NXCoreSetting::RomLoading, CoreSettingsDefaults::defaultRomLoading);
     settings.SetDefaultBool(NXCoreSetting::EmulationRunning, CoreSettingsDefaults::defaultEmulationRunning);
     settings.SetDefaultBool(NXCoreSetting::DisplayedFrames, CoreSettingsDefaults::defaultDisplayedFrames);
+    settings.SetDefaultInt(NXCoreSetting::BenchmarkFrames, CoreSettingsDefaults::defaultBenchmarkFrames);
+    settings.SetDefaultString(NXCoreSetting::BenchmarkReport, CoreSettingsDefaults::defaultBenchmarkReport);
+    settings.SetDefaultBool(NXCoreSetting::BenchmarkComplete, CoreSettingsDefaults::defaultBenchmarkComplete);
 
     coreSettings.moduleLoaderSelected = CoreSettingsDefaults::defaultModuleLoader;
     coreSettings.moduleCpuSelected = CoreSettingsDefaults::defaultModuleCpu;
@@ -12,5 +12,8 @@ constexpr const char * ShowConsole = "nxcore:ShowConsole";
 constexpr const char * RomLoading = "nxcore:RomLoading";
 constexpr const char * EmulationRunning = "nxcore:EmulationRunning";
 constexpr const char * DisplayedFrames = "nxcore:DisplayedFrames";
+constexpr const char * BenchmarkFrames = "nxcore:BenchmarkFrames";
+constexpr const char * BenchmarkReport = "nxcore:BenchmarkReport";
+constexpr const char * BenchmarkComplete = "nxcore:BenchmarkComplete";
 
 } // namespace NXCoreSetting
\ No newline at end of file
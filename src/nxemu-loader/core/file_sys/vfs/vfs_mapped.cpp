@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <common/mapped_file.h>
+#include "core/file_sys/vfs/vfs_mapped.h"
+
+namespace FileSys {
+
+MappedVfsFile::MappedVfsFile(std::shared_ptr<const MappedFile> mapping_, std::size_t offset_,
+                             std::size_t size_, std::string name_, VirtualDir parent_)
+    : mapping(std::move(mapping_)), offset(offset_), size(size_), name(std::move(name_)),
+      parent(std::move(parent_)) {}
+
+MappedVfsFile::~MappedVfsFile() = default;
+
+std::string MappedVfsFile::GetName() const {
+    return name;
+}
+
+std::size_t MappedVfsFile::GetSize() const {
+    return size;
+}
+
+bool MappedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir MappedVfsFile::GetContainingDirectory() const {
+    return parent;
+}
+
+bool MappedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool MappedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t MappedVfsFile::Read(u8* data, std::size_t length, std::size_t read_offset) const {
+    if (read_offset >= size) {
+        return 0;
+    }
+    const auto read_size = std::min(length, size - read_offset);
+    std::memcpy(data, mapping->Data() + offset + read_offset, read_size);
+    return read_size;
+}
+
+std::size_t MappedVfsFile::Write(const u8* data, std::size_t length, std::size_t write_offset) {
+    return 0;
+}
+
+bool MappedVfsFile::Rename(std::string_view new_name) {
+    name = new_name;
+    return true;
+}
+
+} // namespace FileSys
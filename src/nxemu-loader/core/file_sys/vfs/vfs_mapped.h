@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "core/file_sys/vfs/vfs.h"
+
+class MappedFile;
+
+namespace FileSys {
+
+// An implementation of VfsFile that is a read-only window into a memory-mapped host file. Reads
+// are copies out of the mapping, without a system call per read.
+class MappedVfsFile : public VfsFile {
+public:
+    MappedVfsFile(std::shared_ptr<const MappedFile> mapping, std::size_t offset, std::size_t size,
+                  std::string name = "", VirtualDir parent = nullptr);
+    ~MappedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+private:
+    std::shared_ptr<const MappedFile> mapping;
+    std::size_t offset;
+    std::size_t size;
+    std::string name;
+    VirtualDir parent;
+};
+
+} // namespace FileSys
@@ -0,0 +1,62 @@
+#include "default_metadata.h"
+#include <array>
+
+const IProgramMetadata & DefaultMetaData()
+{
+    class ProgramMetaData :
+        public IProgramMetadata
+    {
+        bool Is64BitProgram() const
+        {
+            return true;
+        }
+        ProgramAddressSpaceType GetAddressSpaceType() const
+        {
+            return ProgramAddressSpaceType::Is39Bit;
+        }
+        uint8_t GetMainThreadPriority() const
+        {
+            return 0x2C;
+        }
+        uint8_t GetMainThreadCore() const
+        {
+            return 0;
+        }
+        uint32_t GetMainThreadStackSize() const
+        {
+            return 0x100000;
+        }
+        uint64_t GetTitleID() const
+        {
+            return 0;
+        }
+        uint64_t GetFilesystemPermissions() const
+        {
+            return 0xFFFFFFFFFFFFFFFF;
+        }
+        uint32_t GetSystemResourceSize() const
+        {
+            return 0;
+        }
+        PoolPartition GetPoolPartition() const
+        {
+            return PoolPartition::Application;
+        }
+        const uint32_t * GetKernelCapabilities() const
+        {
+            return &kernelCapabilities[0];
+        }
+        uint32_t GetKernelCapabilitiesSize() const
+        {
+            return (uint32_t)kernelCapabilities.size();
+        }
+        const char * GetName() const
+        {
+            return "";
+        }
+
+        std::array<uint32_t, 1> kernelCapabilities = {0x30043F7};
+    };
+    static ProgramMetaData defaultMetaData;
+    return defaultMetaData;
+}
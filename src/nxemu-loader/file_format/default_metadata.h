@@ -0,0 +1,5 @@
+#pragma once
+#include <nxemu-module-spec/operating_system.h>
+
+// Metadata used for formats that do not carry an NPDM, such as homebrew NROs and standalone NSOs
+const IProgramMetadata & DefaultMetaData();
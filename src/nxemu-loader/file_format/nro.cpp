@@ -1,8 +1,10 @@
 #include "nro.h"
+#include "default_metadata.h"
 #include "nacp.h"
-#include <array>
 #include <common/file.h>
+#include <common/mapped_file.h>
 #include <common/path.h>
+#include <string.h>
 
 typedef struct
 {
@@ -45,9 +47,12 @@ bool Nro::IsNroFile(const char * file)
 }
 
 Nro::Nro(const char * file) :
+    m_file(std::make_shared<MappedFile>()),
     m_header({0}),
     m_moduleHeader({0}),
     m_nacp(nullptr),
+    m_romfsOffset(0),
+    m_romfsSize(0),
     m_bssSize(0),
     m_valid(false)
 {
@@ -57,30 +62,33 @@ Nro::Nro(const char * file) :
         return;
     }
 
-    File readFile(filePath, IFile::modeRead);
-    if (!readFile.IsOpen())
+    // The file is mapped rather than read, the image is copied straight from the mapping into
+    // guest memory and RomFS reads are served from it
+    if (!m_file->Open(file))
     {
         return;
     }
+    const uint8_t * fileData = m_file->Data();
+    const uint64_t fileSize = m_file->Size();
 
-    readFile.SeekToBegin();
-    if (!readFile.Read(&m_header, sizeof(m_header)))
+    if (fileSize < sizeof(m_header))
     {
         return;
     }
+    memcpy(&m_header, fileData, sizeof(m_header));
     if (*((uint32_t *)(&m_header.Signature[0])) != *((uint32_t *)(&"NRO0")))
     {
         return;
     }
+    if (m_header.Size > fileSize)
+    {
+        return;
+    }
 
-    if (readFile.GetLength() >= m_header.Size + sizeof(NRO_ASSET_HEADER))
+    if (fileSize >= m_header.Size + sizeof(NRO_ASSET_HEADER))
     {
         NRO_ASSET_HEADER assetHeader;
-        readFile.Seek(m_header.Size, IFile::SeekPosition::begin);
-        if (readFile.Read(&assetHeader, sizeof(NRO_ASSET_HEADER)) != sizeof(NRO_ASSET_HEADER))
-        {
-            return;
-        }
+        memcpy(&assetHeader, fileData + m_header.Size, sizeof(NRO_ASSET_HEADER));
 
         if (assetHeader.FormatVersion != 0)
         {
@@ -94,28 +102,37 @@ Nro::Nro(const char * file) :
 
         if (assetHeader.NacpSize > 0)
         {
+            uint64_t nacpOffset = m_header.Size + assetHeader.NacpOffset;
+            if (nacpOffset > fileSize || assetHeader.NacpSize > fileSize - nacpOffset)
+            {
+                return;
+            }
             m_nacp = std::make_unique<NACP>();
-            if (!m_nacp->Load(readFile, assetHeader.NacpOffset + m_header.Size, 0, assetHeader.NacpSize))
+            if (!m_nacp->Load(fileData + nacpOffset, assetHeader.NacpSize))
             {
                 return;
             }
         }
+
+        uint64_t romfsOffset = m_header.Size + assetHeader.RomFSOffset;
+        if (assetHeader.RomFSSize > 0 && romfsOffset <= fileSize && assetHeader.RomFSSize <= fileSize - romfsOffset)
+        {
+            m_romfsOffset = romfsOffset;
+            m_romfsSize = assetHeader.RomFSSize;
+            m_file->Advise(m_romfsOffset, m_romfsSize, MappedFile::Access::Random);
+        }
     }
 
-    if (m_header.ModuleOffset + sizeof(NRO_MODULE_HEADER) > readFile.GetLength())
+    if (m_header.ModuleOffset + sizeof(NRO_MODULE_HEADER) > fileSize)
     {
         return;
     }
-    readFile.Seek(m_header.ModuleOffset, IFile::SeekPosition::begin);
-    readFile.Read(&m_moduleHeader, sizeof(m_moduleHeader));
+    memcpy(&m_moduleHeader, fileData + m_header.ModuleOffset, sizeof(m_moduleHeader));
     m_bssSize = HasModHeader() ? PageAlignSize(m_moduleHeader.BssEndOffset - m_moduleHeader.BssStartOffset) : PageAlignSize(m_header.BssSize);
 
-    m_programImage.resize(PageAlignSize(m_header.Size) + m_bssSize);
-    readFile.SeekToBegin();
-    if (!readFile.Read(m_programImage.data(), (uint32_t)m_programImage.size()))
-    {
-        return;
-    }
+    // The image is read once, front to back, when it is written to guest memory
+    m_file->Advise(0, m_header.Size, MappedFile::Access::Sequential);
+    m_file->Advise(0, m_header.Size, MappedFile::Access::WillNeed);
     m_valid = true;
 }
 
@@ -126,12 +143,14 @@ NACP * Nro::Nacp() const
 
 const uint8_t * Nro::Data(void) const
 {
-    return m_programImage.data();
+    return m_file->Data();
 }
 
 uint32_t Nro::DataSize(void) const
 {
-    return (uint32_t)m_programImage.size();
+    // Only the image comes from the file, the code memory it is written to is allocated cleared,
+    // which provides the zeroed padding and bss
+    return m_header.Size;
 }
 
 uint64_t Nro::CodeSegmentAddr(void) const
@@ -184,64 +203,24 @@ uint32_t Nro::CodeSize()
     return PageAlignSize(m_header.Size) + m_bssSize;
 }
 
-const IProgramMetadata & Nro::MetaData() const
+const std::shared_ptr<MappedFile> & Nro::MappedImage() const
 {
-    class NroMetaData :
-        public IProgramMetadata
-    {
-        bool Is64BitProgram() const
-        {
-            return true;
-        }
-        ProgramAddressSpaceType GetAddressSpaceType() const
-        {
-            return ProgramAddressSpaceType::Is39Bit;
-        }
-        uint8_t GetMainThreadPriority() const
-        {
-            return 0x2C;
-        }
-        uint8_t GetMainThreadCore() const
-        {
-            return 0;
-        }
-        uint32_t GetMainThreadStackSize() const
-        {
-            return 0x100000;
-        }
-        uint64_t GetTitleID() const
-        {
-            return 0;
-        }
-        uint64_t GetFilesystemPermissions() const
-        {
-            return 0xFFFFFFFFFFFFFFFF;
-        }
-        uint32_t GetSystemResourceSize() const
-        {
-            return 0;
-        }
-        PoolPartition GetPoolPartition() const
-        {
-            return PoolPartition::Application;
-        }
-        const uint32_t * GetKernelCapabilities() const
-        {
-            return &kernelCapabilities[0];
-        }
-        uint32_t GetKernelCapabilitiesSize() const
-        {
-            return (uint32_t)kernelCapabilities.size();
-        }
-        const char * GetName() const
-        {
-            return "";
-        }
+    return m_file;
+}
 
-        std::array<uint32_t, 1> kernelCapabilities = {0x30043F7};
-    };
-    static NroMetaData defaultMetaData;
-    return defaultMetaData;
+uint64_t Nro::RomFSOffset() const
+{
+    return m_romfsOffset;
+}
+
+uint64_t Nro::RomFSSize() const
+{
+    return m_romfsSize;
+}
+
+const IProgramMetadata & Nro::MetaData() const
+{
+    return DefaultMetaData();
 }
 
 bool Nro::Valid() const
@@ -3,8 +3,8 @@
 #include <memory>
 #include <nxemu-module-spec/operating_system.h>
 #include <stdint.h>
-#include <vector>
 
+class MappedFile;
 class NACP;
 
 __interface IProgramMetadata;
@@ -72,6 +72,9 @@ public:
 
     NACP * Nacp() const;
     uint32_t CodeSize();
+    const std::shared_ptr<MappedFile> & MappedImage() const;
+    uint64_t RomFSOffset() const;
+    uint64_t RomFSSize() const;
     const IProgramMetadata & MetaData() const;
     bool Valid() const;
 
@@ -86,10 +89,12 @@ private:
 
     static constexpr uint32_t PageAlignSize(uint32_t size);
 
-    std::vector<uint8_t> m_programImage;
+    std::shared_ptr<MappedFile> m_file;
     NRO_HEADER m_header;
     NRO_MODULE_HEADER m_moduleHeader;
     std::unique_ptr<NACP> m_nacp;
+    uint64_t m_romfsOffset;
+    uint64_t m_romfsSize;
     uint32_t m_bssSize;
     bool m_valid;
 };
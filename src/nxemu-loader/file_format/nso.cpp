@@ -0,0 +1,238 @@
+#include "nso.h"
+#include "default_metadata.h"
+#include <array>
+#include <common/file.h>
+#include <common/mapped_file.h>
+#include <common/path.h>
+#include <string.h>
+#include <thread>
+#include <yuzu_common/lz4_compression.h>
+
+bool Nso::IsNsoFile(const char * file)
+{
+    // Retail modules (main, rtld, sdk, subsdk*) have no extension, so only the magic is checked
+    Path filePath(file);
+    if (!filePath.FileExists())
+    {
+        return false;
+    }
+
+    File readFile(filePath, IFile::modeRead);
+    if (!readFile.IsOpen())
+    {
+        return false;
+    }
+
+    NSO_HEADER header;
+    readFile.SeekToBegin();
+    if (readFile.Read(&header, sizeof(header)) != sizeof(header))
+    {
+        return false;
+    }
+    return *((uint32_t *)(&header.Signature[0])) == *((uint32_t *)(&"NSO0"));
+}
+
+Nso::Nso(const char * file) :
+    m_file(std::make_unique<MappedFile>()),
+    m_header({0}),
+    m_imageSize(0),
+    m_valid(false)
+{
+    // The compressed segments are decompressed straight out of the mapping, so the file is never
+    // read into a buffer of its own
+    if (!m_file->Open(file))
+    {
+        return;
+    }
+    const uint64_t fileSize = m_file->Size();
+    if (fileSize < sizeof(m_header))
+    {
+        return;
+    }
+    memcpy(&m_header, m_file->Data(), sizeof(m_header));
+    if (*((uint32_t *)(&m_header.Signature[0])) != *((uint32_t *)(&"NSO0")))
+    {
+        return;
+    }
+
+    uint64_t imageEnd = 0;
+    for (uint32_t i = 0; i < SegmentCount; i++)
+    {
+        const NSO_SEGMENT_HEADER & segment = m_header.Segments[i];
+        const uint64_t storedSize = IsSegmentCompressed(i) ? m_header.CompressedSize[i] : segment.Size;
+        if ((uint64_t)segment.FileOffset + storedSize > fileSize)
+        {
+            return;
+        }
+        // Segments are laid out text, rodata, data in ascending order without overlapping
+        if (segment.MemoryOffset < imageEnd)
+        {
+            return;
+        }
+        imageEnd = (uint64_t)segment.MemoryOffset + segment.Size;
+        m_file->Advise(segment.FileOffset, storedSize, MappedFile::Access::Sequential);
+        m_file->Advise(segment.FileOffset, storedSize, MappedFile::Access::WillNeed);
+    }
+    if (imageEnd + m_header.Segments[SegmentData].AlignmentOrBssSize > 0xFFFFF000)
+    {
+        return;
+    }
+    m_imageSize = (uint32_t)imageEnd;
+    m_valid = true;
+}
+
+Nso::~Nso()
+{
+}
+
+bool Nso::Decompress()
+{
+    if (!m_valid || !m_file->IsOpen())
+    {
+        return false;
+    }
+
+    // Only the gaps between segments need clearing, everything else is written by the segments
+    m_image.reset(new uint8_t[m_imageSize]);
+    uint32_t segmentEnd = 0;
+    for (uint32_t i = 0; i < SegmentCount; i++)
+    {
+        const NSO_SEGMENT_HEADER & segment = m_header.Segments[i];
+        memset(m_image.get() + segmentEnd, 0, segment.MemoryOffset - segmentEnd);
+        segmentEnd = segment.MemoryOffset + segment.Size;
+    }
+
+    // Each segment is an independent LZ4 block, rodata and data are decompressed on their own
+    // threads while text, normally the largest, is decompressed on this one
+    std::array<bool, SegmentCount> decompressed = {false, false, false};
+    std::array<std::thread, SegmentCount> workers;
+    for (uint32_t i = SegmentROData; i < SegmentCount; i++)
+    {
+        workers[i] = std::thread([this, i, &decompressed]()
+        {
+            decompressed[i] = DecompressSegment(i);
+        });
+    }
+    decompressed[SegmentText] = DecompressSegment(SegmentText);
+    for (uint32_t i = SegmentROData; i < SegmentCount; i++)
+    {
+        workers[i].join();
+    }
+
+    // The compressed data is no longer needed once the image is built
+    m_file->Close();
+    for (uint32_t i = 0; i < SegmentCount; i++)
+    {
+        if (!decompressed[i])
+        {
+            m_image.reset();
+            return false;
+        }
+    }
+    return true;
+}
+
+const uint8_t * Nso::Data(void) const
+{
+    return m_image.get();
+}
+
+uint32_t Nso::DataSize(void) const
+{
+    // bss is not part of the image, the code memory it is written to is allocated cleared
+    return m_image != nullptr ? m_imageSize : 0;
+}
+
+uint64_t Nso::CodeSegmentAddr(void) const
+{
+    return m_header.Segments[SegmentText].MemoryOffset;
+}
+
+uint64_t Nso::CodeSegmentOffset(void) const
+{
+    return m_header.Segments[SegmentText].MemoryOffset;
+}
+
+uint64_t Nso::CodeSegmentSize(void) const
+{
+    return PageAlignSize(m_header.Segments[SegmentText].Size);
+}
+
+uint64_t Nso::RODataSegmentAddr(void) const
+{
+    return m_header.Segments[SegmentROData].MemoryOffset;
+}
+
+uint64_t Nso::RODataSegmentOffset(void) const
+{
+    return m_header.Segments[SegmentROData].MemoryOffset;
+}
+
+uint64_t Nso::RODataSegmentSize(void) const
+{
+    return PageAlignSize(m_header.Segments[SegmentROData].Size);
+}
+
+uint64_t Nso::DataSegmentAddr(void) const
+{
+    return m_header.Segments[SegmentData].MemoryOffset;
+}
+
+uint64_t Nso::DataSegmentOffset(void) const
+{
+    return m_header.Segments[SegmentData].MemoryOffset;
+}
+
+uint64_t Nso::DataSegmentSize(void) const
+{
+    return CodeSize() - m_header.Segments[SegmentData].MemoryOffset;
+}
+
+uint32_t Nso::CodeSize() const
+{
+    return PageAlignSize(m_imageSize + m_header.Segments[SegmentData].AlignmentOrBssSize);
+}
+
+const IProgramMetadata & Nso::MetaData() const
+{
+    return DefaultMetaData();
+}
+
+bool Nso::Valid() const
+{
+    return m_valid;
+}
+
+bool Nso::IsSegmentCompressed(uint32_t segment) const
+{
+    return (m_header.Flags & (1 << segment)) != 0;
+}
+
+bool Nso::DecompressSegment(uint32_t segmentIndex)
+{
+    const NSO_SEGMENT_HEADER & segment = m_header.Segments[segmentIndex];
+    const uint8_t * source = m_file->Data() + segment.FileOffset;
+    uint8_t * destination = m_image.get() + segment.MemoryOffset;
+    if (segment.Size == 0)
+    {
+        return true;
+    }
+    if (!IsSegmentCompressed(segmentIndex))
+    {
+        memcpy(destination, source, segment.Size);
+        return true;
+    }
+    int result = Common::Compression::DecompressDataLZ4(destination, segment.Size, source, m_header.CompressedSize[segmentIndex]);
+    return result == (int)segment.Size;
+}
+
+constexpr uint32_t Nso::PageAlignSize(uint32_t size)
+{
+    enum
+    {
+        pageBits = 12,
+        pageSize = 1ULL << pageBits,
+        pageMask = pageSize - 1,
+    };
+    return ((size + pageMask) & ~pageMask);
+}
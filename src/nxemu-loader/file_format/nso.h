@@ -0,0 +1,90 @@
+#pragma once
+#include <common/padding.h>
+#include <memory>
+#include <nxemu-module-spec/operating_system.h>
+#include <stdint.h>
+
+class MappedFile;
+
+__interface IProgramMetadata;
+
+class Nso :
+    public IModuleInfo
+{
+    enum
+    {
+        SegmentText = 0,
+        SegmentROData = 1,
+        SegmentData = 2,
+        SegmentCount = 3,
+    };
+
+    typedef struct
+    {
+        uint32_t FileOffset;
+        uint32_t MemoryOffset;
+        uint32_t Size;
+        uint32_t AlignmentOrBssSize;
+    } NSO_SEGMENT_HEADER;
+    static_assert(sizeof(NSO_SEGMENT_HEADER) == 0x10, "NSO_SEGMENT_HEADER has incorrect size.");
+
+    typedef struct
+    {
+        uint8_t Signature[4];
+        uint32_t Version;
+        uint32_t Reserved;
+        uint32_t Flags;
+        NSO_SEGMENT_HEADER Segments[SegmentCount];
+        uint8_t ModuleId[0x20];
+        uint32_t CompressedSize[SegmentCount];
+        PADDING_BYTES(0x1C);
+        uint32_t EmbeddedOffset;
+        uint32_t EmbeddedSize;
+        uint32_t DynStrOffset;
+        uint32_t DynStrSize;
+        uint32_t DynSymOffset;
+        uint32_t DynSymSize;
+        uint8_t SegmentHash[SegmentCount][0x20];
+    } NSO_HEADER;
+    static_assert(sizeof(NSO_HEADER) == 0x100, "NSO_HEADER has incorrect size.");
+
+public:
+    Nso(const char * filePath);
+    ~Nso();
+
+    //IModuleInfo
+    const uint8_t * Data(void) const;
+    uint32_t DataSize(void) const;
+    uint64_t CodeSegmentAddr(void) const;
+    uint64_t CodeSegmentOffset(void) const;
+    uint64_t CodeSegmentSize(void) const;
+    uint64_t RODataSegmentAddr(void) const;
+    uint64_t RODataSegmentOffset(void) const;
+    uint64_t RODataSegmentSize(void) const;
+    uint64_t DataSegmentAddr(void) const;
+    uint64_t DataSegmentOffset(void) const;
+    uint64_t DataSegmentSize(void) const;
+
+    bool Decompress();
+    uint32_t CodeSize() const;
+    const IProgramMetadata & MetaData() const;
+    bool Valid() const;
+
+    static bool IsNsoFile(const char * filePath);
+
+private:
+    Nso(void) = delete;
+    Nso(const Nso &) = delete;
+    Nso & operator=(const Nso &) = delete;
+
+    bool IsSegmentCompressed(uint32_t segment) const;
+    bool DecompressSegment(uint32_t segmentIndex);
+
+    static constexpr uint32_t PageAlignSize(uint32_t size);
+
+    std::unique_ptr<MappedFile> m_file;
+    NSO_HEADER m_header;
+    std::unique_ptr<uint8_t[]> m_image;
+    uint32_t m_imageSize;
+    bool m_valid;
+};
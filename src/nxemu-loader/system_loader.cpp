@@ -1,15 +1,19 @@
 #include "system_loader.h"
 #include "file_format/nro.h"
 #include "file_format/nacp.h"
+#include "file_format/nso.h"
+#include <chrono>
 #include <fmt/core.h>
 #include <common/path.h>
 #include <nxemu-core/settings/identifiers.h>
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/filesystem.h"
 #include "core/file_sys/romfs_factory.h"
+#include "core/file_sys/vfs/vfs_mapped.h"
 #include "core/file_sys/vfs/vfs_real.h"
 #include "core/file_sys/vfs/vfs_types.h"
 #include "core/file_sys/system_archive/system_archive.h"
+#include "yuzu_common/logging/log.h"
 
 extern IModuleSettings * g_settings;
 
@@ -23,6 +27,7 @@ struct Systemloader::Impl {
     }
 
     bool LoadNRO(const char* nroFile);
+    bool LoadNSO(const char* nsoFile);
 
     Systemloader & m_loader;
     ISwitchSystem & m_system;
@@ -60,7 +65,7 @@ bool Systemloader::SelectAndLoad(void * parentWindow)
 {
     Path fileToOpen;
     std::string fileName;
-    const char * filter = "Switch Files (*.nro)\0*.nro\0All files (*.*)\0*.*\0";
+    const char * filter = "Switch Files (*.nro, *.nso)\0*.nro;*.nso\0All files (*.*)\0*.*\0";
     if (fileToOpen.FileSelect(parentWindow, Path(Path::MODULE_DIRECTORY), filter, true))
     {
         fileName = (const std::string &)fileToOpen;
@@ -80,6 +85,18 @@ bool Systemloader::LoadRom(const char * romFile)
     {
         res = impl->LoadNRO(romFile);
     }
+    else if (Nso::IsNsoFile(romFile))
+    {
+        res = impl->LoadNSO(romFile);
+    }
+    else
+    {
+        std::string extension = Path(romFile).GetExtension();
+        if (_stricmp(extension.c_str(), "nsp") == 0 || _stricmp(extension.c_str(), "xci") == 0)
+        {
+            LOG_ERROR(Loader, "Unable to load {}, NSP and XCI content is stored in NCAs and NCA decryption is not supported", romFile);
+        }
+    }
 
     g_settings->SetBool(NXCoreSetting::RomLoading, false);
     if (res)
@@ -135,13 +152,68 @@ bool Systemloader::Impl::LoadNRO(const char* nroFile)
         return false;
     }
 
+    FileSys::VirtualFile romfs;
+    if (m_nro->RomFSSize() > 0)
+    {
+        romfs = std::make_shared<FileSys::MappedVfsFile>(m_nro->MappedImage(), m_nro->RomFSOffset(), m_nro->RomFSSize(), "romfs");
+    }
+
     m_titleID = Nacp->GetTitleId();
-    m_fsController.RegisterProcess(processID, m_titleID, std::make_unique<FileSys::RomFSFactory>(nullptr, false, *m_contentProvider, m_fsController));
+    m_fsController.RegisterProcess(processID, m_titleID, std::make_unique<FileSys::RomFSFactory>(romfs, false, *m_contentProvider, m_fsController));
     g_settings->SetString(NXCoreSetting::GameName, Nacp->GetApplicationName().c_str());
     operatingSystem.StartApplicationProcess(metaData.GetMainThreadPriority(), metaData.GetMainThreadStackSize(), 0, StorageId::None, StorageId::None, nullptr, 0);
     return true;
 }
 
+bool Systemloader::Impl::LoadNSO(const char * nsoFile)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto ElapsedUs = [](Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+
+    Clock::time_point start = Clock::now();
+    Nso nso(nsoFile);
+    if (!nso.Valid())
+    {
+        return false;
+    }
+    const int64_t readTime = ElapsedUs(start);
+
+    IOperatingSystem & operatingSystem = m_system.OperatingSystem();
+    const IProgramMetadata & metaData = nso.MetaData();
+    uint64_t baseAddress = 0;
+    uint64_t processID = 0;
+    if (!operatingSystem.CreateApplicationProcess(nso.CodeSize(), metaData, baseAddress, processID, false))
+    {
+        return false;
+    }
+
+    start = Clock::now();
+    if (!nso.Decompress())
+    {
+        LOG_ERROR(Loader, "Failed to decompress the segments of {}", nsoFile);
+        return false;
+    }
+    const int64_t decompressTime = ElapsedUs(start);
+
+    start = Clock::now();
+    if (!operatingSystem.LoadModule(nso, baseAddress))
+    {
+        return false;
+    }
+    const int64_t mapTime = ElapsedUs(start);
+
+    // A standalone NSO is not encrypted, the decrypt phase only applies to NCA backed content
+    LOG_INFO(Loader, "Loaded {}: read {}us, decrypt 0us, decompress {}us, map {}us", nsoFile, readTime, decompressTime, mapTime);
+
+    m_titleID = metaData.GetTitleID();
+    m_fsController.RegisterProcess(processID, m_titleID, std::make_unique<FileSys::RomFSFactory>(nullptr, false, *m_contentProvider, m_fsController));
+    g_settings->SetString(NXCoreSetting::GameName, Path(nsoFile).GetNameExtension().c_str());
+    operatingSystem.StartApplicationProcess(metaData.GetMainThreadPriority(), metaData.GetMainThreadStackSize(), 0, StorageId::None, StorageId::None, nullptr, 0);
+    return true;
+}
+
 IFileSystemController & Systemloader::FileSystemController()
 {
     return impl->m_fsController;
@@ -17,9 +17,9 @@
 enum
 {
     MODULE_LOADER_SPECS_VERSION = 0x0107,
-    MODULE_VIDEO_SPECS_VERSION = 0x0108,
+    MODULE_VIDEO_SPECS_VERSION = 0x010A,
     MODULE_CPU_SPECS_VERSION = 0x0103,
-    MODULE_OPERATING_SYSTEM_SPECS_VERSION = 0x0108,
+    MODULE_OPERATING_SYSTEM_SPECS_VERSION = 0x0109,
 };
 
 enum MODULE_TYPE : uint16_t
@@ -83,6 +83,7 @@ __interface IOperatingSystem
     void GameFrameEnd() = 0;
     void AudioGetSyncIDs(uint32_t * ids, uint32_t maxCount, uint32_t * actualCount) = 0;
     void AudioGetDeviceListForSink(uint32_t sinkId, bool capture, DeviceEnumCallback callback, void * userData) = 0;
+    bool ReplayAudioCapture(const char * capturePath, const char * reportPath) = 0;
 };
 
 EXPORT IOperatingSystem * CALL CreateOperatingSystem(ISwitchSystem & system);
@@ -26,6 +26,26 @@ struct VideoNvFence
     uint32_t value;
 };
 
+struct VideoTextureFormatBytes
+{
+    char format[32];
+    uint64_t bytes;
+};
+
+struct VideoTextureCacheStats
+{
+    uint64_t residentBytes;
+    uint32_t residentFormatCount;
+    VideoTextureFormatBytes residentFormats[8]; // Formats holding the most resident bytes, largest first
+    uint64_t usedMemory;
+    uint64_t budget;
+    uint64_t evictions;
+    uint64_t evictedBytes;
+    uint64_t reuploads;
+    uint64_t decodes;
+    uint64_t decodeTime;
+};
+
 struct RasterizerDownloadArea 
 {
     uint64_t startAddress;
@@ -63,7 +83,12 @@ __interface IVideo
     bool OnCPUWrite(uint64_t addr, uint64_t size) = 0;
     uint32_t HostSyncpointValue(uint32_t id) = 0;
     uint32_t HostSyncpointRegisterAction(uint32_t fence_id, uint32_t target_value, HostActionCallback operation, uint32_t slot, void * userData) = 0;
+    uint64_t FrontendTime(void) = 0; // Nanoseconds the GPU thread has spent executing commands
+    void TextureCacheStats(VideoTextureCacheStats & stats) = 0; // Counters published on the last frame, decodeTime in nanoseconds
 };
 
 EXPORT IVideo * CALL CreateVideo(IRenderWindow & RenderWindow, ISwitchSystem & System);
 EXPORT void CALL DestroyVideo(IVideo * Video);
+
+// Optional, replays a GPU capture without an emulated system
+EXPORT bool CALL ReplayGpuCapture(const char * capturePath, const char * reportPath);
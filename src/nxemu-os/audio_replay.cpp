@@ -0,0 +1,347 @@
+#include "audio_replay.h"
+#include "core/core.h"
+#include "core/hle/kernel/k_memory_manager.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/service/kernel_helpers.h"
+#include "core/memory.h"
+#include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "yuzu_audio_core/renderer/capture/update_capture.h"
+#include "yuzu_audio_core/renderer/command/command_list_header.h"
+#include "yuzu_audio_core/renderer/system.h"
+#include "yuzu_audio_core/sink/null_sink.h"
+#include "yuzu_common/alignment.h"
+#include "yuzu_common/cityhash.h"
+#include "yuzu_common/fs/file.h"
+#include "yuzu_common/logging/log.h"
+#include "yuzu_common/settings.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fmt/format.h>
+#include <unordered_map>
+#include <vector>
+
+namespace AudioCapture
+{
+namespace
+{
+    using AudioCore::ADSP::AudioRenderer::CommandListProcessor;
+    using AudioCore::Renderer::UpdateCapture;
+    using Core::Memory::YUZU_PAGESIZE;
+
+    /*
+     * Guest memory of the capture. The pages of the memory records are mapped into the replay
+     * process on first use, straight into its page table as nothing but the renderer touches them.
+     */
+    class ReplayMemory
+    {
+    public:
+        ReplayMemory(Core::System & system, Kernel::KProcess & process) :
+            m_kernel(system.Kernel()),
+            m_process(process),
+            m_memory(process.GetMemory())
+        {
+        }
+
+        ~ReplayMemory()
+        {
+            for (const auto & [address, physical] : m_pages)
+            {
+                m_memory.UnmapRegion(m_process.GetPageTable().GetImpl(), address, YUZU_PAGESIZE, false);
+                m_kernel.MemoryManager().Close(physical, 1);
+            }
+        }
+
+        bool Write(u64 address, std::span<const u8> data)
+        {
+            const u64 end = Common::AlignUp(address + data.size(), YUZU_PAGESIZE);
+            for (u64 page = Common::AlignDown(address, YUZU_PAGESIZE); page < end; page += YUZU_PAGESIZE)
+            {
+                if (m_pages.contains(page))
+                {
+                    continue;
+                }
+                const Kernel::KPhysicalAddress physical = m_kernel.MemoryManager().AllocateAndOpenContinuous(1, 1, Kernel::KMemoryManager::EncodeOption(Kernel::KMemoryManager::Pool::Application, Kernel::KMemoryManager::Direction::FromFront));
+                if (physical == 0)
+                {
+                    LOG_ERROR(Audio, "Out of memory mapping captured page {:#x}", page);
+                    return false;
+                }
+                m_memory.MapMemoryRegion(m_process.GetPageTable().GetImpl(), page, YUZU_PAGESIZE, physical, Common::MemoryPermission::ReadWrite, false);
+                m_pages.emplace(page, physical);
+            }
+            m_memory.WriteBlockUnsafe(address, data.data(), data.size());
+            return true;
+        }
+
+    private:
+        Kernel::KernelCore & m_kernel;
+        Kernel::KProcess & m_process;
+        Core::Memory::Memory & m_memory;
+        std::unordered_map<u64, Kernel::KPhysicalAddress> m_pages;
+    };
+
+    double Percentile(const std::vector<double> & sorted, double percentile)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        const size_t index = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+} // namespace
+
+const IProgramMetadata & ReplayMetaData()
+{
+    class ProgramMetaData :
+        public IProgramMetadata
+    {
+        bool Is64BitProgram() const
+        {
+            return true;
+        }
+        ProgramAddressSpaceType GetAddressSpaceType() const
+        {
+            return ProgramAddressSpaceType::Is39Bit;
+        }
+        uint8_t GetMainThreadPriority() const
+        {
+            return 0x2C;
+        }
+        uint8_t GetMainThreadCore() const
+        {
+            return 0;
+        }
+        uint32_t GetMainThreadStackSize() const
+        {
+            return 0x100000;
+        }
+        uint64_t GetTitleID() const
+        {
+            return 0;
+        }
+        uint64_t GetFilesystemPermissions() const
+        {
+            return 0;
+        }
+        uint32_t GetSystemResourceSize() const
+        {
+            return 0;
+        }
+        PoolPartition GetPoolPartition() const
+        {
+            return PoolPartition::Application;
+        }
+        const uint32_t * GetKernelCapabilities() const
+        {
+            return nullptr;
+        }
+        uint32_t GetKernelCapabilitiesSize() const
+        {
+            return 0;
+        }
+        const char * GetName() const
+        {
+            return "AudioReplay";
+        }
+    };
+    static ProgramMetaData replayMetaData;
+    return replayMetaData;
+}
+
+bool Replay(Core::System & system, Kernel::KProcess & process, const std::string & capturePath, const std::string & reportPath)
+{
+    Common::FS::IOFile file(capturePath, Common::FS::FileAccessMode::Read, Common::FS::FileType::BinaryFile);
+    UpdateCapture::CaptureHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header))
+    {
+        LOG_ERROR(Audio, "Failed to open audio capture {}", capturePath);
+        return false;
+    }
+    if (header.magic != UpdateCapture::Magic || header.version != UpdateCapture::Version)
+    {
+        LOG_ERROR(Audio, "{} is not a version {} audio capture", capturePath, UpdateCapture::Version);
+        return false;
+    }
+
+    // Commands are timed on the replay thread, the processor's periodic report is disabled below
+    Settings::values.audio_command_timing.SetValue(true);
+
+    Service::KernelHelpers::ServiceContext serviceContext(system, "AudioReplay");
+    Kernel::KEvent * renderedEvent = serviceContext.CreateEvent("AudioReplay:RenderedEvent");
+    AudioCore::Sink::NullSink sink("");
+    AudioCore::Sink::SinkStream * stream = sink.AcquireSinkStream(system, 2, "AudioReplay", AudioCore::Sink::StreamType::Render);
+    ReplayMemory memory(system, process);
+
+    const u64 workBufferSize = AudioCore::Renderer::System::GetWorkBufferSize(header.params);
+    AudioCore::Renderer::System renderer(system, renderedEvent);
+    if (renderer.Initialize(header.params, nullptr, workBufferSize, &process, header.applet_resource_user_id, header.session_id).IsError())
+    {
+        LOG_ERROR(Audio, "Failed to initialize the audio renderer for replay");
+        serviceContext.CloseEvent(renderedEvent);
+        return false;
+    }
+
+    // The generator does not bound its writes, size the command buffer like the whole work buffer
+    std::vector<u8> commandBuffer(workBufferSize);
+    u64 commandSize = 0;
+    bool commandListPending = false;
+    CommandListProcessor processor;
+    std::array<CommandListProcessor::CommandTiming, CommandListProcessor::CommandIdCount> commandTotals{};
+
+    std::vector<u8> data;
+    std::vector<u8> output;
+    std::vector<u8> performance;
+    std::vector<double> updateTimes;
+    std::vector<double> frameTimes;
+    u64 checksum = 0;
+    bool result = true;
+
+    using Clock = std::chrono::steady_clock;
+    const auto Elapsed = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    };
+    double generateTime = 0.0;
+    const Clock::time_point replayStart = Clock::now();
+
+    UpdateCapture::CaptureRecord record{};
+    while (result && file.ReadObject(record))
+    {
+        data.resize(record.size);
+        if (file.ReadSpan(std::span<u8>(data)) != data.size())
+        {
+            LOG_ERROR(Audio, "Audio capture {} is truncated", capturePath);
+            result = false;
+            break;
+        }
+
+        switch (record.type)
+        {
+        case UpdateCapture::RecordType::Update:
+        {
+            UpdateCapture::UpdateRecord update{};
+            if (data.size() < sizeof(update))
+            {
+                result = false;
+                break;
+            }
+            std::memcpy(&update, data.data(), sizeof(update));
+            output.resize(update.output_size);
+            performance.resize(update.performance_size);
+            const Clock::time_point start = Clock::now();
+            if (renderer.Update(std::span<const u8>(data).subspan(sizeof(update)), performance, output).IsError())
+            {
+                LOG_WARNING(Audio, "Replayed update {} failed", updateTimes.size());
+            }
+            updateTimes.push_back(Elapsed(start));
+            break;
+        }
+        case UpdateCapture::RecordType::Memory:
+            result = memory.Write(record.address, data);
+            break;
+        case UpdateCapture::RecordType::CommandList:
+        {
+            const Clock::time_point start = Clock::now();
+            commandSize = renderer.GenerateCommand(commandBuffer, commandBuffer.size());
+            generateTime = Elapsed(start);
+            commandListPending = true;
+            break;
+        }
+        case UpdateCapture::RecordType::Processed:
+        {
+            if (!commandListPending)
+            {
+                break;
+            }
+            commandListPending = false;
+
+            const Clock::time_point start = Clock::now();
+            processor.Initialize(system, process, AudioCore::CpuAddr(commandBuffer.data()), commandSize, stream);
+            processor.Process(header.session_id);
+            frameTimes.push_back(generateTime + Elapsed(start));
+
+            for (size_t type = 0; type < CommandListProcessor::CommandIdCount; type++)
+            {
+                commandTotals[type].count += processor.command_timings[type].count;
+                commandTotals[type].elapsed_ns += processor.command_timings[type].elapsed_ns;
+                commandTotals[type].estimated_time += processor.command_timings[type].estimated_time;
+            }
+            processor.command_timings = {};
+            processor.timed_lists = 0;
+            processor.timed_lists_us = 0;
+
+            const auto & listHeader = *reinterpret_cast<const AudioCore::Renderer::CommandListHeader *>(commandBuffer.data());
+            const size_t mixSize = static_cast<size_t>(std::max<s16>(listHeader.mix_buffer_count, 0)) * listHeader.sample_count;
+            const std::span<const s32> mixBuffers = listHeader.samples_buffer.first(std::min(mixSize, listHeader.samples_buffer.size()));
+            checksum = Common::CityHash64WithSeed(reinterpret_cast<const char *>(mixBuffers.data()), mixBuffers.size_bytes(), checksum);
+            break;
+        }
+        default:
+            LOG_ERROR(Audio, "Unknown audio capture record {}", static_cast<u32>(record.type));
+            result = false;
+            break;
+        }
+    }
+    renderer.Finalize();
+    serviceContext.CloseEvent(renderedEvent);
+    if (!result)
+    {
+        return false;
+    }
+
+    const double replayTime = std::chrono::duration<double>(Clock::now() - replayStart).count();
+    std::vector<double> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (const double time : frameTimes)
+    {
+        total += time;
+    }
+    const double mean = frameTimes.empty() ? 0.0 : total / static_cast<double>(frameTimes.size());
+    LOG_INFO(Audio, "Audio replay of {}: {} updates, {} frames in {:.2f}s, render per frame mean {:.1f}us p50 {:.1f}us p90 {:.1f}us p99 {:.1f}us max {:.1f}us, output checksum {:016X}", capturePath, updateTimes.size(), frameTimes.size(), replayTime, mean, Percentile(sorted, 0.5), Percentile(sorted, 0.9), Percentile(sorted, 0.99), sorted.empty() ? 0.0 : sorted.back(), checksum);
+    for (size_t type = 0; type < CommandListProcessor::CommandIdCount; type++)
+    {
+        const CommandListProcessor::CommandTiming & timing = commandTotals[type];
+        if (timing.count == 0)
+        {
+            continue;
+        }
+        LOG_INFO(Audio, "\tcommand {:02X}: count {}, total {:.1f}us, average {:.0f}ns, estimated {}", type, timing.count, static_cast<double>(timing.elapsed_ns) / 1000.0, static_cast<double>(timing.elapsed_ns) / static_cast<double>(timing.count), timing.estimated_time);
+    }
+
+    if (!reportPath.empty())
+    {
+        Common::FS::IOFile report(reportPath, Common::FS::FileAccessMode::Write, Common::FS::FileType::TextFile);
+        if (!report.IsOpen())
+        {
+            LOG_ERROR(Audio, "Failed to create audio replay report {}", reportPath);
+            return false;
+        }
+        std::string text = "frame,render_us\n";
+        for (size_t i = 0; i < frameTimes.size(); i++)
+        {
+            text += fmt::format("{},{:.2f}\n", i, frameTimes[i]);
+        }
+        text += "\ncommand,count,total_us,estimated\n";
+        for (size_t type = 0; type < CommandListProcessor::CommandIdCount; type++)
+        {
+            const CommandListProcessor::CommandTiming & timing = commandTotals[type];
+            if (timing.count != 0)
+            {
+                text += fmt::format("{:02X},{},{:.2f},{}\n", type, timing.count, static_cast<double>(timing.elapsed_ns) / 1000.0, timing.estimated_time);
+            }
+        }
+        text += fmt::format("\nchecksum,{:016X}\n", checksum);
+        if (report.WriteString(text) != text.size())
+        {
+            LOG_ERROR(Audio, "Failed to write audio replay report {}", reportPath);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace AudioCapture
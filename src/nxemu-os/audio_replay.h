@@ -0,0 +1,28 @@
+#pragma once
+#include <nxemu-module-spec/operating_system.h>
+#include <string>
+
+namespace Core
+{
+class System;
+}
+
+namespace Kernel
+{
+class KProcess;
+}
+
+namespace AudioCapture
+{
+
+// Metadata of the process a capture is replayed in, it only holds the captured guest memory
+const IProgramMetadata & ReplayMetaData();
+
+/*
+ * Drives a fresh audio renderer through a capture on the calling thread with the null sink, and
+ * reports the host time spent on every frame, the totals per command and a checksum of the
+ * rendered output. Returns false if the capture can not be replayed.
+ */
+bool Replay(Core::System & system, Kernel::KProcess & process, const std::string & capturePath, const std::string & reportPath);
+
+} // namespace AudioCapture
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <common/json.h>
+#include <nxemu-module-spec/video.h>
+#include "yuzu_common/fs/file.h"
+#include "yuzu_common/fs/fs.h"
+#include "yuzu_common/literals.h"
+#include "yuzu_common/logging/log.h"
+#include "core/benchmark.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/perf_stats.h"
+
+namespace Core {
+
+namespace {
+
+using namespace Common::Literals;
+using DoubleMs = std::chrono::duration<double, std::milli>;
+
+/// Nearest-rank percentile of an ascending sorted sample
+double Percentile(const std::vector<double>& sorted, double percent) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(std::ceil(percent / 100.0 * sorted.size()));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+} // Anonymous namespace
+
+Benchmark::Benchmark(System& system_, u32 frames_, std::string report_path_,
+                     std::function<void()> on_complete_)
+    : system{system_}, frames{frames_}, report_path{std::move(report_path_)},
+      on_complete{std::move(on_complete_)} {}
+
+Benchmark::~Benchmark() = default;
+
+void Benchmark::EndSystemFrame() {
+    if (complete) {
+        return;
+    }
+    frame_count++;
+    if (frame_count == PerfStats::IgnoreFrames) {
+        start = TakeSnapshot();
+    }
+    if (frame_count < PerfStats::IgnoreFrames + frames) {
+        return;
+    }
+    complete = true;
+    Report(TakeSnapshot());
+    if (on_complete) {
+        on_complete();
+    }
+}
+
+Benchmark::Snapshot Benchmark::TakeSnapshot() const {
+    Snapshot snapshot{
+        .wall_time = std::chrono::steady_clock::now(),
+        .gpu_frontend_ns = system.GetVideo().FrontendTime(),
+        .emulated_us = static_cast<u64>(system.CoreTiming().GetGlobalTimeUs().count()),
+    };
+    for (std::size_t core = 0; core < snapshot.guest_cpu_time.size(); core++) {
+        snapshot.guest_cpu_time[core] = system.GetGuestCpuTime(core);
+    }
+    return snapshot;
+}
+
+void Benchmark::Report(const Snapshot& end) const {
+    std::vector<double> frametimes = system.GetPerfStats().GetFrametimes();
+    if (frametimes.size() > frames) {
+        frametimes.resize(frames);
+    }
+    const double mean =
+        frametimes.empty()
+            ? 0.0
+            : std::accumulate(frametimes.begin(), frametimes.end(), 0.0) / frametimes.size();
+    std::sort(frametimes.begin(), frametimes.end());
+
+    const double wall_ms = DoubleMs(end.wall_time - start.wall_time).count();
+    const double emulated_ms = static_cast<double>(end.emulated_us - start.emulated_us) / 1000.0;
+    const double gpu_frontend_ms =
+        static_cast<double>(end.gpu_frontend_ns - start.gpu_frontend_ns) / 1'000'000.0;
+
+    JsonValue frame_time(JsonValueType::Object);
+    frame_time["mean"] = mean;
+    frame_time["p50"] = Percentile(frametimes, 50.0);
+    frame_time["p90"] = Percentile(frametimes, 90.0);
+    frame_time["p99"] = Percentile(frametimes, 99.0);
+    frame_time["max"] = frametimes.empty() ? 0.0 : frametimes.back();
+
+    JsonValue guest_cpu(JsonValueType::Array);
+    for (std::size_t core = 0; core < end.guest_cpu_time.size(); core++) {
+        const double core_ms =
+            DoubleMs(end.guest_cpu_time[core] - start.guest_cpu_time[core]).count();
+        guest_cpu.Append(JsonValue(core_ms));
+        LOG_INFO(Core, "Benchmark: core {} guest time {:.1f} ms ({:.1f}%)", core, core_ms,
+                 wall_ms > 0.0 ? core_ms * 100.0 / wall_ms : 0.0);
+    }
+
+    VideoTextureCacheStats texture_stats{};
+    system.GetVideo().TextureCacheStats(texture_stats);
+    JsonValue resident_formats(JsonValueType::Object);
+    for (uint32_t i = 0; i < texture_stats.residentFormatCount; i++) {
+        const VideoTextureFormatBytes& format = texture_stats.residentFormats[i];
+        resident_formats[format.format] = static_cast<double>(format.bytes) / 1_MiB;
+    }
+    JsonValue texture_cache(JsonValueType::Object);
+    texture_cache["resident_mib"] = static_cast<double>(texture_stats.residentBytes) / 1_MiB;
+    texture_cache["resident_formats_mib"] = resident_formats;
+    texture_cache["used_mib"] = static_cast<double>(texture_stats.usedMemory) / 1_MiB;
+    texture_cache["budget_mib"] = static_cast<double>(texture_stats.budget) / 1_MiB;
+    texture_cache["evictions"] = texture_stats.evictions;
+    texture_cache["evicted_mib"] = static_cast<double>(texture_stats.evictedBytes) / 1_MiB;
+    texture_cache["reuploads"] = texture_stats.reuploads;
+    texture_cache["decodes"] = texture_stats.decodes;
+    texture_cache["decode_ms"] = static_cast<double>(texture_stats.decodeTime) / 1'000'000.0;
+
+    JsonValue root(JsonValueType::Object);
+    root["title_id"] = fmt::format("{:016X}", system.GetApplicationProcessProgramID());
+    root["frames"] = static_cast<uint32_t>(frametimes.size());
+    root["wall_ms"] = wall_ms;
+    root["emulated_ms"] = emulated_ms;
+    root["fps"] = wall_ms > 0.0 ? frametimes.size() * 1000.0 / wall_ms : 0.0;
+    root["frame_time_ms"] = frame_time;
+    root["guest_cpu_ms"] = guest_cpu;
+    root["gpu_frontend_ms"] = gpu_frontend_ms;
+    root["texture_cache"] = texture_cache;
+
+    LOG_INFO(Core,
+             "Benchmark: {} frames in {:.1f} ms, frame time mean {:.3f} p50 {:.3f} p90 {:.3f} "
+             "p99 {:.3f} max {:.3f} ms, GPU frontend {:.1f} ms",
+             frametimes.size(), wall_ms, mean, Percentile(frametimes, 50.0),
+             Percentile(frametimes, 90.0), Percentile(frametimes, 99.0),
+             frametimes.empty() ? 0.0 : frametimes.back(), gpu_frontend_ms);
+    LOG_INFO(Core,
+             "Benchmark: texture cache {:.1f} MiB resident, {:.1f} of {:.1f} MiB used, {} "
+             "evictions, {} re-uploads, {} decodes in {:.1f} ms",
+             static_cast<double>(texture_stats.residentBytes) / 1_MiB,
+             static_cast<double>(texture_stats.usedMemory) / 1_MiB,
+             static_cast<double>(texture_stats.budget) / 1_MiB, texture_stats.evictions,
+             texture_stats.reuploads, texture_stats.decodes,
+             static_cast<double>(texture_stats.decodeTime) / 1'000'000.0);
+    for (uint32_t i = 0; i < texture_stats.residentFormatCount; i++) {
+        LOG_INFO(Core, "Benchmark: texture cache {:.1f} MiB of {}",
+                 static_cast<double>(texture_stats.residentFormats[i].bytes) / 1_MiB,
+                 texture_stats.residentFormats[i].format);
+    }
+
+    if (report_path.empty()) {
+        return;
+    }
+    if (Common::FS::WriteStringToFile(report_path, Common::FS::FileType::TextFile,
+                                      JsonStyledWriter().write(root)) == 0) {
+        LOG_ERROR(Core, "Benchmark: failed to write report {}", report_path);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "yuzu_common/common_types.h"
+#include "core/hardware_properties.h"
+
+namespace Core {
+
+class System;
+
+/**
+ * Counts presented system frames of a headless run and, once the requested number has been
+ * reached, reports frame-time percentiles, guest CPU time per core and GPU frontend time. The
+ * first PerfStats::IgnoreFrames frames are treated as warm-up and excluded from the report.
+ */
+class Benchmark {
+public:
+    explicit Benchmark(System& system_, u32 frames_, std::string report_path_,
+                       std::function<void()> on_complete_);
+    ~Benchmark();
+
+    /// Called after every system frame has been presented
+    void EndSystemFrame();
+
+    [[nodiscard]] bool IsComplete() const {
+        return complete;
+    }
+
+private:
+    struct Snapshot {
+        std::chrono::steady_clock::time_point wall_time;
+        std::array<std::chrono::nanoseconds, Hardware::NUM_CPU_CORES> guest_cpu_time{};
+        u64 gpu_frontend_ns{};
+        u64 emulated_us{};
+    };
+
+    Snapshot TakeSnapshot() const;
+    void Report(const Snapshot& end) const;
+
+    System& system;
+    const u32 frames;
+    const std::string report_path;
+    std::function<void()> on_complete;
+
+    Snapshot start{};
+    u32 frame_count{};
+    bool complete{};
+};
+
+} // namespace Core
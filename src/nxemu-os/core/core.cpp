@@ -6,6 +6,7 @@
 
 #include "yuzu_audio_core/audio_core.h"
 #include "yuzu_common/microprofile.h"
+#include "core/benchmark.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
@@ -213,6 +214,7 @@ struct System::Impl {
 
     std::unique_ptr<Core::PerfStats> perf_stats;
     Core::SpeedLimiter speed_limiter;
+    std::unique_ptr<Core::Benchmark> benchmark;
 
     bool is_multicore{};
     bool is_async_gpu{};
@@ -222,6 +224,9 @@ struct System::Impl {
 
     std::array<u64, Core::Hardware::NUM_CPU_CORES> dynarmic_ticks{};
     std::array<MicroProfileToken, Core::Hardware::NUM_CPU_CORES> microprofile_cpu{};
+    std::array<std::chrono::steady_clock::time_point, Core::Hardware::NUM_CPU_CORES>
+        guest_enter_time{};
+    std::array<std::atomic<s64>, Core::Hardware::NUM_CPU_CORES> guest_cpu_ns{};
 
     std::array<Core::GPUDirtyMemoryManager, Core::Hardware::NUM_CPU_CORES>
         gpu_dirty_memory_managers;
@@ -397,6 +402,16 @@ const Core::SpeedLimiter& System::SpeedLimiter() const {
     return impl->speed_limiter;
 }
 
+void System::StartBenchmark(u32 frames, std::string report_path,
+                            std::function<void()> on_complete) {
+    impl->benchmark = std::make_unique<Core::Benchmark>(*this, frames, std::move(report_path),
+                                                        std::move(on_complete));
+}
+
+Core::Benchmark* System::GetBenchmark() {
+    return impl->benchmark.get();
+}
+
 std::shared_ptr<InputCommon::InputSubsystem> & System::InputSubsystem()
 {
     return impl->input_subsystem;
@@ -502,13 +517,22 @@ void System::RegisterHostThread() {
 void System::EnterCPUProfile() {
     std::size_t core = impl->kernel.GetCurrentHostThreadID();
     impl->dynarmic_ticks[core] = MicroProfileEnter(impl->microprofile_cpu[core]);
+    impl->guest_enter_time[core] = std::chrono::steady_clock::now();
 }
 
 void System::ExitCPUProfile() {
     std::size_t core = impl->kernel.GetCurrentHostThreadID();
+    const auto guest_time = std::chrono::steady_clock::now() - impl->guest_enter_time[core];
+    impl->guest_cpu_ns[core].fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(guest_time).count(),
+        std::memory_order_relaxed);
     MicroProfileLeave(impl->microprofile_cpu[core], impl->dynarmic_ticks[core]);
 }
 
+std::chrono::nanoseconds System::GetGuestCpuTime(std::size_t core) const {
+    return std::chrono::nanoseconds{impl->guest_cpu_ns[core].load(std::memory_order_relaxed)};
+}
+
 bool System::IsMulticore() const {
     return impl->is_multicore;
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <deque>
 #include <functional>
@@ -119,6 +120,7 @@ class InputSubsystem;
 
 namespace Core {
 
+class Benchmark;
 class CpuManager;
 class Debugger;
 class DeviceMemory;
@@ -308,6 +310,12 @@ public:
     /// Provides a constant reference to the speed limiter
     [[nodiscard]] const Core::SpeedLimiter& SpeedLimiter() const;
 
+    /// Runs a benchmark over the next frames, on_complete is called once it has been reported
+    void StartBenchmark(u32 frames, std::string report_path, std::function<void()> on_complete);
+
+    /// Provides a pointer to the running benchmark, nullptr when not benchmarking
+    [[nodiscard]] Core::Benchmark* GetBenchmark();
+
     std::shared_ptr<InputCommon::InputSubsystem> & InputSubsystem();
 
     [[nodiscard]] u64 GetApplicationProcessProgramID() const;
@@ -382,6 +390,9 @@ public:
     /// Exit CPU Microprofile
     void ExitCPUProfile();
 
+    /// Gets the time the given core has spent executing guest code
+    [[nodiscard]] std::chrono::nanoseconds GetGuestCpuTime(std::size_t core) const;
+
     /// Tells if system is running on multicore.
     [[nodiscard]] bool IsMulticore() const;
 
@@ -6,6 +6,7 @@
 #include "yuzu_common/nvdata.h"
 #include "yuzu_common/logging/log.h"
 #include "yuzu_common/yuzu_assert.h"
+#include "core/benchmark.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/nvdrv/core/container.h"
@@ -91,6 +92,9 @@ void nvdisp_disp0::Composite(std::span<const Nvnflinger::HwcLayer> sorted_layers
     system.SpeedLimiter().DoSpeedLimiting(system.CoreTiming().GetGlobalTimeUs());
     system.GetPerfStats().EndSystemFrame();
     system.GetPerfStats().BeginSystemFrame();
+    if (auto* benchmark = system.GetBenchmark()) {
+        benchmark->EndSystemFrame();
+    }
 }
 
 Kernel::KEvent* nvdisp_disp0::QueryEvent(u32 event_id) {
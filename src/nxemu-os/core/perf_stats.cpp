@@ -21,10 +21,6 @@ using DoubleSecs = std::chrono::duration<double, std::chrono::seconds::period>;
 using std::chrono::duration_cast;
 using std::chrono::microseconds;
 
-// Purposefully ignore the first five frames, as there's a significant amount of overhead in
-// booting that we shouldn't account for
-constexpr std::size_t IgnoreFrames = 5;
-
 namespace Core {
 
 PerfStats::PerfStats(u64 title_id_) : title_id(title_id_) {}
@@ -89,6 +85,16 @@ double PerfStats::GetMeanFrametime() const {
     return sum / static_cast<double>(current_index - IgnoreFrames);
 }
 
+std::vector<double> PerfStats::GetFrametimes() const {
+    std::scoped_lock lock{object_mutex};
+
+    if (current_index <= IgnoreFrames) {
+        return {};
+    }
+    return std::vector<double>(perf_history.begin() + IgnoreFrames,
+                               perf_history.begin() + current_index);
+}
+
 PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us) {
     std::scoped_lock lock{object_mutex};
 
@@ -8,6 +8,7 @@
 #include <chrono>
 #include <cstddef>
 #include <mutex>
+#include <vector>
 #include "yuzu_common/common_types.h"
 
 namespace Core {
@@ -34,6 +35,9 @@ public:
 
     using Clock = std::chrono::steady_clock;
 
+    /// Number of frames at boot that are left out of the frametime statistics
+    static constexpr std::size_t IgnoreFrames = 5;
+
     void BeginSystemFrame();
     void EndSystemFrame();
     void EndGameFrame();
@@ -45,6 +49,12 @@ public:
      */
     double GetMeanFrametime() const;
 
+    /**
+     * Returns a copy of the frametime values (in milliseconds) stored in the performance history,
+     * excluding the boot frames.
+     */
+    std::vector<double> GetFrametimes() const;
+
     /**
      * Gets the ratio between walltime and the emulated time of the previous system frame. This is
      * useful for scaling inputs or outputs moving between the two time domains.
@@ -11,6 +11,7 @@
 #include "yuzu_input_common/main.h"
 #include "yuzu_input_common/drivers/keyboard.h"
 #include "yuzu_audio_core/sink/sink_details.h"
+#include "audio_replay.h"
 #include "os_manager.h"
 #include "os_settings.h"
 
@@ -72,6 +73,18 @@ bool OSManager::Initialize(void)
     buttons[0x00000014] = "engine:keyboard,code:81,toggle:0";
     buttons[0x00000015] = "engine:keyboard,code:69,toggle:0";
 
+    int32_t benchmarkFrames = g_settings->GetInt(NXCoreSetting::BenchmarkFrames);
+    if (benchmarkFrames > 0)
+    {
+        // Run as fast as the host allows, nothing is presented or played back
+        Settings::values.use_speed_limit.SetValue(false);
+        Settings::values.sink_id.SetValue(Settings::AudioEngine::Null);
+        m_coreSystem.StartBenchmark(benchmarkFrames, g_settings->GetString(NXCoreSetting::BenchmarkReport), []()
+        {
+            g_settings->SetBool(NXCoreSetting::BenchmarkComplete, true);
+        });
+    }
+
     m_coreSystem.Initialize();
     m_coreSystem.HIDCore().ReloadInputDevices();
     return true;
@@ -79,23 +92,7 @@ bool OSManager::Initialize(void)
 
 bool OSManager::CreateApplicationProcess(uint64_t codeSize, const IProgramMetadata & metaData, uint64_t & baseAddress, uint64_t & processID, bool is_hbl)
 {
-    if (m_process != nullptr)
-    {
-       return false;
-    }
-    m_coreSystem.Run();
-    m_coreSystem.InitializeKernel(metaData.GetTitleID());
-    Kernel::KernelCore & kernel = m_coreSystem.Kernel();
-    m_process = Kernel::KProcess::Create(kernel);
-    if (m_process == nullptr)
-    {
-        return false;
-    }
-    Kernel::KProcess::Register(kernel, m_process);
-    kernel.AppendNewProcess(m_process);
-    kernel.MakeApplicationProcess(m_process);
-
-    if (m_process->LoadFromMetadata(metaData, codeSize, 0, false).IsError())
+    if (!CreateProcess(codeSize, metaData))
     {
         return false;
     }
@@ -175,6 +172,43 @@ void OSManager::AudioGetSyncIDs(uint32_t * ids, uint32_t maxCount, uint32_t* act
     }
 }
 
+bool OSManager::ReplayAudioCapture(const char * capturePath, const char * reportPath)
+{
+    if (capturePath == nullptr)
+    {
+        return false;
+    }
+    // Render as fast as the host allows, nothing is played back or captured again
+    Settings::values.sink_id.SetValue(Settings::AudioEngine::Null);
+    Settings::values.audio_capture_updates.SetValue(false);
+    if (!CreateProcess(Kernel::PageSize, AudioCapture::ReplayMetaData()))
+    {
+        return false;
+    }
+    return AudioCapture::Replay(m_coreSystem, *m_process, capturePath, reportPath != nullptr ? reportPath : "");
+}
+
+bool OSManager::CreateProcess(uint64_t codeSize, const IProgramMetadata & metaData)
+{
+    if (m_process != nullptr)
+    {
+       return false;
+    }
+    m_coreSystem.Run();
+    m_coreSystem.InitializeKernel(metaData.GetTitleID());
+    Kernel::KernelCore & kernel = m_coreSystem.Kernel();
+    m_process = Kernel::KProcess::Create(kernel);
+    if (m_process == nullptr)
+    {
+        return false;
+    }
+    Kernel::KProcess::Register(kernel, m_process);
+    kernel.AppendNewProcess(m_process);
+    kernel.MakeApplicationProcess(m_process);
+
+    return m_process->LoadFromMetadata(metaData, codeSize, 0, false).IsSuccess();
+}
+
 void OSManager::AudioGetDeviceListForSink(uint32_t sinkId, bool capture, DeviceEnumCallback callback, void * userData)
 {
     std::vector<std::string> devices = AudioCore::Sink::GetDeviceListForSink((Settings::AudioEngine)sinkId, capture);
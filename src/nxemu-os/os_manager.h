@@ -23,12 +23,15 @@ public:
     void GameFrameEnd() override;
     void AudioGetSyncIDs(uint32_t* ids, uint32_t maxCount, uint32_t* actualCount) override;
     void AudioGetDeviceListForSink(uint32_t sinkId, bool capture, DeviceEnumCallback callback, void* userData) override;
+    bool ReplayAudioCapture(const char * capturePath, const char * reportPath) override;
 
 private:
     OSManager() = delete;
     OSManager(const OSManager &) = delete;
     OSManager & operator=(const OSManager &) = delete;
 
+    bool CreateProcess(uint64_t codeSize, const IProgramMetadata & metaData);
+
     Core::System m_coreSystem;
     ISwitchSystem & m_switchSystem;
     Kernel::KProcess * m_process;
@@ -42,6 +42,12 @@ namespace
         { NXOsSetting::AudioMode, "audio", "mode", &Settings::values.sound_index },
         { NXOsSetting::AudioVolume, "audio", "volume", &Settings::values.volume },
         { NXOsSetting::AudioMuted, "audio", "muted", &Settings::values.audio_muted },
+        { NXOsSetting::AudioRendererWorkers, "audio", "renderer_workers", &Settings::values.audio_renderer_workers },
+        { NXOsSetting::AudioCommandTiming, "audio", "command_timing", &Settings::values.audio_command_timing },
+        { NXOsSetting::AudioOpusDecodeAhead, "audio", "opus_decode_ahead", &Settings::values.audio_opus_decode_ahead },
+        { NXOsSetting::AudioCaptureUpdates, "audio", "capture_updates", &Settings::values.audio_capture_updates },
+        { NXOsSetting::AudioRealtimePriority, "audio", "realtime_priority", &Settings::values.audio_realtime_priority },
+        { NXOsSetting::LogDeferredFormat, "log", "deferred_format", &Settings::values.log_deferred_format },
     };
 }
 
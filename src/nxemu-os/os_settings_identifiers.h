@@ -8,5 +8,11 @@ namespace NXOsSetting
     constexpr const char * AudioMode = "nxos:AudioMode";
     constexpr const char * AudioVolume = "nxos:AudioVolume";
     constexpr const char * AudioMuted = "nxos:AudioMuted";
+    constexpr const char * AudioRendererWorkers = "nxos:AudioRendererWorkers";
+    constexpr const char * AudioCommandTiming = "nxos:AudioCommandTiming";
+    constexpr const char * AudioOpusDecodeAhead = "nxos:AudioOpusDecodeAhead";
+    constexpr const char * AudioCaptureUpdates = "nxos:AudioCaptureUpdates";
+    constexpr const char * AudioRealtimePriority = "nxos:AudioRealtimePriority";
+    constexpr const char * LogDeferredFormat = "nxos:LogDeferredFormat";
 
 } // namespace NXCoreSetting
\ No newline at end of file
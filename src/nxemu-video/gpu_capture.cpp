@@ -0,0 +1,579 @@
+#include "gpu_capture.h"
+#include "yuzu_common/cityhash.h"
+#include "yuzu_common/logging/log.h"
+#include "yuzu_common/zstd_compression.h"
+#include "yuzu_video_core/host1x/gpu_device_memory_manager.h"
+#include "yuzu_video_core/host1x/host1x.h"
+#include "yuzu_video_core/memory_manager.h"
+#include <algorithm>
+
+namespace GpuCapture
+{
+namespace
+{
+    enum PageState : u8
+    {
+        PageTracked = 1 << 0,
+        PageCaptured = 1 << 1,
+        PageDirty = 1 << 2,
+        PageDeferred = 1 << 3,
+    };
+
+    struct PageRun
+    {
+        u64 virtualAddress;
+        u64 physicalAddress;
+        u64 size;
+    };
+} // namespace
+
+/// Forwards channel calls to the GPU channel and records the ones the replay has to repeat
+class GpuCaptureWriter::Channel :
+    public IChannelState
+{
+public:
+    Channel(GpuCaptureWriter & writer, IChannelState * channel, u32 index) :
+        m_writer(writer),
+        m_channel(channel),
+        m_index(index)
+    {
+    }
+
+    bool Initialized() const override
+    {
+        return m_channel->Initialized();
+    }
+
+    int32_t BindId() const override
+    {
+        return m_channel->BindId();
+    }
+
+    void Init(uint64_t programId) override
+    {
+        m_channel->Init(programId);
+        m_writer.ChannelInit(m_index, programId);
+    }
+
+    void SetMemoryManager(uint32_t id) override
+    {
+        m_channel->SetMemoryManager(id);
+        m_writer.ChannelSetMemoryManager(m_index, m_channel->BindId(), id);
+    }
+
+    void Release() override
+    {
+        m_writer.ChannelRelease(m_index, m_channel->BindId());
+        m_channel->Release();
+        delete this;
+    }
+
+private:
+    Channel() = delete;
+    Channel(const Channel &) = delete;
+    Channel & operator=(const Channel &) = delete;
+
+    GpuCaptureWriter & m_writer;
+    IChannelState * m_channel;
+    u32 m_index;
+};
+
+GpuCaptureWriter::GpuCaptureWriter(const std::string & path, const u8 * physicalBase, Tegra::Host1x::Host1x & host1x, Tegra::MemoryManagerRegistry & registry) :
+    m_file(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile),
+    m_header{FileMagic, FileVersion, 0, 0, 0},
+    m_physicalBase(physicalBase),
+    m_host1x(host1x),
+    m_registry(registry),
+    m_nextChannel(0)
+{
+    if (!m_file.IsOpen() || !m_file.WriteObject(m_header))
+    {
+        LOG_ERROR(HW_GPU, "Failed to create GPU capture {}", path);
+        m_file.Close();
+        return;
+    }
+    m_block.Data().reserve(BlockSize + PageSize * 2);
+    LOG_INFO(HW_GPU, "Capturing GPU command stream to {}", path);
+}
+
+GpuCaptureWriter::~GpuCaptureWriter()
+{
+    std::sort(m_watchedDevicePages.begin(), m_watchedDevicePages.end());
+    for (size_t i = 0, n = m_watchedDevicePages.size(); i < n;)
+    {
+        size_t end = i + 1;
+        while (end < n && m_watchedDevicePages[end] == m_watchedDevicePages[end - 1] + 1)
+        {
+            end += 1;
+        }
+        m_host1x.MemoryManager().UpdatePagesCachedCount(static_cast<u64>(m_watchedDevicePages[i]) << PageBits, (end - i) << PageBits, -1);
+        i = end;
+    }
+    if (!m_file.IsOpen())
+    {
+        return;
+    }
+    FlushBlock();
+    // The header is only complete once the whole stream is known
+    if (!m_file.Seek(0) || !m_file.WriteObject(m_header))
+    {
+        LOG_ERROR(HW_GPU, "Failed to finalize GPU capture");
+    }
+    LOG_INFO(HW_GPU, "GPU capture finished: {} frames, {} records, {} MiB of physical memory", m_header.frameCount, m_header.recordCount, m_header.physicalSize >> 20);
+}
+
+bool GpuCaptureWriter::IsOpen() const
+{
+    return m_file.IsOpen();
+}
+
+void GpuCaptureWriter::RegisterProcess(IMemory * memory, u64 asid)
+{
+    std::scoped_lock lock{m_mutex};
+    m_processes[asid] = memory;
+    BeginRecord(Op::RegisterProcess);
+    m_block.Put(asid);
+    EndRecord();
+}
+
+void GpuCaptureWriter::AllocAs(u64 addressSpaceBits, u64 splitAddress, u64 bigPageBits, u64 pageBits, u32 id)
+{
+    std::scoped_lock lock{m_mutex};
+    BeginRecord(Op::AllocAs);
+    m_block.Put(addressSpaceBits);
+    m_block.Put(splitAddress);
+    m_block.Put(bigPageBits);
+    m_block.Put(pageBits);
+    m_block.Put(id);
+    EndRecord();
+}
+
+void GpuCaptureWriter::MapBuffer(u64 gpuAddr, u64 deviceAddr, u64 size, u8 kind, bool isBigPages)
+{
+    std::scoped_lock lock{m_mutex};
+    BeginRecord(Op::MapBuffer);
+    m_block.Put(gpuAddr);
+    m_block.Put(deviceAddr);
+    m_block.Put(size);
+    m_block.Put(kind);
+    m_block.Put(isBigPages);
+    EndRecord();
+}
+
+void GpuCaptureWriter::MemoryAllocate(u64 size, u64 address)
+{
+    std::scoped_lock lock{m_mutex};
+    BeginRecord(Op::MemoryAllocate);
+    m_block.Put(size);
+    m_block.Put(address);
+    EndRecord();
+}
+
+void GpuCaptureWriter::TrackContinuity(u64 address, u64 virtualAddress, u64 size, u64 asid)
+{
+    std::scoped_lock lock{m_mutex};
+    RecordPageMapping(virtualAddress, size, asid);
+    WatchDeviceRange(address, size);
+    BeginRecord(Op::TrackContinuity);
+    m_block.Put(address);
+    m_block.Put(virtualAddress);
+    m_block.Put(size);
+    m_block.Put(asid);
+    EndRecord();
+}
+
+void GpuCaptureWriter::MemoryMap(u64 address, u64 virtualAddress, u64 size, u64 asid, bool track)
+{
+    std::scoped_lock lock{m_mutex};
+    RecordPageMapping(virtualAddress, size, asid);
+    WatchDeviceRange(address, size);
+    BeginRecord(Op::MemoryMap);
+    m_block.Put(address);
+    m_block.Put(virtualAddress);
+    m_block.Put(size);
+    m_block.Put(asid);
+    m_block.Put(track);
+    EndRecord();
+}
+
+IChannelState * GpuCaptureWriter::AllocateChannel(IChannelState * channel)
+{
+    std::scoped_lock lock{m_mutex};
+    const u32 index = m_nextChannel++;
+    BeginRecord(Op::AllocateChannel);
+    m_block.Put(index);
+    m_block.Put(static_cast<s32>(channel->BindId()));
+    EndRecord();
+    return new Channel(*this, channel, index);
+}
+
+void GpuCaptureWriter::ChannelInit(u32 index, u64 programId)
+{
+    std::scoped_lock lock{m_mutex};
+    BeginRecord(Op::ChannelInit);
+    m_block.Put(index);
+    m_block.Put(programId);
+    EndRecord();
+}
+
+void GpuCaptureWriter::ChannelSetMemoryManager(u32 index, s32 bindId, u32 id)
+{
+    std::scoped_lock lock{m_mutex};
+    m_channelMemory[bindId] = m_registry.GetMemoryManager(id);
+    BeginRecord(Op::ChannelSetMemoryManager);
+    m_block.Put(index);
+    m_block.Put(id);
+    EndRecord();
+}
+
+void GpuCaptureWriter::ChannelRelease(u32 index, s32 bindId)
+{
+    std::scoped_lock lock{m_mutex};
+    m_channelMemory.erase(bindId);
+    BeginRecord(Op::ChannelRelease);
+    m_block.Put(index);
+    EndRecord();
+}
+
+void GpuCaptureWriter::PushGPUEntries(s32 bindId, std::span<const u64> commandList, std::span<const u32> prefetchCommandList)
+{
+    std::scoped_lock lock{m_mutex};
+
+    // Pushbuffers are written right before they are submitted, record them first
+    const auto gmmu = m_channelMemory.find(bindId);
+    if (gmmu != m_channelMemory.end() && gmmu->second)
+    {
+        for (const u64 entry : commandList)
+        {
+            const u64 gpuAddr = entry & ((1ULL << 40) - 1);
+            const u64 size = ((entry >> 42) & ((1ULL << 21) - 1)) * sizeof(u32);
+            RecordGpuRange(*gmmu->second, gpuAddr, size);
+        }
+    }
+    // The commands may use any buffer the CPU wrote since the last submission
+    RecordDirtyPages();
+
+    BeginRecord(Op::PushGPUEntries);
+    m_block.Put(bindId);
+    m_block.Put(static_cast<u32>(commandList.size()));
+    m_block.Put(static_cast<u32>(prefetchCommandList.size()));
+    m_block.PutSpan(commandList);
+    m_block.PutSpan(prefetchCommandList);
+    EndRecord();
+}
+
+void GpuCaptureWriter::RequestComposite(std::span<const VideoFramebufferConfig> layers, std::span<const VideoNvFence> fences)
+{
+    std::scoped_lock lock{m_mutex};
+    RecordDirtyPages();
+    BeginRecord(Op::RequestComposite);
+    m_block.Put(static_cast<u32>(layers.size()));
+    m_block.Put(static_cast<u32>(fences.size()));
+    m_block.PutSpan(layers);
+    m_block.PutSpan(fences);
+    EndRecord();
+    m_header.frameCount += 1;
+}
+
+void GpuCaptureWriter::OnCPUWrite(u64 address, u64 size, bool deferred)
+{
+    std::scoped_lock lock{m_mutex};
+    // The write has not happened yet, the pages are recorded before the next submission
+    const u64 start = address & ~(PageSize - 1);
+    const u64 end = address + size;
+    for (u64 page = start; page < end; page += PageSize)
+    {
+        const u64 physicalAddress = m_host1x.MemoryManager().GetPhysicalRawAddressFromDAddr(page);
+        if (physicalAddress == 0)
+        {
+            continue;
+        }
+        const u64 pageIndex = physicalAddress >> PageBits;
+        u8 & state = PageEntry(pageIndex);
+        if (deferred && (state & PageDeferred) == 0)
+        {
+            // Further writes to a deferred page can be collected by the CPU without calling back,
+            // so it is hashed on every record from now on
+            state |= PageDeferred;
+            m_deferredPages.push_back(static_cast<u32>(pageIndex));
+        }
+        if ((state & (PageDirty | PageDeferred)) == 0)
+        {
+            state |= PageDirty;
+            m_dirtyPages.push_back(static_cast<u32>(pageIndex));
+        }
+    }
+    BeginRecord(Op::OnCPUWrite);
+    m_block.Put(address);
+    m_block.Put(size);
+    EndRecord();
+}
+
+void GpuCaptureWriter::RecordPageMapping(u64 virtualAddress, u64 size, u64 asid)
+{
+    const auto process = m_processes.find(asid);
+    if (process == m_processes.end() || process->second == nullptr)
+    {
+        LOG_WARNING(HW_GPU, "GPU capture: mapping of unknown process {}", asid);
+        return;
+    }
+    IMemory & memory = *process->second;
+
+    std::vector<PageRun> runs;
+    const u64 start = virtualAddress & ~(PageSize - 1);
+    const u64 end = virtualAddress + size;
+    for (u64 page = start; page < end; page += PageSize)
+    {
+        const u8 * pointer = memory.GetPointerSilent(page);
+        if (pointer == nullptr)
+        {
+            continue;
+        }
+        const u64 physicalAddress = static_cast<u64>(pointer - m_physicalBase);
+        if (!runs.empty() && runs.back().virtualAddress + runs.back().size == page && runs.back().physicalAddress + runs.back().size == physicalAddress)
+        {
+            runs.back().size += PageSize;
+            continue;
+        }
+        runs.push_back(PageRun{page, physicalAddress, PageSize});
+    }
+
+    for (const PageRun & run : runs)
+    {
+        BeginRecord(Op::PageMapping);
+        m_block.Put(asid);
+        m_block.Put(run.virtualAddress);
+        m_block.Put(run.physicalAddress);
+        m_block.Put(run.size);
+        EndRecord();
+    }
+    for (const PageRun & run : runs)
+    {
+        for (u64 offset = 0; offset < run.size; offset += PageSize)
+        {
+            RecordPhysicalPage(run.physicalAddress + offset);
+        }
+    }
+}
+
+u8 & GpuCaptureWriter::PageEntry(u64 pageIndex)
+{
+    if (pageIndex >= m_pageState.size())
+    {
+        m_pageState.resize(pageIndex + 1);
+        m_pageHash.resize(pageIndex + 1);
+    }
+    return m_pageState[pageIndex];
+}
+
+void GpuCaptureWriter::RecordPhysicalPage(u64 physicalAddress)
+{
+    const u64 pageIndex = physicalAddress >> PageBits;
+    if ((PageEntry(pageIndex) & PageTracked) == 0)
+    {
+        m_pageState[pageIndex] |= PageTracked;
+        m_header.physicalSize = std::max(m_header.physicalSize, (pageIndex + 1) << PageBits);
+    }
+
+    const u8 * data = m_physicalBase + (pageIndex << PageBits);
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char *>(data), PageSize);
+    if ((m_pageState[pageIndex] & PageCaptured) != 0 && m_pageHash[pageIndex] == hash)
+    {
+        return;
+    }
+    m_pageState[pageIndex] |= PageCaptured;
+    m_pageHash[pageIndex] = hash;
+
+    BeginRecord(Op::PhysicalPage);
+    m_block.Put(pageIndex << PageBits);
+    m_block.PutSpan(std::span<const u8>(data, PageSize));
+    EndRecord();
+}
+
+void GpuCaptureWriter::RecordDeviceRange(u64 address, u64 size)
+{
+    const u64 start = address & ~(PageSize - 1);
+    const u64 end = address + size;
+    for (u64 page = start; page < end; page += PageSize)
+    {
+        const u64 physicalAddress = m_host1x.MemoryManager().GetPhysicalRawAddressFromDAddr(page);
+        if (physicalAddress != 0)
+        {
+            RecordPhysicalPage(physicalAddress & ~(PageSize - 1));
+        }
+    }
+}
+
+void GpuCaptureWriter::RecordGpuRange(Tegra::MemoryManager & gmmu, u64 gpuAddr, u64 size)
+{
+    const u64 start = gpuAddr & ~(PageSize - 1);
+    const u64 end = gpuAddr + size;
+    for (u64 page = start; page < end; page += PageSize)
+    {
+        const std::optional<DAddr> deviceAddr = gmmu.GpuToCpuAddress(page);
+        if (deviceAddr)
+        {
+            RecordDeviceRange(*deviceAddr & ~(PageSize - 1), PageSize);
+        }
+    }
+}
+
+void GpuCaptureWriter::RecordDirtyPages()
+{
+    for (size_t i = 0, n = m_deferredPages.size(); i < n; i++)
+    {
+        RecordPhysicalPage(static_cast<u64>(m_deferredPages[i]) << PageBits);
+    }
+    for (size_t i = 0, n = m_dirtyPages.size(); i < n; i++)
+    {
+        const u32 pageIndex = m_dirtyPages[i];
+        m_pageState[pageIndex] &= ~PageDirty;
+        if ((m_pageState[pageIndex] & PageDeferred) == 0)
+        {
+            RecordPhysicalPage(static_cast<u64>(pageIndex) << PageBits);
+        }
+    }
+    m_dirtyPages.clear();
+}
+
+void GpuCaptureWriter::WatchDeviceRange(u64 address, u64 size)
+{
+    // Caching the pages routes CPU writes to them through OnCPUWrite, the count is shared with
+    // the rasterizer so its own caching of the pages is unaffected
+    const u64 startPage = address >> PageBits;
+    const u64 endPage = (address + size + PageSize - 1) >> PageBits;
+    if (endPage > m_deviceWatched.size())
+    {
+        m_deviceWatched.resize(endPage);
+    }
+    u64 runStart = startPage;
+    for (u64 page = startPage; page <= endPage; page++)
+    {
+        if (page < endPage && m_deviceWatched[page] == 0)
+        {
+            m_deviceWatched[page] = 1;
+            m_watchedDevicePages.push_back(static_cast<u32>(page));
+            continue;
+        }
+        if (page > runStart)
+        {
+            m_host1x.MemoryManager().UpdatePagesCachedCount(runStart << PageBits, (page - runStart) << PageBits, 1);
+        }
+        runStart = page + 1;
+    }
+}
+
+void GpuCaptureWriter::BeginRecord(Op op)
+{
+    m_block.Put(op);
+}
+
+void GpuCaptureWriter::EndRecord()
+{
+    m_header.recordCount += 1;
+    if (m_block.Data().size() >= BlockSize)
+    {
+        FlushBlock();
+    }
+}
+
+void GpuCaptureWriter::FlushBlock()
+{
+    std::vector<u8> & data = m_block.Data();
+    if (data.empty() || !m_file.IsOpen())
+    {
+        data.clear();
+        return;
+    }
+    const std::vector<u8> compressed = Common::Compression::CompressDataZSTDDefault(data.data(), data.size());
+    const u32 compressedSize = static_cast<u32>(compressed.size());
+    if (compressed.empty() || !m_file.WriteObject(compressedSize) || m_file.WriteSpan(std::span<const u8>(compressed)) != compressed.size())
+    {
+        LOG_ERROR(HW_GPU, "Failed to write GPU capture, capture stopped");
+        m_file.Close();
+    }
+    data.clear();
+}
+
+GpuCaptureReader::GpuCaptureReader(const std::string & path) :
+    m_file(path, Common::FS::FileAccessMode::Read, Common::FS::FileType::BinaryFile),
+    m_header{},
+    m_offset(0),
+    m_valid(false)
+{
+    if (!m_file.IsOpen() || !m_file.ReadObject(m_header))
+    {
+        LOG_ERROR(HW_GPU, "Failed to open GPU capture {}", path);
+        return;
+    }
+    if (m_header.magic != FileMagic || m_header.version != FileVersion)
+    {
+        LOG_ERROR(HW_GPU, "{} is not a supported GPU capture (version {})", path, m_header.version);
+        return;
+    }
+    m_valid = true;
+}
+
+bool GpuCaptureReader::IsOpen() const
+{
+    return m_valid;
+}
+
+const FileHeader & GpuCaptureReader::Header() const
+{
+    return m_header;
+}
+
+bool GpuCaptureReader::Next(Op & op)
+{
+    if (!m_valid)
+    {
+        return false;
+    }
+    if (m_offset >= m_block.size() && !ReadBlock())
+    {
+        return false;
+    }
+    op = static_cast<Op>(m_block[m_offset++]);
+    return true;
+}
+
+std::span<const u8> GpuCaptureReader::Take(size_t size)
+{
+    if (!m_valid || m_block.size() - m_offset < size)
+    {
+        LOG_ERROR(HW_GPU, "GPU capture record is truncated");
+        m_valid = false;
+        return {};
+    }
+    const std::span<const u8> data(m_block.data() + m_offset, size);
+    m_offset += size;
+    return data;
+}
+
+bool GpuCaptureReader::ReadBlock()
+{
+    u32 compressedSize = 0;
+    if (!m_file.ReadObject(compressedSize))
+    {
+        return false;
+    }
+    std::vector<u8> compressed(compressedSize);
+    if (m_file.ReadSpan(std::span<u8>(compressed)) != compressed.size())
+    {
+        LOG_ERROR(HW_GPU, "GPU capture is truncated");
+        m_valid = false;
+        return false;
+    }
+    m_block = Common::Compression::DecompressDataZSTD(compressed);
+    m_offset = 0;
+    if (m_block.empty())
+    {
+        LOG_ERROR(HW_GPU, "GPU capture block is corrupted");
+        m_valid = false;
+        return false;
+    }
+    return true;
+}
+
+} // namespace GpuCapture
@@ -0,0 +1,209 @@
+#pragma once
+#include <nxemu-module-spec/video.h>
+#include <yuzu_common/common_types.h>
+#include <yuzu_common/fs/file.h>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Tegra
+{
+class MemoryManager;
+class MemoryManagerRegistry;
+namespace Host1x
+{
+class Host1x;
+}
+} // namespace Tegra
+
+/*
+ * A GPU capture is the stream of IVideo calls made by the operating system module, together with
+ * the guest physical pages the GPU could read when each call was made. The file is a header
+ * followed by zstd compressed blocks, each block holds whole records.
+ *
+ * Guest memory is stored as physical pages of the device memory backing, a page is written again
+ * only when its content changed since it was last recorded. The writer holds a cached count on
+ * every device page mapped while capturing, so CPU writes to them reach OnCPUWrite and only the
+ * pages written since the last record are hashed again.
+ */
+namespace GpuCapture
+{
+constexpr u32 FileMagic = 0x4350474E; // NGPC
+constexpr u32 FileVersion = 1;
+constexpr u64 PageBits = 12;
+constexpr u64 PageSize = 1ULL << PageBits;
+constexpr size_t BlockSize = 4 * 1024 * 1024;
+
+enum class Op : u8
+{
+    RegisterProcess,
+    AllocAs,
+    MapBuffer,
+    MemoryAllocate,
+    TrackContinuity,
+    MemoryMap,
+    PageMapping,
+    PhysicalPage,
+    AllocateChannel,
+    ChannelInit,
+    ChannelSetMemoryManager,
+    ChannelRelease,
+    PushGPUEntries,
+    RequestComposite,
+    OnCPUWrite,
+};
+
+struct FileHeader
+{
+    u32 magic;
+    u32 version;
+    u64 physicalSize; // Size of the device memory backing the replay has to provide
+    u64 frameCount;
+    u64 recordCount;
+};
+
+/// Serialized records, values are stored in host byte order
+class RecordBuffer
+{
+public:
+    template <typename T>
+    void Put(const T & value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const size_t offset = m_data.size();
+        m_data.resize(offset + sizeof(T));
+        std::memcpy(m_data.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void PutSpan(std::span<const T> values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const size_t offset = m_data.size();
+        m_data.resize(offset + values.size_bytes());
+        std::memcpy(m_data.data() + offset, values.data(), values.size_bytes());
+    }
+
+    std::vector<u8> & Data()
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<u8> m_data;
+};
+
+class GpuCaptureWriter
+{
+public:
+    GpuCaptureWriter(const std::string & path, const u8 * physicalBase, Tegra::Host1x::Host1x & host1x, Tegra::MemoryManagerRegistry & registry);
+    ~GpuCaptureWriter();
+
+    bool IsOpen() const;
+
+    void RegisterProcess(IMemory * memory, u64 asid);
+    void AllocAs(u64 addressSpaceBits, u64 splitAddress, u64 bigPageBits, u64 pageBits, u32 id);
+    void MapBuffer(u64 gpuAddr, u64 deviceAddr, u64 size, u8 kind, bool isBigPages);
+    void MemoryAllocate(u64 size, u64 address);
+    void TrackContinuity(u64 address, u64 virtualAddress, u64 size, u64 asid);
+    void MemoryMap(u64 address, u64 virtualAddress, u64 size, u64 asid, bool track);
+    IChannelState * AllocateChannel(IChannelState * channel);
+    void PushGPUEntries(s32 bindId, std::span<const u64> commandList, std::span<const u32> prefetchCommandList);
+    void RequestComposite(std::span<const VideoFramebufferConfig> layers, std::span<const VideoNvFence> fences);
+    void OnCPUWrite(u64 address, u64 size, bool deferred);
+
+private:
+    GpuCaptureWriter() = delete;
+    GpuCaptureWriter(const GpuCaptureWriter &) = delete;
+    GpuCaptureWriter & operator=(const GpuCaptureWriter &) = delete;
+
+    class Channel;
+    friend class Channel;
+
+    void ChannelInit(u32 index, u64 programId);
+    void ChannelSetMemoryManager(u32 index, s32 bindId, u32 id);
+    void ChannelRelease(u32 index, s32 bindId);
+
+    void RecordPageMapping(u64 virtualAddress, u64 size, u64 asid);
+    void RecordPhysicalPage(u64 physicalAddress);
+    void RecordDeviceRange(u64 address, u64 size);
+    void RecordGpuRange(Tegra::MemoryManager & gmmu, u64 gpuAddr, u64 size);
+    void RecordDirtyPages();
+    void WatchDeviceRange(u64 address, u64 size);
+    u8 & PageEntry(u64 pageIndex);
+    void BeginRecord(Op op);
+    void EndRecord();
+    void FlushBlock();
+
+    std::mutex m_mutex;
+    Common::FS::IOFile m_file;
+    FileHeader m_header;
+    RecordBuffer m_block;
+    const u8 * m_physicalBase;
+    Tegra::Host1x::Host1x & m_host1x;
+    Tegra::MemoryManagerRegistry & m_registry;
+    std::unordered_map<u64, IMemory *> m_processes;
+    std::unordered_map<s32, std::shared_ptr<Tegra::MemoryManager>> m_channelMemory;
+    std::vector<u64> m_pageHash;
+    std::vector<u8> m_pageState;
+    std::vector<u32> m_dirtyPages;
+    std::vector<u32> m_deferredPages;
+    std::vector<u8> m_deviceWatched;
+    std::vector<u32> m_watchedDevicePages;
+    u32 m_nextChannel;
+};
+
+/// Reads back the records of a capture one at a time
+class GpuCaptureReader
+{
+public:
+    explicit GpuCaptureReader(const std::string & path);
+
+    bool IsOpen() const;
+    const FileHeader & Header() const;
+
+    /// Moves to the next record, returns false at the end of the capture
+    bool Next(Op & op);
+
+    template <typename T>
+    T Get()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        const std::span<const u8> data = Take(sizeof(T));
+        std::memcpy(&value, data.data(), data.size());
+        return value;
+    }
+
+    /// Copies an array of values into out, reusing its storage
+    template <typename T>
+    void GetArray(std::vector<T> & out, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const std::span<const u8> data = Take(count * sizeof(T));
+        out.resize(data.size() / sizeof(T));
+        std::memcpy(out.data(), data.data(), out.size() * sizeof(T));
+    }
+
+    std::span<const u8> Take(size_t size);
+
+private:
+    GpuCaptureReader() = delete;
+    GpuCaptureReader(const GpuCaptureReader &) = delete;
+    GpuCaptureReader & operator=(const GpuCaptureReader &) = delete;
+
+    bool ReadBlock();
+
+    Common::FS::IOFile m_file;
+    FileHeader m_header;
+    std::vector<u8> m_block;
+    size_t m_offset;
+    bool m_valid;
+};
+
+} // namespace GpuCapture
@@ -0,0 +1,562 @@
+#include "gpu_replay.h"
+#include "gpu_capture.h"
+#include "video_manager.h"
+#include "yuzu_common/fs/file.h"
+#include "yuzu_common/logging/log.h"
+#include "yuzu_common/settings.h"
+#include "yuzu_common/virtual_buffer.h"
+#include "yuzu_common/yuzu_assert.h"
+#include <nxemu-module-spec/cpu.h>
+#include <nxemu-module-spec/operating_system.h>
+#include <algorithm>
+#include <chrono>
+#include <fmt/format.h>
+#include <unordered_map>
+
+namespace GpuCapture
+{
+namespace
+{
+    /// Guest process memory rebuilt from the page mappings of the capture
+    class ReplayMemory :
+        public IMemory
+    {
+    public:
+        explicit ReplayMemory(Common::VirtualBuffer<u8> & backing) :
+            m_backing(backing)
+        {
+        }
+
+        void AddMapping(u64 virtualAddress, u64 physicalAddress, u64 size)
+        {
+            for (u64 offset = 0; offset < size; offset += PageSize)
+            {
+                m_pages[(virtualAddress + offset) >> PageBits] = physicalAddress + offset;
+            }
+        }
+
+        void RasterizerMarkRegionCached(uint64_t /*vaddr*/, uint64_t /*size*/, bool /*cached*/) override
+        {
+        }
+
+        uint8_t * GetPointerSilent(uint64_t vaddr) override
+        {
+            const auto page = m_pages.find(vaddr >> PageBits);
+            if (page == m_pages.end())
+            {
+                return nullptr;
+            }
+            return m_backing.data() + page->second + (vaddr & (PageSize - 1));
+        }
+
+        uint8_t Read8(uint64_t addr) override
+        {
+            return Read<uint8_t>(addr);
+        }
+
+        uint16_t Read16(uint64_t addr) override
+        {
+            return Read<uint16_t>(addr);
+        }
+
+        uint32_t Read32(uint64_t addr) override
+        {
+            return Read<uint32_t>(addr);
+        }
+
+        uint64_t Read64(uint64_t addr) override
+        {
+            return Read<uint64_t>(addr);
+        }
+
+        bool WriteExclusive8(uint64_t addr, uint8_t data, uint8_t /*expected*/) override
+        {
+            return Write(addr, data);
+        }
+
+        bool WriteExclusive16(uint64_t addr, uint16_t data, uint16_t /*expected*/) override
+        {
+            return Write(addr, data);
+        }
+
+        bool WriteExclusive32(uint64_t addr, uint32_t data, uint32_t /*expected*/) override
+        {
+            return Write(addr, data);
+        }
+
+        bool WriteExclusive64(uint64_t addr, uint64_t data, uint64_t /*expected*/) override
+        {
+            return Write(addr, data);
+        }
+
+    private:
+        template <typename T>
+        T Read(uint64_t addr)
+        {
+            T value{};
+            if (const uint8_t * pointer = GetPointerSilent(addr))
+            {
+                std::memcpy(&value, pointer, sizeof(T));
+            }
+            return value;
+        }
+
+        template <typename T>
+        bool Write(uint64_t addr, T value)
+        {
+            uint8_t * pointer = GetPointerSilent(addr);
+            if (pointer == nullptr)
+            {
+                return false;
+            }
+            std::memcpy(pointer, &value, sizeof(T));
+            return true;
+        }
+
+        Common::VirtualBuffer<u8> & m_backing;
+        std::unordered_map<u64, u64> m_pages;
+    };
+
+    class ReplayDeviceMemory :
+        public IDeviceMemory
+    {
+    public:
+        explicit ReplayDeviceMemory(const Common::VirtualBuffer<u8> & backing) :
+            m_backing(backing)
+        {
+        }
+
+        const uint8_t * BackingBasePointer() const override
+        {
+            return m_backing.data();
+        }
+
+    private:
+        const Common::VirtualBuffer<u8> & m_backing;
+    };
+
+    /// The GPU only needs the device memory and the frame end notification from the OS
+    class ReplayOperatingSystem :
+        public IOperatingSystem
+    {
+    public:
+        explicit ReplayOperatingSystem(IDeviceMemory & deviceMemory) :
+            m_deviceMemory(deviceMemory)
+        {
+        }
+
+        bool Initialize() override
+        {
+            return true;
+        }
+
+        bool CreateApplicationProcess(uint64_t /*codeSize*/, const IProgramMetadata & /*metaData*/, uint64_t & /*baseAddress*/, uint64_t & /*processID*/, bool /*is_hbl*/) override
+        {
+            return false;
+        }
+
+        void StartApplicationProcess(int32_t /*priority*/, int64_t /*stackSize*/, uint32_t /*version*/, StorageId /*baseGameStorageId*/, StorageId /*updateStorageId*/, uint8_t * /*nacpData*/, uint32_t /*nacpDataLen*/) override
+        {
+        }
+
+        bool LoadModule(const IModuleInfo & /*module*/, uint64_t /*baseAddress*/) override
+        {
+            return false;
+        }
+
+        IDeviceMemory & DeviceMemory() override
+        {
+            return m_deviceMemory;
+        }
+
+        void KeyboardKeyPress(int /*modifier*/, int /*keyIndex*/, int /*keyCode*/) override
+        {
+        }
+
+        void KeyboardKeyRelease(int /*modifier*/, int /*keyIndex*/, int /*keyCode*/) override
+        {
+        }
+
+        void GatherGPUDirtyMemory(ICacheInvalidator * /*invalidator*/) override
+        {
+            // CPU writes are replayed through OnCPUWrite records
+        }
+
+        void GameFrameEnd() override
+        {
+        }
+
+        void AudioGetSyncIDs(uint32_t * /*ids*/, uint32_t /*maxCount*/, uint32_t * actualCount) override
+        {
+            *actualCount = 0;
+        }
+
+        void AudioGetDeviceListForSink(uint32_t /*sinkId*/, bool /*capture*/, DeviceEnumCallback /*callback*/, void * /*userData*/) override
+        {
+        }
+
+        bool ReplayAudioCapture(const char * /*capturePath*/, const char * /*reportPath*/) override
+        {
+            return false;
+        }
+
+    private:
+        IDeviceMemory & m_deviceMemory;
+    };
+
+    class ReplaySystem :
+        public ISwitchSystem
+    {
+    public:
+        explicit ReplaySystem(IOperatingSystem & operatingSystem) :
+            m_operatingSystem(operatingSystem),
+            m_video(nullptr)
+        {
+        }
+
+        void SetVideo(IVideo * video)
+        {
+            m_video = video;
+        }
+
+        void StartEmulation() override
+        {
+        }
+
+        ISystemloader & Systemloader() override
+        {
+            UNREACHABLE_MSG("GPU replay has no system loader");
+        }
+
+        IOperatingSystem & OperatingSystem() override
+        {
+            return m_operatingSystem;
+        }
+
+        IVideo & Video() override
+        {
+            return *m_video;
+        }
+
+        ICpu & Cpu() override
+        {
+            UNREACHABLE_MSG("GPU replay has no CPU");
+        }
+
+    private:
+        IOperatingSystem & m_operatingSystem;
+        IVideo * m_video;
+    };
+
+    class ReplayWindow :
+        public IRenderWindow
+    {
+    public:
+        void * RenderSurface(void) const override
+        {
+            return nullptr;
+        }
+
+        float PixelRatio(void) const override
+        {
+            return 1.0f;
+        }
+    };
+
+    double Percentile(const std::vector<double> & sorted, double percentile)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        const size_t index = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+} // namespace
+
+bool Replay(const std::string & capturePath, const std::string & reportPath)
+{
+    GpuCaptureReader reader(capturePath);
+    if (!reader.IsOpen())
+    {
+        return false;
+    }
+    if (reader.Header().physicalSize == 0)
+    {
+        LOG_ERROR(HW_GPU, "GPU capture {} was not finalized", capturePath);
+        return false;
+    }
+
+    // Run the GPU frontend on the replay thread so the time spent in every call is measurable
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+
+    Common::VirtualBuffer<u8> backing(reader.Header().physicalSize);
+    ReplayDeviceMemory deviceMemory(backing);
+    ReplayOperatingSystem operatingSystem(deviceMemory);
+    ReplaySystem system(operatingSystem);
+    ReplayWindow window;
+    // Process memory is referenced by the GPU until it is destroyed
+    std::unordered_map<u64, std::unique_ptr<ReplayMemory>> processes;
+    VideoManager video(window, system, false);
+    system.SetVideo(&video);
+    if (!video.Initialize())
+    {
+        LOG_ERROR(HW_GPU, "Failed to initialize the GPU for replay");
+        return false;
+    }
+    video.EmulationStarting();
+
+    std::unordered_map<u64, u64> asids;
+    std::unordered_map<u32, u32> addressSpaces;
+    std::unordered_map<u32, IChannelState *> channels;
+    std::unordered_map<s32, s32> bindIds;
+    std::vector<u64> commandList;
+    std::vector<u32> prefetchCommandList;
+    std::vector<VideoFramebufferConfig> layers;
+    std::vector<VideoNvFence> fences;
+    std::vector<double> frameTimes;
+    frameTimes.reserve(reader.Header().frameCount);
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration frameTime{};
+    const Clock::time_point replayStart = Clock::now();
+    const auto Timed = [&frameTime](auto && call) {
+        const Clock::time_point start = Clock::now();
+        call();
+        frameTime += Clock::now() - start;
+    };
+    // Channel indices come from the file, a corrupt or truncated capture must not reach the GPU
+    const auto FindChannel = [&channels](u32 index) -> IChannelState * {
+        const auto channel = channels.find(index);
+        if (channel == channels.end() || channel->second == nullptr)
+        {
+            LOG_ERROR(HW_GPU, "GPU capture refers to unknown channel {}", index);
+            return nullptr;
+        }
+        return channel->second;
+    };
+
+    Op op;
+    while (reader.Next(op))
+    {
+        switch (op)
+        {
+        case Op::RegisterProcess:
+        {
+            const u64 asid = reader.Get<u64>();
+            auto & memory = processes[asid];
+            memory = std::make_unique<ReplayMemory>(backing);
+            asids[asid] = video.RegisterProcess(memory.get());
+            break;
+        }
+        case Op::AllocAs:
+        {
+            const u64 addressSpaceBits = reader.Get<u64>();
+            const u64 splitAddress = reader.Get<u64>();
+            const u64 bigPageBits = reader.Get<u64>();
+            const u64 pageBits = reader.Get<u64>();
+            const u32 id = reader.Get<u32>();
+            addressSpaces[id] = video.AllocAsEx(addressSpaceBits, splitAddress, bigPageBits, pageBits);
+            break;
+        }
+        case Op::MapBuffer:
+        {
+            const u64 gpuAddr = reader.Get<u64>();
+            const u64 deviceAddr = reader.Get<u64>();
+            const u64 size = reader.Get<u64>();
+            const u8 kind = reader.Get<u8>();
+            const bool isBigPages = reader.Get<bool>();
+            Timed([&] { video.MapBufferEx(gpuAddr, deviceAddr, size, kind, isBigPages); });
+            break;
+        }
+        case Op::MemoryAllocate:
+        {
+            const u64 size = reader.Get<u64>();
+            const u64 address = reader.Get<u64>();
+            const u64 replayed = video.MemoryAllocate(size);
+            if (replayed != address)
+            {
+                LOG_WARNING(HW_GPU, "Replayed device allocation {:#x} differs from the captured {:#x}", replayed, address);
+            }
+            break;
+        }
+        case Op::TrackContinuity:
+        {
+            const u64 address = reader.Get<u64>();
+            const u64 virtualAddress = reader.Get<u64>();
+            const u64 size = reader.Get<u64>();
+            const u64 asid = reader.Get<u64>();
+            video.MemoryTrackContinuity(address, virtualAddress, size, asids[asid]);
+            break;
+        }
+        case Op::MemoryMap:
+        {
+            const u64 address = reader.Get<u64>();
+            const u64 virtualAddress = reader.Get<u64>();
+            const u64 size = reader.Get<u64>();
+            const u64 asid = reader.Get<u64>();
+            const bool track = reader.Get<bool>();
+            Timed([&] { video.MemoryMap(address, virtualAddress, size, asids[asid], track); });
+            break;
+        }
+        case Op::PageMapping:
+        {
+            const u64 asid = reader.Get<u64>();
+            const u64 virtualAddress = reader.Get<u64>();
+            const u64 physicalAddress = reader.Get<u64>();
+            const u64 size = reader.Get<u64>();
+            const auto process = processes.find(asid);
+            if (process != processes.end() && physicalAddress + size <= backing.size())
+            {
+                process->second->AddMapping(virtualAddress, physicalAddress, size);
+            }
+            break;
+        }
+        case Op::PhysicalPage:
+        {
+            const u64 physicalAddress = reader.Get<u64>();
+            const std::span<const u8> data = reader.Take(PageSize);
+            if (physicalAddress + data.size() <= backing.size())
+            {
+                std::memcpy(backing.data() + physicalAddress, data.data(), data.size());
+            }
+            break;
+        }
+        case Op::AllocateChannel:
+        {
+            const u32 index = reader.Get<u32>();
+            const s32 bindId = reader.Get<s32>();
+            if (channels.contains(index))
+            {
+                LOG_ERROR(HW_GPU, "GPU capture allocates channel {} twice", index);
+                return false;
+            }
+            IChannelState * channel = video.AllocateChannel();
+            if (channel == nullptr)
+            {
+                LOG_ERROR(HW_GPU, "Failed to allocate GPU channel {} for replay", index);
+                return false;
+            }
+            channels[index] = channel;
+            bindIds[bindId] = channel->BindId();
+            break;
+        }
+        case Op::ChannelInit:
+        {
+            const u32 index = reader.Get<u32>();
+            const u64 programId = reader.Get<u64>();
+            IChannelState * channel = FindChannel(index);
+            if (channel == nullptr)
+            {
+                return false;
+            }
+            channel->Init(programId);
+            break;
+        }
+        case Op::ChannelSetMemoryManager:
+        {
+            const u32 index = reader.Get<u32>();
+            const u32 id = reader.Get<u32>();
+            IChannelState * channel = FindChannel(index);
+            const auto addressSpace = addressSpaces.find(id);
+            if (channel == nullptr)
+            {
+                return false;
+            }
+            if (addressSpace == addressSpaces.end())
+            {
+                LOG_ERROR(HW_GPU, "GPU capture refers to unknown address space {}", id);
+                return false;
+            }
+            channel->SetMemoryManager(addressSpace->second);
+            break;
+        }
+        case Op::ChannelRelease:
+        {
+            const u32 index = reader.Get<u32>();
+            IChannelState * channel = FindChannel(index);
+            if (channel == nullptr)
+            {
+                return false;
+            }
+            channel->Release();
+            channels.erase(index);
+            break;
+        }
+        case Op::PushGPUEntries:
+        {
+            const s32 bindId = reader.Get<s32>();
+            const u32 commandListSize = reader.Get<u32>();
+            const u32 prefetchCommandListSize = reader.Get<u32>();
+            reader.GetArray(commandList, commandListSize);
+            reader.GetArray(prefetchCommandList, prefetchCommandListSize);
+            Timed([&] { video.PushGPUEntries(bindIds[bindId], commandList.data(), static_cast<u32>(commandList.size()), prefetchCommandList.data(), static_cast<u32>(prefetchCommandList.size())); });
+            break;
+        }
+        case Op::RequestComposite:
+        {
+            const u32 layerCount = reader.Get<u32>();
+            const u32 fenceCount = reader.Get<u32>();
+            reader.GetArray(layers, layerCount);
+            reader.GetArray(fences, fenceCount);
+            Timed([&] { video.RequestComposite(layers.data(), static_cast<u32>(layers.size()), fences.data(), static_cast<u32>(fences.size())); });
+            frameTimes.push_back(std::chrono::duration<double, std::milli>(frameTime).count());
+            frameTime = {};
+            break;
+        }
+        case Op::OnCPUWrite:
+        {
+            const u64 address = reader.Get<u64>();
+            const u64 size = reader.Get<u64>();
+            Timed([&] { video.OnCPUWrite(address, size); });
+            break;
+        }
+        default:
+            LOG_ERROR(HW_GPU, "Unknown GPU capture record {}", static_cast<u32>(op));
+            return false;
+        }
+    }
+    if (!reader.IsOpen())
+    {
+        return false;
+    }
+    for (const auto & [index, channel] : channels)
+    {
+        channel->Release();
+    }
+
+    const double replayTime = std::chrono::duration<double>(Clock::now() - replayStart).count();
+    std::vector<double> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (const double time : frameTimes)
+    {
+        total += time;
+    }
+    const double mean = frameTimes.empty() ? 0.0 : total / static_cast<double>(frameTimes.size());
+    LOG_INFO(HW_GPU, "GPU replay of {}: {} frames in {:.2f}s, GPU frontend per frame mean {:.3f}ms p50 {:.3f}ms p90 {:.3f}ms p99 {:.3f}ms max {:.3f}ms", capturePath, frameTimes.size(), replayTime, mean, Percentile(sorted, 0.5), Percentile(sorted, 0.9), Percentile(sorted, 0.99), sorted.empty() ? 0.0 : sorted.back());
+
+    if (!reportPath.empty())
+    {
+        Common::FS::IOFile report(reportPath, Common::FS::FileAccessMode::Write, Common::FS::FileType::TextFile);
+        if (!report.IsOpen())
+        {
+            LOG_ERROR(HW_GPU, "Failed to create GPU replay report {}", reportPath);
+            return false;
+        }
+        std::string text = "frame,cpu_ms\n";
+        for (size_t i = 0; i < frameTimes.size(); i++)
+        {
+            text += fmt::format("{},{:.4f}\n", i, frameTimes[i]);
+        }
+        if (report.WriteString(text) != text.size())
+        {
+            LOG_ERROR(HW_GPU, "Failed to write GPU replay report {}", reportPath);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace GpuCapture
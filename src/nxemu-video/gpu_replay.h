@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+
+namespace GpuCapture
+{
+
+/*
+ * Drives a fresh GPU through a capture as fast as possible with the null renderer and reports
+ * the CPU time the GPU frontend spent on every frame. Returns false if the capture can not be
+ * replayed.
+ */
+bool Replay(const std::string & capturePath, const std::string & reportPath);
+
+} // namespace GpuCapture
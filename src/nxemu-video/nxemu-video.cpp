@@ -1,3 +1,4 @@
+#include "gpu_replay.h"
 #include "video_manager.h"
 #include <memory>
 #include <stdio.h>
@@ -110,6 +111,15 @@ void CALL DestroyVideo(IVideo * video)
     g_videoManager = nullptr;
 }
 
+bool CALL ReplayGpuCapture(const char * capturePath, const char * reportPath)
+{
+    if (capturePath == nullptr || g_videoManager.get() != nullptr)
+    {
+        return false;
+    }
+    return GpuCapture::Replay(capturePath, reportPath != nullptr ? reportPath : "");
+}
+
 extern "C" int __stdcall DllMain(void * /*hinst*/, unsigned long /*fdwReason*/, void * /*lpReserved*/)
 {
     return true;
@@ -1,27 +1,69 @@
 #include "video_manager.h"
+#include "gpu_capture.h"
 #include "render_window.h"
+#include "video_settings_identifiers.h"
 #include "yuzu_video_core/control/channel_state.h"
 #include "yuzu_video_core/dma_pusher.h"
 #include "yuzu_video_core/host1x/host1x.h"
 #include "yuzu_video_core/video_core.h"
 #include "yuzu_video_core/gpu.h"
+#include "yuzu_video_core/texture_cache/formatter.h"
+#include "yuzu_video_core/texture_cache/statistics.h"
+#include "yuzu_common/settings.h"
+#include <nxemu-core/settings/identifiers.h>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+extern IModuleSettings * g_settings;
 
 struct VideoManager::Impl 
 {
-    Impl(IRenderWindow & window, ISwitchSystem & system) :
+    Impl(IRenderWindow & window, ISwitchSystem & system, bool allowCapture) :
         m_window(window),
-        m_system(system)
+        m_system(system),
+        m_allowCapture(allowCapture)
     {
     }
 
+    ~Impl()
+    {
+        // Finish the capture before the GPU it reads memory through goes away
+        m_capture.reset();
+    }
+
     bool Initialize(void)
     {
-        m_host1x = std::make_unique<Tegra::Host1x::Host1x>(m_system.OperatingSystem().DeviceMemory());
+        if (g_settings != nullptr && g_settings->GetInt(NXCoreSetting::BenchmarkFrames) > 0)
+        {
+            // Headless benchmark, nothing is presented so there is nothing to wait on
+            Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+            Settings::values.vsync_mode.SetValue(Settings::VSyncMode::Immediate);
+        }
+        const int32_t textureMemoryBudget = g_settings != nullptr ? g_settings->GetInt(NXVideoSetting::TextureMemoryBudget) : 0;
+        if (textureMemoryBudget > 0)
+        {
+            Settings::values.texture_memory_budget.SetValue(static_cast<uint32_t>(textureMemoryBudget));
+        }
+
+        IDeviceMemory & deviceMemory = m_system.OperatingSystem().DeviceMemory();
+        m_host1x = std::make_unique<Tegra::Host1x::Host1x>(deviceMemory);
         m_emuWindow = std::make_unique<RenderWindow>(m_window);
         m_gpuCore = VideoCore::CreateGPU(m_system, *(m_emuWindow.get()), *m_host1x);
+
+        const char * capturePath = m_allowCapture && g_settings != nullptr ? g_settings->GetString(NXVideoSetting::GpuCapturePath) : nullptr;
+        if (capturePath != nullptr && capturePath[0] != '\0')
+        {
+            m_capture = std::make_unique<GpuCapture::GpuCaptureWriter>(capturePath, deviceMemory.BackingBasePointer(), *m_host1x, m_memoryManagerRegistry);
+            if (!m_capture->IsOpen())
+            {
+                m_capture.reset();
+            }
+        }
         return true;
     }
     
+    std::unique_ptr<GpuCapture::GpuCaptureWriter> m_capture;
     std::shared_ptr<Tegra::MemoryManager> m_gmmu;
     std::unique_ptr<Tegra::Host1x::Host1x> m_host1x;
     std::unique_ptr<RenderWindow> m_emuWindow;
@@ -29,10 +71,11 @@ struct VideoManager::Impl
     IRenderWindow & m_window;
     ISwitchSystem & m_system;
     Tegra::MemoryManagerRegistry m_memoryManagerRegistry;
+    bool m_allowCapture;
 };
 
-VideoManager::VideoManager(IRenderWindow & window, ISwitchSystem & system) :
-    impl{ std::make_unique<Impl>(window, system) } 
+VideoManager::VideoManager(IRenderWindow & window, ISwitchSystem & system, bool allowCapture) :
+    impl{ std::make_unique<Impl>(window, system, allowCapture) } 
 {
 }
 
@@ -52,6 +95,11 @@ bool VideoManager::Initialize(void)
 
 void VideoManager::RequestComposite(VideoFramebufferConfig * layers, uint32_t layerCount, VideoNvFence * fences, uint32_t fenceCount)
 {
+    if (impl->m_capture)
+    {
+        impl->m_capture->RequestComposite(std::span<const VideoFramebufferConfig>(layers, layerCount), std::span<const VideoNvFence>(fences, fenceCount));
+    }
+
     std::vector<Tegra::FramebufferConfig> output_layers;
     std::vector<Service::Nvidia::NvFence> output_fences;
     output_layers.reserve(layerCount);
@@ -84,6 +132,10 @@ void VideoManager::RequestComposite(VideoFramebufferConfig * layers, uint32_t la
 uint64_t VideoManager::RegisterProcess(IMemory * memory)
 {
     Core::Asid asid = impl->m_host1x->MemoryManager().RegisterProcess(memory);
+    if (impl->m_capture)
+    {
+        impl->m_capture->RegisterProcess(memory, asid.id);
+    }
     return asid.id;
 }
 
@@ -94,19 +146,27 @@ void VideoManager::UpdateFramebufferLayout(uint32_t width, uint32_t height)
 
 IChannelState * VideoManager::AllocateChannel()
 {
-    return std::make_unique<IChannelStatePtr>(*impl->m_gpuCore, impl->m_memoryManagerRegistry, std::move(impl->m_gpuCore->AllocateChannel())).release();
+    IChannelState * channel = std::make_unique<IChannelStatePtr>(*impl->m_gpuCore, impl->m_memoryManagerRegistry, std::move(impl->m_gpuCore->AllocateChannel())).release();
+    if (impl->m_capture)
+    {
+        return impl->m_capture->AllocateChannel(channel);
+    }
+    return channel;
 }
 
 void VideoManager::PushGPUEntries(int32_t bindId, const uint64_t * commandList, uint32_t commandListSize, const uint32_t * prefetchCommandlist, uint32_t prefetchCommandlistSize)
 {
-    Tegra::CommandList entries(commandListSize);
-    memcpy(entries.command_lists.data(), commandList, sizeof(uint64_t) * commandListSize);
-    if (prefetchCommandlistSize > 0)
+    static_assert(sizeof(Tegra::CommandListHeader) == sizeof(uint64_t) && sizeof(Tegra::CommandHeader) == sizeof(uint32_t));
+
+    if (impl->m_capture)
     {
-        entries.prefetch_command_list.resize(prefetchCommandlistSize);
-        memcpy(entries.prefetch_command_list.data(), prefetchCommandlist, sizeof(uint32_t) * prefetchCommandlistSize);
+        impl->m_capture->PushGPUEntries(bindId, std::span<const uint64_t>(commandList, commandListSize), std::span<const uint32_t>(prefetchCommandlist, prefetchCommandlistSize));
     }
-    impl->m_gpuCore->PushGPUEntries(bindId, std::move(entries));
+
+    // The entries are copied straight into the recycled storage of the channel submission ring
+    std::span<const Tegra::CommandListHeader> commandLists(reinterpret_cast<const Tegra::CommandListHeader *>(commandList), commandListSize);
+    std::span<const Tegra::CommandHeader> prefetchCommandLists(reinterpret_cast<const Tegra::CommandHeader *>(prefetchCommandlist), prefetchCommandlistSize);
+    impl->m_gpuCore->PushGPUEntries(bindId, commandLists, prefetchCommandLists);
 }
 
 uint32_t VideoManager::AllocAsEx(uint64_t addressSpaceBits, uint64_t splitAddress, uint64_t bigPageBits, uint64_t pageBits)
@@ -114,27 +174,50 @@ uint32_t VideoManager::AllocAsEx(uint64_t addressSpaceBits, uint64_t splitAddres
     impl->m_gmmu = std::make_shared<Tegra::MemoryManager>(impl->m_host1x->MemoryManager(), addressSpaceBits, splitAddress, bigPageBits, pageBits);
     impl->m_gpuCore->InitAddressSpace(*impl->m_gmmu);
 
-    return impl->m_memoryManagerRegistry.AddMemoryManager(impl->m_gmmu);
+    uint32_t id = impl->m_memoryManagerRegistry.AddMemoryManager(impl->m_gmmu);
+    if (impl->m_capture)
+    {
+        impl->m_capture->AllocAs(addressSpaceBits, splitAddress, bigPageBits, pageBits, id);
+    }
+    return id;
 }
 
 uint64_t VideoManager::MapBufferEx(uint64_t gpuAddr, uint64_t deviceAddr, uint64_t size, uint8_t kind, bool isBigPages)
 {
+    if (impl->m_capture)
+    {
+        impl->m_capture->MapBuffer(gpuAddr, deviceAddr, size, kind, isBigPages);
+    }
     return impl->m_gmmu->Map(gpuAddr, deviceAddr, size, (Tegra::PTEKind)kind, isBigPages);
 }
 
 uint64_t VideoManager::MemoryAllocate(uint64_t size)
 {
-    return impl->m_host1x->MemoryManager().Allocate(size);
+    uint64_t address = impl->m_host1x->MemoryManager().Allocate(size);
+    if (impl->m_capture)
+    {
+        impl->m_capture->MemoryAllocate(size, address);
+    }
+    return address;
 }
 
 void VideoManager::MemoryTrackContinuity(uint64_t address, uint64_t virtualAddress, uint64_t size, uint64_t asid)
 {
     impl->m_host1x->MemoryManager().TrackContinuity(address, virtualAddress, size, Core::Asid{ asid });
+    if (impl->m_capture)
+    {
+        impl->m_capture->TrackContinuity(address, virtualAddress, size, asid);
+    }
 }
 
 void VideoManager::MemoryMap(uint64_t address, uint64_t virtualAddress, uint64_t size, uint64_t asid, bool track)
 {
+    // The capture watches the device pages for CPU writes, so they have to be mapped first
     impl->m_host1x->MemoryManager().Map(address, virtualAddress, size, Core::Asid{asid}, track);
+    if (impl->m_capture)
+    {
+        impl->m_capture->MemoryMap(address, virtualAddress, size, asid, track);
+    }
 }
 
 void VideoManager::ApplyOpOnDeviceMemoryPointer(const uint8_t * pointer, uint32_t * scratchBuffer, size_t scratchBufferSize, DeviceMemoryOperation operation, void * userData)
@@ -156,7 +239,12 @@ RasterizerDownloadArea VideoManager::OnCPURead(uint64_t addr, uint64_t size)
 
 bool VideoManager::OnCPUWrite(uint64_t addr, uint64_t size)
 {
-    return impl->m_gpuCore->OnCPUWrite(addr, size);
+    const bool deferred = impl->m_gpuCore->OnCPUWrite(addr, size);
+    if (impl->m_capture)
+    {
+        impl->m_capture->OnCPUWrite(addr, size, deferred);
+    }
+    return deferred;
 }
 
 uint32_t VideoManager::HostSyncpointValue(uint32_t id)
@@ -170,3 +258,43 @@ uint32_t VideoManager::HostSyncpointRegisterAction(uint32_t fence_id, uint32_t t
         operation(slot, userData);
     });
 }
+
+uint64_t VideoManager::FrontendTime(void)
+{
+    return impl->m_gpuCore->GetFrontendTime();
+}
+
+void VideoManager::TextureCacheStats(VideoTextureCacheStats & stats)
+{
+    const VideoCommon::TextureCacheStatistics statistics = impl->m_gpuCore->GetTextureCacheStatistics();
+
+    std::vector<size_t> formats;
+    stats.residentBytes = 0;
+    for (size_t i = 0, n = statistics.resident_bytes.size(); i < n; i++)
+    {
+        stats.residentBytes += statistics.resident_bytes[i];
+        if (statistics.resident_bytes[i] != 0)
+        {
+            formats.push_back(i);
+        }
+    }
+    const size_t formatCount = std::min(formats.size(), std::size(stats.residentFormats));
+    std::partial_sort(formats.begin(), formats.begin() + formatCount, formats.end(), [&statistics](size_t a, size_t b) {
+        return statistics.resident_bytes[a] > statistics.resident_bytes[b];
+    });
+    stats.residentFormatCount = static_cast<uint32_t>(formatCount);
+    for (size_t i = 0; i < formatCount; i++)
+    {
+        VideoTextureFormatBytes & entry = stats.residentFormats[i];
+        const auto result = fmt::format_to_n(entry.format, sizeof(entry.format) - 1, "{}", static_cast<VideoCore::Surface::PixelFormat>(formats[i]));
+        *result.out = '\0';
+        entry.bytes = statistics.resident_bytes[formats[i]];
+    }
+    stats.usedMemory = statistics.used_memory;
+    stats.budget = statistics.budget;
+    stats.evictions = statistics.evictions;
+    stats.evictedBytes = statistics.evicted_bytes;
+    stats.reuploads = statistics.reuploads;
+    stats.decodes = statistics.decodes;
+    stats.decodeTime = statistics.decode_ns;
+}
@@ -11,7 +11,7 @@ class VideoManager :
     public IVideo
 {
 public:
-    VideoManager(IRenderWindow & window, ISwitchSystem & system);
+    VideoManager(IRenderWindow & window, ISwitchSystem & system, bool allowCapture = true);
     ~VideoManager();
 
     void EmulationStarting();
@@ -33,6 +33,8 @@ public:
     bool OnCPUWrite(uint64_t addr, uint64_t size) override;
     uint32_t HostSyncpointValue(uint32_t id) override;
     uint32_t HostSyncpointRegisterAction(uint32_t fence_id, uint32_t target_value, HostActionCallback operation, uint32_t slot, void * userData) override;
+    uint64_t FrontendTime(void) override;
+    void TextureCacheStats(VideoTextureCacheStats & stats) override;
 
 private:
     VideoManager() = delete;
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace NXVideoSetting
+{
+    constexpr const char * GpuCapturePath = "nxvideo:GpuCapturePath";
+    constexpr const char * TextureMemoryBudget = "nxvideo:TextureMemoryBudget";
+
+} // namespace NXVideoSetting
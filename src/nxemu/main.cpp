@@ -4,11 +4,18 @@
 #include <common/std_string.h>
 #include <memory>
 #include <nxemu-core/app_init.h>
+#include <nxemu-core/machine/switch_system.h>
+#include <nxemu-core/modules/modules.h>
+#include <nxemu-core/settings/identifiers.h>
+#include <nxemu-core/settings/settings.h>
 #include <nxemu-core/version.h>
 #include <sciter_ui.h>
 #include <widgets/combo_box.h>
 #include <widgets/menubar.h>
 #include <widgets/page_nav.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <windows.h>
 
 void RegisterWidgets(ISciterUI & sciterUI)
@@ -18,8 +25,122 @@ void RegisterWidgets(ISciterUI & sciterUI)
     Register_WidgetPageNav(sciterUI);
 }
 
+// nxemu --replay-gpu <capture> [report.csv]
+int ReplayGpuCapture(int argc, char ** argv)
+{
+    bool Res = AppInit(&Notification::GetInstance());
+    if (Res)
+    {
+        Modules modules;
+        Res = modules.ReplayGpuCapture(argv[2], argc > 3 ? argv[3] : nullptr);
+    }
+    AppCleanup();
+    Notification::CleanUp();
+    return Res ? 0 : 1;
+}
+
+class HeadlessWindow :
+    public IRenderWindow
+{
+public:
+    // IRenderWindow
+    void * RenderSurface(void) const override
+    {
+        return nullptr;
+    }
+
+    float PixelRatio(void) const override
+    {
+        return 1.0;
+    }
+};
+
+// nxemu --replay-audio <capture> [report.csv]
+int ReplayAudioCapture(int argc, char ** argv)
+{
+    bool Res = AppInit(&Notification::GetInstance());
+    if (Res)
+    {
+        HeadlessWindow window;
+        Res = SwitchSystem::Create(window) && SwitchSystem::GetInstance()->OperatingSystem().ReplayAudioCapture(argv[2], argc > 3 ? argv[3] : nullptr);
+        SwitchSystem::ShutDown();
+    }
+    AppCleanup();
+    Notification::CleanUp();
+    return Res ? 0 : 1;
+}
+
+void BenchmarkCompleteChanged(const char * /*setting*/, void * userData)
+{
+    if (SettingsStore::GetInstance().GetBool(NXCoreSetting::BenchmarkComplete))
+    {
+        SetEvent((HANDLE)userData);
+    }
+}
+
+// nxemu --benchmark <rom> [frames] [report.json] [timeout seconds]
+int RunBenchmark(int argc, char ** argv)
+{
+    constexpr int32_t DefaultBenchmarkFrames = 600;
+    // Without an explicit timeout allow for loading plus a slow 5 frames per second run
+    constexpr uint64_t DefaultStartupTimeoutMs = 60 * 1000;
+    constexpr uint64_t DefaultFrameTimeoutMs = 200;
+
+    bool Res = AppInit(&Notification::GetInstance());
+    int32_t frames = argc > 3 ? atoi(argv[3]) : DefaultBenchmarkFrames;
+    int32_t timeoutSeconds = argc > 5 ? atoi(argv[5]) : 0;
+    const uint64_t timeoutMs = timeoutSeconds > 0 ? static_cast<uint64_t>(timeoutSeconds) * 1000 : DefaultStartupTimeoutMs + static_cast<uint64_t>(frames > 0 ? frames : 0) * DefaultFrameTimeoutMs;
+    HANDLE completeEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+    if (Res && (frames <= 0 || completeEvent == nullptr))
+    {
+        fprintf(stderr, "Benchmark: invalid frame count %d\n", frames);
+        Res = false;
+    }
+    if (Res)
+    {
+        SettingsStore & settings = SettingsStore::GetInstance();
+        settings.SetInt(NXCoreSetting::BenchmarkFrames, frames);
+        settings.SetString(NXCoreSetting::BenchmarkReport, argc > 4 ? argv[4] : "");
+        settings.SetBool(NXCoreSetting::BenchmarkComplete, false);
+        settings.RegisterCallback(NXCoreSetting::BenchmarkComplete, BenchmarkCompleteChanged, completeEvent);
+
+        HeadlessWindow window;
+        Res = SwitchSystem::Create(window) && SwitchSystem::GetInstance()->Systemloader().LoadRom(argv[2]);
+        if (!Res)
+        {
+            fprintf(stderr, "Benchmark: failed to start %s\n", argv[2]);
+        }
+        else if (WaitForSingleObject(completeEvent, timeoutMs < INFINITE ? static_cast<DWORD>(timeoutMs) : INFINITE - 1) != WAIT_OBJECT_0)
+        {
+            fprintf(stderr, "Benchmark: %d frames did not complete within %llu seconds\n", frames, static_cast<unsigned long long>(timeoutMs / 1000));
+            Res = false;
+        }
+        SwitchSystem::ShutDown();
+    }
+    if (completeEvent != nullptr)
+    {
+        CloseHandle(completeEvent);
+    }
+    AppCleanup();
+    Notification::CleanUp();
+    return Res ? 0 : 1;
+}
+
 int WINAPI WinMain(_In_ HINSTANCE /*hInstance*/, _In_opt_ HINSTANCE /*hPrevInstance*/, _In_ LPSTR /*lpszArgs*/, _In_ int /*nWinMode*/)
 {
+    if (__argc > 2 && strcmp(__argv[1], "--replay-gpu") == 0)
+    {
+        return ReplayGpuCapture(__argc, __argv);
+    }
+    if (__argc > 2 && strcmp(__argv[1], "--replay-audio") == 0)
+    {
+        return ReplayAudioCapture(__argc, __argv);
+    }
+    if (__argc > 2 && strcmp(__argv[1], "--benchmark") == 0)
+    {
+        return RunBenchmark(__argc, __argv);
+    }
+
     bool Res = AppInit(&Notification::GetInstance());
 
     ISciterUI * sciterUI = nullptr;
@@ -0,0 +1,319 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "tests/tests.h"
+#include "yuzu_audio_core/renderer/command/data_source/decode_kernels.h"
+
+namespace Tests {
+
+namespace {
+
+using AudioCore::Renderer::VoiceState;
+
+constexpr u32 SamplesPerFrame = 14;
+constexpr u32 NibblesPerFrame = 16;
+constexpr u32 BytesPerFrame = NibblesPerFrame / 2;
+
+/// The per sample loop DecodeAdpcm used before the frame decoder, from the sample position on
+void ReferenceAdpcm(std::span<s16> out_buffer, std::span<const u8> wavebuffer,
+                    const std::array<s16, 16>& coefficients, VoiceState::AdpcmContext& context,
+                    u32 position_in_frame, u32 samples_to_read) {
+    auto header{context.header};
+    u8 coeff_index{static_cast<u8>((header >> 4U) & 0xFU)};
+    u8 scale{static_cast<u8>(header & 0xFU)};
+    s32 coeff0{coefficients[coeff_index * 2 + 0]};
+    s32 coeff1{coefficients[coeff_index * 2 + 1]};
+
+    auto yn0{context.yn0};
+    auto yn1{context.yn1};
+
+    static constexpr std::array<s32, 16> Steps{
+        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
+    };
+
+    const auto decode_sample = [&](const s32 code) -> s16 {
+        const auto xn = code * (1 << scale);
+        const auto prediction = coeff0 * yn0 + coeff1 * yn1;
+        const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
+        const auto saturated = std::clamp<s32>(sample, -0x8000, 0x7FFF);
+        yn1 = yn0;
+        yn0 = static_cast<s16>(saturated);
+        return yn0;
+    };
+
+    u32 read_index{0};
+    u32 write_index{0};
+
+    while (samples_to_read > 0) {
+        // Are we at a new frame?
+        if ((position_in_frame % NibblesPerFrame) == 0) {
+            header = wavebuffer[read_index++];
+            coeff_index = (header >> 4) & 0xF;
+            scale = header & 0xF;
+            coeff0 = coefficients[coeff_index * 2 + 0];
+            coeff1 = coefficients[coeff_index * 2 + 1];
+            position_in_frame += 2;
+
+            // Can we consume all of this frame's samples?
+            if (samples_to_read >= SamplesPerFrame) {
+                // Can grab all samples until the next header
+                for (u32 i = 0; i < SamplesPerFrame / 2; i++) {
+                    auto code0{Steps[(wavebuffer[read_index] >> 4) & 0xF]};
+                    auto code1{Steps[wavebuffer[read_index] & 0xF]};
+                    read_index++;
+
+                    out_buffer[write_index++] = decode_sample(code0);
+                    out_buffer[write_index++] = decode_sample(code1);
+                }
+
+                position_in_frame += SamplesPerFrame;
+                samples_to_read -= SamplesPerFrame;
+                continue;
+            }
+        }
+
+        // Decode a single sample
+        auto code{wavebuffer[read_index]};
+        if (position_in_frame & 1) {
+            code &= 0xF;
+            read_index++;
+        } else {
+            code >>= 4;
+        }
+
+        out_buffer[write_index++] = decode_sample(Steps[code]);
+
+        position_in_frame++;
+        samples_to_read--;
+    }
+
+    context.header = header;
+    context.yn0 = yn0;
+    context.yn1 = yn1;
+}
+
+/// The per sample loops DecodePcm used before the constant stride copies
+template <typename T>
+void ReferencePcm(std::span<s16> out_buffer, std::span<const T> samples, u32 target_channel,
+                  u32 channel_count, u32 samples_to_decode) {
+    constexpr s32 min{std::numeric_limits<s16>::min()};
+    constexpr s32 max{std::numeric_limits<s16>::max()};
+    if constexpr (std::is_floating_point_v<T>) {
+        for (u32 i = 0; i < samples_to_decode; i++) {
+            auto sample{static_cast<s32>(samples[i * channel_count + target_channel] *
+                                         std::numeric_limits<s16>::max())};
+            out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
+        }
+    } else {
+        for (u32 i = 0; i < samples_to_decode; i++) {
+            out_buffer[i] = samples[i * channel_count + target_channel];
+        }
+    }
+}
+
+/// Nibble position of a sample, as DecodeAdpcm computes it from the wave buffer offsets
+u32 AdpcmPosition(u32 sample) {
+    const u32 in_frame{sample % SamplesPerFrame};
+    return (sample / SamplesPerFrame) * NibblesPerFrame + in_frame + (in_frame != 0 ? 2 : 0);
+}
+
+/// Random coefficient pairs, some at full scale so the prediction saturates
+std::array<s16, 16> MakeCoefficients(std::mt19937& rng) {
+    std::uniform_int_distribution<s32> coefficient{std::numeric_limits<s16>::min(),
+                                                   std::numeric_limits<s16>::max()};
+    std::uniform_int_distribution<u32> pick{0, 7};
+    std::array<s16, 16> coefficients;
+    for (s16& value : coefficients) {
+        const u32 choice = pick(rng);
+        value = static_cast<s16>(choice == 0   ? std::numeric_limits<s16>::max()
+                                 : choice == 1 ? std::numeric_limits<s16>::min()
+                                 : choice < 5  ? coefficient(rng) / 8
+                                               : coefficient(rng));
+    }
+    return coefficients;
+}
+
+VoiceState::AdpcmContext MakeContext(std::mt19937& rng) {
+    std::uniform_int_distribution<u32> byte{0, 0xFF};
+    std::uniform_int_distribution<s32> sample{std::numeric_limits<s16>::min(),
+                                              std::numeric_limits<s16>::max()};
+    return {
+        .header = static_cast<u16>(byte(rng)),
+        .yn0 = static_cast<s16>(sample(rng)),
+        .yn1 = static_cast<s16>(sample(rng)),
+    };
+}
+
+bool SameContext(const VoiceState::AdpcmContext& a, const VoiceState::AdpcmContext& b) {
+    return a.header == b.header && a.yn0 == b.yn0 && a.yn1 == b.yn1;
+}
+
+bool CheckAdpcm(std::mt19937& rng) {
+    constexpr std::string_view test = "decode_adpcm";
+    constexpr u32 FrameCount = 24;
+    constexpr u32 TotalSamples = FrameCount * SamplesPerFrame;
+    std::uniform_int_distribution<u32> byte{0, 0xFF};
+    std::uniform_int_distribution<u32> start_sample{0, TotalSamples - 1};
+
+    for (u32 iteration = 0; iteration < 4000; ++iteration) {
+        std::vector<u8> data(FrameCount * BytesPerFrame);
+        for (u8& value : data) {
+            value = static_cast<u8>(byte(rng));
+        }
+        const auto coefficients = MakeCoefficients(rng);
+        const auto context = MakeContext(rng);
+
+        // Frame starts, one sample into a frame and the last sample of a frame are the edges of
+        // the frame decoder, the rest are random
+        u32 start = start_sample(rng);
+        switch (iteration % 4) {
+        case 0:
+            start -= start % SamplesPerFrame;
+            break;
+        case 1:
+            start = start - start % SamplesPerFrame + 1;
+            break;
+        case 2:
+            start += SamplesPerFrame - 1 - start % SamplesPerFrame;
+            break;
+        }
+        const u32 remaining = TotalSamples - start;
+        constexpr std::array<u32, 8> edge_counts{1, 2, 13, 14, 15, 27, 28, 29};
+        const u32 count = std::min(
+            remaining, iteration % 2 == 0 ? edge_counts[(iteration / 2) % edge_counts.size()]
+                                          : std::uniform_int_distribution<u32>{1, remaining}(rng));
+
+        const u32 position = AdpcmPosition(start);
+        const std::span<const u8> wavebuffer{data.data() + position / 2,
+                                             data.size() - position / 2};
+
+        std::vector<s16> expected(count);
+        auto expected_context{context};
+        ReferenceAdpcm(expected, wavebuffer, coefficients, expected_context, position, count);
+
+        std::vector<s16> result(count);
+        auto result_context{context};
+        AudioCore::Renderer::DecodeAdpcmSamples(result, wavebuffer, coefficients, result_context,
+                                                position, count);
+
+        const auto [mismatch, _] = std::ranges::mismatch(result, expected);
+        if (mismatch != result.end()) {
+            const size_t index = static_cast<size_t>(mismatch - result.begin());
+            return Fail(test, "differs at sample {}: {} != {} (start {}, count {})", index,
+                        *mismatch, expected[index], start, count);
+        }
+        if (!SameContext(result_context, expected_context)) {
+            return Fail(test, "context differs (start {}, count {})", start, count);
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<T> MakePcm(std::mt19937& rng, size_t count) {
+    std::vector<T> samples(count);
+    std::uniform_int_distribution<u32> pick{0, 15};
+    if constexpr (std::is_floating_point_v<T>) {
+        // In range, at and past full scale of either sign
+        std::uniform_real_distribution<f32> sample{-1.0f, 1.0f};
+        std::uniform_real_distribution<f32> loud{-4.0f, 4.0f};
+        constexpr std::array<f32, 6> edges{1.0f, -1.0f, 0.0f, -0.0f, 1.00002f, -1.00002f};
+        for (T& value : samples) {
+            const u32 choice = pick(rng);
+            value = choice < edges.size() ? edges[choice] : choice < 10 ? loud(rng) : sample(rng);
+        }
+    } else {
+        std::uniform_int_distribution<s32> sample{std::numeric_limits<s16>::min(),
+                                                  std::numeric_limits<s16>::max()};
+        for (T& value : samples) {
+            value = static_cast<T>(sample(rng));
+        }
+    }
+    return samples;
+}
+
+template <typename T>
+bool CheckPcm(std::mt19937& rng) {
+    constexpr std::string_view test = "decode_pcm";
+    std::uniform_int_distribution<u32> count_distribution{0, 600};
+
+    for (const u32 channel_count : {1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U}) {
+        for (u32 channel = 0; channel < channel_count; ++channel) {
+            for (u32 iteration = 0; iteration < 20; ++iteration) {
+                const u32 count = iteration < 3 ? iteration : count_distribution(rng);
+                const std::vector<T> samples = MakePcm<T>(rng, count * channel_count);
+
+                std::vector<s16> expected(count);
+                ReferencePcm<T>(expected, samples, channel, channel_count, count);
+                std::vector<s16> result(count);
+                AudioCore::Renderer::DecodePcmChannel(result, std::span<const T>{samples},
+                                                      channel, channel_count, count);
+
+                const auto [mismatch, _] = std::ranges::mismatch(result, expected);
+                if (mismatch != result.end()) {
+                    const size_t index = static_cast<size_t>(mismatch - result.begin());
+                    return Fail(test, "{} channel {} of {} differs at sample {}: {} != {}",
+                                std::is_floating_point_v<T> ? "float" : "int16", channel,
+                                channel_count, index, *mismatch, expected[index]);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+bool DecodeSamples() {
+    std::mt19937 rng{RandomSeed};
+    return CheckAdpcm(rng) && CheckPcm<s16>(rng) && CheckPcm<f32>(rng);
+}
+
+void BenchmarkDecodeSamples() {
+    // One command list worth of voices: 24 voices of 240 samples
+    constexpr u32 SampleCount = 240;
+    constexpr u32 VoiceCount = 24;
+    constexpr u32 FrameCount = (SampleCount + SamplesPerFrame - 1) / SamplesPerFrame;
+    std::mt19937 rng{RandomSeed};
+    std::uniform_int_distribution<u32> byte{0, 0xFF};
+    std::vector<u8> data(FrameCount * BytesPerFrame);
+    for (u8& value : data) {
+        value = static_cast<u8>(byte(rng));
+    }
+    const auto coefficients = MakeCoefficients(rng);
+    const std::vector<f32> stereo = MakePcm<f32>(rng, SampleCount * 2);
+    std::vector<s16> output(SampleCount);
+
+    Benchmark("adpcm reference 24x240", 2000, [&] {
+        for (u32 voice = 0; voice < VoiceCount; ++voice) {
+            VoiceState::AdpcmContext context{};
+            ReferenceAdpcm(output, data, coefficients, context, 0, SampleCount);
+        }
+    });
+    Benchmark("adpcm 24x240", 2000, [&] {
+        for (u32 voice = 0; voice < VoiceCount; ++voice) {
+            VoiceState::AdpcmContext context{};
+            AudioCore::Renderer::DecodeAdpcmSamples(output, data, coefficients, context, 0,
+                                                    SampleCount);
+        }
+    });
+    Benchmark("float stereo reference 24x240", 2000, [&] {
+        for (u32 voice = 0; voice < VoiceCount; ++voice) {
+            ReferencePcm<f32>(output, stereo, voice % 2, 2, SampleCount);
+        }
+    });
+    Benchmark("float stereo 24x240", 2000, [&] {
+        for (u32 voice = 0; voice < VoiceCount; ++voice) {
+            AudioCore::Renderer::DecodePcmChannel(output, std::span<const f32>{stereo}, voice % 2,
+                                                  2, SampleCount);
+        }
+    });
+}
+
+} // namespace Tests
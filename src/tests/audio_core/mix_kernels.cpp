@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tests/tests.h"
+#include "yuzu_audio_core/renderer/command/mix/mix_kernels.h"
+#include "yuzu_common/fixed_point.h"
+
+namespace Tests {
+
+namespace {
+
+using AudioCore::Renderer::GainKernel;
+using AudioCore::Renderer::GainKernelFn;
+
+/// The FixedPoint loops the mix and volume commands used before the kernels
+template <size_t Q>
+void ReferenceGain(bool accumulate, std::span<s32> output, std::span<const s32> input, s64 gain,
+                   s64 ramp) {
+    using Fixed = Common::FixedPoint<64 - Q, Q>;
+    Fixed volume{Fixed::from_base(gain)};
+    const Fixed step{Fixed::from_base(ramp)};
+    for (size_t i = 0; i < input.size(); i++) {
+        Fixed sample{input[i] * volume};
+        output[i] = static_cast<s32>(accumulate ? (output[i] + sample).to_int() : sample.to_int());
+        volume += step;
+    }
+}
+
+struct GainCase {
+    u32 q;
+    s64 gain;
+    s64 ramp;
+    u32 sample_count;
+};
+
+/// Random cases plus the edges: unity and full scale gains, ramps ending right at and right past
+/// the 32-bit limit of the SIMD kernels, and ramps crossing zero
+std::vector<GainCase> MakeGainCases(std::mt19937& rng) {
+    constexpr s64 s32_max{std::numeric_limits<s32>::max()};
+    constexpr s64 s32_min{std::numeric_limits<s32>::min()};
+    std::vector<GainCase> cases;
+    for (const u32 q : {15U, 23U}) {
+        const s64 unity{s64{1} << q};
+        for (const u32 count : {0U, 1U, 3U, 4U, 7U, 8U, 9U, 15U, 16U, 17U, 31U, 33U, 240U}) {
+            const s64 n{static_cast<s64>(count)};
+            cases.push_back({q, unity, 0, count});
+            cases.push_back({q, -unity, 0, count});
+            cases.push_back({q, s32_max, 0, count});
+            cases.push_back({q, s32_min, 0, count});
+            cases.push_back({q, 0, unity / 64, count});
+            cases.push_back({q, unity, -unity / 16, count});
+            if (count != 0) {
+                cases.push_back({q, s32_max - 7 * n, 7, count});
+                cases.push_back({q, s32_max - 7 * n, 8, count});
+                cases.push_back({q, s32_min + 5 * n, -5, count});
+                cases.push_back({q, s32_min + 5 * n, -6, count});
+            }
+            cases.push_back({q, s32_max + 1, 0, count});
+            cases.push_back({q, s32_max * 2, -s32_max / 128, count});
+        }
+        std::uniform_int_distribution<s64> gain{s32_min, s32_max};
+        std::uniform_int_distribution<s64> ramp{-unity / 32, unity / 32};
+        std::uniform_int_distribution<u32> count{0, 300};
+        for (u32 i = 0; i < 400; ++i) {
+            cases.push_back({q, gain(rng), ramp(rng), count(rng)});
+        }
+    }
+    return cases;
+}
+
+std::vector<s32> MakeSamples(std::mt19937& rng, size_t count) {
+    std::uniform_int_distribution<s32> sample{std::numeric_limits<s32>::min(),
+                                              std::numeric_limits<s32>::max()};
+    std::uniform_int_distribution<u32> pick{0, 15};
+    constexpr std::array<s32, 4> extremes{std::numeric_limits<s32>::min(),
+                                          std::numeric_limits<s32>::max(), -1, 0};
+    std::vector<s32> samples(count);
+    for (s32& value : samples) {
+        const u32 choice = pick(rng);
+        if (choice < 4) {
+            value = extremes[choice];
+        } else if (choice < 10) {
+            value = sample(rng) >> 16;
+        } else {
+            value = sample(rng);
+        }
+    }
+    return samples;
+}
+
+void RunReference(bool accumulate, std::span<s32> output, std::span<const s32> input,
+                  const GainCase& test_case) {
+    if (test_case.q == 15) {
+        ReferenceGain<15>(accumulate, output, input, test_case.gain, test_case.ramp);
+    } else {
+        ReferenceGain<23>(accumulate, output, input, test_case.gain, test_case.ramp);
+    }
+}
+
+} // Anonymous namespace
+
+bool MixGainKernels() {
+    constexpr std::string_view test = "mix_gain_kernels";
+    std::mt19937 rng{RandomSeed};
+    const std::span<const GainKernel> kernels = AudioCore::Renderer::GetGainKernels();
+
+    for (const GainCase& test_case : MakeGainCases(rng)) {
+        const std::vector<s32> input = MakeSamples(rng, test_case.sample_count);
+        const std::vector<s32> initial = MakeSamples(rng, test_case.sample_count);
+        for (const bool accumulate : {true, false}) {
+            std::vector<s32> expected = initial;
+            RunReference(accumulate, expected, input, test_case);
+
+            const auto check = [&](std::string_view name, std::span<const s32> result) {
+                const auto [mismatch, _] = std::ranges::mismatch(result, expected);
+                if (mismatch == result.end()) {
+                    return true;
+                }
+                const size_t index = static_cast<size_t>(mismatch - result.begin());
+                return Fail(test,
+                            "{} {} differs at sample {}: {} != {} (q {}, gain {}, ramp {}, "
+                            "count {}, input {})",
+                            name, accumulate ? "mix" : "apply", index, *mismatch, expected[index],
+                            test_case.q, test_case.gain, test_case.ramp,
+                            test_case.sample_count, input[index]);
+            };
+
+            // The dispatching entry points, including the scalar fallback for wide gains
+            std::vector<s32> result = initial;
+            if (accumulate) {
+                AudioCore::Renderer::MixGainKernel(result, input, test_case.gain, test_case.ramp,
+                                                   test_case.q, test_case.sample_count);
+            } else {
+                AudioCore::Renderer::ApplyGainKernel(result, input, test_case.gain,
+                                                     test_case.ramp, test_case.q,
+                                                     test_case.sample_count);
+            }
+            if (!check("dispatch", result)) {
+                return false;
+            }
+
+            // Every kernel on its own, within the range it accepts
+            if (!AudioCore::Renderer::GainFitsSimd(test_case.gain, test_case.ramp,
+                                                   test_case.sample_count)) {
+                continue;
+            }
+            for (const GainKernel& kernel : kernels) {
+                const GainKernelFn run = accumulate ? kernel.mix : kernel.apply;
+                result = initial;
+                run(result.data(), input.data(), test_case.gain, test_case.ramp, test_case.q,
+                    test_case.sample_count);
+                if (!check(kernel.name, result)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void BenchmarkMixGainKernels() {
+    // One command list worth of mixing: 24 mix buffers of 240 samples
+    constexpr u32 SampleCount = 240;
+    constexpr u32 BufferCount = 24;
+    constexpr u32 Q = 15;
+    std::mt19937 rng{RandomSeed};
+    const std::vector<s32> input = MakeSamples(rng, SampleCount * BufferCount);
+    std::vector<s32> output(input.size());
+
+    for (const GainKernel& kernel : AudioCore::Renderer::GetGainKernels()) {
+        for (const s64 ramp : {s64{0}, s64{3}}) {
+            const std::string name =
+                fmt::format("{} {} 24x240", kernel.name, ramp == 0 ? "mix" : "mix ramp");
+            Benchmark(name, 2000, [&] {
+                for (u32 buffer = 0; buffer < BufferCount; ++buffer) {
+                    const size_t offset = static_cast<size_t>(buffer) * SampleCount;
+                    kernel.mix(output.data() + offset, input.data() + offset, 0x5a5a, ramp, Q,
+                               SampleCount);
+                }
+            });
+        }
+    }
+}
+
+} // namespace Tests
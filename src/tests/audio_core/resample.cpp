@@ -0,0 +1,423 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tests/tests.h"
+#include "yuzu_audio_core/renderer/command/resample/resample.h"
+#include "yuzu_audio_core/renderer/command/resample/upsample.h"
+#include "yuzu_audio_core/renderer/upsampler/upsampler_state.h"
+#include "yuzu_common/fixed_point.h"
+
+namespace Tests {
+
+namespace {
+
+using AudioCore::Renderer::PolyphaseFilter;
+using AudioCore::Renderer::PolyphaseFilterFn;
+using AudioCore::Renderer::UpsampleKernel;
+using AudioCore::Renderer::UpsamplerState;
+
+/// Number of phases of the polyphase filter LUTs
+constexpr u32 FilterPhases = 128;
+
+/// The per sample FixedPoint loop the medium and high quality resamplers used before the filters
+template <u32 Taps>
+void ReferencePolyphaseFilter(std::span<s32> output, std::span<const s16> input,
+                              std::span<const f32> lut,
+                              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                              Common::FixedPoint<49, 15>& fraction, u32 samples_to_write) {
+    u32 read_index{0};
+    for (u32 i = 0; i < samples_to_write; i++) {
+        const auto lut_index{(fraction.get_frac() >> 8) * Taps};
+        Common::FixedPoint<56, 8> sum{0};
+        for (u32 tap = 0; tap < Taps; tap++) {
+            sum += Common::FixedPoint<56, 8>{input[read_index + tap] * lut[lut_index + tap]};
+        }
+        output[i] = sum.to_int_floor();
+        fraction += sample_rate_ratio;
+        read_index += static_cast<u32>(fraction.to_int_floor());
+        fraction.clear_int();
+    }
+}
+
+struct FilterCase {
+    s64 ratio;
+    s64 fraction;
+    u32 sample_count;
+};
+
+/// Random cases plus the edges: unity ratio, ratios a step off unity and off whole samples, and
+/// start fractions right before the next sample
+std::vector<FilterCase> MakeFilterCases(std::mt19937& rng) {
+    constexpr s64 Unity{1 << 15};
+    std::vector<FilterCase> cases;
+    for (const u32 count : {0U, 1U, 3U, 4U, 5U, 7U, 8U, 9U, 15U, 16U, 17U, 31U, 33U, 240U}) {
+        for (const s64 ratio : {Unity, Unity - 1, Unity + 1, Unity / 6, Unity * 2 / 3,
+                                Unity * 2, Unity * 4 - 1, s64{1}}) {
+            for (const s64 fraction : {s64{0}, Unity / 2, Unity - 1}) {
+                cases.push_back({ratio, fraction, count});
+            }
+        }
+    }
+    std::uniform_int_distribution<s64> ratio{1, Unity * 4};
+    std::uniform_int_distribution<s64> fraction{0, Unity - 1};
+    std::uniform_int_distribution<u32> count{0, 300};
+    for (u32 i = 0; i < 1000; ++i) {
+        cases.push_back({ratio(rng), fraction(rng), count(rng)});
+    }
+    return cases;
+}
+
+std::vector<s16> MakeInput(std::mt19937& rng, size_t count) {
+    std::uniform_int_distribution<s32> sample{std::numeric_limits<s16>::min(),
+                                              std::numeric_limits<s16>::max()};
+    std::uniform_int_distribution<u32> pick{0, 15};
+    constexpr std::array<s16, 4> extremes{std::numeric_limits<s16>::min(),
+                                          std::numeric_limits<s16>::max(), -1, 0};
+    std::vector<s16> input(count);
+    for (s16& value : input) {
+        const u32 choice = pick(rng);
+        value = static_cast<s16>(choice < 4 ? extremes[choice] : sample(rng));
+    }
+    return input;
+}
+
+/// Random taps in [-1, 1] like the real LUTs, plus taps at full scale of either sign
+std::vector<f32> MakeLut(std::mt19937& rng, u32 taps) {
+    std::uniform_real_distribution<f32> tap{-1.0f, 1.0f};
+    std::uniform_int_distribution<u32> pick{0, 15};
+    std::vector<f32> lut(FilterPhases * taps);
+    for (f32& value : lut) {
+        const u32 choice = pick(rng);
+        value = choice == 0 ? 1.0f : choice == 1 ? -1.0f : tap(rng);
+    }
+    return lut;
+}
+
+template <u32 Taps>
+bool CheckPolyphaseFilter(std::mt19937& rng, std::span<const FilterCase> cases) {
+    constexpr std::string_view test = "resample_polyphase_filters";
+    const std::span<const PolyphaseFilter> filters = AudioCore::Renderer::GetPolyphaseFilters();
+
+    for (const FilterCase& test_case : cases) {
+        const auto ratio = Common::FixedPoint<49, 15>::from_base(test_case.ratio);
+        const auto start = Common::FixedPoint<49, 15>::from_base(test_case.fraction);
+        const size_t input_count =
+            static_cast<size_t>((test_case.fraction + test_case.ratio * test_case.sample_count) >>
+                                15) +
+            Taps;
+        const std::vector<s16> input = MakeInput(rng, input_count);
+        const std::vector<f32> lut = MakeLut(rng, Taps);
+
+        std::vector<s32> expected(test_case.sample_count);
+        auto expected_fraction{start};
+        ReferencePolyphaseFilter<Taps>(expected, input, lut, ratio, expected_fraction,
+                                       test_case.sample_count);
+
+        for (const PolyphaseFilter& filter : filters) {
+            const PolyphaseFilterFn run = Taps == 4 ? filter.four_tap : filter.eight_tap;
+            std::vector<s32> result(test_case.sample_count);
+            auto fraction{start};
+            run(result, input, lut, ratio, fraction, test_case.sample_count);
+
+            const auto [mismatch, _] = std::ranges::mismatch(result, expected);
+            if (mismatch != result.end()) {
+                const size_t index = static_cast<size_t>(mismatch - result.begin());
+                return Fail(test,
+                            "{} {} tap differs at sample {}: {} != {} (ratio {}, fraction {}, "
+                            "count {})",
+                            filter.name, Taps, index, *mismatch, expected[index], test_case.ratio,
+                            test_case.fraction, test_case.sample_count);
+            }
+            if (fraction.to_raw() != expected_fraction.to_raw()) {
+                return Fail(test, "{} {} tap ends at fraction {} != {} (ratio {}, count {})",
+                            filter.name, Taps, fraction.to_raw(), expected_fraction.to_raw(),
+                            test_case.ratio, test_case.sample_count);
+            }
+        }
+    }
+    return true;
+}
+
+/// The upsampler as it was before the dot product kernels, walking the history ring per tap
+void ReferenceUpsample(std::span<s32> output, std::span<const s32> input,
+                       const u32 target_sample_count, const u32 source_sample_count,
+                       UpsamplerState* state) {
+    static constexpr u32 WindowSize = 10;
+    static constexpr std::array<Common::FixedPoint<17, 15>, WindowSize> WindowedSinc1{
+        0.95376587f,   -0.12872314f, 0.060028076f,  -0.032470703f, 0.017669678f,
+        -0.009124756f, 0.004272461f, -0.001739502f, 0.000579834f,  -0.000091552734f,
+    };
+    static constexpr std::array<Common::FixedPoint<17, 15>, WindowSize> WindowedSinc2{
+        0.8230896f,    -0.19161987f,  0.093444824f,  -0.05090332f,   0.027557373f,
+        -0.014038086f, 0.0064697266f, -0.002532959f, 0.00079345703f, -0.00012207031f,
+    };
+    static constexpr std::array<Common::FixedPoint<17, 15>, WindowSize> WindowedSinc3{
+        0.6298828f,    -0.19274902f, 0.09725952f,    -0.05319214f,  0.028625488f,
+        -0.014373779f, 0.006500244f, -0.0024719238f, 0.0007324219f, -0.000091552734f,
+    };
+    static constexpr std::array<Common::FixedPoint<17, 15>, WindowSize> WindowedSinc4{
+        0.4057312f,    -0.1468811f,  0.07601929f,    -0.041656494f,  0.022216797f,
+        -0.011016846f, 0.004852295f, -0.0017700195f, 0.00048828125f, -0.000030517578f,
+    };
+    static constexpr std::array<Common::FixedPoint<17, 15>, WindowSize> WindowedSinc5{
+        0.1854248f,    -0.075164795f, 0.03967285f,    -0.021728516f,  0.011474609f,
+        -0.005584717f, 0.0024108887f, -0.0008239746f, 0.00021362305f, 0.0f,
+    };
+
+    if (!state->initialized) {
+        state->window_size = WindowSize;
+        state->ratio = source_sample_count == 40 ? 6.0f : source_sample_count == 80 ? 3.0f : 1.5f;
+        state->history.fill(0);
+        state->history_input_index = 0;
+        state->history_output_index = 9;
+        state->history_start_index = 0;
+        state->history_end_index = UpsamplerState::HistorySize - 1;
+        state->initialized = true;
+    }
+
+    u32 read_index{0};
+
+    auto increment = [&]() -> void {
+        state->history[state->history_input_index] = input[read_index++];
+        state->history_input_index =
+            static_cast<u16>((state->history_input_index + 1) % UpsamplerState::HistorySize);
+        state->history_output_index =
+            static_cast<u16>((state->history_output_index + 1) % UpsamplerState::HistorySize);
+    };
+
+    auto calculate_sample = [&state](std::span<const Common::FixedPoint<17, 15>> coeffs1,
+                                     std::span<const Common::FixedPoint<17, 15>> coeffs2) -> s32 {
+        auto output_index{state->history_output_index};
+        u64 result{0};
+
+        for (u32 coeff_index = 0; coeff_index < 10; coeff_index++) {
+            result += static_cast<u64>(state->history[output_index].to_raw()) *
+                      coeffs1[coeff_index].to_raw();
+
+            output_index = output_index == state->history_start_index ? state->history_end_index
+                                                                      : output_index - 1;
+        }
+
+        output_index =
+            static_cast<u16>((state->history_output_index + 1) % UpsamplerState::HistorySize);
+
+        for (u32 coeff_index = 0; coeff_index < 10; coeff_index++) {
+            result += static_cast<u64>(state->history[output_index].to_raw()) *
+                      coeffs2[coeff_index].to_raw();
+
+            output_index = output_index == state->history_end_index ? state->history_start_index
+                                                                    : output_index + 1;
+        }
+
+        return static_cast<s32>(result >> (8 + 15));
+    };
+
+    switch (state->ratio.to_int_floor()) {
+    // 40 -> 240
+    case 6:
+        for (u32 write_index = 0; write_index < target_sample_count; write_index++) {
+            switch (state->sample_index) {
+            case 0:
+                increment();
+                output[write_index] = state->history[state->history_output_index].to_int_floor();
+                break;
+
+            case 1:
+                output[write_index] = calculate_sample(WindowedSinc1, WindowedSinc5);
+                break;
+
+            case 2:
+                output[write_index] = calculate_sample(WindowedSinc2, WindowedSinc4);
+                break;
+
+            case 3:
+                output[write_index] = calculate_sample(WindowedSinc3, WindowedSinc3);
+                break;
+
+            case 4:
+                output[write_index] = calculate_sample(WindowedSinc4, WindowedSinc2);
+                break;
+
+            case 5:
+                output[write_index] = calculate_sample(WindowedSinc5, WindowedSinc1);
+                break;
+            }
+            state->sample_index = static_cast<u8>((state->sample_index + 1) % 6);
+        }
+        break;
+
+    // 80 -> 240
+    case 3:
+        for (u32 write_index = 0; write_index < target_sample_count; write_index++) {
+            switch (state->sample_index) {
+            case 0:
+                increment();
+                output[write_index] = state->history[state->history_output_index].to_int_floor();
+                break;
+
+            case 1:
+                output[write_index] = calculate_sample(WindowedSinc2, WindowedSinc4);
+                break;
+
+            case 2:
+                output[write_index] = calculate_sample(WindowedSinc4, WindowedSinc2);
+                break;
+            }
+            state->sample_index = static_cast<u8>((state->sample_index + 1) % 3);
+        }
+        break;
+
+    // 160 -> 240
+    default:
+        for (u32 write_index = 0; write_index < target_sample_count; write_index++) {
+            switch (state->sample_index) {
+            case 0:
+                increment();
+                output[write_index] = state->history[state->history_output_index].to_int_floor();
+                break;
+
+            case 1:
+                output[write_index] = calculate_sample(WindowedSinc4, WindowedSinc2);
+                break;
+
+            case 2:
+                increment();
+                output[write_index] = calculate_sample(WindowedSinc2, WindowedSinc4);
+                break;
+            }
+            state->sample_index = static_cast<u8>((state->sample_index + 1) % 3);
+        }
+
+        break;
+    }
+}
+
+bool SameState(const UpsamplerState& a, const UpsamplerState& b) {
+    for (u32 i = 0; i < UpsamplerState::HistorySize; i++) {
+        if (a.history[i].to_raw() != b.history[i].to_raw()) {
+            return false;
+        }
+    }
+    return a.ratio.to_raw() == b.ratio.to_raw() && a.window_size == b.window_size &&
+           a.history_output_index == b.history_output_index &&
+           a.history_input_index == b.history_input_index &&
+           a.history_start_index == b.history_start_index &&
+           a.history_end_index == b.history_end_index && a.initialized == b.initialized &&
+           a.sample_index == b.sample_index;
+}
+
+/// Mix buffer samples, mostly in the 24 bit range the history holds plus full scale extremes
+std::vector<s32> MakeMixSamples(std::mt19937& rng, size_t count) {
+    std::uniform_int_distribution<s32> sample{-(1 << 23), (1 << 23) - 1};
+    std::uniform_int_distribution<s32> wide{std::numeric_limits<s32>::min(),
+                                            std::numeric_limits<s32>::max()};
+    std::uniform_int_distribution<u32> pick{0, 31};
+    std::vector<s32> samples(count);
+    for (s32& value : samples) {
+        const u32 choice = pick(rng);
+        value = choice == 0   ? (1 << 23) - 1
+                : choice == 1 ? -(1 << 23)
+                : choice == 2 ? wide(rng)
+                              : sample(rng);
+    }
+    return samples;
+}
+
+} // Anonymous namespace
+
+bool ResamplePolyphaseFilters() {
+    std::mt19937 rng{RandomSeed};
+    const std::vector<FilterCase> cases = MakeFilterCases(rng);
+    return CheckPolyphaseFilter<4>(rng, cases) && CheckPolyphaseFilter<8>(rng, cases);
+}
+
+bool UpsampleFrames() {
+    constexpr std::string_view test = "upsample_frames";
+    constexpr u32 TargetSampleCount = 240;
+    std::mt19937 rng{RandomSeed};
+    // Odd target counts leave the phase mid cycle for the next frame
+    std::uniform_int_distribution<u32> odd_count{0, 17};
+
+    for (const u32 source_sample_count : {40U, 80U, 160U}) {
+        for (const UpsampleKernel& kernel : AudioCore::Renderer::GetUpsampleKernels()) {
+            UpsamplerState expected_state{};
+            UpsamplerState state{};
+            for (u32 frame = 0; frame < 200; ++frame) {
+                const u32 target_count = frame % 8 == 7 ? odd_count(rng) : TargetSampleCount;
+                const std::vector<s32> input = MakeMixSamples(rng, target_count);
+                std::vector<s32> expected(target_count);
+                std::vector<s32> result(target_count);
+                ReferenceUpsample(expected, input, target_count, source_sample_count,
+                                  &expected_state);
+                kernel.process_frame(result, input, target_count, source_sample_count, &state);
+
+                const auto [mismatch, _] = std::ranges::mismatch(result, expected);
+                if (mismatch != result.end()) {
+                    const size_t index = static_cast<size_t>(mismatch - result.begin());
+                    return Fail(test, "{} {} -> 240 differs at frame {} sample {}: {} != {}",
+                                kernel.name, source_sample_count, frame, index, *mismatch,
+                                expected[index]);
+                }
+                if (!SameState(state, expected_state)) {
+                    return Fail(test, "{} {} -> 240 state differs after frame {}", kernel.name,
+                                source_sample_count, frame);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void BenchmarkResamplePolyphaseFilters() {
+    // One command list worth of voices: 24 voices of 240 samples from 32K
+    constexpr u32 SampleCount = 240;
+    constexpr u32 VoiceCount = 24;
+    std::mt19937 rng{RandomSeed};
+    const auto ratio = Common::FixedPoint<49, 15>::from_base((1 << 15) * 2 / 3);
+    const std::vector<s16> input = MakeInput(rng, SampleCount + 8);
+    const std::vector<f32> lut4 = MakeLut(rng, 4);
+    const std::vector<f32> lut8 = MakeLut(rng, 8);
+    std::vector<s32> output(SampleCount);
+
+    for (const PolyphaseFilter& filter : AudioCore::Renderer::GetPolyphaseFilters()) {
+        for (const u32 taps : {4U, 8U}) {
+            const PolyphaseFilterFn run = taps == 4 ? filter.four_tap : filter.eight_tap;
+            const std::vector<f32>& lut = taps == 4 ? lut4 : lut8;
+            const std::string name = fmt::format("{} {} tap 24x240", filter.name, taps);
+            Benchmark(name, 2000, [&] {
+                for (u32 voice = 0; voice < VoiceCount; ++voice) {
+                    Common::FixedPoint<49, 15> fraction{0};
+                    run(output, input, lut, ratio, fraction, SampleCount);
+                }
+            });
+        }
+    }
+}
+
+void BenchmarkUpsampleFrames() {
+    // Six channels of 160 -> 240 samples
+    constexpr u32 TargetSampleCount = 240;
+    constexpr u32 ChannelCount = 6;
+    std::mt19937 rng{RandomSeed};
+    const std::vector<s32> input = MakeMixSamples(rng, TargetSampleCount);
+    std::vector<s32> output(TargetSampleCount);
+
+    for (const UpsampleKernel& kernel : AudioCore::Renderer::GetUpsampleKernels()) {
+        std::array<UpsamplerState, ChannelCount> states{};
+        const std::string name = fmt::format("{} 6x160 -> 240", kernel.name);
+        Benchmark(name, 2000, [&] {
+            for (UpsamplerState& state : states) {
+                kernel.process_frame(output, input, TargetSampleCount, 160, &state);
+            }
+        });
+    }
+}
+
+} // namespace Tests
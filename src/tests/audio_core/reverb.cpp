@@ -0,0 +1,587 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "tests/tests.h"
+#include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "yuzu_audio_core/renderer/command/effect/i3dl2_reverb.h"
+#include "yuzu_audio_core/renderer/command/effect/reverb.h"
+
+namespace Tests {
+
+namespace {
+
+using namespace AudioCore;
+using namespace AudioCore::Renderer;
+
+constexpr u32 SampleCount = 240;
+constexpr u32 FrameCount = 24;
+
+// The reverbs as they were before the FixedPoint arithmetic was taken out of their sample loops
+
+Common::FixedPoint<50, 14> ReferenceReverbAllPassTick(ReverbInfo::ReverbDelayLine& decay,
+                                                      ReverbInfo::ReverbDelayLine& fdn,
+                                                      const Common::FixedPoint<50, 14> mix) {
+    const auto val{decay.Read()};
+    const auto mixed{mix - (val * decay.decay)};
+    const auto out{decay.Tick(mixed) + (mixed * decay.decay)};
+
+    fdn.Tick(out);
+    return out;
+}
+
+template <size_t NumChannels>
+void ReferenceReverb(const ReverbInfo::ParameterVersion2& params, ReverbInfo::State& state,
+                     std::span<std::span<const s32>> inputs,
+                     std::span<std::span<s32>> outputs, const u32 sample_count) {
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes1Ch{
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes2Ch{
+        0, 0, 1, 1, 0, 1, 0, 0, 1, 1,
+    };
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes4Ch{
+        0, 0, 1, 1, 0, 1, 2, 2, 3, 3,
+    };
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes6Ch{
+        0, 0, 1, 1, 2, 2, 4, 4, 5, 5,
+    };
+
+    std::span<const u8> tap_indexes{};
+    if constexpr (NumChannels == 1) {
+        tap_indexes = OutTapIndexes1Ch;
+    } else if constexpr (NumChannels == 2) {
+        tap_indexes = OutTapIndexes2Ch;
+    } else if constexpr (NumChannels == 4) {
+        tap_indexes = OutTapIndexes4Ch;
+    } else if constexpr (NumChannels == 6) {
+        tap_indexes = OutTapIndexes6Ch;
+    }
+
+    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
+        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
+
+        for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
+            const auto sample{state.pre_delay_line.TapOut(state.early_delay_times[early_tap]) *
+                              state.early_gains[early_tap]};
+            output_samples[tap_indexes[early_tap]] += sample;
+            if constexpr (NumChannels == 6) {
+                output_samples[static_cast<u32>(Channels::LFE)] += sample;
+            }
+        }
+
+        if constexpr (NumChannels == 6) {
+            output_samples[static_cast<u32>(Channels::LFE)] *= 0.2f;
+        }
+
+        Common::FixedPoint<50, 14> input_sample{};
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            input_sample += inputs[channel][sample_index];
+        }
+
+        input_sample *= 64;
+        input_sample *= Common::FixedPoint<50, 14>::from_base(params.base_gain);
+        state.pre_delay_line.Write(input_sample);
+
+        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
+            state.prev_feedback_output[i] =
+                state.prev_feedback_output[i] * state.hf_decay_prev_gain[i] +
+                state.fdn_delay_lines[i].Read() * state.hf_decay_gain[i];
+        }
+
+        Common::FixedPoint<50, 14> pre_delay_sample{
+            state.pre_delay_line.TapOut(state.pre_delay_time) *
+            Common::FixedPoint<50, 14>::from_base(params.late_gain)};
+
+        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
+            state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
+            -state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+            state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+            state.prev_feedback_output[1] - state.prev_feedback_output[2] + pre_delay_sample,
+        };
+
+        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> allpass_samples{};
+        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
+            allpass_samples[i] = ReferenceReverbAllPassTick(state.decay_delay_lines[i],
+                                                  state.fdn_delay_lines[i], mix_matrix[i]);
+        }
+
+        const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
+        const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
+
+        if constexpr (NumChannels == 6) {
+            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
+                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
+                allpass_samples[3], allpass_samples[2], allpass_samples[3],
+            };
+
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                auto in_sample{inputs[channel][sample_index] * dry_gain};
+
+                Common::FixedPoint<50, 14> allpass{};
+                if (channel == static_cast<u32>(Channels::Center)) {
+                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
+                } else {
+                    allpass = allpass_outputs[channel];
+                }
+
+                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
+                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+            }
+        } else {
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                auto in_sample{inputs[channel][sample_index] * dry_gain};
+                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
+                                64};
+                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+            }
+        }
+    }
+}
+
+constexpr std::array<f32, I3dl2ReverbInfo::MaxDelayTaps> ReferenceEarlyGains{
+    0.67096f, 0.61027f, 1.0f,     0.3568f,  0.68361f, 0.65978f, 0.51939f,
+    0.24712f, 0.45945f, 0.45021f, 0.64196f, 0.54879f, 0.92925f, 0.3827f,
+    0.72867f, 0.69794f, 0.5464f,  0.24563f, 0.45214f, 0.44042f};
+
+Common::FixedPoint<50, 14> ReferenceI3dl2AllPassTick(I3dl2ReverbInfo::I3dl2DelayLine& decay0,
+                                                     I3dl2ReverbInfo::I3dl2DelayLine& decay1,
+                                                     I3dl2ReverbInfo::I3dl2DelayLine& fdn,
+                                                     const Common::FixedPoint<50, 14> mix) {
+    auto val{decay0.Read()};
+    auto mixed{mix - (val * decay0.wet_gain)};
+    auto out{decay0.Tick(mixed) + (mixed * decay0.wet_gain)};
+
+    val = decay1.Read();
+    mixed = out - (val * decay1.wet_gain);
+    out = decay1.Tick(mixed) + (mixed * decay1.wet_gain);
+
+    fdn.Tick(out);
+    return out;
+}
+
+template <size_t NumChannels>
+void ReferenceI3dl2Reverb(I3dl2ReverbInfo::State& state,
+                          std::span<std::span<const s32>> inputs,
+                          std::span<std::span<s32>> outputs, const u32 sample_count) {
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes1Ch{
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes2Ch{
+        0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1,
+    };
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes4Ch{
+        0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0, 3, 3, 3,
+    };
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes6Ch{
+        2, 0, 0, 1, 1, 1, 1, 4, 4, 4, 1, 1, 1, 0, 0, 0, 0, 5, 5, 5,
+    };
+
+    std::span<const u8> tap_indexes{};
+    if constexpr (NumChannels == 1) {
+        tap_indexes = OutTapIndexes1Ch;
+    } else if constexpr (NumChannels == 2) {
+        tap_indexes = OutTapIndexes2Ch;
+    } else if constexpr (NumChannels == 4) {
+        tap_indexes = OutTapIndexes4Ch;
+    } else if constexpr (NumChannels == 6) {
+        tap_indexes = OutTapIndexes6Ch;
+    }
+
+    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
+        Common::FixedPoint<50, 14> early_to_late_tap{
+            state.early_delay_line.TapOut(state.early_to_late_taps)};
+        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
+
+        for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
+            output_samples[tap_indexes[early_tap]] +=
+                state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
+                ReferenceEarlyGains[early_tap];
+            if constexpr (NumChannels == 6) {
+                output_samples[static_cast<u32>(Channels::LFE)] +=
+                    state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
+                    ReferenceEarlyGains[early_tap];
+            }
+        }
+
+        Common::FixedPoint<50, 14> current_sample{};
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            current_sample += inputs[channel][sample_index];
+        }
+
+        state.lowpass_0 =
+            (current_sample * state.lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
+        state.early_delay_line.Tick(state.lowpass_0);
+
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            output_samples[channel] *= state.early_gain;
+        }
+
+        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> filtered_samples{};
+        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+            filtered_samples[delay_line] =
+                state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][0] +
+                state.shelf_filter[delay_line];
+            state.shelf_filter[delay_line] =
+                (filtered_samples[delay_line] * state.lowpass_coeff[delay_line][2] +
+                 state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][1])
+                    .to_float();
+        }
+
+        const std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> mix_matrix{
+            filtered_samples[1] + filtered_samples[2] + early_to_late_tap * state.late_gain,
+            -filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
+            filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
+            filtered_samples[1] - filtered_samples[2] + early_to_late_tap * state.late_gain,
+        };
+
+        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> allpass_samples{};
+        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+            allpass_samples[delay_line] = ReferenceI3dl2AllPassTick(
+                state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
+                state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+        }
+
+        if constexpr (NumChannels == 6) {
+            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
+                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
+                allpass_samples[3], allpass_samples[2], allpass_samples[3],
+            };
+
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                Common::FixedPoint<50, 14> allpass{};
+
+                if (channel == static_cast<u32>(Channels::Center)) {
+                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
+                } else {
+                    allpass = allpass_outputs[channel];
+                }
+
+                auto out_sample{output_samples[channel] + allpass +
+                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+
+                outputs[channel][sample_index] =
+                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+            }
+        } else {
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                auto out_sample{output_samples[channel] + allpass_samples[channel] +
+                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+                outputs[channel][sample_index] =
+                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+            }
+        }
+    }
+}
+void ReferenceReverb(const ReverbInfo::ParameterVersion2& params, ReverbInfo::State& state,
+                     std::span<std::span<const s32>> inputs, std::span<std::span<s32>> outputs) {
+    switch (params.channel_count) {
+    case 1:
+        ReferenceReverb<1>(params, state, inputs, outputs, SampleCount);
+        break;
+    case 2:
+        ReferenceReverb<2>(params, state, inputs, outputs, SampleCount);
+        break;
+    case 4:
+        ReferenceReverb<4>(params, state, inputs, outputs, SampleCount);
+        break;
+    case 6:
+        ReferenceReverb<6>(params, state, inputs, outputs, SampleCount);
+        break;
+    }
+}
+
+void ReferenceI3dl2Reverb(const I3dl2ReverbInfo::ParameterVersion1& params,
+                          I3dl2ReverbInfo::State& state, std::span<std::span<const s32>> inputs,
+                          std::span<std::span<s32>> outputs) {
+    switch (params.channel_count) {
+    case 1:
+        ReferenceI3dl2Reverb<1>(state, inputs, outputs, SampleCount);
+        break;
+    case 2:
+        ReferenceI3dl2Reverb<2>(state, inputs, outputs, SampleCount);
+        break;
+    case 4:
+        ReferenceI3dl2Reverb<4>(state, inputs, outputs, SampleCount);
+        break;
+    case 6:
+        ReferenceI3dl2Reverb<6>(state, inputs, outputs, SampleCount);
+        break;
+    }
+}
+
+/// Random parameters in the ranges games use, in 1.14 fixed point
+ReverbInfo::ParameterVersion2 MakeReverbParameter(std::mt19937& rng, u16 channel_count) {
+    const auto fixed = [&rng](f32 min, f32 max) {
+        return static_cast<s32>(std::uniform_real_distribution<f32>{min, max}(rng) * (1 << 14));
+    };
+    std::uniform_int_distribution<u32> mode{0, ReverbInfo::NumEarlyModes - 1};
+    return {
+        .channel_count_max = channel_count,
+        .channel_count = channel_count,
+        .sample_rate = 48 << 14,
+        .early_mode = mode(rng),
+        .early_gain = fixed(0.0f, 1.0f),
+        .pre_delay = fixed(0.0f, 150.0f),
+        .late_mode = static_cast<s32>(mode(rng)),
+        .late_gain = fixed(0.0f, 1.0f),
+        .decay_time = fixed(0.1f, 20.0f),
+        .high_freq_decay_ratio = fixed(0.1f, 1.0f),
+        .colouration = fixed(0.0f, 1.0f),
+        .base_gain = fixed(0.0f, 1.0f),
+        .wet_gain = fixed(0.0f, 1.0f),
+        .dry_gain = fixed(0.0f, 1.0f),
+        .state = ReverbInfo::ParameterState::Initialized,
+    };
+}
+
+/// Random parameters across the I3DL2 ranges
+I3dl2ReverbInfo::ParameterVersion1 MakeI3dl2Parameter(std::mt19937& rng, u16 channel_count) {
+    const auto real = [&rng](f32 min, f32 max) {
+        return std::uniform_real_distribution<f32>{min, max}(rng);
+    };
+    return {
+        .channel_count_max = channel_count,
+        .channel_count = channel_count,
+        .sample_rate = 48000,
+        .room_HF_gain = real(-10000.0f, 0.0f),
+        .reference_HF = real(20.0f, 20000.0f),
+        .late_reverb_decay_time = real(0.1f, 20.0f),
+        .late_reverb_HF_decay_ratio = real(0.1f, 2.0f),
+        .room_gain = real(-10000.0f, 0.0f),
+        .reflection_gain = real(-10000.0f, 1000.0f),
+        .reverb_gain = real(-10000.0f, 2000.0f),
+        .late_reverb_diffusion = real(0.0f, 100.0f),
+        .reflection_delay = real(0.0f, 0.3f),
+        .late_reverb_delay_time = real(0.0f, 0.1f),
+        .late_reverb_density = real(0.0f, 100.0f),
+        .dry_gain = real(0.0f, 1.0f),
+        .state = I3dl2ReverbInfo::ParameterState::Initialized,
+    };
+}
+
+/// Mix buffer samples in the 24 bit range, with full scale, silent and out of range stretches
+void FillInput(std::mt19937& rng, std::span<s32> samples) {
+    std::uniform_int_distribution<s32> sample{-(1 << 23), (1 << 23) - 1};
+    std::uniform_int_distribution<u32> pick{0, 7};
+    switch (pick(rng)) {
+    case 0:
+        std::ranges::fill(samples, 0);
+        return;
+    case 1:
+        std::ranges::fill(samples, (1 << 23) - 1);
+        return;
+    case 2:
+        for (s32& value : samples) {
+            value = sample(rng) * 64;
+        }
+        return;
+    default:
+        for (s32& value : samples) {
+            value = sample(rng);
+        }
+        return;
+    }
+}
+
+template <typename DelayLine>
+bool SameDelayLine(const DelayLine& a, const DelayLine& b) {
+    return a.input - a.buffer.data() == b.input - b.buffer.data() &&
+           a.output - a.buffer.data() == b.output - b.buffer.data() &&
+           std::ranges::equal(a.buffer, b.buffer, [](const auto& x, const auto& y) {
+               return x.to_raw() == y.to_raw();
+           });
+}
+
+bool SameState(const ReverbInfo::State& a, const ReverbInfo::State& b) {
+    for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
+        if (!SameDelayLine(a.decay_delay_lines[i], b.decay_delay_lines[i]) ||
+            !SameDelayLine(a.fdn_delay_lines[i], b.fdn_delay_lines[i]) ||
+            a.prev_feedback_output[i].to_raw() != b.prev_feedback_output[i].to_raw()) {
+            return false;
+        }
+    }
+    return SameDelayLine(a.pre_delay_line, b.pre_delay_line) &&
+           SameDelayLine(a.center_delay_line, b.center_delay_line);
+}
+
+bool SameState(const I3dl2ReverbInfo::State& a, const I3dl2ReverbInfo::State& b) {
+    for (u32 i = 0; i < I3dl2ReverbInfo::MaxDelayLines; i++) {
+        if (!SameDelayLine(a.fdn_delay_lines[i], b.fdn_delay_lines[i]) ||
+            !SameDelayLine(a.decay_delay_lines0[i], b.decay_delay_lines0[i]) ||
+            !SameDelayLine(a.decay_delay_lines1[i], b.decay_delay_lines1[i]) ||
+            a.shelf_filter[i] != b.shelf_filter[i]) {
+            return false;
+        }
+    }
+    return SameDelayLine(a.early_delay_line, b.early_delay_line) &&
+           SameDelayLine(a.center_delay_line, b.center_delay_line) && a.lowpass_0 == b.lowpass_0;
+}
+
+/**
+ * Runs a reverb command and the reference reverb side by side for a number of frames, changing
+ * the parameters every eight frames, and compares their outputs and states after every frame.
+ * The inputs are the first channel_count mix buffers, the outputs the next channel_count, or
+ * the inputs themselves when processing in place.
+ */
+template <typename Command, typename Info, typename Parameter, typename MakeParameter,
+          typename Reference>
+bool CheckReverbCommand(std::string_view test, std::mt19937& rng, u16 channel_count,
+                        bool in_place, MakeParameter&& make_parameter, Reference&& reference) {
+    using State = typename Info::State;
+    const auto state = std::make_unique<State>();
+    const auto reference_state = std::make_unique<State>();
+
+    Command command{};
+    Command reference_command{};
+    for (Command* target : {&command, &reference_command}) {
+        for (u32 channel = 0; channel < channel_count; channel++) {
+            target->inputs[channel] = static_cast<s16>(channel);
+            target->outputs[channel] =
+                static_cast<s16>(in_place ? channel : channel_count + channel);
+        }
+        target->effect_enabled = true;
+    }
+    command.state = reinterpret_cast<CpuAddr>(state.get());
+    reference_command.state = reinterpret_cast<CpuAddr>(reference_state.get());
+
+    std::vector<s32> mix_buffers(channel_count * 2 * SampleCount);
+    ADSP::AudioRenderer::CommandListProcessor processor{};
+    processor.buffer_count = channel_count * 2;
+
+    Parameter parameter = make_parameter(rng, channel_count);
+    for (u32 frame = 0; frame < FrameCount; ++frame) {
+        if (frame != 0) {
+            if (frame % 8 == 0) {
+                // The sample rate and so the delay line sizes stay as initialized
+                parameter = make_parameter(rng, channel_count);
+                parameter.state = Info::ParameterState::Updating;
+            } else {
+                parameter.state = Info::ParameterState::Updated;
+            }
+        }
+        command.parameter = parameter;
+        reference_command.parameter = parameter;
+
+        // Initialize or update the reference state through the command, without processing
+        processor.mix_buffers = {};
+        processor.sample_count = 0;
+        reference_command.Process(processor);
+
+        FillInput(rng, mix_buffers);
+        std::vector<s32> expected = mix_buffers;
+        std::array<std::span<const s32>, MaxChannels> inputs{};
+        std::array<std::span<s32>, MaxChannels> outputs{};
+        for (u32 channel = 0; channel < channel_count; channel++) {
+            inputs[channel] = std::span<const s32>{expected}.subspan(
+                command.inputs[channel] * SampleCount, SampleCount);
+            outputs[channel] =
+                std::span<s32>{expected}.subspan(command.outputs[channel] * SampleCount,
+                                                 SampleCount);
+        }
+        reference(parameter, *reference_state, inputs, outputs);
+
+        processor.mix_buffers = mix_buffers;
+        processor.sample_count = SampleCount;
+        command.Process(processor);
+
+        const auto [mismatch, _] = std::ranges::mismatch(mix_buffers, expected);
+        if (mismatch != mix_buffers.end()) {
+            const size_t index = static_cast<size_t>(mismatch - mix_buffers.begin());
+            return Fail(test, "{} channels{} differ at frame {} buffer {} sample {}: {} != {}",
+                        channel_count, in_place ? " in place" : "", frame, index / SampleCount,
+                        index % SampleCount, *mismatch, expected[index]);
+        }
+        if (!SameState(*state, *reference_state)) {
+            return Fail(test, "{} channels{} state differs after frame {}", channel_count,
+                        in_place ? " in place" : "", frame);
+        }
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+bool ReverbEffects() {
+    std::mt19937 rng{RandomSeed};
+    for (u32 iteration = 0; iteration < 6; ++iteration) {
+        for (const u16 channel_count : {1, 2, 4, 6}) {
+            const bool in_place = iteration % 2 == 1;
+            const bool passed =
+                CheckReverbCommand<ReverbCommand, ReverbInfo, ReverbInfo::ParameterVersion2>(
+                    "reverb", rng, channel_count, in_place, MakeReverbParameter,
+                    [](const auto& parameter, auto& state, auto inputs, auto outputs) {
+                        ReferenceReverb(parameter, state, inputs, outputs);
+                    }) &&
+                CheckReverbCommand<I3dl2ReverbCommand, I3dl2ReverbInfo,
+                                   I3dl2ReverbInfo::ParameterVersion1>(
+                    "i3dl2_reverb", rng, channel_count, in_place, MakeI3dl2Parameter,
+                    [](const auto& parameter, auto& state, auto inputs, auto outputs) {
+                        ReferenceI3dl2Reverb(parameter, state, inputs, outputs);
+                    });
+            if (!passed) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void BenchmarkReverbEffects() {
+    // Six channels of one 240 sample frame
+    constexpr u16 ChannelCount = 6;
+    std::mt19937 rng{RandomSeed};
+    std::vector<s32> mix_buffers(ChannelCount * 2 * SampleCount);
+    FillInput(rng, mix_buffers);
+    std::array<std::span<const s32>, MaxChannels> inputs{};
+    std::array<std::span<s32>, MaxChannels> outputs{};
+    for (u32 channel = 0; channel < ChannelCount; channel++) {
+        inputs[channel] = std::span<const s32>{mix_buffers}.subspan(channel * SampleCount,
+                                                                    SampleCount);
+        outputs[channel] = std::span<s32>{mix_buffers}.subspan(
+            (ChannelCount + channel) * SampleCount, SampleCount);
+    }
+    ADSP::AudioRenderer::CommandListProcessor processor{};
+    processor.buffer_count = ChannelCount * 2;
+    processor.mix_buffers = mix_buffers;
+    processor.sample_count = SampleCount;
+
+    const auto run = [&]<typename Command>(std::string_view name, Command& command,
+                                           auto& state, auto&& reference) {
+        for (u32 channel = 0; channel < ChannelCount; channel++) {
+            command.inputs[channel] = static_cast<s16>(channel);
+            command.outputs[channel] = static_cast<s16>(ChannelCount + channel);
+        }
+        command.effect_enabled = true;
+        command.state = reinterpret_cast<CpuAddr>(&state);
+        command.Process(processor);
+        command.parameter.state = decltype(command.parameter.state)::Updated;
+        Benchmark(fmt::format("{} reference 6x240", name), 2000,
+                  [&] { reference(command.parameter, state, inputs, outputs); });
+        Benchmark(fmt::format("{} 6x240", name), 2000, [&] { command.Process(processor); });
+    };
+
+    ReverbCommand reverb{};
+    reverb.parameter = MakeReverbParameter(rng, ChannelCount);
+    const auto reverb_state = std::make_unique<ReverbInfo::State>();
+    run("reverb", reverb, *reverb_state,
+        [](const auto& parameter, auto& state, auto inputs, auto outputs) {
+            ReferenceReverb(parameter, state, inputs, outputs);
+        });
+
+    I3dl2ReverbCommand i3dl2{};
+    i3dl2.parameter = MakeI3dl2Parameter(rng, ChannelCount);
+    const auto i3dl2_state = std::make_unique<I3dl2ReverbInfo::State>();
+    run("i3dl2 reverb", i3dl2, *i3dl2_state,
+        [](const auto& parameter, auto& state, auto inputs, auto outputs) {
+            ReferenceI3dl2Reverb(parameter, state, inputs, outputs);
+        });
+}
+
+} // namespace Tests
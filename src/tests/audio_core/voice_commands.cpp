@@ -0,0 +1,299 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "tests/tests.h"
+#include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "yuzu_audio_core/adsp/apps/audio_renderer/voice_command_processor.h"
+#include "yuzu_audio_core/renderer/command/command_list_header.h"
+#include "yuzu_audio_core/renderer/command/mix/mix.h"
+#include "yuzu_audio_core/renderer/command/mix/mix_ramp.h"
+#include "yuzu_audio_core/renderer/command/mix/volume_ramp.h"
+#include "yuzu_common/thread_worker.h"
+
+namespace Tests {
+
+namespace {
+
+using namespace AudioCore::ADSP::AudioRenderer;
+using namespace AudioCore::Renderer;
+
+constexpr u32 SampleCount = 240;
+constexpr u32 WorkerCount = 3;
+
+/// Commands follow each other at their aligned size
+template <typename Command>
+constexpr size_t CommandSize() {
+    constexpr size_t alignment{alignof(std::max_align_t)};
+    return (sizeof(Command) + alignment - 1) / alignment * alignment;
+}
+
+constexpr size_t MaxCommandSize{std::max({CommandSize<VolumeRampCommand>(),
+                                          CommandSize<MixCommand>(),
+                                          CommandSize<MixRampCommand>()})};
+
+/**
+ * The voice section of a command list: per voice, a volume ramp on each of its channel buffers
+ * followed by mixes of them into the mix buffers. Every voice has its own channel buffers, as
+ * they start out the same in every bucket, which the data sources otherwise guarantee.
+ */
+class VoiceList {
+public:
+    VoiceList(std::mt19937& rng, u32 voice_count, s16 mix_buffer_count_)
+        : mix_buffer_count{mix_buffer_count_} {
+        std::uniform_int_distribution<u32> channels{1, 2};
+        std::uniform_int_distribution<u32> mixes{1, 3};
+        std::uniform_int_distribution<s32> output{0, mix_buffer_count - 1};
+        std::uniform_int_distribution<u32> estimate{1, 5000};
+        std::uniform_int_distribution<u32> pick{0, 15};
+        std::uniform_real_distribution<f32> volume{-1.0f, 4.0f};
+        // Out of range gains and samples make the mixes wrap, a silent volume skips them
+        const auto make_volume = [&] { return pick(rng) == 0 ? 0.0f : volume(rng); };
+        const auto add = [&]<typename Command>(Command& command, u32 node_id) {
+            command.magic = CommandMagic;
+            command.enabled = pick(rng) != 0;
+            command.size = static_cast<s16>(CommandSize<Command>());
+            command.estimated_process_time = estimate(rng);
+            command.node_id = node_id;
+        };
+
+        // At most two channels per voice, each with a volume ramp and three mixes
+        storage.resize(voice_count * 2 * 4 * MaxCommandSize / sizeof(std::max_align_t));
+        s16 channel_buffer{mix_buffer_count};
+        previous_samples.resize(voice_count * 2 * 3);
+        size_t previous_sample{};
+        for (u32 voice = 0; voice < voice_count; voice++) {
+            const u32 channel_count{channels(rng)};
+            for (u32 channel = 0; channel < channel_count; channel++) {
+                auto& command{Append<VolumeRampCommand>()};
+                add(command, voice);
+                command.type = CommandId::VolumeRamp;
+                command.precision = pick(rng) < 12 ? 15 : 23;
+                command.input_index = static_cast<s16>(channel_buffer + channel);
+                command.output_index = command.input_index;
+                command.prev_volume = make_volume();
+                command.volume = make_volume();
+            }
+            for (u32 channel = 0; channel < channel_count; channel++) {
+                for (u32 mix = mixes(rng); mix > 0; mix--) {
+                    if (pick(rng) < 8) {
+                        auto& command{Append<MixCommand>()};
+                        add(command, voice);
+                        command.type = CommandId::Mix;
+                        command.precision = pick(rng) < 12 ? 15 : 23;
+                        command.input_index = static_cast<s16>(channel_buffer + channel);
+                        command.output_index = static_cast<s16>(output(rng));
+                        command.volume = make_volume();
+                    } else {
+                        auto& command{Append<MixRampCommand>()};
+                        add(command, voice);
+                        command.type = CommandId::MixRamp;
+                        command.precision = pick(rng) < 12 ? 15 : 23;
+                        command.input_index = static_cast<s16>(channel_buffer + channel);
+                        command.output_index = static_cast<s16>(output(rng));
+                        command.prev_volume = make_volume();
+                        command.volume = make_volume();
+                        auto& depop_sample{previous_samples[previous_sample++]};
+                        command.previous_sample =
+                            reinterpret_cast<AudioCore::CpuAddr>(&depop_sample);
+                    }
+                }
+            }
+            channel_buffer = static_cast<s16>(channel_buffer + channel_count);
+        }
+        buffer_count = channel_buffer;
+
+        header.command_count = static_cast<u32>(commands.size());
+        header.voice_command_count = header.command_count;
+        header.buffer_count = static_cast<s16>(buffer_count);
+        header.mix_buffer_count = mix_buffer_count;
+        header.sample_count = SampleCount;
+        header.sample_rate = 48000;
+    }
+
+    VoiceList(const VoiceList&) = delete;
+    VoiceList& operator=(const VoiceList&) = delete;
+
+    ~VoiceList() {
+        for (auto* command : commands) {
+            std::destroy_at(command);
+        }
+    }
+
+    /// Fill the mix buffers with some mix and random voice channel samples
+    std::vector<s32> MakeMixBuffers(std::mt19937& rng) const {
+        std::uniform_int_distribution<s32> sample;
+        std::vector<s32> mix_buffers(static_cast<size_t>(buffer_count) * SampleCount);
+        const auto voice_samples{std::next(mix_buffers.begin(), mix_buffer_count * SampleCount)};
+        std::generate(mix_buffers.begin(), voice_samples, [&] { return sample(rng) >> 8; });
+        std::generate(voice_samples, mix_buffers.end(), [&] { return sample(rng); });
+        return mix_buffers;
+    }
+
+    /// Process every command in order, the way CommandListProcessor::Process does
+    void ProcessInOrder(std::span<s32> mix_buffers) {
+        CommandListProcessor processor{};
+        processor.mix_buffers = mix_buffers;
+        processor.sample_count = SampleCount;
+        processor.buffer_count = buffer_count;
+        for (auto* command : commands) {
+            if (command->enabled) {
+                command->Process(processor);
+            }
+        }
+    }
+
+    /// Process the commands with the voice command processor, returns the processed count
+    u32 ProcessBuckets(VoiceCommandProcessor& voice_processor, std::span<s32> mix_buffers) {
+        CommandListProcessor processor{};
+        processor.header = &header;
+        processor.commands = Storage();
+        processor.commands_buffer_size = used_size;
+        processor.command_count = header.command_count;
+        processor.mix_buffers = mix_buffers;
+        processor.sample_count = SampleCount;
+        processor.buffer_count = buffer_count;
+        if (!voice_processor.Process(processor) ||
+            processor.commands != Storage() + used_size) {
+            return 0;
+        }
+        return processor.processed_command_count;
+    }
+
+    u32 CommandCount() const {
+        return header.command_count;
+    }
+
+    s16 mix_buffer_count;
+    u32 buffer_count{};
+    std::vector<s32> previous_samples;
+
+private:
+    u8* Storage() {
+        return reinterpret_cast<u8*>(storage.data());
+    }
+
+    /// Construct a command after the previous ones, the commands are contiguous in guest memory
+    template <typename Command>
+    Command& Append() {
+        auto* command{new (Storage() + used_size) Command{}};
+        used_size += CommandSize<Command>();
+        commands.push_back(command);
+        return *command;
+    }
+
+    CommandListHeader header{};
+    std::vector<ICommand*> commands;
+    std::vector<std::max_align_t> storage;
+    size_t used_size{};
+};
+
+/// Processes a list in order and on the voice buckets, and compares the mixes they produce
+class VoiceListCheck {
+public:
+    VoiceListCheck(std::mt19937& rng, u32 voice_count, s16 mix_buffer_count)
+        : list{rng, voice_count, mix_buffer_count}, expected{list.MakeMixBuffers(rng)},
+          actual{expected} {
+        list.ProcessInOrder(expected);
+        expected_previous_samples = list.previous_samples;
+        std::ranges::fill(list.previous_samples, 0);
+    }
+
+    void ProcessBuckets(VoiceCommandProcessor& voice_processor) {
+        processed = list.ProcessBuckets(voice_processor, actual);
+    }
+
+    bool Compare(std::string_view test, u32 session) const {
+        if (processed != list.CommandCount()) {
+            return Fail(test, "session {}: {} of {} commands processed", session, processed,
+                        list.CommandCount());
+        }
+        const size_t mix_size{static_cast<size_t>(list.mix_buffer_count) * SampleCount};
+        const auto mix_end{actual.begin() + static_cast<ptrdiff_t>(mix_size)};
+        const auto [mismatch, expected_sample] =
+            std::mismatch(actual.begin(), mix_end, expected.begin());
+        if (mismatch != mix_end) {
+            const auto index{static_cast<size_t>(mismatch - actual.begin())};
+            return Fail(test, "session {}: mix buffer {} sample {} is {}, expected {}", session,
+                        index / SampleCount, index % SampleCount, *mismatch, *expected_sample);
+        }
+        if (list.previous_samples != expected_previous_samples) {
+            return Fail(test, "session {}: mix ramp depop samples differ", session);
+        }
+        return true;
+    }
+
+private:
+    VoiceList list;
+    std::vector<s32> expected;
+    std::vector<s32> actual;
+    std::vector<s32> expected_previous_samples;
+    u32 processed{};
+};
+
+} // Anonymous namespace
+
+bool VoiceCommands() {
+    std::mt19937 rng{RandomSeed};
+    Common::ThreadWorker workers{WorkerCount, "VoiceCommands"};
+    std::array<VoiceCommandProcessor, 2> voice_processors{};
+    for (auto& voice_processor : voice_processors) {
+        voice_processor.SetWorkers(&workers, WorkerCount);
+    }
+
+    // A single voice has nothing to run in parallel and is left to the in order path
+    {
+        VoiceList list{rng, 1, 2};
+        auto mix_buffers{list.MakeMixBuffers(rng)};
+        if (list.ProcessBuckets(voice_processors[0], mix_buffers) != 0) {
+            return Fail("voice_commands", "a single voice was processed on the buckets");
+        }
+    }
+
+    std::uniform_int_distribution<u32> voice_count{2, 96};
+    std::uniform_int_distribution<s16> mix_buffer_count{1, 24};
+    for (u32 iteration = 0; iteration < 200; ++iteration) {
+        // Two sessions share the worker pool at the same time, as they do in the renderer. The
+        // first iterations have as few voices as can be split, and as many buckets as voices.
+        std::array<std::unique_ptr<VoiceListCheck>, 2> checks;
+        for (auto& check : checks) {
+            const u32 voices{iteration < 4 ? 2 + iteration : voice_count(rng)};
+            check = std::make_unique<VoiceListCheck>(rng, voices, mix_buffer_count(rng));
+        }
+        {
+            std::jthread session{[&] { checks[1]->ProcessBuckets(voice_processors[1]); }};
+            checks[0]->ProcessBuckets(voice_processors[0]);
+        }
+        for (u32 session = 0; session < 2; session++) {
+            if (!checks[session]->Compare("voice_commands", session)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void BenchmarkVoiceCommands() {
+    // 64 voices of one 240 sample frame, mixed into 6 buffers
+    std::mt19937 rng{RandomSeed};
+    VoiceList list{rng, 64, 6};
+    auto mix_buffers{list.MakeMixBuffers(rng)};
+    Common::ThreadWorker workers{WorkerCount, "VoiceCommands"};
+    VoiceCommandProcessor voice_processor;
+    voice_processor.SetWorkers(&workers, WorkerCount);
+
+    Benchmark("in order 64 voices", 2000, [&] { list.ProcessInOrder(mix_buffers); });
+    Benchmark(fmt::format("{} workers 64 voices", WorkerCount), 2000,
+              [&] { list.ProcessBuckets(voice_processor, mix_buffers); });
+}
+
+} // namespace Tests
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <string_view>
+
+#include "tests/tests.h"
+
+namespace {
+
+struct Check {
+    std::string_view name;
+    bool (*run)();
+};
+
+struct Benchmark {
+    std::string_view name;
+    void (*run)();
+};
+
+constexpr std::array checks{
+    Check{"vic_convert_row", &Tests::VicConvertRow},
+    Check{"mix_gain_kernels", &Tests::MixGainKernels},
+    Check{"resample_polyphase_filters", &Tests::ResamplePolyphaseFilters},
+    Check{"upsample_frames", &Tests::UpsampleFrames},
+    Check{"decode_samples", &Tests::DecodeSamples},
+    Check{"reverb_effects", &Tests::ReverbEffects},
+    Check{"voice_commands", &Tests::VoiceCommands},
+};
+
+constexpr std::array benchmarks{
+    Benchmark{"vic_convert_row", &Tests::BenchmarkVicConvertRow},
+    Benchmark{"mix_gain_kernels", &Tests::BenchmarkMixGainKernels},
+    Benchmark{"resample_polyphase_filters", &Tests::BenchmarkResamplePolyphaseFilters},
+    Benchmark{"upsample_frames", &Tests::BenchmarkUpsampleFrames},
+    Benchmark{"decode_samples", &Tests::BenchmarkDecodeSamples},
+    Benchmark{"reverb_effects", &Tests::BenchmarkReverbEffects},
+    Benchmark{"voice_commands", &Tests::BenchmarkVoiceCommands},
+};
+
+} // Anonymous namespace
+
+// Checks the SIMD and reworked kernels against their reference implementations.
+// tests [--benchmark]
+int main(int argc, char** argv) {
+    const bool run_benchmarks = argc > 1 && std::string_view{argv[1]} == "--benchmark";
+
+    size_t num_failed = 0;
+    for (const Check& check : checks) {
+        const bool passed = check.run();
+        fmt::print("{} {}\n", passed ? "[ OK ]" : "[FAIL]", check.name);
+        num_failed += passed ? 0 : 1;
+    }
+    fmt::print("{} of {} checks passed\n", checks.size() - num_failed, checks.size());
+
+    if (run_benchmarks) {
+        for (const Benchmark& benchmark : benchmarks) {
+            fmt::print("{}\n", benchmark.name);
+            benchmark.run();
+        }
+    }
+    return num_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "yuzu_common/common_types.h"
+
+namespace Tests {
+
+/// Seed of every random input, so a failure reproduces on the next run
+constexpr u32 RandomSeed = 0x4e58454d;
+
+/// Prints a failed check, tests return the result and stop at their first failure
+template <typename... Args>
+bool Fail(std::string_view test, fmt::format_string<Args...> format, Args&&... args) {
+    fmt::print("  {}: {}\n", test, fmt::format(format, std::forward<Args>(args)...));
+    return false;
+}
+
+/// Runs func once to warm up, then times the given number of runs and prints the average
+template <typename Func>
+void Benchmark(std::string_view name, u32 iterations, Func&& func) {
+    func();
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        func();
+    }
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    fmt::print("  {:<52} {:>10.2f} us\n", name, elapsed.count() / iterations);
+}
+
+// Checks, each returns false on a mismatch
+bool VicConvertRow();
+bool MixGainKernels();
+bool DecodeSamples();
+bool ReverbEffects();
+bool VoiceCommands();
+bool ResamplePolyphaseFilters();
+bool UpsampleFrames();
+
+// Benchmarks, run with --benchmark
+void BenchmarkVicConvertRow();
+void BenchmarkMixGainKernels();
+void BenchmarkDecodeSamples();
+void BenchmarkReverbEffects();
+void BenchmarkVoiceCommands();
+void BenchmarkResamplePolyphaseFilters();
+void BenchmarkUpsampleFrames();
+
+} // namespace Tests
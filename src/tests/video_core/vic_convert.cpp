@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tests/tests.h"
+#include "yuzu_video_core/host1x/vic_convert.h"
+
+namespace Tests {
+
+namespace {
+
+using Tegra::Host1x::ConvertRowFn;
+using Tegra::Host1x::ConvertRowKernel;
+
+/// One 4:2:0 frame, chroma either planar (u, v) or interleaved (uv)
+struct Frame {
+    u32 width;
+    u32 height;
+    std::vector<u8> y;
+    std::vector<u8> u;
+    std::vector<u8> v;
+    std::vector<u8> uv;
+};
+
+Frame MakeFrame(u32 width, u32 height, std::mt19937& rng) {
+    const u32 chroma_width = (width + 1) / 2;
+    const u32 chroma_height = (height + 1) / 2;
+    Frame frame{width, height};
+    frame.y.resize(static_cast<size_t>(width) * height);
+    frame.u.resize(static_cast<size_t>(chroma_width) * chroma_height);
+    frame.v.resize(frame.u.size());
+    frame.uv.resize(frame.u.size() * 2);
+
+    std::uniform_int_distribution<u32> byte{0, 255};
+    // Random samples, with runs of the extreme values that saturate the intermediate sums
+    constexpr std::array<u8, 6> extremes{0, 16, 128, 235, 240, 255};
+    const auto fill = [&](std::vector<u8>& plane) {
+        for (u8& sample : plane) {
+            sample = byte(rng) < 64 ? extremes[byte(rng) % extremes.size()]
+                                    : static_cast<u8>(byte(rng));
+        }
+    };
+    fill(frame.y);
+    fill(frame.u);
+    fill(frame.v);
+    for (size_t i = 0; i < frame.u.size(); ++i) {
+        frame.uv[i * 2] = frame.u[i];
+        frame.uv[i * 2 + 1] = frame.v[i];
+    }
+    return frame;
+}
+
+void ConvertFrame(ConvertRowFn convert_row, bool interleaved, const Frame& frame, u8* dst,
+                  bool swap_rb) {
+    const u32 chroma_width = (frame.width + 1) / 2;
+    for (u32 row = 0; row < frame.height; ++row) {
+        const size_t chroma_row = static_cast<size_t>(row / 2) * chroma_width;
+        const u8* const y_row = frame.y.data() + static_cast<size_t>(row) * frame.width;
+        u8* const dst_row = dst + static_cast<size_t>(row) * frame.width * 4;
+        if (interleaved) {
+            convert_row(dst_row, y_row, frame.uv.data() + chroma_row * 2, nullptr, frame.width,
+                        swap_rb);
+        } else {
+            convert_row(dst_row, y_row, frame.u.data() + chroma_row,
+                        frame.v.data() + chroma_row, frame.width, swap_rb);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+bool VicConvertRow() {
+    constexpr std::string_view test = "vic_convert_row";
+    const std::span<const ConvertRowKernel> kernels = Tegra::Host1x::GetConvertRowKernels();
+    const ConvertRowKernel& reference = kernels.front();
+
+    std::mt19937 rng{RandomSeed};
+    std::vector<u32> widths(70);
+    std::ranges::generate(widths, [width = 1U]() mutable { return width++; });
+    widths.insert(widths.end(), {127, 1280, 1920});
+
+    std::vector<u8> expected;
+    std::vector<u8> result;
+    for (const u32 width : widths) {
+        const Frame frame = MakeFrame(width, 4, rng);
+        expected.resize(static_cast<size_t>(width) * frame.height * 4);
+        result.resize(expected.size());
+        for (const ConvertRowKernel& kernel : kernels.subspan(1)) {
+            for (const bool interleaved : {false, true}) {
+                for (const bool swap_rb : {false, true}) {
+                    const ConvertRowFn reference_row =
+                        interleaved ? reference.interleaved : reference.planar;
+                    const ConvertRowFn kernel_row =
+                        interleaved ? kernel.interleaved : kernel.planar;
+                    ConvertFrame(reference_row, interleaved, frame, expected.data(), swap_rb);
+                    std::ranges::fill(result, u8{0xcd});
+                    ConvertFrame(kernel_row, interleaved, frame, result.data(), swap_rb);
+                    const auto [mismatch, _] = std::ranges::mismatch(result, expected);
+                    if (mismatch != result.end()) {
+                        return Fail(test,
+                                    "{} differs from scalar at byte {} (width {}, interleaved "
+                                    "{}, swap_rb {})",
+                                    kernel.name, mismatch - result.begin(), width, interleaved,
+                                    swap_rb);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void BenchmarkVicConvertRow() {
+    struct Size {
+        std::string_view name;
+        u32 width;
+        u32 height;
+    };
+    constexpr std::array sizes{Size{"720p", 1280, 720}, Size{"1080p", 1920, 1080}};
+
+    std::mt19937 rng{RandomSeed};
+    for (const Size& size : sizes) {
+        const Frame frame = MakeFrame(size.width, size.height, rng);
+        std::vector<u8> rgba(static_cast<size_t>(size.width) * size.height * 4);
+        for (const ConvertRowKernel& kernel : Tegra::Host1x::GetConvertRowKernels()) {
+            for (const bool interleaved : {true, false}) {
+                const ConvertRowFn convert_row = interleaved ? kernel.interleaved : kernel.planar;
+                const std::string name = fmt::format("{} {} {}", size.name,
+                                                     interleaved ? "NV12" : "YV12", kernel.name);
+                Benchmark(name, 20, [&] {
+                    ConvertFrame(convert_row, interleaved, frame, rgba.data(), false);
+                });
+            }
+        }
+    }
+}
+
+} // namespace Tests
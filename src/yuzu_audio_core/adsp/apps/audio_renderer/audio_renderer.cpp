@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 
@@ -10,6 +11,7 @@
 #include "yuzu_audio_core/sink/sink.h"
 #include "yuzu_common/logging/log.h"
 #include "yuzu_common/microprofile.h"
+#include "yuzu_common/settings.h"
 #include "yuzu_common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -28,6 +30,16 @@ AudioRenderer::~AudioRenderer() {
 void AudioRenderer::Start() {
     CreateSinkStreams();
 
+    const u32 worker_count{Settings::values.audio_renderer_workers.GetValue()};
+    if (worker_count > 0) {
+        session_worker = std::make_unique<Common::ThreadWorker>(1, "DSP_AudioRenderer_Session");
+        voice_workers =
+            std::make_unique<Common::ThreadWorker>(worker_count, "DSP_AudioRenderer_Voice");
+    }
+    for (auto& command_list_processor : command_list_processors) {
+        command_list_processor.SetVoiceWorkers(voice_workers.get(), worker_count);
+    }
+
     mailbox.Initialize(AppMailboxId::AudioRenderer);
 
     main_thread = std::jthread([this](std::stop_token stop_token) { Main(stop_token); });
@@ -54,6 +66,12 @@ void AudioRenderer::Stop() {
     main_thread.request_stop();
     main_thread.join();
 
+    for (auto& command_list_processor : command_list_processors) {
+        command_list_processor.SetVoiceWorkers(nullptr, 0);
+    }
+    session_worker.reset();
+    voice_workers.reset();
+
     for (auto& stream : streams) {
         if (stream) {
             stream->Stop();
@@ -131,9 +149,15 @@ void AudioRenderer::CreateSinkStreams() {
 
 void AudioRenderer::Main(std::stop_token stop_token) {
     static constexpr char name[]{"DSP_AudioRenderer_Main"};
+    // One frame of samples has to be rendered every period
+    static constexpr std::chrono::microseconds frame_period{1'000'000ULL * TargetSampleCount /
+                                                            TargetSampleRate};
     MicroProfileOnThreadCreate(name);
     Common::SetCurrentThreadName(name);
-    Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    if (!Settings::values.audio_realtime_priority.GetValue() ||
+        !Common::SetCurrentThreadRealtime(frame_period, frame_period * 4 / 5)) {
+        Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    }
 
     // TODO: Create buffer map/unmap thread + mailbox
     // TODO: Create gMix devices, initialize them here
@@ -146,9 +170,6 @@ void AudioRenderer::Main(std::stop_token stop_token) {
 
     mailbox.Send(Direction::Host, Message::InitializeOK);
 
-    // 0.12 seconds (2,304,000 / 19,200,000)
-    constexpr u64 max_process_time{2'304'000ULL};
-
     while (!stop_token.stop_requested()) {
         auto msg{mailbox.Receive(Direction::DSP)};
         switch (msg) {
@@ -162,57 +183,43 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                 mailbox.Send(Direction::Host, Message::RenderResponse);
                 continue;
             }
-            std::array<bool, MaxRendererSessions> buffers_reset{};
             std::array<u64, MaxRendererSessions> render_times_taken{};
+            std::array<u64, MaxRendererSessions> work_times{};
             const auto start_time{system.CoreTiming().GetGlobalTimeUs().count()};
 
+            // Sessions of different applets share nothing, render the second one on the session
+            // worker meanwhile. Sessions of the same applet split one time budget, so the second
+            // one needs the time taken by the first and has to wait for it.
+            const bool render_in_parallel{
+                session_worker && command_buffers[0].buffer != 0 &&
+                command_buffers[1].buffer != 0 &&
+                command_buffers[0].applet_resource_user_id !=
+                    command_buffers[1].applet_resource_user_id};
+            if (render_in_parallel) {
+                session_worker->QueueWork([&, stop_token] {
+                    RenderSession(1, start_time, render_times_taken, work_times, stop_token);
+                });
+                RenderSession(0, start_time, render_times_taken, work_times, stop_token);
+                session_worker->WaitForRequests();
+            } else {
+                for (u32 index = 0; index < MaxRendererSessions; index++) {
+                    RenderSession(index, start_time, render_times_taken, work_times, stop_token);
+                }
+            }
+
+            // Only the render work counts against the deadline. Waiting for sink space means the
+            // renderer is ahead, counting it as a miss would grow the queue for no reason.
+            const u64 work_time{render_in_parallel
+                                    ? std::max(work_times[0], work_times[1])
+                                    : work_times[0] + work_times[1]};
+            const bool missed{work_time > static_cast<u64>(frame_period.count())};
+            rendered_frames.fetch_add(1, std::memory_order_relaxed);
+            if (missed) {
+                deadline_misses.fetch_add(1, std::memory_order_relaxed);
+            }
             for (u32 index = 0; index < MaxRendererSessions; index++) {
-                auto& command_buffer{command_buffers[index]};
-                auto& command_list_processor{command_list_processors[index]};
-
-                // Check this buffer is valid, as it may not be used.
-                if (command_buffer.buffer != 0) {
-                    // If there are no remaining commands (from the previous list),
-                    // this is a new command list, initialize it.
-                    if (command_buffer.remaining_command_count == 0) {
-                        command_list_processor.Initialize(system, *command_buffer.process,
-                                                          command_buffer.buffer,
-                                                          command_buffer.size, streams[index]);
-                    }
-
-                    if (command_buffer.reset_buffer && !buffers_reset[index]) {
-                        streams[index]->ClearQueue();
-                        buffers_reset[index] = true;
-                    }
-
-                    u64 max_time{max_process_time};
-                    if (index == 1 && command_buffer.applet_resource_user_id ==
-                                          command_buffers[0].applet_resource_user_id) {
-                        max_time = max_process_time - render_times_taken[0];
-                        if (render_times_taken[0] > max_process_time) {
-                            max_time = 0;
-                        }
-                    }
-
-                    max_time = std::min(command_buffer.time_limit, max_time);
-                    command_list_processor.SetProcessTimeMax(max_time);
-
-                    if (index == 0) {
-                        streams[index]->WaitFreeSpace(stop_token);
-                    }
-
-                    // Process the command list
-                    {
-                        MICROPROFILE_SCOPE(Audio_Renderer);
-                        render_times_taken[index] =
-                            command_list_processor.Process(index) - start_time;
-                    }
-
-                    const auto end_time{system.CoreTiming().GetGlobalTimeUs().count()};
-
-                    command_buffer.remaining_command_count =
-                        command_list_processor.GetRemainingCommandCount();
-                    command_buffer.render_time_taken_us = end_time - start_time;
+                if (command_buffers[index].buffer != 0) {
+                    streams[index]->RecordRenderDeadline(missed);
                 }
             }
 
@@ -227,4 +234,60 @@ void AudioRenderer::Main(std::stop_token stop_token) {
     }
 }
 
+void AudioRenderer::RenderSession(u32 index, u64 start_time,
+                                  std::array<u64, MaxRendererSessions>& render_times_taken,
+                                  std::array<u64, MaxRendererSessions>& work_times,
+                                  std::stop_token stop_token) {
+    // 0.12 seconds (2,304,000 / 19,200,000)
+    constexpr u64 max_process_time{2'304'000ULL};
+
+    auto& command_buffer{command_buffers[index]};
+    auto& command_list_processor{command_list_processors[index]};
+
+    // Check this buffer is valid, as it may not be used.
+    if (command_buffer.buffer == 0) {
+        return;
+    }
+
+    // If there are no remaining commands (from the previous list),
+    // this is a new command list, initialize it.
+    if (command_buffer.remaining_command_count == 0) {
+        command_list_processor.Initialize(system, *command_buffer.process, command_buffer.buffer,
+                                          command_buffer.size, streams[index]);
+    }
+
+    if (command_buffer.reset_buffer) {
+        streams[index]->ClearQueue();
+    }
+
+    u64 max_time{max_process_time};
+    if (index == 1 &&
+        command_buffer.applet_resource_user_id == command_buffers[0].applet_resource_user_id) {
+        max_time = max_process_time - render_times_taken[0];
+        if (render_times_taken[0] > max_process_time) {
+            max_time = 0;
+        }
+    }
+
+    max_time = std::min(command_buffer.time_limit, max_time);
+    command_list_processor.SetProcessTimeMax(max_time);
+
+    if (index == 0) {
+        streams[index]->WaitFreeSpace(stop_token);
+    }
+
+    // Process the command list
+    const auto work_start_time{system.CoreTiming().GetGlobalTimeUs().count()};
+    {
+        MICROPROFILE_SCOPE(Audio_Renderer);
+        render_times_taken[index] = command_list_processor.Process(index) - start_time;
+    }
+
+    const auto end_time{system.CoreTiming().GetGlobalTimeUs().count()};
+    work_times[index] = end_time - work_start_time;
+
+    command_buffer.remaining_command_count = command_list_processor.GetRemainingCommandCount();
+    command_buffer.render_time_taken_us = end_time - start_time;
+}
+
 } // namespace AudioCore::ADSP::AudioRenderer
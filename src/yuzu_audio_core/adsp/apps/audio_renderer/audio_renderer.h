@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -14,6 +15,7 @@
 #include "yuzu_common/polyfill_thread.h"
 #include "yuzu_common/reader_writer_queue.h"
 #include "yuzu_common/thread.h"
+#include "yuzu_common/thread_worker.h"
 
 namespace Core {
 class System;
@@ -79,6 +81,24 @@ public:
     void ClearRemainCommandCount(s32 session_id) noexcept;
     u64 GetRenderingStartTick(s32 session_id) const noexcept;
 
+    /**
+     * Get the number of frames rendered since the AudioRenderer started.
+     *
+     * @return The number of frames.
+     */
+    u64 GetRenderedFrameCount() const noexcept {
+        return rendered_frames.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the number of rendered frames which took longer than one frame period to render.
+     *
+     * @return The number of missed deadlines.
+     */
+    u64 GetDeadlineMissCount() const noexcept {
+        return deadline_misses.load(std::memory_order_relaxed);
+    }
+
 private:
     /**
      * Main AudioRenderer thread, responsible for processing the command lists.
@@ -92,6 +112,21 @@ private:
 
     void PostDSPClearCommandBuffer() noexcept;
 
+    /**
+     * Render one session's command list.
+     *
+     * @param index              - Session index.
+     * @param start_time         - Time the render was started, in microseconds.
+     * @param render_times_taken - Render times of the sessions, updated for this session.
+     * @param work_times         - Time spent processing the command list of the sessions,
+     *                             excluding waits for sink space, updated for this session.
+     * @param stop_token         - Stop token of the main thread.
+     */
+    void RenderSession(u32 index, u64 start_time,
+                       std::array<u64, MaxRendererSessions>& render_times_taken,
+                       std::array<u64, MaxRendererSessions>& work_times,
+                       std::stop_token stop_token);
+
     /// Core system
     Core::System& system;
     /// The output sink the AudioRenderer will send samples to
@@ -110,6 +145,13 @@ private:
     std::array<Sink::SinkStream*, MaxRendererSessions> streams{};
     /// CPU Tick when the DSP was signalled to process, uses time rather than tick
     u64 signalled_tick{0};
+    /// Worker rendering a second session alongside the main thread
+    std::unique_ptr<Common::ThreadWorker> session_worker{};
+    /// Workers shared by the command list processors for the voice command chains
+    std::unique_ptr<Common::ThreadWorker> voice_workers{};
+    /// Frames rendered, and how many of them overran the frame period
+    std::atomic<u64> rendered_frames{};
+    std::atomic<u64> deadline_misses{};
 };
 
 } // namespace ADSP::AudioRenderer
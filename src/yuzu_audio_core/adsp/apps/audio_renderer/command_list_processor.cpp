@@ -4,6 +4,7 @@
 #include <string>
 
 #include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "yuzu_audio_core/renderer/capture/update_capture.h"
 #include "yuzu_audio_core/renderer/command/command_list_header.h"
 #include "yuzu_audio_core/renderer/command/commands.h"
 #include "yuzu_common/settings.h"
@@ -27,6 +28,7 @@ void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& p
     target_sample_rate = header->sample_rate;
     mix_buffers = header->samples_buffer;
     buffer_count = header->buffer_count;
+    capture = header->capture;
     processed_command_count = 0;
 }
 
@@ -42,9 +44,14 @@ Sink::SinkStream* CommandListProcessor::GetOutputSinkStream() const {
     return stream;
 }
 
+void CommandListProcessor::SetVoiceWorkers(Common::ThreadWorker* workers, u32 worker_count) {
+    voice_command_processor.SetWorkers(workers, worker_count);
+}
+
 u64 CommandListProcessor::Process(u32 session_id) {
     const auto start_time_{system->CoreTiming().GetGlobalTimeUs().count()};
     const auto command_base{CpuAddr(commands)};
+    time_commands = Settings::values.audio_command_timing.GetValue();
 
     if (processed_command_count > 0) {
         current_processing_time += start_time_ - end_time;
@@ -55,7 +62,11 @@ u64 CommandListProcessor::Process(u32 session_id) {
 
     std::string dump{fmt::format("\nSession {}\n", session_id)};
 
-    for (u32 index = 0; index < command_count; index++) {
+    if (!Settings::values.dump_audio_commands) {
+        voice_command_processor.Process(*this);
+    }
+
+    for (u32 index = processed_command_count; index < command_count; index++) {
         auto& command{*reinterpret_cast<Renderer::ICommand*>(commands)};
 
         if (command.magic != 0xCAFEBABE) {
@@ -83,7 +94,7 @@ u64 CommandListProcessor::Process(u32 session_id) {
         }
 
         if (command.enabled) {
-            command.Process(*this);
+            ProcessCommand(command);
         } else {
             dump += fmt::format("\tDisabled!\n");
         }
@@ -98,7 +109,41 @@ u64 CommandListProcessor::Process(u32 session_id) {
     }
 
     end_time = system->CoreTiming().GetGlobalTimeUs().count();
+
+    if (capture != nullptr && processed_command_count == command_count) {
+        capture->WriteProcessed();
+    }
+
+    if (time_commands) {
+        timed_lists_us += end_time - start_time_;
+        if (++timed_lists >= 1000) {
+            ReportCommandTimings();
+        }
+    }
+
     return end_time - start_time_;
 }
 
+void CommandListProcessor::ReportCommandTimings() {
+    LOG_INFO(Service_Audio, "Command timings over the last {} command lists, {:.1f} us per list:",
+             timed_lists, static_cast<f64>(timed_lists_us) / static_cast<f64>(timed_lists));
+    for (size_t type = 0; type < CommandIdCount; type++) {
+        const auto& timing{command_timings[type]};
+        if (timing.count == 0) {
+            continue;
+        }
+        const auto count{static_cast<f64>(timing.count)};
+        const auto estimated{static_cast<f64>(timing.estimated_time)};
+        LOG_INFO(Service_Audio,
+                 "\tcommand {:02X}: count {}, average {:.0f} ns, estimated {:.0f}, {:.3f} ns per "
+                 "estimated unit",
+                 type, timing.count, static_cast<f64>(timing.elapsed_ns) / count,
+                 estimated / count,
+                 estimated > 0.0 ? static_cast<f64>(timing.elapsed_ns) / estimated : 0.0);
+    }
+    command_timings = {};
+    timed_lists = 0;
+    timed_lists_us = 0;
+}
+
 } // namespace AudioCore::ADSP::AudioRenderer
@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <span>
+#include <string>
 
+#include "yuzu_audio_core/adsp/apps/audio_renderer/voice_command_processor.h"
 #include "yuzu_audio_core/common/common.h"
 #include "yuzu_audio_core/renderer/command/command_list_header.h"
+#include "yuzu_audio_core/renderer/command/icommand.h"
 #include "yuzu_common/common_types.h"
+#include "yuzu_common/thread_worker.h"
 
 namespace Core {
 namespace Memory {
@@ -27,7 +33,8 @@ class SinkStream;
 
 namespace Renderer {
 struct CommandListHeader;
-}
+class UpdateCapture;
+} // namespace Renderer
 
 namespace ADSP::AudioRenderer {
 
@@ -68,6 +75,14 @@ public:
      */
     Sink::SinkStream* GetOutputSinkStream() const;
 
+    /**
+     * Set the worker pool used to process the voice command chains in parallel.
+     *
+     * @param workers      - The worker pool, or nullptr to process every command in order.
+     * @param worker_count - Number of threads in the pool.
+     */
+    void SetVoiceWorkers(Common::ThreadWorker* workers, u32 worker_count);
+
     /**
      * Process the command list.
      *
@@ -77,6 +92,41 @@ public:
      */
     u64 Process(u32 session_id);
 
+    /**
+     * Process one command, measuring it if enabled.
+     *
+     * @param command - The command to process.
+     */
+    void ProcessCommand(Renderer::ICommand& command) {
+        const auto type{static_cast<size_t>(command.type)};
+        if (!time_commands || type >= CommandIdCount) {
+            command.Process(*this);
+            return;
+        }
+
+        const auto start{std::chrono::steady_clock::now()};
+        command.Process(*this);
+        const auto elapsed{std::chrono::steady_clock::now() - start};
+
+        auto& timing{command_timings[type]};
+        timing.count++;
+        timing.elapsed_ns += static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        timing.estimated_time += command.estimated_process_time;
+    }
+
+    /// Host time measured for one command type, next to the estimator's figure for it
+    struct CommandTiming {
+        /// Number of commands processed
+        u64 count;
+        /// Host time taken by those commands, in nanoseconds
+        u64 elapsed_ns;
+        /// Sum of the estimated processing times of those commands
+        u64 estimated_time;
+    };
+
+    static constexpr size_t CommandIdCount{static_cast<size_t>(Renderer::CommandId::Compressor) + 1};
+
     /// Core system
     Core::System* system{};
     /// Core memory
@@ -85,6 +135,8 @@ public:
     Sink::SinkStream* stream{};
     /// Header info for this command list
     Renderer::CommandListHeader* header{};
+    /// Capture the guest memory read by the commands is recorded to, null when not capturing
+    Renderer::UpdateCapture* capture{};
     /// The command buffer
     u8* commands{};
     /// The command buffer size
@@ -111,6 +163,21 @@ public:
     u64 end_time{};
     /// Last command list string generated, used for dumping audio commands to console
     std::string last_dump{};
+    /// Whether command processing times are measured, see audio_command_timing
+    bool time_commands{};
+    /// Measured command processing times, indexed by CommandId
+    std::array<CommandTiming, CommandIdCount> command_timings{};
+    /// Number of command lists processed since the timings were last reported
+    u32 timed_lists{};
+    /// Time spent processing those command lists, in microseconds
+    u64 timed_lists_us{};
+
+private:
+    /// Log and reset the measured command timings
+    void ReportCommandTimings();
+
+    /// Processes the voice commands on the voice workers
+    VoiceCommandProcessor voice_command_processor{};
 };
 
 } // namespace ADSP::AudioRenderer
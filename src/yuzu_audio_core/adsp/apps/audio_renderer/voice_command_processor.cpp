@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "yuzu_audio_core/adsp/apps/audio_renderer/voice_command_processor.h"
+#include "yuzu_audio_core/renderer/command/command_list_header.h"
+#include "yuzu_audio_core/renderer/command/icommand.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+VoiceCommandProcessor::VoiceCommandProcessor() = default;
+
+VoiceCommandProcessor::~VoiceCommandProcessor() = default;
+
+void VoiceCommandProcessor::SetWorkers(Common::ThreadWorker* workers_, u32 worker_count_) {
+    workers = workers_;
+    worker_count = workers_ != nullptr ? worker_count_ : 0;
+}
+
+bool VoiceCommandProcessor::Process(CommandListProcessor& list) {
+    using Renderer::CommandId;
+
+    const auto voice_command_count{list.header->voice_command_count};
+    if (worker_count == 0 || list.processed_command_count != 0 ||
+        voice_command_count > list.command_count) {
+        return false;
+    }
+
+    // Split the voice commands into chains, checking them the same way the in order path does.
+    // Anything unexpected leaves the whole list to that path, which reports it.
+    voice_commands.clear();
+    leading_commands.clear();
+    voice_chains.clear();
+
+    const auto command_base{CpuAddr(list.commands)};
+    auto command_ptr{list.commands};
+    for (u32 index = 0; index < voice_command_count; index++) {
+        auto& command{*reinterpret_cast<Renderer::ICommand*>(command_ptr)};
+        const auto offset{CpuAddr(command_ptr) - command_base};
+        if (command.magic != Renderer::CommandMagic || command.size <= 0 ||
+            offset + command.size > list.commands_buffer_size || !command.Verify(list)) {
+            return false;
+        }
+        command_ptr += command.size;
+
+        switch (command.type) {
+        case CommandId::ClearMixBuffer:
+            if (!voice_commands.empty()) {
+                return false;
+            }
+            leading_commands.push_back(&command);
+            continue;
+        case CommandId::DepopPrepare:
+            // Only reads and resets its own voice state and adds into the depop buffer, so it
+            // can run ahead of every chain.
+            leading_commands.push_back(&command);
+            continue;
+        case CommandId::DataSourcePcmInt16Version1:
+        case CommandId::DataSourcePcmInt16Version2:
+        case CommandId::DataSourcePcmFloatVersion1:
+        case CommandId::DataSourcePcmFloatVersion2:
+        case CommandId::DataSourceAdpcmVersion1:
+        case CommandId::DataSourceAdpcmVersion2:
+        case CommandId::VolumeRamp:
+        case CommandId::BiquadFilter:
+        case CommandId::MultiTapBiquadFilter:
+        case CommandId::Mix:
+        case CommandId::MixRamp:
+        case CommandId::MixRampGrouped:
+        case CommandId::Performance:
+            break;
+        default:
+            return false;
+        }
+
+        const auto position{static_cast<u32>(voice_commands.size())};
+        if (voice_chains.empty() ||
+            voice_commands[voice_chains.back().begin]->node_id != command.node_id) {
+            voice_chains.push_back({.begin = position, .end = position, .bucket = 0});
+        }
+        voice_commands.push_back(&command);
+        voice_chains.back().end = position + 1;
+    }
+
+    if (voice_chains.size() < 2) {
+        return false;
+    }
+
+    // Balance the buckets by the estimated processing time of their chains
+    std::array<u64, 16> bucket_loads{};
+    const auto bucket_count{std::min<u32>({worker_count + 1,
+                                           static_cast<u32>(voice_chains.size()),
+                                           static_cast<u32>(bucket_loads.size())})};
+    for (auto& chain : voice_chains) {
+        u64 chain_load{1};
+        for (u32 i = chain.begin; i < chain.end; i++) {
+            chain_load += voice_commands[i]->estimated_process_time;
+        }
+        const auto lightest{std::min_element(bucket_loads.begin(),
+                                             bucket_loads.begin() + bucket_count)};
+        chain.bucket = static_cast<u32>(lightest - bucket_loads.begin());
+        *lightest += chain_load;
+    }
+
+    const size_t buffer_size{static_cast<size_t>(list.buffer_count) * list.sample_count};
+    const auto mix_buffer_count{std::min(
+        static_cast<u32>(std::max<s16>(list.header->mix_buffer_count, 0)), list.buffer_count)};
+    const size_t mix_size{static_cast<size_t>(mix_buffer_count) * list.sample_count};
+    if (list.mix_buffers.size() < buffer_size) {
+        return false;
+    }
+
+    for (auto* command : leading_commands) {
+        if (command->enabled) {
+            list.ProcessCommand(*command);
+        }
+    }
+
+    // The mix buffers of the buckets start out silent, the voice channel buffers after them
+    // start out as the list's, as they would be for the first voice on the in order path.
+    if (bucket_mix_buffers.size() < buffer_size * bucket_count) {
+        bucket_mix_buffers.resize(buffer_size * bucket_count);
+    }
+    while (bucket_processors.size() < bucket_count) {
+        bucket_processors.push_back(std::make_unique<CommandListProcessor>());
+    }
+    for (u32 bucket = 0; bucket < bucket_count; bucket++) {
+        auto& processor{*bucket_processors[bucket]};
+        processor.system = list.system;
+        processor.memory = list.memory;
+        processor.stream = list.stream;
+        processor.header = list.header;
+        processor.capture = list.capture;
+        processor.commands_buffer_size = list.commands_buffer_size;
+        processor.command_count = list.command_count;
+        processor.sample_count = list.sample_count;
+        processor.target_sample_rate = list.target_sample_rate;
+        processor.mix_buffers = std::span<s32>(bucket_mix_buffers).subspan(bucket * buffer_size,
+                                                                          buffer_size);
+        processor.buffer_count = list.buffer_count;
+        processor.start_time = list.start_time;
+        processor.current_processing_time = list.current_processing_time;
+        processor.time_commands = list.time_commands;
+        std::fill_n(processor.mix_buffers.begin(), mix_size, 0);
+        std::copy(list.mix_buffers.begin() + mix_size, list.mix_buffers.begin() + buffer_size,
+                  processor.mix_buffers.begin() + mix_size);
+    }
+
+    // Buckets are taken by whoever gets to them first, the calling thread included. Once it
+    // finds none left, every bucket is running, so it only ever waits for this list's work and
+    // never for jobs of other lists queued ahead in the shared pool.
+    const auto latch{std::make_shared<BucketLatch>()};
+    latch->bucket_count = bucket_count;
+    for (u32 bucket = 1; bucket < bucket_count; bucket++) {
+        workers->QueueWork([this, latch] { ProcessBuckets(*latch); });
+    }
+    ProcessBuckets(*latch);
+    for (auto finished{latch->finished_buckets.load()}; finished != bucket_count;
+         finished = latch->finished_buckets.load()) {
+        latch->finished_buckets.wait(finished);
+    }
+
+    for (u32 bucket = 0; bucket < bucket_count; bucket++) {
+        auto& processor{*bucket_processors[bucket]};
+        for (size_t i = 0; i < mix_size; i++) {
+            list.mix_buffers[i] = static_cast<s32>(static_cast<u32>(list.mix_buffers[i]) +
+                                                   static_cast<u32>(processor.mix_buffers[i]));
+        }
+        if (list.time_commands) {
+            for (size_t type = 0; type < CommandListProcessor::CommandIdCount; type++) {
+                auto& timing{list.command_timings[type]};
+                auto& bucket_timing{processor.command_timings[type]};
+                timing.count += bucket_timing.count;
+                timing.elapsed_ns += bucket_timing.elapsed_ns;
+                timing.estimated_time += bucket_timing.estimated_time;
+                bucket_timing = {};
+            }
+        }
+    }
+
+    list.commands = command_ptr;
+    list.processed_command_count = voice_command_count;
+    return true;
+}
+
+void VoiceCommandProcessor::ProcessBuckets(BucketLatch& latch) {
+    for (auto bucket{latch.next_bucket.fetch_add(1)}; bucket < latch.bucket_count;
+         bucket = latch.next_bucket.fetch_add(1)) {
+        ProcessBucket(bucket);
+        if (latch.finished_buckets.fetch_add(1) + 1 == latch.bucket_count) {
+            latch.finished_buckets.notify_all();
+        }
+    }
+}
+
+void VoiceCommandProcessor::ProcessBucket(u32 bucket) {
+    auto& processor{*bucket_processors[bucket]};
+    for (const auto& chain : voice_chains) {
+        if (chain.bucket != bucket) {
+            continue;
+        }
+        for (u32 i = chain.begin; i < chain.end; i++) {
+            if (voice_commands[i]->enabled) {
+                processor.ProcessCommand(*voice_commands[i]);
+            }
+        }
+    }
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "yuzu_common/common_types.h"
+#include "yuzu_common/thread_worker.h"
+
+namespace AudioCore {
+namespace Renderer {
+struct ICommand;
+}
+
+namespace ADSP::AudioRenderer {
+class CommandListProcessor;
+
+/**
+ * Processes the voice commands at the start of a command list, running independent voice chains
+ * on a worker pool. Each bucket of chains mixes into its own copy of the mix buffers, which are
+ * summed into the real ones afterwards. Mixing only ever adds with wrap around, so the result is
+ * bit exact with processing the commands in order.
+ */
+class VoiceCommandProcessor {
+public:
+    VoiceCommandProcessor();
+    ~VoiceCommandProcessor();
+
+    /**
+     * Set the worker pool used to process the voice chains.
+     *
+     * @param workers      - The worker pool, or nullptr to leave every list to the in order path.
+     * @param worker_count - Number of threads in the pool.
+     */
+    void SetWorkers(Common::ThreadWorker* workers, u32 worker_count);
+
+    /**
+     * Process the voice commands of a command list which has not processed any command yet.
+     * On success the list is advanced past them.
+     *
+     * @param list - The command list to process the voice commands of.
+     * @return True if the voice commands were processed, false if they were left untouched for
+     *         the in order path.
+     */
+    bool Process(CommandListProcessor& list);
+
+private:
+    /// A run of consecutive voice commands sharing a node id
+    struct VoiceChain {
+        /// First command of the chain in voice_commands
+        u32 begin;
+        /// One past the last command of the chain in voice_commands
+        u32 end;
+        /// Bucket the chain runs in
+        u32 bucket;
+    };
+
+    /**
+     * Buckets of one command list. The queued jobs share it, so a job which only starts after
+     * the list finished finds every bucket taken and returns without touching the processor.
+     */
+    struct BucketLatch {
+        /// Number of buckets of the list
+        u32 bucket_count;
+        /// Next bucket to be taken
+        std::atomic<u32> next_bucket;
+        /// Number of buckets processed
+        std::atomic<u32> finished_buckets;
+    };
+
+    /**
+     * Take and process buckets of a list until none are left.
+     *
+     * @param latch - Buckets of the list.
+     */
+    void ProcessBuckets(BucketLatch& latch);
+
+    /**
+     * Process the chains assigned to a bucket, with that bucket's processor.
+     *
+     * @param bucket - Index of the bucket.
+     */
+    void ProcessBucket(u32 bucket);
+
+    /// Workers used for the voice chains, nullptr when disabled
+    Common::ThreadWorker* workers{};
+    /// Number of threads in workers
+    u32 worker_count{};
+    /// Voice commands of the current list, except the leading ones, in list order
+    std::vector<Renderer::ICommand*> voice_commands{};
+    /// Commands run in order before the voice chains
+    std::vector<Renderer::ICommand*> leading_commands{};
+    /// Voice chains of the current list
+    std::vector<VoiceChain> voice_chains{};
+    /// Per bucket processors, mixing into bucket_mix_buffers
+    std::vector<std::unique_ptr<CommandListProcessor>> bucket_processors{};
+    /// Mix buffer copies of the buckets
+    std::vector<s32> bucket_mix_buffers{};
+};
+
+} // namespace ADSP::AudioRenderer
+} // namespace AudioCore
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 
@@ -36,6 +37,46 @@ bool IsValidMultiStreamStreamCounts(s32 total_stream_count, s32 stereo_stream_co
 }
 } // namespace
 
+template <typename DecodeObject>
+void OpusDecoder::DecodeBatch() {
+    auto batch_start_time = system.CoreTiming().GetGlobalTimeUs();
+
+    auto buffer = shared_memory->host_send_data[0];
+    auto packet_count = std::min<u64>(shared_memory->host_send_data[1], MaxBatchPackets);
+    auto reset_requested = shared_memory->host_send_data[2];
+
+    // The decode object is looked up once for the whole batch, rather than once per packet
+    auto& decoder_object = DecodeObject::Initialize(buffer, buffer);
+    s32 error_code{OPUS_OK};
+    if (reset_requested) {
+        error_code = decoder_object.ResetDecoder();
+    }
+
+    u64 decoded_packets{0};
+    for (; error_code == OPUS_OK && decoded_packets < packet_count; decoded_packets++) {
+        auto& packet = shared_memory->batch_packets[decoded_packets];
+        auto start_time = system.CoreTiming().GetGlobalTimeUs();
+
+        u32 decoded_samples{0};
+        error_code = decoder_object.Decode(decoded_samples, packet.output_data,
+                                           packet.output_data_size, packet.input_data,
+                                           packet.input_data_size);
+
+        auto end_time = system.CoreTiming().GetGlobalTimeUs();
+        packet.error_code = error_code;
+        packet.sample_count = decoded_samples;
+        packet.time_taken = (end_time - start_time).count();
+        if (error_code != OPUS_OK) {
+            break;
+        }
+    }
+
+    auto batch_end_time = system.CoreTiming().GetGlobalTimeUs();
+    shared_memory->dsp_return_data[0] = error_code;
+    shared_memory->dsp_return_data[1] = decoded_packets;
+    shared_memory->dsp_return_data[2] = (batch_end_time - batch_start_time).count();
+}
+
 OpusDecoder::OpusDecoder(Core::System& system_) : system{system_} {
     init_thread = std::jthread([this](std::stop_token stop_token) { Init(stop_token); });
 }
@@ -259,6 +300,16 @@ void OpusDecoder::Main(std::stop_token stop_token) {
             Send(Direction::Host, Message::DecodeInterleavedForMultiStreamOK);
         } break;
 
+        case DecodeInterleavedBatch: {
+            DecodeBatch<OpusDecodeObject>();
+            Send(Direction::Host, Message::DecodeInterleavedBatchOK);
+        } break;
+
+        case DecodeInterleavedForMultiStreamBatch: {
+            DecodeBatch<OpusMultiStreamDecodeObject>();
+            Send(Direction::Host, Message::DecodeInterleavedForMultiStreamBatchOK);
+        } break;
+
         default:
             LOG_ERROR(Service_Audio, "Invalid OpusDecoder command {}", msg);
             continue;
@@ -32,6 +32,8 @@ enum Message : u32 {
     InitializeMultiStreamDecodeObject = 28,
     ShutdownMultiStreamDecodeObject = 29,
     DecodeInterleavedForMultiStream = 30,
+    DecodeInterleavedBatch = 31,
+    DecodeInterleavedForMultiStreamBatch = 32,
 
     GetWorkBufferSizeOK = 41,
     InitializeDecodeObjectOK = 42,
@@ -43,6 +45,8 @@ enum Message : u32 {
     InitializeMultiStreamDecodeObjectOK = 48,
     ShutdownMultiStreamDecodeObjectOK = 49,
     DecodeInterleavedForMultiStreamOK = 50,
+    DecodeInterleavedBatchOK = 51,
+    DecodeInterleavedForMultiStreamBatchOK = 52,
 };
 
 /**
@@ -73,6 +77,14 @@ private:
      * Main OpusDecoder thread, responsible for processing the incoming Opus packets.
      */
     void Main(std::stop_token stop_token);
+    /**
+     * Decode the packets of a batched decode message with the decode object in buffer, stopping
+     * at the first packet which fails.
+     *
+     * @tparam DecodeObject - OpusDecodeObject or OpusMultiStreamDecodeObject.
+     */
+    template <typename DecodeObject>
+    void DecodeBatch();
 
     /// Core system
     Core::System& system;
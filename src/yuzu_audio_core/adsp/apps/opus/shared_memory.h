@@ -8,10 +8,29 @@
 
 namespace AudioCore::ADSP::OpusDecoder {
 
+/// Maximum number of packets decoded by a single batched decode message
+constexpr size_t MaxBatchPackets = 32;
+
+/**
+ * One packet of a batched decode. The host fills in the input and output, the OpusDecoder writes
+ * back the result of decoding the packet.
+ */
+struct BatchPacket {
+    u64 input_data;
+    u64 input_data_size;
+    u64 output_data;
+    u64 output_data_size;
+    s32 error_code;
+    u32 sample_count;
+    /// Time taken to decode this packet, in microseconds
+    u64 time_taken;
+};
+
 struct SharedMemory {
     std::array<u8, 0x100> channel_mapping{};
     std::array<u64, 16> host_send_data{};
     std::array<u64, 16> dsp_return_data{};
+    std::array<BatchPacket, MaxBatchPackets> batch_packets{};
 };
 
 } // namespace AudioCore::ADSP::OpusDecoder
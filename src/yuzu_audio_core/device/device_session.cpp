@@ -108,8 +108,12 @@ void DeviceSession::AppendBuffers(std::span<const AudioBuffer> buffers) {
 
 void DeviceSession::ReleaseBuffer(const AudioBuffer& buffer) const {
     if (type == Sink::StreamType::In) {
-        auto samples{stream->ReleaseBuffer(buffer.size / sizeof(s16))};
-        handle->GetMemory().WriteBlockUnsafe(buffer.samples, samples.data(), buffer.size);
+        // Recorded samples go straight to guest memory when it is contiguous
+        release_samples.resize_destructive(buffer.size / sizeof(s16));
+        Core::Memory::CpuGuestMemoryScoped<s16, Core::Memory::GuestMemoryFlags::UnsafeWrite>
+            samples(handle->GetMemory(), buffer.samples, buffer.size / sizeof(s16),
+                    &release_samples);
+        stream->ReleaseBuffer(samples);
     }
 }
 
@@ -153,6 +153,8 @@ private:
     bool initialized{};
     /// Temporary sample buffer
     Common::ScratchBuffer<s16> tmp_samples{};
+    /// Fallback for recorded samples when the guest buffer is not contiguous
+    mutable Common::ScratchBuffer<s16> release_samples{};
 };
 
 } // namespace AudioCore
@@ -1,16 +1,25 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
+
 #include "yuzu_audio_core/opus/decoder.h"
 #include "yuzu_audio_core/opus/hardware_opus.h"
 #include "yuzu_audio_core/opus/parameters.h"
 #include "yuzu_common/alignment.h"
+#include "yuzu_common/settings.h"
 #include "yuzu_common/swap.h"
 #include "core/core.h"
 
 namespace AudioCore::OpusDecoder {
 using namespace Service::Audio;
 namespace {
+/// Most samples per channel a packet decodes to, 120ms at 48kHz
+constexpr u64 MaxPacketSampleCount = 5760;
+/// Size of the samples a decoder keeps for packets decoded ahead
+constexpr u64 DecodeAheadOutputSize = 0x40000;
+
 OpusPacketHeader ReverseHeader(OpusPacketHeader header) {
     OpusPacketHeader out;
     out.size = Common::swap32(header.size);
@@ -38,6 +47,9 @@ Result OpusDecoder::Initialize(const OpusParametersEx& params,
     buffer_size =
         Common::AlignUp((frame_size * params.channel_count) / (48'000 / params.sample_rate), 16);
 
+    ahead_slot_size = Common::AlignUp(
+        std::min<u64>(buffer_size, MaxPacketSampleCount) * params.channel_count * sizeof(s16), 16);
+
     out_data = {shared_buffer.get() + shared_buffer_size - buffer_size, buffer_size};
     size_t in_data_size{0x600u};
     in_data = {out_data.data() - in_data_size, in_data_size};
@@ -69,6 +81,9 @@ Result OpusDecoder::Initialize(const OpusMultiStreamParametersEx& params,
     buffer_size =
         Common::AlignUp((frame_size * params.channel_count) / (48'000 / params.sample_rate), 16);
 
+    ahead_slot_size = Common::AlignUp(
+        std::min<u64>(buffer_size, MaxPacketSampleCount) * params.channel_count * sizeof(s16), 16);
+
     out_data = {shared_buffer.get() + shared_buffer_size - buffer_size, buffer_size};
     size_t in_data_size{Common::AlignUp(1500ull * params.total_stream_count, 64u)};
     in_data = {out_data.data() - in_data_size, in_data_size};
@@ -89,6 +104,7 @@ Result OpusDecoder::Initialize(const OpusMultiStreamParametersEx& params,
     channel_count = params.channel_count;
     total_stream_count = params.total_stream_count;
     stereo_stream_count = params.stereo_stream_count;
+    multi_stream = true;
     use_large_frame_size = params.use_large_frame_size;
     decode_object_initialized = true;
     R_SUCCEED();
@@ -114,13 +130,23 @@ Result OpusDecoder::DecodeInterleaved(u32* out_data_size, u64* out_time_taken,
         shared_memory_mapped = true;
     }
 
-    std::memcpy(in_data.data(), input_data.data() + sizeof(OpusPacketHeader), header.size);
-
-    R_TRY(hardware_opus.DecodeInterleaved(out_samples, out_data.data(), out_data.size_bytes(),
-                                          channel_count, in_data.data(), header.size,
-                                          shared_buffer.get(), time_taken, reset));
-
-    std::memcpy(output_data.data(), out_data.data(), out_samples * channel_count * sizeof(s16));
+    if (!TakeDecodedAhead(out_samples, time_taken, input_data, output_data, reset)) {
+        R_TRY(DropDecodedAhead(reset));
+        if (const auto packet_count{DecodeAheadPacketCount(input_data)}; packet_count > 1) {
+            R_TRY(DecodeAhead(out_samples, time_taken, input_data, output_data, packet_count,
+                              reset));
+        } else {
+            std::memcpy(in_data.data(), input_data.data() + sizeof(OpusPacketHeader),
+                        header.size);
+
+            R_TRY(hardware_opus.DecodeInterleaved(
+                out_samples, out_data.data(), out_data.size_bytes(), channel_count,
+                in_data.data(), header.size, shared_buffer.get(), time_taken, reset));
+
+            std::memcpy(output_data.data(), out_data.data(),
+                        out_samples * channel_count * sizeof(s16));
+        }
+    }
 
     *out_data_size = header.size + sizeof(OpusPacketHeader);
     *out_sample_count = out_samples;
@@ -160,13 +186,23 @@ Result OpusDecoder::DecodeInterleavedForMultiStream(u32* out_data_size, u64* out
         shared_memory_mapped = true;
     }
 
-    std::memcpy(in_data.data(), input_data.data() + sizeof(OpusPacketHeader), header.size);
-
-    R_TRY(hardware_opus.DecodeInterleavedForMultiStream(
-        out_samples, out_data.data(), out_data.size_bytes(), channel_count, in_data.data(),
-        header.size, shared_buffer.get(), time_taken, reset));
-
-    std::memcpy(output_data.data(), out_data.data(), out_samples * channel_count * sizeof(s16));
+    if (!TakeDecodedAhead(out_samples, time_taken, input_data, output_data, reset)) {
+        R_TRY(DropDecodedAhead(reset));
+        if (const auto packet_count{DecodeAheadPacketCount(input_data)}; packet_count > 1) {
+            R_TRY(DecodeAhead(out_samples, time_taken, input_data, output_data, packet_count,
+                              reset));
+        } else {
+            std::memcpy(in_data.data(), input_data.data() + sizeof(OpusPacketHeader),
+                        header.size);
+
+            R_TRY(hardware_opus.DecodeInterleavedForMultiStream(
+                out_samples, out_data.data(), out_data.size_bytes(), channel_count,
+                in_data.data(), header.size, shared_buffer.get(), time_taken, reset));
+
+            std::memcpy(output_data.data(), out_data.data(),
+                        out_samples * channel_count * sizeof(s16));
+        }
+    }
 
     *out_data_size = header.size + sizeof(OpusPacketHeader);
     *out_sample_count = out_samples;
@@ -176,4 +212,135 @@ Result OpusDecoder::DecodeInterleavedForMultiStream(u32* out_data_size, u64* out
     R_SUCCEED();
 }
 
+u32 OpusDecoder::DecodeAheadPacketCount(std::span<const u8> input_data) const {
+    const auto depth{std::min<u64>({Settings::values.audio_opus_decode_ahead.GetValue(),
+                                    ADSP::OpusDecoder::MaxBatchPackets,
+                                    DecodeAheadOutputSize / ahead_slot_size})};
+
+    // Only complete packets which could be decoded on their own are decoded ahead
+    u32 packet_count{0};
+    u64 input_offset{0};
+    while (packet_count < depth &&
+           input_data.size_bytes() - input_offset > sizeof(OpusPacketHeader)) {
+        auto* header_p{
+            reinterpret_cast<const OpusPacketHeader*>(input_data.data() + input_offset)};
+        OpusPacketHeader header{ReverseHeader(*header_p)};
+        if (in_data.size_bytes() < header.size ||
+            header.size + sizeof(OpusPacketHeader) > input_data.size_bytes() - input_offset) {
+            break;
+        }
+        input_offset += header.size + sizeof(OpusPacketHeader);
+        packet_count++;
+    }
+    return packet_count;
+}
+
+Result OpusDecoder::DecodeAhead(u32& out_samples, u64& out_time_taken,
+                                std::span<const u8> input_data, std::span<u8> output_data,
+                                u32 packet_count, bool reset) {
+    // The decode object and libopus state lead the shared buffer, up to the staging areas
+    ahead_state.assign(shared_buffer.get(), in_data.data());
+    if (ahead_output.size() < packet_count * ahead_slot_size) {
+        ahead_output.resize(packet_count * ahead_slot_size);
+    }
+
+    u64 input_size{0};
+    for (u32 i = 0; i < packet_count; i++) {
+        auto* header_p{reinterpret_cast<const OpusPacketHeader*>(input_data.data() + input_size)};
+        OpusPacketHeader header{ReverseHeader(*header_p)};
+        ahead_packets[i] = {
+            .input_offset = input_size,
+            .input_size = static_cast<u32>(header.size + sizeof(OpusPacketHeader)),
+            .sample_count = 0,
+            .time_taken = 0,
+        };
+        input_size += ahead_packets[i].input_size;
+    }
+
+    // The packets are kept to compare them with the input of the following calls
+    ahead_input.assign(input_data.begin(), input_data.begin() + input_size);
+    for (u32 i = 0; i < packet_count; i++) {
+        const auto& packet{ahead_packets[i]};
+        const auto* payload{ahead_input.data() + packet.input_offset + sizeof(OpusPacketHeader)};
+        ahead_batch[i] = {
+            .input_data = (u64)payload,
+            .input_data_size = packet.input_size - sizeof(OpusPacketHeader),
+            .output_data = (u64)(ahead_output.data() + i * ahead_slot_size),
+            .output_data_size = buffer_size,
+        };
+    }
+
+    u32 decoded_packets{0};
+    u64 batch_time_taken{0};
+    const auto result{hardware_opus.DecodeInterleavedBatch(
+        decoded_packets, std::span{ahead_batch.data(), packet_count}, shared_buffer.get(),
+        batch_time_taken, multi_stream, reset)};
+    LOG_TRACE(Service_Audio, "Decoded {} of {} packets ahead in {}us", decoded_packets,
+              packet_count, batch_time_taken / 1000);
+
+    for (u32 i = 0; i < decoded_packets; i++) {
+        ahead_packets[i].sample_count = ahead_batch[i].sample_count;
+        ahead_packets[i].time_taken = 1000 * ahead_batch[i].time_taken;
+    }
+    ahead_packet_count = decoded_packets;
+    ahead_packets_taken = 0;
+    ahead_reset = reset;
+
+    // A failing first packet leaves the decoder where decoding it on its own would have
+    R_UNLESS(decoded_packets > 0, result);
+    ahead_failed = R_FAILED(result);
+
+    const auto& packet{ahead_packets[0]};
+    std::memcpy(output_data.data(), ahead_output.data(),
+                packet.sample_count * channel_count * sizeof(s16));
+    out_samples = packet.sample_count;
+    out_time_taken = packet.time_taken;
+    ahead_packets_taken = 1;
+    R_SUCCEED();
+}
+
+bool OpusDecoder::TakeDecodedAhead(u32& out_samples, u64& out_time_taken,
+                                   std::span<const u8> input_data, std::span<u8> output_data,
+                                   bool reset) {
+    if (reset || ahead_packets_taken >= ahead_packet_count) {
+        return false;
+    }
+
+    const auto& packet{ahead_packets[ahead_packets_taken]};
+    if (input_data.size_bytes() < packet.input_size ||
+        std::memcmp(input_data.data(), ahead_input.data() + packet.input_offset,
+                    packet.input_size) != 0) {
+        return false;
+    }
+
+    std::memcpy(output_data.data(), ahead_output.data() + ahead_packets_taken * ahead_slot_size,
+                packet.sample_count * channel_count * sizeof(s16));
+    out_samples = packet.sample_count;
+    out_time_taken = packet.time_taken;
+    ahead_packets_taken++;
+    return true;
+}
+
+Result OpusDecoder::DropDecodedAhead(bool reset) {
+    const bool went_past{ahead_packets_taken < ahead_packet_count || ahead_failed};
+    const auto packets_taken{ahead_packets_taken};
+    ahead_packet_count = 0;
+    ahead_packets_taken = 0;
+    ahead_failed = false;
+
+    // A reset clears any state the decoder built past the packets the guest was given
+    R_SUCCEED_IF(!went_past || reset);
+
+    std::memcpy(shared_buffer.get(), ahead_state.data(), ahead_state.size());
+
+    u32 decoded_packets{0};
+    u64 batch_time_taken{0};
+    R_TRY(hardware_opus.DecodeInterleavedBatch(
+        decoded_packets, std::span{ahead_batch.data(), packets_taken}, shared_buffer.get(),
+        batch_time_taken, multi_stream, ahead_reset));
+    LOG_TRACE(Service_Audio, "Replayed {} packets decoded ahead in {}us", decoded_packets,
+              batch_time_taken / 1000);
+    R_SUCCEED();
+}
+
 } // namespace AudioCore::OpusDecoder
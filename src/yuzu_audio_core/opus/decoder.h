@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <span>
+#include <vector>
 
+#include "yuzu_audio_core/adsp/apps/opus/shared_memory.h"
 #include "yuzu_audio_core/opus/parameters.h"
 #include "yuzu_common/common_types.h"
 #include "core/hle/kernel/k_transfer_memory.h"
@@ -34,6 +37,65 @@ public:
                                            std::span<u8> output_data, bool reset);
 
 private:
+    /// A packet decoded ahead of the guest asking for it
+    struct DecodedPacket {
+        /// Offset of the packet in ahead_input, header included
+        u64 input_offset;
+        /// Size of the packet, header included
+        u32 input_size;
+        /// Number of samples per channel decoded
+        u32 sample_count;
+        /// Time taken to decode the packet
+        u64 time_taken;
+    };
+
+    /**
+     * Number of packets to decode with a single exchange, given the input of a decode call.
+     * Counts the complete packets at the start of the input, up to the decode ahead depth.
+     *
+     * @param input_data - Input of the decode call, starting with a packet.
+     * @return Number of packets to decode, 1 to decode only the packet asked for.
+     */
+    u32 DecodeAheadPacketCount(std::span<const u8> input_data) const;
+
+    /**
+     * Decode the first packets of the input with a single exchange, returning the first one
+     * and keeping the others for the following decode calls.
+     *
+     * @param out_samples    - Returns the number of samples per channel of the first packet.
+     * @param out_time_taken - Returns the time taken to decode the first packet.
+     * @param input_data     - Input of the decode call, starting with packet_count packets.
+     * @param output_data    - Output of the decode call.
+     * @param packet_count   - Number of packets to decode, from DecodeAheadPacketCount.
+     * @param reset          - Reset the decoder before the first packet.
+     * @return Result of decoding the first packet.
+     */
+    Result DecodeAhead(u32& out_samples, u64& out_time_taken, std::span<const u8> input_data,
+                       std::span<u8> output_data, u32 packet_count, bool reset);
+
+    /**
+     * Return the next packet decoded ahead, if the input of a decode call starts with it.
+     *
+     * @param out_samples    - Returns the number of samples per channel of the packet.
+     * @param out_time_taken - Returns the time taken to decode the packet.
+     * @param input_data     - Input of the decode call.
+     * @param output_data    - Output of the decode call.
+     * @param reset          - Whether the decode call resets the decoder.
+     * @return True if the packet was returned, false if it has to be decoded.
+     */
+    bool TakeDecodedAhead(u32& out_samples, u64& out_time_taken, std::span<const u8> input_data,
+                          std::span<u8> output_data, bool reset);
+
+    /**
+     * Drop the packets decoded ahead. If the decoder went past the last packet returned to the
+     * guest, its state is restored and the returned packets are decoded again, so it is left
+     * where decoding one packet per call would have left it.
+     *
+     * @param reset - Whether the next decode resets the decoder, which makes the replay moot.
+     * @return Result of decoding the returned packets again.
+     */
+    Result DropDecodedAhead(bool reset);
+
     Core::System& system;
     HardwareOpus& hardware_opus;
     std::unique_ptr<u8[]> shared_buffer{};
@@ -46,8 +108,30 @@ private:
     bool use_large_frame_size{false};
     s32 total_stream_count{};
     s32 stereo_stream_count{};
+    bool multi_stream{false};
     bool shared_memory_mapped{false};
     bool decode_object_initialized{false};
+
+    /// Copy of the packets of the last batch, header included
+    std::vector<u8> ahead_input{};
+    /// Decoded samples of the last batch, one slot of ahead_slot_size per packet
+    std::vector<u8> ahead_output{};
+    /// Size of a packet's slot in ahead_output
+    u64 ahead_slot_size{};
+    /// Decode object and libopus state as they were before the last batch
+    std::vector<u8> ahead_state{};
+    /// Packets of the last batch which were decoded successfully
+    std::array<DecodedPacket, ADSP::OpusDecoder::MaxBatchPackets> ahead_packets{};
+    /// Packets of the last batch as sent to the OpusDecoder, sent again to replay them
+    std::array<ADSP::OpusDecoder::BatchPacket, ADSP::OpusDecoder::MaxBatchPackets> ahead_batch{};
+    /// Number of valid ahead_packets
+    u32 ahead_packet_count{};
+    /// Number of ahead_packets already returned to the guest
+    u32 ahead_packets_taken{};
+    /// Whether the last batch stopped at a failing packet, which the decoder state went through
+    bool ahead_failed{false};
+    /// Whether the last batch reset the decoder before its first packet
+    bool ahead_reset{false};
 };
 
 } // namespace AudioCore::OpusDecoder
@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <utility>
 
 #include "yuzu_audio_core/audio_core.h"
 #include "yuzu_audio_core/opus/hardware_opus.h"
@@ -209,6 +211,37 @@ Result HardwareOpus::DecodeInterleavedForMultiStream(u32& out_sample_count, void
     R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
 }
 
+Result HardwareOpus::DecodeInterleavedBatch(u32& out_packet_count,
+                                            std::span<ADSP::OpusDecoder::BatchPacket> packets,
+                                            void* buffer, u64& out_time_taken, bool multi_stream,
+                                            bool reset) {
+    ASSERT(packets.size() <= ADSP::OpusDecoder::MaxBatchPackets);
+
+    std::scoped_lock l{mutex};
+    shared_memory.host_send_data[0] = (u64)buffer;
+    shared_memory.host_send_data[1] = packets.size();
+    shared_memory.host_send_data[2] = reset;
+    std::ranges::copy(packets, shared_memory.batch_packets.begin());
+
+    const auto [message, expected] =
+        multi_stream ? std::pair{ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamBatch,
+                                 ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamBatchOK}
+                     : std::pair{ADSP::OpusDecoder::Message::DecodeInterleavedBatch,
+                                 ADSP::OpusDecoder::Message::DecodeInterleavedBatchOK};
+    opus_decoder.Send(ADSP::Direction::DSP, message);
+    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
+    if (msg != expected) {
+        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
+                  expected, msg);
+        R_THROW(ResultInvalidOpusDSPReturnCode);
+    }
+
+    out_packet_count = static_cast<u32>(shared_memory.dsp_return_data[1]);
+    out_time_taken = 1000 * shared_memory.dsp_return_data[2];
+    std::copy_n(shared_memory.batch_packets.begin(), packets.size(), packets.begin());
+    R_RETURN(ResultCodeFromLibOpusErrorCode(shared_memory.dsp_return_data[0]));
+}
+
 Result HardwareOpus::MapMemory(void* buffer, u64 buffer_size) {
     std::scoped_lock l{mutex};
     shared_memory.host_send_data[0] = (u64)buffer;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <mutex>
+#include <span>
 #include <opus.h>
 
 #include "yuzu_audio_core/adsp/apps/opus/opus_decoder.h"
@@ -33,6 +34,22 @@ public:
                                            u64 output_data_size, u32 channel_count,
                                            void* input_data, u64 input_data_size, void* buffer,
                                            u64& out_time_taken, bool reset);
+    /**
+     * Decode several packets with a single exchange with the OpusDecoder. Decoding stops at the
+     * first packet which fails, the packets before it keep their results.
+     *
+     * @param out_packet_count - Returns the number of packets successfully decoded.
+     * @param packets          - Packets to decode, at most ADSP::OpusDecoder::MaxBatchPackets.
+     *                           The error code, sample count and time taken are written back.
+     * @param buffer           - Work buffer holding the decode object.
+     * @param out_time_taken   - Returns the time taken to decode the whole batch.
+     * @param multi_stream     - Whether buffer holds a multi-stream decode object.
+     * @param reset            - Reset the decoder before the first packet.
+     * @return Result of the first failing packet, or success.
+     */
+    Result DecodeInterleavedBatch(u32& out_packet_count,
+                                  std::span<ADSP::OpusDecoder::BatchPacket> packets, void* buffer,
+                                  u64& out_time_taken, bool multi_stream, bool reset);
     Result MapMemory(void* buffer, u64 buffer_size);
     Result UnmapMemory(void* buffer, u64 buffer_size);
 
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "yuzu_audio_core/renderer/capture/update_capture.h"
+#include "yuzu_common/cityhash.h"
+#include "yuzu_common/fs/file.h"
+#include "yuzu_common/fs/fs.h"
+#include "yuzu_common/logging/log.h"
+
+namespace AudioCore::Renderer {
+
+UpdateCapture::UpdateCapture() = default;
+
+UpdateCapture::~UpdateCapture() = default;
+
+bool UpdateCapture::Open(const std::string& path, const AudioRendererParameterInternal& params,
+                         const u64 applet_resource_user_id, const s32 session_id) {
+    std::scoped_lock l{mutex};
+    CloseLocked();
+
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Service_Audio, "Failed to create the directory of audio capture {}", path);
+        return false;
+    }
+
+    file = std::make_unique<Common::FS::IOFile>(path, Common::FS::FileAccessMode::Write,
+                                                Common::FS::FileType::BinaryFile);
+    if (!file->IsOpen()) {
+        LOG_ERROR(Service_Audio, "Failed to create audio capture {}", path);
+        file.reset();
+        return false;
+    }
+
+    CaptureHeader header{};
+    header.magic = Magic;
+    header.version = Version;
+    header.applet_resource_user_id = applet_resource_user_id;
+    header.session_id = session_id;
+    header.params = params;
+    if (!file->WriteObject(header)) {
+        LOG_ERROR(Service_Audio, "Failed to write audio capture header");
+        file.reset();
+        return false;
+    }
+
+    LOG_INFO(Service_Audio, "Capturing audio renderer session {} to {}", session_id, path);
+    return true;
+}
+
+void UpdateCapture::Close() {
+    std::scoped_lock l{mutex};
+    CloseLocked();
+}
+
+bool UpdateCapture::IsOpen() const {
+    std::scoped_lock l{mutex};
+    return file != nullptr;
+}
+
+void UpdateCapture::WriteUpdate(std::span<const u8> input, const u64 output_size,
+                                const u64 performance_size) {
+    const UpdateRecord update{
+        .output_size{output_size},
+        .performance_size{performance_size},
+    };
+    std::scoped_lock l{mutex};
+    WriteRecord(RecordType::Update, 0, {reinterpret_cast<const u8*>(&update), sizeof(update)},
+                input);
+}
+
+void UpdateCapture::WriteMemory(const CpuAddr address, const void* data, const u64 size) {
+    if (address == 0 || size == 0) {
+        return;
+    }
+
+    // Only the bytes a command consumed are hashed, never the whole buffer they belong to
+    const auto hash{Common::CityHash64(static_cast<const char*>(data), size)};
+
+    std::scoped_lock l{mutex};
+    if (!file) {
+        return;
+    }
+    const auto [it, inserted]{recorded_ranges.try_emplace(address, RecordedRange{size, hash})};
+    if (!inserted) {
+        if (it->second.size == size && it->second.hash == hash) {
+            return;
+        }
+        it->second = {size, hash};
+    }
+
+    WriteRecord(RecordType::Memory, address, {}, {static_cast<const u8*>(data), size});
+}
+
+void UpdateCapture::WriteCommandList() {
+    std::scoped_lock l{mutex};
+    WriteRecord(RecordType::CommandList, 0, {}, {});
+}
+
+void UpdateCapture::WriteProcessed() {
+    std::scoped_lock l{mutex};
+    WriteRecord(RecordType::Processed, 0, {}, {});
+}
+
+void UpdateCapture::CloseLocked() {
+    file.reset();
+    recorded_ranges.clear();
+}
+
+void UpdateCapture::WriteRecord(const RecordType type, const CpuAddr address,
+                                std::span<const u8> prefix, std::span<const u8> data) {
+    if (!file) {
+        return;
+    }
+
+    CaptureRecord record{};
+    record.type = type;
+    record.address = address;
+    record.size = prefix.size() + data.size();
+    if (!file->WriteObject(record) || file->WriteSpan(prefix) != prefix.size() ||
+        file->WriteSpan(data) != data.size()) {
+        LOG_ERROR(Service_Audio, "Failed to write audio capture, stopping the capture");
+        CloseLocked();
+    }
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include "yuzu_audio_core/common/audio_renderer_parameter.h"
+#include "yuzu_audio_core/common/common.h"
+#include "yuzu_common/common_funcs.h"
+#include "yuzu_common/common_types.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace AudioCore::Renderer {
+
+/**
+ * Records the inputs of an audio renderer session to a file, so the session can be replayed
+ * offline to measure and compare the renderer. The file starts with a CaptureHeader, followed by
+ * CaptureRecords in the order they happened, each followed by its data.
+ *
+ * Guest memory is recorded by the commands as they read it, so only the ranges a command list
+ * actually consumed are written. Updates come from the service thread while the memory records
+ * come from the ADSP, so every write is serialized.
+ */
+class UpdateCapture {
+public:
+    static constexpr u32 Magic{Common::MakeMagic('N', 'X', 'A', 'C')};
+    static constexpr u32 Version{2};
+
+    struct CaptureHeader {
+        /* 0x00 */ u32 magic;
+        /* 0x04 */ u32 version;
+        /* 0x08 */ u64 applet_resource_user_id;
+        /* 0x10 */ s32 session_id;
+        /* 0x14 */ INSERT_PADDING_BYTES(4);
+        /* 0x18 */ AudioRendererParameterInternal params;
+    };
+
+    enum class RecordType : u32 {
+        /// A RequestUpdate call, an UpdateRecord followed by the input buffer
+        Update,
+        /// Guest memory read by a command, valid from this point of the session on
+        Memory,
+        /// A command list was generated from the current state
+        CommandList,
+        /// The last generated command list was processed, its memory records precede this
+        Processed,
+    };
+
+    struct CaptureRecord {
+        /* 0x00 */ RecordType type;
+        /* 0x04 */ INSERT_PADDING_BYTES(4);
+        /* 0x08 */ CpuAddr address;
+        /* 0x10 */ u64 size;
+    };
+    static_assert(sizeof(CaptureRecord) == 0x18, "CaptureRecord has the wrong size!");
+
+    /// Sizes of the buffers the update wrote, the replay must pass the same sizes back
+    struct UpdateRecord {
+        /* 0x00 */ u64 output_size;
+        /* 0x08 */ u64 performance_size;
+    };
+    static_assert(sizeof(UpdateRecord) == 0x10, "UpdateRecord has the wrong size!");
+
+    UpdateCapture();
+    ~UpdateCapture();
+
+    /**
+     * Create the capture file and write its header.
+     *
+     * @param path                    - Path of the capture file.
+     * @param params                  - Parameters the session was created with.
+     * @param applet_resource_user_id - Applet the session belongs to.
+     * @param session_id              - Id of the session.
+     * @return True if the file was created, otherwise false.
+     */
+    bool Open(const std::string& path, const AudioRendererParameterInternal& params,
+              u64 applet_resource_user_id, s32 session_id);
+
+    /**
+     * Close the capture file.
+     */
+    void Close();
+
+    /**
+     * Check if a capture is being written.
+     *
+     * @return True if the capture file is open, otherwise false.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Record an update.
+     *
+     * @param input            - Input buffer of the update.
+     * @param output_size      - Size of the output buffer of the update.
+     * @param performance_size - Size of the performance buffer of the update.
+     */
+    void WriteUpdate(std::span<const u8> input, u64 output_size, u64 performance_size);
+
+    /**
+     * Record guest memory read by a command. The range is skipped when it was already recorded
+     * at this address with the same contents. Safe to call from the voice workers.
+     *
+     * @param address - Guest address the data was read from.
+     * @param data    - Data read, already in host memory.
+     * @param size    - Size of the data.
+     */
+    void WriteMemory(CpuAddr address, const void* data, u64 size);
+
+    /**
+     * Record that a command list was generated.
+     */
+    void WriteCommandList();
+
+    /**
+     * Record that the last generated command list was processed.
+     */
+    void WriteProcessed();
+
+private:
+    /**
+     * Close the capture file, with the mutex held.
+     */
+    void CloseLocked();
+
+    /**
+     * Write a record and its data to the capture file, with the mutex held.
+     *
+     * @param type    - Type of the record.
+     * @param address - Address of the data, for memory records.
+     * @param prefix  - Data written ahead of data, part of the same record.
+     * @param data    - Data of the record.
+     */
+    void WriteRecord(RecordType type, CpuAddr address, std::span<const u8> prefix,
+                     std::span<const u8> data);
+
+    /// Last recorded contents of a memory range
+    struct RecordedRange {
+        u64 size;
+        u64 hash;
+    };
+
+    /// Serializes the writes from the service thread and the ADSP
+    mutable std::mutex mutex;
+    /// Capture file, null when not capturing
+    std::unique_ptr<Common::FS::IOFile> file;
+    /// Last recorded range at each address
+    std::unordered_map<CpuAddr, RecordedRange> recorded_ranges;
+};
+
+} // namespace AudioCore::Renderer
@@ -9,14 +9,23 @@
 #include "yuzu_common/common_types.h"
 
 namespace AudioCore::Renderer {
+class UpdateCapture;
 
 struct CommandListHeader {
     u64 buffer_size;
     u32 command_count;
     std::span<s32> samples_buffer;
     s16 buffer_count;
+    /// Number of mix buffers, the voice channel buffers follow them
+    s16 mix_buffer_count;
     u32 sample_count;
     u32 sample_rate;
+    /// Number of commands up to the end of the voice commands. After the initial clear, these
+    /// are the per voice chains, which only accumulate into the mix buffers.
+    u32 voice_command_count;
+    /// Capture of the session, the guest memory read by the commands is recorded to it. Null
+    /// when the session is not captured.
+    UpdateCapture* capture;
 };
 
 } // namespace AudioCore::Renderer
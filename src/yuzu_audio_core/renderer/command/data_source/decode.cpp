@@ -4,7 +4,9 @@
 #include <array>
 #include <vector>
 
+#include "yuzu_audio_core/renderer/capture/update_capture.h"
 #include "yuzu_audio_core/renderer/command/data_source/decode.h"
+#include "yuzu_audio_core/renderer/command/data_source/decode_kernels.h"
 #include "yuzu_audio_core/renderer/command/resample/resample.h"
 #include "yuzu_common/fixed_point.h"
 #include "yuzu_common/logging/log.h"
@@ -19,6 +21,8 @@ constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
 
 /**
  * Decode PCM data. Only s16 or f32 is supported.
+ * Samples are read in place from host memory when the range is contiguous, otherwise they are
+ * gathered into a scratch buffer kept per thread, so neither case allocates once warmed up.
  *
  * @tparam T         - Type to decode. Only s16 and f32 are supported.
  * @param memory     - Core memory for reading samples.
@@ -29,8 +33,7 @@ constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
 template <typename T>
 static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
                      const DecodeArg& req) {
-    constexpr s32 min{std::numeric_limits<s16>::min()};
-    constexpr s32 max{std::numeric_limits<s16>::max()};
+    thread_local Common::ScratchBuffer<T> samples_backup;
 
     if (req.buffer == 0 || req.buffer_size == 0) {
         return 0;
@@ -44,50 +47,23 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         std::min(req.samples_to_read, req.end_offset - req.start_offset - req.offset)};
     u32 channel_count{static_cast<u32>(req.channel_count)};
 
-    switch (req.channel_count) {
-    default: {
-        const VAddr source{req.buffer +
-                           (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
-        const u64 size{channel_count * samples_to_decode};
-
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, size);
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                out_buffer[i] = samples[i * channel_count + req.target_channel];
-            }
-        }
-    } break;
-
-    case 1:
-        if (req.target_channel != 0) {
-            LOG_ERROR(Service_Audio, "Invalid target channel, expected 0, got {}",
-                      req.target_channel);
-            return 0;
-        }
-
-        const VAddr source{req.buffer + ((req.start_offset + req.offset) * sizeof(T))};
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, samples_to_decode);
+    if (channel_count == 1 && req.target_channel != 0) {
+        LOG_ERROR(Service_Audio, "Invalid target channel, expected 0, got {}", req.target_channel);
+        return 0;
+    }
 
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            std::memcpy(out_buffer.data(), samples.data(), samples_to_decode * sizeof(s16));
-        }
-        break;
+    const VAddr source{req.buffer +
+                       (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
+    const u64 size{channel_count * samples_to_decode};
+    Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
+        memory, source, size, &samples_backup);
+    if (req.capture != nullptr) {
+        req.capture->WriteMemory(source, samples.data(), size * sizeof(T));
     }
 
+    DecodePcmChannel(out_buffer, {samples.data(), size}, static_cast<u32>(req.target_channel),
+                     channel_count, samples_to_decode);
+
     return samples_to_decode;
 }
 
@@ -103,6 +79,7 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
                        const DecodeArg& req) {
     constexpr u32 SamplesPerFrame{14};
     constexpr u32 NibblesPerFrame{16};
+    thread_local Common::ScratchBuffer<u8> wavebuffer_backup;
 
     if (req.buffer == 0 || req.buffer_size == 0) {
         return 0;
@@ -130,7 +107,6 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         return 0;
     }
 
-    auto samples_to_read{samples_to_process};
     auto samples_remaining_in_frame{start_pos % SamplesPerFrame};
     auto position_in_frame{(start_pos / SamplesPerFrame) * NibblesPerFrame +
                            samples_remaining_in_frame};
@@ -141,81 +117,13 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
 
     const auto size{std::max((samples_to_process / 8U) * SamplesPerFrame, 8U)};
     Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
-        memory, req.buffer + position_in_frame / 2, size);
-
-    auto context{req.adpcm_context};
-    auto header{context->header};
-    u8 coeff_index{static_cast<u8>((header >> 4U) & 0xFU)};
-    u8 scale{static_cast<u8>(header & 0xFU)};
-    s32 coeff0{req.coefficients[coeff_index * 2 + 0]};
-    s32 coeff1{req.coefficients[coeff_index * 2 + 1]};
-
-    auto yn0{context->yn0};
-    auto yn1{context->yn1};
-
-    static constexpr std::array<s32, 16> Steps{
-        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
-    };
-
-    const auto decode_sample = [&](const s32 code) -> s16 {
-        const auto xn = code * (1 << scale);
-        const auto prediction = coeff0 * yn0 + coeff1 * yn1;
-        const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
-        const auto saturated = std::clamp<s32>(sample, -0x8000, 0x7FFF);
-        yn1 = yn0;
-        yn0 = static_cast<s16>(saturated);
-        return yn0;
-    };
-
-    u32 read_index{0};
-    u32 write_index{0};
-
-    while (samples_to_read > 0) {
-        // Are we at a new frame?
-        if ((position_in_frame % NibblesPerFrame) == 0) {
-            header = wavebuffer[read_index++];
-            coeff_index = (header >> 4) & 0xF;
-            scale = header & 0xF;
-            coeff0 = req.coefficients[coeff_index * 2 + 0];
-            coeff1 = req.coefficients[coeff_index * 2 + 1];
-            position_in_frame += 2;
-
-            // Can we consume all of this frame's samples?
-            if (samples_to_read >= SamplesPerFrame) {
-                // Can grab all samples until the next header
-                for (u32 i = 0; i < SamplesPerFrame / 2; i++) {
-                    auto code0{Steps[(wavebuffer[read_index] >> 4) & 0xF]};
-                    auto code1{Steps[wavebuffer[read_index] & 0xF]};
-                    read_index++;
-
-                    out_buffer[write_index++] = decode_sample(code0);
-                    out_buffer[write_index++] = decode_sample(code1);
-                }
-
-                position_in_frame += SamplesPerFrame;
-                samples_to_read -= SamplesPerFrame;
-                continue;
-            }
-        }
-
-        // Decode a single sample
-        auto code{wavebuffer[read_index]};
-        if (position_in_frame & 1) {
-            code &= 0xF;
-            read_index++;
-        } else {
-            code >>= 4;
-        }
-
-        out_buffer[write_index++] = decode_sample(Steps[code]);
-
-        position_in_frame++;
-        samples_to_read--;
+        memory, req.buffer + position_in_frame / 2, size, &wavebuffer_backup);
+    if (req.capture != nullptr) {
+        req.capture->WriteMemory(req.buffer + position_in_frame / 2, wavebuffer.data(), size);
     }
 
-    context->header = header;
-    context->yn0 = yn0;
-    context->yn1 = yn1;
+    DecodeAdpcmSamples(out_buffer, {wavebuffer.data(), size}, req.coefficients,
+                       *req.adpcm_context, position_in_frame, samples_to_process);
 
     return samples_to_process;
 }
@@ -270,7 +178,19 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
     u32 offset{voice_state.offset};
 
     auto output_buffer{args.output};
-    std::array<s16, TempBufferSize> temp_buffer{};
+    // Left uninitialized, every sample the resampler reads is written first, either decoded,
+    // copied from the history or zeroed when the buffers starve
+    std::array<s16, TempBufferSize> temp_buffer;
+
+    // The coefficients are the same for every wavebuffer of the voice, read them once
+    std::array<s16, 16> coefficients{};
+    if (args.sample_format == SampleFormat::Adpcm) {
+        const auto coefficients_size{std::min<u64>(args.data_size, sizeof(coefficients))};
+        memory.ReadBlockUnsafe(args.data_address, coefficients.data(), coefficients_size);
+        if (args.capture != nullptr) {
+            args.capture->WriteMemory(args.data_address, coefficients.data(), coefficients_size);
+        }
+    }
 
     while (remaining_sample_count > 0) {
         const auto samples_to_write{std::min(remaining_sample_count, max_remaining_sample_count)};
@@ -306,6 +226,10 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
                 wavebuffer.context != 0) {
                 memory.ReadBlockUnsafe(wavebuffer.context, &voice_state.adpcm_context,
                                        wavebuffer.context_size);
+                if (args.capture != nullptr) {
+                    args.capture->WriteMemory(wavebuffer.context, &voice_state.adpcm_context,
+                                              wavebuffer.context_size);
+                }
             }
 
             auto start_offset{wavebuffer.start_offset};
@@ -323,11 +247,12 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
                 .start_offset{start_offset},
                 .end_offset{end_offset},
                 .channel_count{args.channel_count},
-                .coefficients{},
+                .coefficients{coefficients},
                 .adpcm_context{nullptr},
                 .target_channel{args.channel},
                 .offset{offset},
                 .samples_to_read{samples_to_read - samples_read},
+                .capture{args.capture},
             };
 
             s32 samples_decoded{0};
@@ -347,7 +272,6 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
 
             case SampleFormat::Adpcm: {
                 decode_arg.adpcm_context = &voice_state.adpcm_context;
-                memory.ReadBlockUnsafe(args.data_address, &decode_arg.coefficients, args.data_size);
                 samples_decoded = DecodeAdpcm(
                     memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
                     decode_arg);
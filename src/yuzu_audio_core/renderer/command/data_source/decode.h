@@ -16,6 +16,7 @@ class Memory;
 }
 
 namespace AudioCore::Renderer {
+class UpdateCapture;
 
 struct DecodeFromWaveBuffersArgs {
     SampleFormat sample_format;
@@ -33,6 +34,7 @@ struct DecodeFromWaveBuffersArgs {
     u64 data_size;
     bool IsVoicePlayedSampleCountResetAtLoopPointSupported;
     bool IsVoicePitchAndSrcSkippedSupported;
+    UpdateCapture* capture;
 };
 
 struct DecodeArg {
@@ -46,6 +48,7 @@ struct DecodeArg {
     s8 target_channel;
     u32 offset;
     u32 samples_to_read;
+    UpdateCapture* capture;
 };
 
 /**
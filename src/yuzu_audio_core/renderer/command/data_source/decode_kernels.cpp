@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "yuzu_audio_core/renderer/command/data_source/decode_kernels.h"
+
+namespace AudioCore::Renderer {
+
+namespace {
+
+/**
+ * Convert a PCM sample to s16. Float samples are scaled and saturated.
+ *
+ * @tparam T     - Type of the sample. Only s16 and f32 are supported.
+ * @param sample - Sample to convert.
+ * @return The converted sample.
+ */
+template <typename T>
+s16 ToPcm16(const T sample) {
+    if constexpr (std::is_floating_point_v<T>) {
+        constexpr s32 min{std::numeric_limits<s16>::min()};
+        constexpr s32 max{std::numeric_limits<s16>::max()};
+        const auto scaled{static_cast<s32>(sample * std::numeric_limits<s16>::max())};
+        return static_cast<s16>(std::clamp(scaled, min, max));
+    } else {
+        return sample;
+    }
+}
+
+/**
+ * Copy one channel out of interleaved PCM samples. The channel count is a template parameter
+ * for the common layouts so the stride is a constant the compiler can vectorize over, 0 takes it
+ * at runtime instead.
+ *
+ * @tparam T            - Type of the samples. Only s16 and f32 are supported.
+ * @tparam ChannelCount - Number of interleaved channels, or 0 to use channel_count.
+ * @param out_buffer    - Output buffer to receive the samples.
+ * @param samples       - Interleaved samples, starting at the first frame to copy.
+ * @param channel       - Channel to copy.
+ * @param channel_count - Number of interleaved channels, used when ChannelCount is 0.
+ * @param count         - Number of samples to copy.
+ */
+template <typename T, u32 ChannelCount>
+void CopyPcmChannel(s16* out_buffer, const T* samples, const u32 channel,
+                    const u32 channel_count, const u32 count) {
+    const u32 stride{ChannelCount != 0 ? ChannelCount : channel_count};
+    samples += channel;
+    for (u32 i = 0; i < count; i++) {
+        out_buffer[i] = ToPcm16(samples[i * stride]);
+    }
+}
+
+template <typename T>
+void DecodePcm(std::span<s16> out_buffer, std::span<const T> samples, const u32 channel,
+               const u32 channel_count, const u32 count) {
+    switch (channel_count) {
+    case 1:
+        if constexpr (std::is_floating_point_v<T>) {
+            CopyPcmChannel<T, 1>(out_buffer.data(), samples.data(), 0, 1, count);
+        } else {
+            std::memcpy(out_buffer.data(), samples.data(), count * sizeof(s16));
+        }
+        break;
+    case 2:
+        CopyPcmChannel<T, 2>(out_buffer.data(), samples.data(), channel, 2, count);
+        break;
+    case 6:
+        CopyPcmChannel<T, 6>(out_buffer.data(), samples.data(), channel, 6, count);
+        break;
+    default:
+        CopyPcmChannel<T, 0>(out_buffer.data(), samples.data(), channel, channel_count, count);
+        break;
+    }
+}
+
+/**
+ * Sign extend the high nibble of an ADPCM byte, equivalent to a lookup of the signed 4-bit code.
+ */
+constexpr s32 AdpcmHighNibble(const u8 byte) {
+    return static_cast<s8>(byte) >> 4;
+}
+
+/**
+ * Sign extend the low nibble of an ADPCM byte, equivalent to a lookup of the signed 4-bit code.
+ */
+constexpr s32 AdpcmLowNibble(const u8 byte) {
+    return static_cast<s8>(static_cast<u8>(byte << 4)) >> 4;
+}
+
+/**
+ * Decode one ADPCM sample, updating the sample history.
+ *
+ * @param code   - Signed 4-bit code of the sample.
+ * @param scale  - Scale of the current frame.
+ * @param coeff0 - First coefficient of the current frame's pair.
+ * @param coeff1 - Second coefficient of the current frame's pair.
+ * @param yn0    - Last decoded sample, updated.
+ * @param yn1    - Sample before the last, updated.
+ * @return The decoded sample.
+ */
+s16 DecodeAdpcmSample(const s32 code, const u32 scale, const s32 coeff0, const s32 coeff1,
+                      s16& yn0, s16& yn1) {
+    const auto xn = code * (1 << scale);
+    const auto prediction = coeff0 * yn0 + coeff1 * yn1;
+    const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
+    yn1 = yn0;
+    yn0 = static_cast<s16>(std::clamp<s32>(sample, -0x8000, 0x7FFF));
+    return yn0;
+}
+
+/**
+ * Decode the 14 samples of a whole ADPCM frame, without the header byte.
+ * The prediction of each sample depends on the two samples before it, so the frame is decoded in
+ * order, but the coefficient pair and scale are resolved once and the nibbles are extracted
+ * without lookups or per-sample position checks.
+ *
+ * @param frame_data   - The 7 data bytes of the frame.
+ * @param header       - Header byte of the frame.
+ * @param coefficients - Coefficient pairs of the voice.
+ * @param out_buffer   - Output buffer to receive the 14 samples.
+ * @param yn0          - Last decoded sample, updated.
+ * @param yn1          - Sample before the last, updated.
+ */
+void DecodeAdpcmFrame(const u8* frame_data, const u8 header,
+                      const std::array<s16, 16>& coefficients, s16* out_buffer, s16& yn0,
+                      s16& yn1) {
+    const u32 coeff_index{static_cast<u32>((header >> 4) & 0xF)};
+    const u32 scale{static_cast<u32>(header & 0xF)};
+    const s32 coeff0{coefficients[coeff_index * 2 + 0]};
+    const s32 coeff1{coefficients[coeff_index * 2 + 1]};
+
+    for (u32 i = 0; i < 7; i++) {
+        const u8 byte{frame_data[i]};
+        out_buffer[i * 2 + 0] =
+            DecodeAdpcmSample(AdpcmHighNibble(byte), scale, coeff0, coeff1, yn0, yn1);
+        out_buffer[i * 2 + 1] =
+            DecodeAdpcmSample(AdpcmLowNibble(byte), scale, coeff0, coeff1, yn0, yn1);
+    }
+}
+
+} // Anonymous namespace
+
+void DecodePcmChannel(std::span<s16> out_buffer, std::span<const s16> samples, const u32 channel,
+                      const u32 channel_count, const u32 count) {
+    DecodePcm(out_buffer, samples, channel, channel_count, count);
+}
+
+void DecodePcmChannel(std::span<s16> out_buffer, std::span<const f32> samples, const u32 channel,
+                      const u32 channel_count, const u32 count) {
+    DecodePcm(out_buffer, samples, channel, channel_count, count);
+}
+
+void DecodeAdpcmSamples(std::span<s16> out_buffer, std::span<const u8> data,
+                        const std::array<s16, 16>& coefficients,
+                        VoiceState::AdpcmContext& context, u32 position, u32 count) {
+    constexpr u32 SamplesPerFrame{14};
+    constexpr u32 NibblesPerFrame{16};
+
+    auto header{context.header};
+    u32 scale{static_cast<u32>(header & 0xFU)};
+    u32 coeff_index{static_cast<u32>((header >> 4U) & 0xFU)};
+    s32 coeff0{coefficients[coeff_index * 2 + 0]};
+    s32 coeff1{coefficients[coeff_index * 2 + 1]};
+
+    s16 yn0{context.yn0};
+    s16 yn1{context.yn1};
+
+    u32 read_index{0};
+    u32 write_index{0};
+
+    while (count > 0) {
+        // Are we at a new frame?
+        if ((position % NibblesPerFrame) == 0) {
+            header = data[read_index++];
+            position += 2;
+
+            // Can we consume all of this frame's samples?
+            if (count >= SamplesPerFrame) {
+                DecodeAdpcmFrame(&data[read_index], static_cast<u8>(header), coefficients,
+                                 &out_buffer[write_index], yn0, yn1);
+                read_index += SamplesPerFrame / 2;
+                write_index += SamplesPerFrame;
+                position += SamplesPerFrame;
+                count -= SamplesPerFrame;
+                continue;
+            }
+
+            coeff_index = (header >> 4) & 0xF;
+            scale = header & 0xF;
+            coeff0 = coefficients[coeff_index * 2 + 0];
+            coeff1 = coefficients[coeff_index * 2 + 1];
+        }
+
+        // Decode a single sample
+        s32 code;
+        if (position & 1) {
+            code = AdpcmLowNibble(data[read_index]);
+            read_index++;
+        } else {
+            code = AdpcmHighNibble(data[read_index]);
+        }
+
+        out_buffer[write_index++] = DecodeAdpcmSample(code, scale, coeff0, coeff1, yn0, yn1);
+
+        position++;
+        count--;
+    }
+
+    context.header = header;
+    context.yn0 = yn0;
+    context.yn1 = yn1;
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "yuzu_audio_core/renderer/voice/voice_state.h"
+#include "yuzu_common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Copy one channel out of interleaved PCM16 samples.
+ *
+ * @param out_buffer    - Output buffer to receive the samples.
+ * @param samples       - Interleaved samples, starting at the first frame to copy.
+ * @param channel       - Channel to copy.
+ * @param channel_count - Number of interleaved channels.
+ * @param count         - Number of samples to copy.
+ */
+void DecodePcmChannel(std::span<s16> out_buffer, std::span<const s16> samples, u32 channel,
+                      u32 channel_count, u32 count);
+
+/**
+ * Convert one channel out of interleaved float samples to PCM16, scaled and saturated.
+ *
+ * @param out_buffer    - Output buffer to receive the samples.
+ * @param samples       - Interleaved samples, starting at the first frame to convert.
+ * @param channel       - Channel to convert.
+ * @param channel_count - Number of interleaved channels.
+ * @param count         - Number of samples to convert.
+ */
+void DecodePcmChannel(std::span<s16> out_buffer, std::span<const f32> samples, u32 channel,
+                      u32 channel_count, u32 count);
+
+/**
+ * Decode ADPCM samples. Frames are a header byte followed by 14 samples of 4 bits.
+ *
+ * @param out_buffer   - Output buffer to receive the samples.
+ * @param data         - ADPCM data, starting at the byte holding the first sample, or the header
+ *                       when starting on a frame.
+ * @param coefficients - Coefficient pairs of the voice.
+ * @param context      - Header and sample history of the voice, updated.
+ * @param position     - Position of the first sample in nibbles, counting the 2 header nibbles
+ *                       of every frame.
+ * @param count        - Number of samples to decode.
+ */
+void DecodeAdpcmSamples(std::span<s16> out_buffer, std::span<const u8> data,
+                        const std::array<s16, 16>& coefficients,
+                        VoiceState::AdpcmContext& context, u32 position, u32 count);
+
+} // namespace AudioCore::Renderer
@@ -43,6 +43,7 @@ void PcmFloatDataSourceVersion1Command::Process(
         .data_size{0},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
+        .capture{processor.capture},
     };
 
     DecodeFromWaveBuffers(*processor.memory, args);
@@ -83,6 +84,7 @@ void PcmFloatDataSourceVersion2Command::Process(
         .data_size{0},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
+        .capture{processor.capture},
     };
 
     DecodeFromWaveBuffers(*processor.memory, args);
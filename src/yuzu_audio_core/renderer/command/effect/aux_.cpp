@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "yuzu_audio_core/renderer/capture/update_capture.h"
 #include "yuzu_audio_core/renderer/command/effect/aux_.h"
 #include "yuzu_audio_core/renderer/effect/aux_.h"
 #include "core/core.h"
@@ -12,9 +13,11 @@ namespace AudioCore::Renderer {
  * Reset an AuxBuffer.
  *
  * @param memory   - Core memory for writing.
+ * @param capture  - Capture the read memory is recorded to, or nullptr.
  * @param aux_info - Memory address pointing to the AuxInfo to reset.
  */
-static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_info) {
+static void ResetAuxBufferDsp(Core::Memory::Memory& memory, UpdateCapture* capture,
+                              const CpuAddr aux_info) {
     if (aux_info == 0) {
         LOG_ERROR(Service_Audio, "Aux info is 0!");
         return;
@@ -22,6 +25,9 @@ static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_in
 
     AuxInfo::AuxInfoDsp info{};
     memory.ReadBlockUnsafe(aux_info, &info, sizeof(AuxInfo::AuxInfoDsp));
+    if (capture != nullptr) {
+        capture->WriteMemory(aux_info, &info, sizeof(AuxInfo::AuxInfoDsp));
+    }
 
     info.read_offset = 0;
     info.write_offset = 0;
@@ -35,6 +41,7 @@ static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_in
  * update_count is set, to notify the game that an update happened.
  *
  * @param memory       - Core memory for writing.
+ * @param capture      - Capture the read memory is recorded to, or nullptr.
  * @param send_info_   - Meta information for where to write the mix buffer.
  * @param sample_count - Unused.
  * @param send_buffer  - Memory address to write the mix buffer to.
@@ -45,10 +52,10 @@ static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_in
  * @param update_count - If non-zero, send_info_ will be updated.
  * @return Number of samples written.
  */
-static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
-                             [[maybe_unused]] u32 sample_count, CpuAddr send_buffer, u32 count_max,
-                             std::span<const s32> input, u32 write_count_, u32 write_offset,
-                             u32 update_count) {
+static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, UpdateCapture* capture,
+                             CpuAddr send_info_, [[maybe_unused]] u32 sample_count,
+                             CpuAddr send_buffer, u32 count_max, std::span<const s32> input,
+                             u32 write_count_, u32 write_offset, u32 update_count) {
     if (write_count_ > count_max) {
         LOG_ERROR(Service_Audio,
                   "write_count must be smaller than count_max! write_count {}, count_max {}",
@@ -77,6 +84,9 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
 
     AuxInfo::AuxInfoDsp send_info{};
     memory.ReadBlockUnsafe(send_info_, &send_info, sizeof(AuxInfo::AuxInfoDsp));
+    if (capture != nullptr) {
+        capture->WriteMemory(send_info_, &send_info, sizeof(AuxInfo::AuxInfoDsp));
+    }
 
     u32 target_write_offset{send_info.write_offset + write_offset};
     if (target_write_offset > count_max) {
@@ -109,6 +119,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
  * update_count is set, to notify the game that an update happened.
  *
  * @param memory        - Core memory for reading.
+ * @param capture       - Capture the read memory is recorded to, or nullptr.
  * @param return_info_  - Meta information for where to read the mix buffer.
  * @param return_buffer - Memory address to read the samples from.
  * @param count_max     - Maximum number of samples in the receiving buffer.
@@ -118,9 +129,10 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
  * @param update_count  - If non-zero, send_info_ will be updated.
  * @return Number of samples read.
  */
-static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr return_info_,
-                            CpuAddr return_buffer, u32 count_max, std::span<s32> output,
-                            u32 read_count_, u32 read_offset, u32 update_count) {
+static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, UpdateCapture* capture,
+                            CpuAddr return_info_, CpuAddr return_buffer, u32 count_max,
+                            std::span<s32> output, u32 read_count_, u32 read_offset,
+                            u32 update_count) {
     if (count_max == 0) {
         return 0;
     }
@@ -148,6 +160,9 @@ static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr return_info_,
 
     AuxInfo::AuxInfoDsp return_info{};
     memory.ReadBlockUnsafe(return_info_, &return_info, sizeof(AuxInfo::AuxInfoDsp));
+    if (capture != nullptr) {
+        capture->WriteMemory(return_info_, &return_info, sizeof(AuxInfo::AuxInfoDsp));
+    }
 
     u32 target_read_offset{return_info.read_offset + read_offset};
     if (target_read_offset > count_max) {
@@ -161,6 +176,9 @@ static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr return_info_,
         if (to_read > 0) {
             const auto read_addr = return_buffer + target_read_offset * sizeof(s32);
             memory.ReadBlockUnsafe(read_addr, &output[write_pos], to_read * sizeof(s32));
+            if (capture != nullptr) {
+                capture->WriteMemory(read_addr, &output[write_pos], to_read * sizeof(s32));
+            }
         }
         target_read_offset = (target_read_offset + to_read) % count_max;
         read_count -= to_read;
@@ -188,20 +206,20 @@ void AuxCommand::Process(const AudioRenderer::CommandListProcessor& processor) {
         processor.mix_buffers.subspan(output * processor.sample_count, processor.sample_count)};
 
     if (effect_enabled) {
-        WriteAuxBufferDsp(*processor.memory, send_buffer_info, processor.sample_count, send_buffer,
-                          count_max, input_buffer, processor.sample_count, write_offset,
-                          update_count);
+        WriteAuxBufferDsp(*processor.memory, processor.capture, send_buffer_info,
+                          processor.sample_count, send_buffer, count_max, input_buffer,
+                          processor.sample_count, write_offset, update_count);
 
-        auto read{ReadAuxBufferDsp(*processor.memory, return_buffer_info, return_buffer, count_max,
-                                   output_buffer, processor.sample_count, write_offset,
-                                   update_count)};
+        auto read{ReadAuxBufferDsp(*processor.memory, processor.capture, return_buffer_info,
+                                   return_buffer, count_max, output_buffer,
+                                   processor.sample_count, write_offset, update_count)};
 
         if (read != processor.sample_count) {
             std::memset(&output_buffer[read], 0, (processor.sample_count - read) * sizeof(s32));
         }
     } else {
-        ResetAuxBufferDsp(*processor.memory, send_buffer_info);
-        ResetAuxBufferDsp(*processor.memory, return_buffer_info);
+        ResetAuxBufferDsp(*processor.memory, processor.capture, send_buffer_info);
+        ResetAuxBufferDsp(*processor.memory, processor.capture, return_buffer_info);
         if (input != output) {
             std::memcpy(output_buffer.data(), input_buffer.data(), output_buffer.size_bytes());
         }
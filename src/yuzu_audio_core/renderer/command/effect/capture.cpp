@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "yuzu_audio_core/renderer/capture/update_capture.h"
 #include "yuzu_audio_core/renderer/command/effect/capture.h"
 #include "yuzu_audio_core/renderer/effect/aux_.h"
 #include "core/memory.h"
@@ -29,6 +30,7 @@ static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_in
  * update_count is set, to notify the game that an update happened.
  *
  * @param memory       - Core memory for writing.
+ * @param capture      - Capture the read memory is recorded to, or nullptr.
  * @param send_info_   - Header information for where to write the mix buffer.
  * @param send_buffer  - Memory address to write the mix buffer to.
  * @param count_max    - Maximum number of samples in the receiving buffer.
@@ -38,10 +40,10 @@ static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_in
  * @param update_count - If non-zero, send_info_ will be updated.
  * @return Number of samples written.
  */
-static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr send_info_,
-                             const CpuAddr send_buffer, u32 count_max, std::span<const s32> input,
-                             const u32 write_count_, const u32 write_offset,
-                             const u32 update_count) {
+static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, UpdateCapture* capture,
+                             const CpuAddr send_info_, const CpuAddr send_buffer, u32 count_max,
+                             std::span<const s32> input, const u32 write_count_,
+                             const u32 write_offset, const u32 update_count) {
     if (write_count_ > count_max) {
         LOG_ERROR(Service_Audio,
                   "write_count must be smaller than count_max! write_count {}, count_max {}",
@@ -70,6 +72,9 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr send_in
 
     AuxInfo::AuxBufferInfo send_info{};
     memory.ReadBlockUnsafe(send_info_, &send_info, sizeof(AuxInfo::AuxBufferInfo));
+    if (capture != nullptr) {
+        capture->WriteMemory(send_info_, &send_info, sizeof(AuxInfo::AuxBufferInfo));
+    }
 
     u32 target_write_offset{send_info.dsp_info.write_offset + write_offset};
     if (target_write_offset > count_max || write_count_ == 0) {
@@ -128,8 +133,9 @@ void CaptureCommand::Process(const AudioRenderer::CommandListProcessor& processo
     if (effect_enabled) {
         auto input_buffer{
             processor.mix_buffers.subspan(input * processor.sample_count, processor.sample_count)};
-        WriteAuxBufferDsp(*processor.memory, send_buffer_info, send_buffer, count_max, input_buffer,
-                          processor.sample_count, write_offset, update_count);
+        WriteAuxBufferDsp(*processor.memory, processor.capture, send_buffer_info, send_buffer,
+                          count_max, input_buffer, processor.sample_count, write_offset,
+                          update_count);
     } else {
         ResetAuxBufferDsp(*processor.memory, send_buffer_info);
     }
@@ -216,6 +216,30 @@ static void ApplyReverbEffectBypass(std::span<std::span<const s32>> inputs,
     }
 }
 
+/**
+ * Divide a sample by 64, truncating towards zero. This is what dividing by the FixedPoint 64
+ * computes, without going through its wide division.
+ *
+ * @param sample - Sample to divide.
+ * @return The divided sample.
+ */
+static Common::FixedPoint<50, 14> DivideBy64(const Common::FixedPoint<50, 14> sample) {
+    return Common::FixedPoint<50, 14>::from_base(sample.to_raw() / 64);
+}
+
+/**
+ * Multiply an integer sample by a raw fixed point gain. The sample has no fractional bits, so the
+ * product of the raw values is exactly what multiplying the FixedPoints computes.
+ *
+ * @param sample - Integer sample.
+ * @param gain   - Gain to apply.
+ * @return The scaled sample.
+ */
+static Common::FixedPoint<50, 14> ScaleSample(const s32 sample,
+                                              const Common::FixedPoint<50, 14> gain) {
+    return Common::FixedPoint<50, 14>::from_base(static_cast<s64>(sample) * gain.to_raw());
+}
+
 /**
  * Tick the delay lines, reading and returning their current output, and writing a new decaying
  * sample (mix).
@@ -265,6 +289,10 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         0, 0, 1, 1, 2, 2, 4, 4, 5, 5,
     };
 
+    // Float constants converted to FixedPoint once, rather than on every use
+    static constexpr Common::FixedPoint<50, 14> LfeGain{0.2f};
+    static constexpr Common::FixedPoint<50, 14> CenterGain{0.5f};
+
     std::span<const u8> tap_indexes{};
     if constexpr (NumChannels == 1) {
         tap_indexes = OutTapIndexes1Ch;
@@ -276,6 +304,11 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         tap_indexes = OutTapIndexes6Ch;
     }
 
+    const auto base_gain{Common::FixedPoint<50, 14>::from_base(params.base_gain)};
+    const auto late_gain{Common::FixedPoint<50, 14>::from_base(params.late_gain)};
+    const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
+    const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
+
     for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
         std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
 
@@ -289,16 +322,17 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         }
 
         if constexpr (NumChannels == 6) {
-            output_samples[static_cast<u32>(Channels::LFE)] *= 0.2f;
+            output_samples[static_cast<u32>(Channels::LFE)] *= LfeGain;
         }
 
-        Common::FixedPoint<50, 14> input_sample{};
+        // Sum as raw fixed point, with the * 64 folded into the shift from integer samples
+        s64 input_sum{};
         for (u32 channel = 0; channel < NumChannels; channel++) {
-            input_sample += inputs[channel][sample_index];
+            input_sum += inputs[channel][sample_index];
         }
-
-        input_sample *= 64;
-        input_sample *= Common::FixedPoint<50, 14>::from_base(params.base_gain);
+        auto input_sample{Common::FixedPoint<50, 14>::from_base(static_cast<s64>(
+            static_cast<u64>(input_sum) << (Common::FixedPoint<50, 14>::fractional_bits + 6)))};
+        input_sample *= base_gain;
         state.pre_delay_line.Write(input_sample);
 
         for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
@@ -308,8 +342,7 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         }
 
         Common::FixedPoint<50, 14> pre_delay_sample{
-            state.pre_delay_line.TapOut(state.pre_delay_time) *
-            Common::FixedPoint<50, 14>::from_base(params.late_gain)};
+            state.pre_delay_line.TapOut(state.pre_delay_time) * late_gain};
 
         std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
             state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
@@ -324,9 +357,6 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
                                                   state.fdn_delay_lines[i], mix_matrix[i]);
         }
 
-        const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
-        const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
-
         if constexpr (NumChannels == 6) {
             const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
                 allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
@@ -334,23 +364,23 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
             };
 
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
+                auto in_sample{ScaleSample(inputs[channel][sample_index], dry_gain)};
 
                 Common::FixedPoint<50, 14> allpass{};
                 if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
+                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * CenterGain);
                 } else {
                     allpass = allpass_outputs[channel];
                 }
 
-                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
+                auto out_sample{DivideBy64((output_samples[channel] + allpass) * wet_gain)};
                 outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
         } else {
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
-                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
-                                64};
+                auto in_sample{ScaleSample(inputs[channel][sample_index], dry_gain)};
+                auto out_sample{
+                    DivideBy64((output_samples[channel] + allpass_samples[channel]) * wet_gain)};
                 outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
         }
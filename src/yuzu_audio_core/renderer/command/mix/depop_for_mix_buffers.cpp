@@ -21,14 +21,16 @@ static s32 ApplyDepopMix(std::span<s32> output, const s32 depop_sample,
     auto sample{std::abs(depop_sample)};
     auto decay{decay_.to_raw()};
 
+    // The recurrence depends on the truncated previous sample so it cannot be vectorized, but once
+    // the sample has decayed to 0 it stays there and the rest of the buffer is left untouched.
     if (depop_sample <= 0) {
-        for (u32 i = 0; i < sample_count; i++) {
+        for (u32 i = 0; i < sample_count && sample != 0; i++) {
             sample = static_cast<s32>((static_cast<s64>(sample) * decay) >> 15);
             output[i] -= sample;
         }
         return -sample;
     } else {
-        for (u32 i = 0; i < sample_count; i++) {
+        for (u32 i = 0; i < sample_count && sample != 0; i++) {
             sample = static_cast<s32>((static_cast<s64>(sample) * decay) >> 15);
             output[i] += sample;
         }
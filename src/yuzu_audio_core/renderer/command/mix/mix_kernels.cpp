@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#include <xbyak/xbyak_util.h>
+#define MIX_KERNELS_HAS_SIMD
+#endif
+
+#include "yuzu_audio_core/renderer/command/mix/mix_kernels.h"
+
+#if defined(MIX_KERNELS_HAS_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define MIX_KERNELS_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define MIX_KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MIX_KERNELS_TARGET_SSE41
+#define MIX_KERNELS_TARGET_AVX2
+#endif
+
+namespace AudioCore::Renderer {
+
+namespace {
+
+template <bool Accumulate>
+void GainScalar(s32* output, const s32* input, s64 gain, const s64 ramp, const u32 q,
+                const u32 sample_count) {
+    for (u32 i = 0; i < sample_count; i++) {
+        const s32 sample{RoundFixedSample(static_cast<s64>(input[i]) * gain, q)};
+        if constexpr (Accumulate) {
+            // Wraps on overflow like the vector adds
+            output[i] = static_cast<s32>(static_cast<u32>(output[i]) + static_cast<u32>(sample));
+        } else {
+            output[i] = sample;
+        }
+        gain += ramp;
+    }
+}
+
+#ifdef MIX_KERNELS_HAS_SIMD
+/// Round the 64-bit products of each lane, leaving the 32-bit result in the low half of the lane
+MIX_KERNELS_TARGET_SSE41
+__m128i RoundProductsSSE41(const __m128i products, const __m128i fraction_mask,
+                           const __m128i shift) {
+    const __m128i rounding{_mm_srli_epi64(_mm_and_si128(products, fraction_mask), 1)};
+    return _mm_srl_epi64(_mm_add_epi64(products, rounding), shift);
+}
+
+/// Four samples per step, even and odd samples are multiplied separately and blended back
+template <bool Accumulate>
+MIX_KERNELS_TARGET_SSE41 void GainSSE41(s32* output, const s32* input, const s64 gain,
+                                        const s64 ramp, const u32 q, const u32 sample_count) {
+    const __m128i shift{_mm_cvtsi32_si128(static_cast<int>(q))};
+    const __m128i fraction_mask{_mm_set1_epi64x((s64{1} << q) - 1)};
+    const __m128i step{_mm_set1_epi64x(ramp * 4)};
+    __m128i even_gain{_mm_set_epi64x(gain + ramp * 2, gain)};
+    __m128i odd_gain{_mm_set_epi64x(gain + ramp * 3, gain + ramp)};
+
+    u32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i samples{_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))};
+        const __m128i even{RoundProductsSSE41(_mm_mul_epi32(samples, even_gain), fraction_mask,
+                                              shift)};
+        const __m128i odd{RoundProductsSSE41(
+            _mm_mul_epi32(_mm_srli_epi64(samples, 32), odd_gain), fraction_mask, shift)};
+        __m128i result{_mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC)};
+        if constexpr (Accumulate) {
+            result = _mm_add_epi32(
+                result, _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+        even_gain = _mm_add_epi64(even_gain, step);
+        odd_gain = _mm_add_epi64(odd_gain, step);
+    }
+    GainScalar<Accumulate>(output + i, input + i, gain + ramp * i, ramp, q, sample_count - i);
+}
+
+MIX_KERNELS_TARGET_AVX2
+__m256i RoundProductsAVX2(const __m256i products, const __m256i fraction_mask,
+                          const __m128i shift) {
+    const __m256i rounding{_mm256_srli_epi64(_mm256_and_si256(products, fraction_mask), 1)};
+    return _mm256_srl_epi64(_mm256_add_epi64(products, rounding), shift);
+}
+
+/// Eight samples per step, same scheme as the SSE4.1 kernel
+template <bool Accumulate>
+MIX_KERNELS_TARGET_AVX2 void GainAVX2(s32* output, const s32* input, const s64 gain,
+                                      const s64 ramp, const u32 q, const u32 sample_count) {
+    const __m128i shift{_mm_cvtsi32_si128(static_cast<int>(q))};
+    const __m256i fraction_mask{_mm256_set1_epi64x((s64{1} << q) - 1)};
+    const __m256i step{_mm256_set1_epi64x(ramp * 8)};
+    __m256i even_gain{_mm256_set_epi64x(gain + ramp * 6, gain + ramp * 4, gain + ramp * 2, gain)};
+    __m256i odd_gain{
+        _mm256_set_epi64x(gain + ramp * 7, gain + ramp * 5, gain + ramp * 3, gain + ramp)};
+
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i samples{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i))};
+        const __m256i even{RoundProductsAVX2(_mm256_mul_epi32(samples, even_gain), fraction_mask,
+                                             shift)};
+        const __m256i odd{RoundProductsAVX2(
+            _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), odd_gain), fraction_mask, shift)};
+        __m256i result{_mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA)};
+        if constexpr (Accumulate) {
+            result = _mm256_add_epi32(
+                result, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), result);
+        even_gain = _mm256_add_epi64(even_gain, step);
+        odd_gain = _mm256_add_epi64(odd_gain, step);
+    }
+    GainScalar<Accumulate>(output + i, input + i, gain + ramp * i, ramp, q, sample_count - i);
+}
+#endif
+
+std::vector<GainKernel> DetectGainKernels() {
+    std::vector<GainKernel> kernels{
+        {"Scalar", &GainScalar<true>, &GainScalar<false>},
+    };
+#ifdef MIX_KERNELS_HAS_SIMD
+    const Xbyak::util::Cpu cpu;
+    if (cpu.has(Xbyak::util::Cpu::tSSE41)) {
+        kernels.push_back({"SSE4.1", &GainSSE41<true>, &GainSSE41<false>});
+    }
+    if (cpu.has(Xbyak::util::Cpu::tAVX2)) {
+        kernels.push_back({"AVX2", &GainAVX2<true>, &GainAVX2<false>});
+    }
+#endif
+    return kernels;
+}
+
+} // Anonymous namespace
+
+std::span<const GainKernel> GetGainKernels() {
+    static const std::vector<GainKernel> kernels = DetectGainKernels();
+    return kernels;
+}
+
+bool GainFitsSimd(const s64 gain, const s64 ramp, const u32 sample_count) {
+    constexpr s64 min{std::numeric_limits<s32>::min()};
+    constexpr s64 max{std::numeric_limits<s32>::max()};
+    if (gain < min || gain > max || ramp < min || ramp > max) {
+        return false;
+    }
+    const s64 last_gain{gain + ramp * static_cast<s64>(sample_count)};
+    return last_gain >= min && last_gain <= max;
+}
+
+void MixGainKernel(std::span<s32> output, std::span<const s32> input, const s64 gain,
+                   const s64 ramp, const u32 q, const u32 sample_count) {
+    static const GainKernelFn mix_gain = GetGainKernels().back().mix;
+    if (GainFitsSimd(gain, ramp, sample_count)) {
+        mix_gain(output.data(), input.data(), gain, ramp, q, sample_count);
+    } else {
+        GainScalar<true>(output.data(), input.data(), gain, ramp, q, sample_count);
+    }
+}
+
+void ApplyGainKernel(std::span<s32> output, std::span<const s32> input, const s64 gain,
+                     const s64 ramp, const u32 q, const u32 sample_count) {
+    static const GainKernelFn apply_gain = GetGainKernels().back().apply;
+    if (GainFitsSimd(gain, ramp, sample_count)) {
+        apply_gain(output.data(), input.data(), gain, ramp, q, sample_count);
+    } else {
+        GainScalar<false>(output.data(), input.data(), gain, ramp, q, sample_count);
+    }
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "yuzu_common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/// Gain kernel, see MixGainKernel and ApplyGainKernel for the arguments
+using GainKernelFn = void (*)(s32* output, const s32* input, s64 gain, s64 ramp, u32 q,
+                              u32 sample_count);
+
+struct GainKernel {
+    const char* name;
+    GainKernelFn mix;
+    GainKernelFn apply;
+};
+
+/**
+ * Get the gain kernels the host CPU can run, the scalar kernel first and the fastest last.
+ * Every kernel produces the same output as the scalar one, the SIMD kernels only for gains
+ * accepted by GainFitsSimd.
+ *
+ * @return The supported kernels.
+ */
+std::span<const GainKernel> GetGainKernels();
+
+/**
+ * Check whether every gain along a ramp fits in 32 bits. The SIMD kernels multiply with 32x32->64
+ * bit signed multiplies and are only used when it does. The gain is linear, so checking both ends
+ * suffices.
+ *
+ * @param gain         - Raw fixed point gain applied to the first sample.
+ * @param ramp         - Raw fixed point value added to the gain after every sample.
+ * @param sample_count - Number of samples to process.
+ * @return True if the SIMD kernels can process the ramp.
+ */
+bool GainFitsSimd(s64 gain, s64 ramp, u32 sample_count);
+
+/**
+ * Mix input mix buffer into output mix buffer, with a linearly ramped fixed point gain applied to
+ * the input. Each sample is computed as output[i] += round(input[i] * (gain + i * ramp)), using
+ * the same rounding as Common::FixedPoint::to_int, so results match the scalar FixedPoint loop
+ * bit for bit. SIMD kernels are selected at runtime when the CPU supports them.
+ *
+ * @param output       - Output mix buffer.
+ * @param input        - Input mix buffer.
+ * @param gain         - Raw fixed point gain applied to the first sample.
+ * @param ramp         - Raw fixed point value added to the gain after every sample.
+ * @param q            - Number of fractional bits of gain and ramp.
+ * @param sample_count - Number of samples to process.
+ */
+void MixGainKernel(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp, u32 q,
+                   u32 sample_count);
+
+/**
+ * Apply a linearly ramped fixed point gain to the input mix buffer, saving to the output buffer.
+ * Each sample is computed as output[i] = round(input[i] * (gain + i * ramp)), matching the
+ * scalar FixedPoint loop bit for bit.
+ *
+ * @param output       - Output mix buffer.
+ * @param input        - Input mix buffer.
+ * @param gain         - Raw fixed point gain applied to the first sample.
+ * @param ramp         - Raw fixed point value added to the gain after every sample.
+ * @param q            - Number of fractional bits of gain and ramp.
+ * @param sample_count - Number of samples to process.
+ */
+void ApplyGainKernel(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp, u32 q,
+                     u32 sample_count);
+
+/**
+ * Round a raw fixed point sample with q fractional bits to an integer sample, the same way
+ * Common::FixedPoint::to_int does.
+ *
+ * @param sample - Raw fixed point sample.
+ * @param q      - Number of fractional bits.
+ * @return The rounded integer sample.
+ */
+constexpr s32 RoundFixedSample(s64 sample, u32 q) {
+    const s64 fraction_mask{(s64{1} << q) - 1};
+    sample += (sample & fraction_mask) >> 1;
+    return static_cast<s32>(sample >> q);
+}
+
+} // namespace AudioCore::Renderer
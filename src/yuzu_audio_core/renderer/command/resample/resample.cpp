@@ -1,10 +1,226 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#include <xbyak/xbyak_util.h>
+#define RESAMPLE_HAS_SIMD
+#endif
+
 #include "yuzu_audio_core/renderer/command/resample/resample.h"
 
+#if defined(RESAMPLE_HAS_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define RESAMPLE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define RESAMPLE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define RESAMPLE_TARGET_SSE41
+#define RESAMPLE_TARGET_AVX2
+#endif
+
 namespace AudioCore::Renderer {
 
+namespace {
+
+/**
+ * Read position and LUT phase of the polyphase filters. Steps exactly like the
+ * FixedPoint<49, 15> fraction does, so the kernels can compute the positions of several output
+ * samples up front.
+ */
+struct FilterCursor {
+    template <u32 Taps>
+    u32 LutIndex() const {
+        return static_cast<u32>((fraction & 0x7FFF) >> 8) * Taps;
+    }
+
+    void Advance() {
+        fraction += ratio;
+        read_index += static_cast<u32>(fraction >> 15);
+        fraction &= 0x7FFF;
+    }
+
+    s64 ratio;
+    s64 fraction;
+    u32 read_index;
+};
+
+using FilterKernelFn = void (*)(s32*, const s16*, const f32*, FilterCursor&, u32);
+
+template <u32 Taps>
+void FilterScalar(s32* output, const s16* input, const f32* lut, FilterCursor& cursor,
+                  const u32 sample_count) {
+    for (u32 i = 0; i < sample_count; i++) {
+        const auto samples{input + cursor.read_index};
+        const auto taps{lut + cursor.LutIndex<Taps>()};
+        s64 sum{0};
+        for (u32 tap = 0; tap < Taps; tap++) {
+            sum += Common::FixedPoint<56, 8>{samples[tap] * taps[tap]}.to_raw();
+        }
+        output[i] = Common::FixedPoint<56, 8>::from_base(sum).to_int_floor();
+        cursor.Advance();
+    }
+}
+
+#ifdef RESAMPLE_HAS_SIMD
+/**
+ * The kernels below make the same float multiplies as the scalar filter and truncate every tap
+ * to 8 fractional bits on its own before summing in integers, so the output is bit exact. Taps
+ * fit in 24 bits, so 32-bit lanes cannot overflow.
+ */
+RESAMPLE_TARGET_SSE41
+__m128i FixedTapsSSE41(const s16* input, const f32* lut) {
+    const __m128i samples{
+        _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)))};
+    const __m128 products{_mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_loadu_ps(lut))};
+    return _mm_cvttps_epi32(_mm_mul_ps(products, _mm_set1_ps(256.0f)));
+}
+
+template <u32 Taps>
+RESAMPLE_TARGET_SSE41 __m128i OutputTapsSSE41(const s16* input, const f32* lut) {
+    if constexpr (Taps == 4) {
+        return FixedTapsSSE41(input, lut);
+    } else {
+        return _mm_add_epi32(FixedTapsSSE41(input, lut), FixedTapsSSE41(input + 4, lut + 4));
+    }
+}
+
+/// Four output samples per step, their taps are summed with a horizontal add tree
+template <u32 Taps>
+RESAMPLE_TARGET_SSE41 void FilterSSE41(s32* output, const s16* input, const f32* lut,
+                                       FilterCursor& cursor, const u32 sample_count) {
+    u32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        std::array<__m128i, 4> taps;
+        for (auto& output_taps : taps) {
+            output_taps =
+                OutputTapsSSE41<Taps>(input + cursor.read_index, lut + cursor.LutIndex<Taps>());
+            cursor.Advance();
+        }
+        const __m128i sums{_mm_hadd_epi32(_mm_hadd_epi32(taps[0], taps[1]),
+                                          _mm_hadd_epi32(taps[2], taps[3]))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_srai_epi32(sums, 8));
+    }
+    FilterScalar<Taps>(output + i, input, lut, cursor, sample_count - i);
+}
+
+/// Fixed point taps of two 4 tap output samples, or of one 8 tap output sample
+template <u32 Taps>
+RESAMPLE_TARGET_AVX2 __m256i FixedTapsAVX2(const s16* input, const f32* lut,
+                                           FilterCursor& cursor) {
+    __m256i samples;
+    __m256 taps;
+    if constexpr (Taps == 4) {
+        const auto first_input{input + cursor.read_index};
+        const auto first_lut{lut + cursor.LutIndex<Taps>()};
+        cursor.Advance();
+        const auto second_input{input + cursor.read_index};
+        const auto second_lut{lut + cursor.LutIndex<Taps>()};
+        cursor.Advance();
+        samples = _mm256_cvtepi16_epi32(
+            _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(first_input)),
+                               _mm_loadl_epi64(reinterpret_cast<const __m128i*>(second_input))));
+        taps = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(first_lut)),
+                                    _mm_loadu_ps(second_lut), 1);
+    } else {
+        samples = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + cursor.read_index)));
+        taps = _mm256_loadu_ps(lut + cursor.LutIndex<Taps>());
+        cursor.Advance();
+    }
+    const __m256 products{_mm256_mul_ps(_mm256_cvtepi32_ps(samples), taps)};
+    return _mm256_cvttps_epi32(_mm256_mul_ps(products, _mm256_set1_ps(256.0f)));
+}
+
+/// Eight output samples per step
+template <u32 Taps>
+RESAMPLE_TARGET_AVX2 void FilterAVX2(s32* output, const s16* input, const f32* lut,
+                                     FilterCursor& cursor, const u32 sample_count) {
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        __m256i sums;
+        if constexpr (Taps == 4) {
+            std::array<__m256i, 4> taps;
+            for (auto& output_taps : taps) {
+                output_taps = FixedTapsAVX2<Taps>(input, lut, cursor);
+            }
+            // Lanes hold outputs 0, 2, 4, 6 and 1, 3, 5, 7 after the add tree
+            const __m256i interleaved{_mm256_hadd_epi32(_mm256_hadd_epi32(taps[0], taps[1]),
+                                                        _mm256_hadd_epi32(taps[2], taps[3]))};
+            sums = _mm256_permutevar8x32_epi32(interleaved,
+                                               _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+        } else {
+            std::array<__m256i, 8> taps;
+            for (auto& output_taps : taps) {
+                output_taps = FixedTapsAVX2<Taps>(input, lut, cursor);
+            }
+            // Each lane holds half of the taps of four outputs, fold the lanes together
+            const __m256i low{_mm256_hadd_epi32(_mm256_hadd_epi32(taps[0], taps[1]),
+                                                _mm256_hadd_epi32(taps[2], taps[3]))};
+            const __m256i high{_mm256_hadd_epi32(_mm256_hadd_epi32(taps[4], taps[5]),
+                                                 _mm256_hadd_epi32(taps[6], taps[7]))};
+            sums = _mm256_add_epi32(_mm256_permute2x128_si256(low, high, 0x20),
+                                    _mm256_permute2x128_si256(low, high, 0x31));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_srai_epi32(sums, 8));
+    }
+    FilterScalar<Taps>(output + i, input, lut, cursor, sample_count - i);
+}
+#endif
+
+/**
+ * Run a polyphase filter kernel over the input.
+ *
+ * @tparam Taps             - Number of taps per output sample, 4 or 8.
+ * @tparam Kernel           - Filter kernel to run.
+ * @param output            - Output buffer.
+ * @param input             - Input buffer.
+ * @param lut               - Filter taps, Taps entries for each of the 128 phases.
+ * @param sample_rate_ratio - Ratio for resampling.
+ * @param fraction          - Current read fraction, updated.
+ * @param samples_to_write  - Number of samples to write.
+ */
+template <u32 Taps, FilterKernelFn Kernel>
+void ApplyPolyphaseFilter(std::span<s32> output, std::span<const s16> input,
+                          std::span<const f32> lut,
+                          const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                          Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
+    FilterCursor cursor{
+        .ratio = sample_rate_ratio.to_raw(),
+        .fraction = fraction.to_raw(),
+        .read_index = 0,
+    };
+    Kernel(output.data(), input.data(), lut.data(), cursor, samples_to_write);
+    fraction = Common::FixedPoint<49, 15>::from_base(cursor.fraction);
+}
+
+std::vector<PolyphaseFilter> DetectPolyphaseFilters() {
+    std::vector<PolyphaseFilter> filters{
+        {"Scalar", &ApplyPolyphaseFilter<4, &FilterScalar<4>>,
+         &ApplyPolyphaseFilter<8, &FilterScalar<8>>},
+    };
+#ifdef RESAMPLE_HAS_SIMD
+    const Xbyak::util::Cpu cpu;
+    if (cpu.has(Xbyak::util::Cpu::tSSE41)) {
+        filters.push_back({"SSE4.1", &ApplyPolyphaseFilter<4, &FilterSSE41<4>>,
+                           &ApplyPolyphaseFilter<8, &FilterSSE41<8>>});
+    }
+    if (cpu.has(Xbyak::util::Cpu::tAVX2)) {
+        filters.push_back({"AVX2", &ApplyPolyphaseFilter<4, &FilterAVX2<4>>,
+                           &ApplyPolyphaseFilter<8, &FilterAVX2<8>>});
+    }
+#endif
+    return filters;
+}
+
+} // Anonymous namespace
+
+std::span<const PolyphaseFilter> GetPolyphaseFilters() {
+    static const std::vector<PolyphaseFilter> filters = DetectPolyphaseFilters();
+    return filters;
+}
+
 static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input,
                                const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
@@ -292,19 +508,8 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 4};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        output[i] = (sample0 + sample1 + sample2 + sample3).to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    static const PolyphaseFilterFn filter = GetPolyphaseFilters().back().four_tap;
+    filter(output, input, get_lut(), sample_rate_ratio, fraction, samples_to_write);
 }
 
 static void ResampleHighQuality(std::span<s32> output, std::span<const s16> input,
@@ -842,24 +1047,8 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 8};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        const Common::FixedPoint<56, 8> sample4{input[read_index + 4] * lut[lut_index + 4]};
-        const Common::FixedPoint<56, 8> sample5{input[read_index + 5] * lut[lut_index + 5]};
-        const Common::FixedPoint<56, 8> sample6{input[read_index + 6] * lut[lut_index + 6]};
-        const Common::FixedPoint<56, 8> sample7{input[read_index + 7] * lut[lut_index + 7]};
-        output[i] = (sample0 + sample1 + sample2 + sample3 + sample4 + sample5 + sample6 + sample7)
-                        .to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    static const PolyphaseFilterFn filter = GetPolyphaseFilters().back().eight_tap;
+    filter(output, input, get_lut(), sample_rate_ratio, fraction, samples_to_write);
 }
 
 void Resample(std::span<s32> output, std::span<const s16> input,
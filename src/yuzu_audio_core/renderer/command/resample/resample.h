@@ -10,6 +10,28 @@
 #include "yuzu_common/fixed_point.h"
 
 namespace AudioCore::Renderer {
+
+/// Polyphase filter, lut holds the taps of each of the 128 phases. See Resample for the others.
+using PolyphaseFilterFn = void (*)(std::span<s32> output, std::span<const s16> input,
+                                   std::span<const f32> lut,
+                                   const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                                   Common::FixedPoint<49, 15>& fraction, u32 samples_to_write);
+
+struct PolyphaseFilter {
+    const char* name;
+    PolyphaseFilterFn four_tap;
+    PolyphaseFilterFn eight_tap;
+};
+
+/**
+ * Get the polyphase filters of the medium and high quality resamplers the host CPU can run, the
+ * scalar filter first and the fastest last. Every filter produces the same output as the scalar
+ * one.
+ *
+ * @return The supported filters.
+ */
+std::span<const PolyphaseFilter> GetPolyphaseFilters();
+
 /**
  * Resample an input buffer into an output buffer, according to the sample_rate_ratio.
  *
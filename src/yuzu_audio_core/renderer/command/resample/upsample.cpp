@@ -2,23 +2,72 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#include <xbyak/xbyak_util.h>
+#define UPSAMPLE_HAS_SIMD
+#endif
 
 #include "yuzu_audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "yuzu_audio_core/renderer/command/resample/upsample.h"
 #include "yuzu_audio_core/renderer/upsampler/upsampler_info.h"
 
+#if defined(UPSAMPLE_HAS_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define UPSAMPLE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define UPSAMPLE_TARGET_SSE41
+#endif
+
 namespace AudioCore::Renderer {
+
+namespace {
+
+/// Number of taps of the upsampling filter, it spans the whole history
+constexpr u32 FilterTaps = UpsamplerState::HistorySize;
+
+using DotProductFn = s64 (*)(const s32*, const s32*);
+
+s64 DotProductScalar(const s32* samples, const s32* kernel) {
+    s64 result{0};
+    for (u32 i = 0; i < FilterTaps; i++) {
+        result += static_cast<s64>(samples[i]) * kernel[i];
+    }
+    return result;
+}
+
+#ifdef UPSAMPLE_HAS_SIMD
+/// Even and odd taps are multiplied into separate 64-bit accumulators
+UPSAMPLE_TARGET_SSE41
+s64 DotProductSSE41(const s32* samples, const s32* kernel) {
+    static_assert(FilterTaps % 4 == 0);
+    __m128i even{_mm_setzero_si128()};
+    __m128i odd{_mm_setzero_si128()};
+    for (u32 i = 0; i < FilterTaps; i += 4) {
+        const __m128i a{_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i))};
+        const __m128i b{_mm_loadu_si128(reinterpret_cast<const __m128i*>(kernel + i))};
+        even = _mm_add_epi64(even, _mm_mul_epi32(a, b));
+        odd = _mm_add_epi64(odd, _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)));
+    }
+    const __m128i sum{_mm_add_epi64(even, odd)};
+    return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+}
+#endif
+
 /**
  * Upsampling impl. Input must be 8K, 16K or 32K, output is 48K.
  *
+ * @tparam DotProduct         - Dot product of the history window and a filter kernel.
  * @param output              - Output buffer.
  * @param input               - Input buffer.
  * @param target_sample_count - Number of samples for output.
  * @param state               - Upsampler state, updated each call.
  */
-static void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
-                            const u32 target_sample_count, const u32 source_sample_count,
-                            UpsamplerState* state) {
+template <DotProductFn DotProduct>
+void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
+                     const u32 target_sample_count, const u32 source_sample_count,
+                     UpsamplerState* state) {
     static constexpr u32 WindowSize = 10;
     static constexpr std::array<Common::FixedPoint<17, 15>, WindowSize> WindowedSinc1{
         0.95376587f,   -0.12872314f, 0.060028076f,  -0.032470703f, 0.017669678f,
@@ -41,6 +90,23 @@ static void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
         -0.005584717f, 0.0024108887f, -0.0008239746f, 0.00021362305f, 0.0f,
     };
 
+    // Each output is coeffs1 applied backwards from the output index and coeffs2 forwards from
+    // the sample after it. Those 20 taps cover the whole history ring, so read from the oldest
+    // sample onwards they become a single kernel over contiguous samples.
+    static constexpr auto make_kernel = [](const auto& coeffs1, const auto& coeffs2) {
+        std::array<s32, FilterTaps> kernel{};
+        for (u32 i = 0; i < WindowSize; i++) {
+            kernel[WindowSize - 1 - i] = coeffs1[i].to_raw();
+            kernel[WindowSize + i] = coeffs2[i].to_raw();
+        }
+        return kernel;
+    };
+    static constexpr auto SincKernel15{make_kernel(WindowedSinc1, WindowedSinc5)};
+    static constexpr auto SincKernel24{make_kernel(WindowedSinc2, WindowedSinc4)};
+    static constexpr auto SincKernel33{make_kernel(WindowedSinc3, WindowedSinc3)};
+    static constexpr auto SincKernel42{make_kernel(WindowedSinc4, WindowedSinc2)};
+    static constexpr auto SincKernel51{make_kernel(WindowedSinc5, WindowedSinc1)};
+
     if (!state->initialized) {
         switch (source_sample_count) {
         case 40:
@@ -83,38 +149,28 @@ static void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
 
     u32 read_index{0};
 
+    // The history ring is mirrored twice in a row, so the HistorySize samples starting at the
+    // input index (the oldest sample) are always contiguous. This relies on history_start_index
+    // and history_end_index spanning the whole ring, which they always do.
+    std::array<s32, UpsamplerState::HistorySize * 2> window;
+    for (u32 i = 0; i < UpsamplerState::HistorySize; i++) {
+        window[i] = state->history[i].to_raw();
+        window[i + UpsamplerState::HistorySize] = window[i];
+    }
+
     auto increment = [&]() -> void {
-        state->history[state->history_input_index] = input[read_index++];
+        auto& sample{state->history[state->history_input_index]};
+        sample = input[read_index++];
+        window[state->history_input_index] = sample.to_raw();
+        window[state->history_input_index + UpsamplerState::HistorySize] = sample.to_raw();
         state->history_input_index =
             static_cast<u16>((state->history_input_index + 1) % UpsamplerState::HistorySize);
         state->history_output_index =
             static_cast<u16>((state->history_output_index + 1) % UpsamplerState::HistorySize);
     };
 
-    auto calculate_sample = [&state](std::span<const Common::FixedPoint<17, 15>> coeffs1,
-                                     std::span<const Common::FixedPoint<17, 15>> coeffs2) -> s32 {
-        auto output_index{state->history_output_index};
-        u64 result{0};
-
-        for (u32 coeff_index = 0; coeff_index < 10; coeff_index++) {
-            result += static_cast<u64>(state->history[output_index].to_raw()) *
-                      coeffs1[coeff_index].to_raw();
-
-            output_index = output_index == state->history_start_index ? state->history_end_index
-                                                                      : output_index - 1;
-        }
-
-        output_index =
-            static_cast<u16>((state->history_output_index + 1) % UpsamplerState::HistorySize);
-
-        for (u32 coeff_index = 0; coeff_index < 10; coeff_index++) {
-            result += static_cast<u64>(state->history[output_index].to_raw()) *
-                      coeffs2[coeff_index].to_raw();
-
-            output_index = output_index == state->history_end_index ? state->history_start_index
-                                                                    : output_index + 1;
-        }
-
+    auto calculate_sample = [&](const std::array<s32, FilterTaps>& kernel) -> s32 {
+        const s64 result{DotProduct(window.data() + state->history_input_index, kernel.data())};
         return static_cast<s32>(result >> (8 + 15));
     };
 
@@ -129,23 +185,23 @@ static void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
                 break;
 
             case 1:
-                output[write_index] = calculate_sample(WindowedSinc1, WindowedSinc5);
+                output[write_index] = calculate_sample(SincKernel15);
                 break;
 
             case 2:
-                output[write_index] = calculate_sample(WindowedSinc2, WindowedSinc4);
+                output[write_index] = calculate_sample(SincKernel24);
                 break;
 
             case 3:
-                output[write_index] = calculate_sample(WindowedSinc3, WindowedSinc3);
+                output[write_index] = calculate_sample(SincKernel33);
                 break;
 
             case 4:
-                output[write_index] = calculate_sample(WindowedSinc4, WindowedSinc2);
+                output[write_index] = calculate_sample(SincKernel42);
                 break;
 
             case 5:
-                output[write_index] = calculate_sample(WindowedSinc5, WindowedSinc1);
+                output[write_index] = calculate_sample(SincKernel51);
                 break;
             }
             state->sample_index = static_cast<u8>((state->sample_index + 1) % 6);
@@ -162,11 +218,11 @@ static void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
                 break;
 
             case 1:
-                output[write_index] = calculate_sample(WindowedSinc2, WindowedSinc4);
+                output[write_index] = calculate_sample(SincKernel24);
                 break;
 
             case 2:
-                output[write_index] = calculate_sample(WindowedSinc4, WindowedSinc2);
+                output[write_index] = calculate_sample(SincKernel42);
                 break;
             }
             state->sample_index = static_cast<u8>((state->sample_index + 1) % 3);
@@ -183,12 +239,12 @@ static void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
                 break;
 
             case 1:
-                output[write_index] = calculate_sample(WindowedSinc4, WindowedSinc2);
+                output[write_index] = calculate_sample(SincKernel42);
                 break;
 
             case 2:
                 increment();
-                output[write_index] = calculate_sample(WindowedSinc2, WindowedSinc4);
+                output[write_index] = calculate_sample(SincKernel24);
                 break;
             }
             state->sample_index = static_cast<u8>((state->sample_index + 1) % 3);
@@ -198,6 +254,26 @@ static void SrcProcessFrame(std::span<s32> output, std::span<const s32> input,
     }
 }
 
+std::vector<UpsampleKernel> DetectUpsampleKernels() {
+    std::vector<UpsampleKernel> kernels{
+        {"Scalar", &SrcProcessFrame<&DotProductScalar>},
+    };
+#ifdef UPSAMPLE_HAS_SIMD
+    const Xbyak::util::Cpu cpu;
+    if (cpu.has(Xbyak::util::Cpu::tSSE41)) {
+        kernels.push_back({"SSE4.1", &SrcProcessFrame<&DotProductSSE41>});
+    }
+#endif
+    return kernels;
+}
+
+} // Anonymous namespace
+
+std::span<const UpsampleKernel> GetUpsampleKernels() {
+    static const std::vector<UpsampleKernel> kernels = DetectUpsampleKernels();
+    return kernels;
+}
+
 auto UpsampleCommand::Dump([[maybe_unused]] const AudioRenderer::CommandListProcessor& processor,
                            std::string& string) -> void {
     string += fmt::format("UpsampleCommand\n\tsource_sample_count {} source_sample_rate {}",
@@ -217,6 +293,7 @@ void UpsampleCommand::Process(const AudioRenderer::CommandListProcessor& process
     const auto info{reinterpret_cast<UpsamplerInfo*>(upsampler_info)};
     const auto input_count{std::min(info->input_count, buffer_count)};
     const std::span<const s16> inputs_{reinterpret_cast<const s16*>(inputs), input_count};
+    static const UpsampleFrameFn process_frame = GetUpsampleKernels().back().process_frame;
 
     for (u32 i = 0; i < input_count; i++) {
         const auto channel{inputs_[i]};
@@ -229,7 +306,7 @@ void UpsampleCommand::Process(const AudioRenderer::CommandListProcessor& process
             auto input{processor.mix_buffers.subspan(channel * processor.sample_count,
                                                      processor.sample_count)};
 
-            SrcProcessFrame(output, input, info->sample_count, source_sample_count, state);
+            process_frame(output, input, info->sample_count, source_sample_count, state);
         }
     }
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 
 #include "yuzu_audio_core/renderer/command/icommand.h"
@@ -13,6 +14,33 @@ class CommandListProcessor;
 }
 
 namespace AudioCore::Renderer {
+struct UpsamplerState;
+
+/**
+ * Upsample one frame of a mix buffer. Input must be 8K, 16K or 32K, output is 48K.
+ *
+ * @param output              - Output buffer.
+ * @param input               - Input buffer.
+ * @param target_sample_count - Number of samples for output.
+ * @param source_sample_count - Number of input samples per frame, selects the ratio.
+ * @param state               - Upsampler state, updated each call.
+ */
+using UpsampleFrameFn = void (*)(std::span<s32> output, std::span<const s32> input,
+                                 u32 target_sample_count, u32 source_sample_count,
+                                 UpsamplerState* state);
+
+struct UpsampleKernel {
+    const char* name;
+    UpsampleFrameFn process_frame;
+};
+
+/**
+ * Get the upsamplers the host CPU can run, the scalar one first and the fastest last. Every
+ * upsampler produces the same output and state as the scalar one.
+ *
+ * @return The supported upsamplers.
+ */
+std::span<const UpsampleKernel> GetUpsampleKernels();
 
 /**
  * AudioRenderer command for upsampling a mix buffer to 48Khz.
@@ -29,6 +29,8 @@
 #include "yuzu_audio_core/renderer/voice/voice_info.h"
 #include "yuzu_audio_core/renderer/voice/voice_state.h"
 #include "yuzu_common/alignment.h"
+#include "yuzu_common/fs/path_util.h"
+#include "yuzu_common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_event.h"
@@ -131,8 +133,11 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
     render_device = params.rendering_device;
     execution_mode = params.execution_mode;
 
-    process_handle->GetMemory().ZeroBlock(transfer_memory->GetSourceAddress(),
-                                          transfer_memory_size);
+    // A replayed session has no guest transfer memory
+    if (transfer_memory != nullptr) {
+        process_handle->GetMemory().ZeroBlock(transfer_memory->GetSourceAddress(),
+                                              transfer_memory_size);
+    }
 
     // Note: We're not actually using the transfer memory because it's a pain to code for.
     // Allocate the memory normally instead and hope the game doesn't try to read anything back
@@ -394,6 +399,13 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
                                                                      mix_buffer_count);
     }
 
+    if (Settings::values.audio_capture_updates.GetValue()) {
+        const auto path{fmt::format("{}/audio/renderer_{:016X}_{}.bin",
+                                    Common::FS::GetYuzuPathString(Common::FS::YuzuPath::DumpDir),
+                                    applet_resource_user_id, session_id)};
+        update_capture.Open(path, params, applet_resource_user_id, session_id);
+    }
+
     initialized = true;
     return ResultSuccess;
 }
@@ -408,6 +420,7 @@ void System::Finalize() {
     }
 
     applet_resource_user_id = 0;
+    update_capture.Close();
 
     PoolMapper pool_mapper(process_handle, false);
     pool_mapper.Unmap(memory_pool_info);
@@ -537,6 +550,8 @@ Result System::Update(std::span<const u8> input, std::span<u8> performance, std:
         return result;
     }
 
+    update_capture.WriteUpdate(input, output.size(), performance.size());
+
     adsp_rendered_event->Clear();
     num_times_updated++;
 
@@ -638,9 +653,14 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
     auto command_list_header{reinterpret_cast<CommandListHeader*>(in_command_buffer.data())};
 
     command_list_header->buffer_count = static_cast<s16>(voice_channels + mix_buffer_count);
+    command_list_header->mix_buffer_count = static_cast<s16>(mix_buffer_count);
     command_list_header->sample_count = sample_count;
     command_list_header->sample_rate = sample_rate;
     command_list_header->samples_buffer = samples_workbuffer;
+    command_list_header->capture = update_capture.IsOpen() ? &update_capture : nullptr;
+    if (command_list_header->capture != nullptr) {
+        update_capture.WriteCommandList();
+    }
 
     const auto performance_initialized{performance_manager.IsInitialized()};
     if (performance_initialized) {
@@ -689,6 +709,7 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
 
     voice_context.SortInfo();
     command_generator.GenerateVoiceCommands();
+    command_list_header->voice_command_count = command_buffer.count;
 
     const auto start_estimated_time{drop_voice_param *
                                     static_cast<f32>(command_buffer.estimated_process_time)};
@@ -8,6 +8,7 @@
 #include <span>
 
 #include "yuzu_audio_core/renderer/behavior/behavior_info.h"
+#include "yuzu_audio_core/renderer/capture/update_capture.h"
 #include "yuzu_audio_core/renderer/command/command_processing_time_estimator.h"
 #include "yuzu_audio_core/renderer/effect/effect_context.h"
 #include "yuzu_audio_core/renderer/memory/memory_pool_info.h"
@@ -72,7 +73,8 @@ public:
      * RequestUpdate.
      *
      * @param params                  - Input parameters to initialize the system with.
-     * @param transfer_memory         - Game-supplied memory for all workbuffers. Unused.
+     * @param transfer_memory         - Game-supplied memory for all workbuffers. Unused, may be
+     *                                  null.
      * @param transfer_memory_size    - Size of the transfer memory. Unused.
      * @param process_handle          - Process handle, also used for memory.
      * @param applet_resource_user_id - Applet id for this renderer. Unused.
@@ -323,6 +325,8 @@ private:
     u64 render_start_tick{};
     /// Parameter to control the threshold for dropping voices if the audio graph gets too large
     f32 drop_voice_param{1.0f};
+    /// Capture of the updates, written when audio_capture_updates is enabled
+    UpdateCapture update_capture{};
 };
 
 } // namespace Renderer
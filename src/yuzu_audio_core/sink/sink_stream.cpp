@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <memory>
@@ -12,6 +13,7 @@
 #include "yuzu_audio_core/sink/sink_stream.h"
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/fixed_point.h"
+#include "yuzu_common/logging/log.h"
 #include "yuzu_common/scope_exit.h"
 #include "yuzu_common/settings.h"
 #include "core/core.h"
@@ -77,7 +79,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
                 static_cast<s16>(std::clamp(right_sample, min, max));
         }
 
-        samples_buffer.Push(samples.subspan(0, samples.size() / system_channels * device_channels));
+        PushSamples(samples.subspan(0, samples.size() / system_channels * device_channels));
         return;
     }
 
@@ -85,7 +87,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
         // We need moar samples! Not all games will provide 6 channel audio.
         // TODO: Implement some upmixing here. Currently just passthrough, with other
         // channels left as silence.
-        std::vector<s16> new_samples(samples.size() / system_channels * device_channels);
+        upmix_samples.assign(samples.size() / system_channels * device_channels, 0);
 
         for (u32 read_index = 0, write_index = 0; read_index < samples.size();
              read_index += system_channels, write_index += device_channels) {
@@ -95,7 +97,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
                     volume),
                 min, max))};
 
-            new_samples[write_index + static_cast<u32>(Channels::FrontLeft)] = left_sample;
+            upmix_samples[write_index + static_cast<u32>(Channels::FrontLeft)] = left_sample;
 
             const auto right_sample{static_cast<s16>(std::clamp(
                 static_cast<s32>(
@@ -103,10 +105,10 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
                     volume),
                 min, max))};
 
-            new_samples[write_index + static_cast<u32>(Channels::FrontRight)] = right_sample;
+            upmix_samples[write_index + static_cast<u32>(Channels::FrontRight)] = right_sample;
         }
 
-        samples_buffer.Push(new_samples);
+        PushSamples(upmix_samples);
         return;
     }
 
@@ -117,14 +119,20 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
         }
     }
 
-    samples_buffer.Push(samples);
+    PushSamples(samples);
 }
 
-std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
+void SinkStream::PushSamples(std::span<const s16> samples) {
+    if (samples_buffer.Push(samples) < samples.size()) {
+        overrun_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void SinkStream::ReleaseBuffer(std::span<s16> output) {
     constexpr s32 min = std::numeric_limits<s16>::min();
     constexpr s32 max = std::numeric_limits<s16>::max();
 
-    auto samples{samples_buffer.Pop(num_samples)};
+    const auto samples{output.first(samples_buffer.Pop(output.data(), output.size()))};
 
     // TODO: Up-mix to 6 channels if the game expects it.
     // For audio input this is unlikely to ever be the case though.
@@ -137,10 +145,7 @@ std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
             std::clamp(static_cast<s32>(static_cast<f32>(samples[i]) * volume), min, max));
     }
 
-    if (samples.size() < num_samples) {
-        samples.resize(num_samples, 0);
-    }
-    return samples;
+    std::fill(output.begin() + samples.size(), output.end(), s16{0});
 }
 
 void SinkStream::ClearQueue() {
@@ -170,8 +175,8 @@ void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t n
             if (!queue.try_dequeue(playing_buffer)) {
                 // If no buffer was available we've underrun, just push the samples and
                 // continue.
-                samples_buffer.Push(&input_buffer[frames_written * frame_size],
-                                    (num_frames - frames_written) * frame_size);
+                PushSamples(input_buffer.subspan(frames_written * frame_size,
+                                                 (num_frames - frames_written) * frame_size));
                 frames_written = num_frames;
                 continue;
             }
@@ -184,8 +189,8 @@ void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t n
         size_t frames_available{std::min<u64>(playing_buffer.frames - playing_buffer.frames_played,
                                               num_frames - frames_written)};
 
-        samples_buffer.Push(&input_buffer[frames_written * frame_size],
-                            frames_available * frame_size);
+        PushSamples(input_buffer.subspan(frames_written * frame_size,
+                                         frames_available * frame_size));
 
         frames_written += frames_available;
         playing_buffer.frames_played += frames_available;
@@ -201,6 +206,15 @@ void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t n
 }
 
 void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::size_t num_frames) {
+    // The backend owns the callback thread, promote it the first time it calls in
+    if (Settings::values.audio_realtime_priority.GetValue()) {
+        thread_local bool realtime_requested{false};
+        if (!realtime_requested) {
+            realtime_requested = true;
+            Common::SetCurrentThreadRealtime();
+        }
+    }
+
     const std::size_t num_channels = GetDeviceChannels();
     const std::size_t frame_size = num_channels;
     const std::size_t frame_size_bytes = frame_size * sizeof(s16);
@@ -211,10 +225,7 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
     // paused and we'll desync, so just play silence.
     if (system.IsPaused() || system.IsShuttingDown()) {
         if (system.IsShuttingDown()) {
-            {
-                std::scoped_lock lk{release_mutex};
-                queued_buffers.store(0);
-            }
+            queued_buffers.store(0);
             release_cv.notify_one();
         }
 
@@ -231,17 +242,17 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
             if (!queue.try_dequeue(playing_buffer)) {
                 // If no buffer was available we've underrun, fill the remaining buffer with
                 // the last written frame and continue.
+                underrun_count.fetch_add(1, std::memory_order_relaxed);
                 for (size_t i = frames_written; i < num_frames; i++) {
                     std::memcpy(&output_buffer[i * frame_size], &last_frame[0], frame_size_bytes);
                 }
                 frames_written = num_frames;
                 continue;
             }
-            // Successfully dequeued a new buffer.
+            // Successfully dequeued a new buffer. The waiter polls at the callback period, so
+            // a notification racing with it going to sleep is only delayed, and this real-time
+            // thread never blocks on its mutex.
             queued_buffers--;
-
-            { std::unique_lock lk{release_mutex}; }
-
             release_cv.notify_one();
         }
 
@@ -250,8 +261,14 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         size_t frames_available{std::min<u64>(playing_buffer.frames - playing_buffer.frames_played,
                                               num_frames - frames_written)};
 
-        samples_buffer.Pop(&output_buffer[frames_written * frame_size],
-                           frames_available * frame_size);
+        const size_t samples_wanted{frames_available * frame_size};
+        const size_t samples_popped{
+            samples_buffer.Pop(&output_buffer[frames_written * frame_size], samples_wanted)};
+        if (samples_popped < samples_wanted) {
+            underrun_count.fetch_add(1, std::memory_order_relaxed);
+            std::fill_n(&output_buffer[frames_written * frame_size + samples_popped],
+                        samples_wanted - samples_popped, s16{0});
+        }
 
         frames_written += frames_available;
         actual_frames_written += frames_available;
@@ -267,23 +284,40 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
     std::memcpy(&last_frame[0], &output_buffer[(frames_written - 1) * frame_size],
                 frame_size_bytes);
 
-    {
-        std::scoped_lock lk{sample_count_lock};
-        last_sample_count_update_time = system.CoreTiming().GetGlobalTimeNs();
-        min_played_sample_count = max_played_sample_count;
-        max_played_sample_count += actual_frames_written;
-    }
+    // Single writer sequence lock, readers retry instead of blocking this thread
+    const u32 sequence{sample_count_sequence.load(std::memory_order_relaxed)};
+    sample_count_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const u64 played{max_played_sample_count.load(std::memory_order_relaxed)};
+    last_sample_count_update_time.store(system.CoreTiming().GetGlobalTimeNs().count(),
+                                        std::memory_order_relaxed);
+    min_played_sample_count.store(played, std::memory_order_relaxed);
+    max_played_sample_count.store(played + actual_frames_written, std::memory_order_relaxed);
+    sample_count_sequence.store(sequence + 2, std::memory_order_release);
 }
 
 u64 SinkStream::GetExpectedPlayedSampleCount() {
-    std::scoped_lock lk{sample_count_lock};
+    u64 min_played{};
+    u64 max_played{};
+    std::chrono::nanoseconds last_update_time{};
+    u32 sequence{};
+    do {
+        sequence = sample_count_sequence.load(std::memory_order_acquire);
+        min_played = min_played_sample_count.load(std::memory_order_relaxed);
+        max_played = max_played_sample_count.load(std::memory_order_relaxed);
+        last_update_time = std::chrono::nanoseconds{
+            last_sample_count_update_time.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 ||
+             sequence != sample_count_sequence.load(std::memory_order_relaxed));
+
     auto cur_time{system.CoreTiming().GetGlobalTimeNs()};
-    auto time_delta{cur_time - last_sample_count_update_time};
-    auto exp_played_sample_count{min_played_sample_count +
+    auto time_delta{cur_time - last_update_time};
+    auto exp_played_sample_count{min_played +
                                  (TargetSampleRate * time_delta) / std::chrono::seconds{1}};
 
     // Add 15ms of latency in sample reporting to allow for some leeway in scheduler timings
-    return std::min<u64>(exp_played_sample_count, max_played_sample_count) + TargetSampleCount * 3;
+    return std::min<u64>(exp_played_sample_count, max_played) + TargetSampleCount * 3;
 }
 
 void SinkStream::WaitFreeSpace(std::stop_token stop_token) {
@@ -291,9 +325,37 @@ void SinkStream::WaitFreeSpace(std::stop_token stop_token) {
     release_cv.wait_for(lk, std::chrono::milliseconds(5),
                         [this]() { return paused || queued_buffers < max_queue_size; });
     if (queued_buffers > max_queue_size + 3) {
-        Common::CondvarWait(release_cv, lk, stop_token,
-                            [this] { return paused || queued_buffers < max_queue_size; });
+        // The callback notifies without the mutex, so re-check at the callback period rather
+        // than relying on every notification arriving
+        const auto has_space = [this] { return paused || queued_buffers < max_queue_size; };
+        while (!stop_token.stop_requested() && !has_space()) {
+            release_cv.wait_for(lk, std::chrono::milliseconds(5), has_space);
+        }
+    }
+}
+
+void SinkStream::RecordRenderDeadline(bool missed) {
+    // Adapt once per second of frames, growing when more than 2% of them missed
+    constexpr u32 window_size{TargetSampleRate / TargetSampleCount};
+    constexpr u32 grow_misses{window_size / 50};
+
+    window_frames++;
+    if (missed) {
+        window_misses++;
+    }
+    if (window_frames < window_size) {
+        return;
+    }
+
+    if (window_misses > grow_misses && max_queue_size < base_queue_size * 2) {
+        max_queue_size++;
+        LOG_DEBUG(Audio_Sink, "Stream {} missed {} of {} deadlines, queueing {} buffers", name,
+                  window_misses, window_frames, max_queue_size);
+    } else if (window_misses == 0 && max_queue_size > base_queue_size) {
+        max_queue_size--;
     }
+    window_frames = 0;
+    window_misses = 0;
 }
 
 void SinkStream::SignalPause() {
@@ -161,6 +161,7 @@ public:
      * Set the maximum buffer queue size.
      */
     void SetRingSize(u32 ring_size) {
+        base_queue_size = ring_size;
         max_queue_size = ring_size;
     }
 
@@ -175,10 +176,10 @@ public:
     /**
      * Release a buffer. Audio In only, will fill a buffer with recorded samples.
      *
-     * @param num_samples - Maximum number of samples to receive.
-     * @return Vector of recorded samples. May have fewer than num_samples.
+     * @param output - Buffer receiving the recorded samples, padded with silence when fewer
+     *                 samples were recorded.
      */
-    virtual std::vector<s16> ReleaseBuffer(u64 num_samples);
+    virtual void ReleaseBuffer(std::span<s16> output);
 
     /**
      * Empty out the buffer queue.
@@ -213,12 +214,47 @@ public:
      */
     void WaitFreeSpace(std::stop_token stop_token);
 
+    /**
+     * Record whether the renderer met the deadline of a frame sent to this stream. While
+     * deadlines are being missed more buffers are kept queued, up to twice the ring size, and the
+     * queue shrinks back to the ring size once they are met again.
+     *
+     * @param missed - True if the frame took longer than its period to render.
+     */
+    void RecordRenderDeadline(bool missed);
+
+    /**
+     * Get the number of times the sample ring ran dry while the device wanted samples.
+     *
+     * @return The number of underruns.
+     */
+    u64 GetUnderrunCount() const {
+        return underrun_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the number of times appended samples were dropped because the sample ring was full.
+     *
+     * @return The number of overruns.
+     */
+    u64 GetOverrunCount() const {
+        return overrun_count.load(std::memory_order_relaxed);
+    }
+
 protected:
     /**
      * Unblocks the ADSP if the stream is paused.
      */
     void SignalPause();
 
+private:
+    /**
+     * Push samples to the ring buffer, counting an overrun if they did not all fit.
+     *
+     * @param samples - The samples to push.
+     */
+    void PushSamples(std::span<const s16> samples);
+
 protected:
     /// Core system
     Core::System& system;
@@ -234,8 +270,14 @@ protected:
     std::string name{};
 
 private:
-    /// Ring buffer of the samples waiting to be played or consumed
+    /// Lock-free SPSC ring buffer of the samples waiting to be played or consumed
     Common::RingBuffer<s16, 0x10000> samples_buffer;
+    /// Scratch space for up-mixed samples, reused across appends
+    std::vector<s16> upmix_samples;
+    /// Times the device callback found fewer samples than it needed
+    std::atomic<u64> underrun_count{};
+    /// Times appended samples did not fit in the ring buffer
+    std::atomic<u64> overrun_count{};
     /// Audio buffers queued and waiting to play
     Common::ReaderWriterQueue<SinkBuffer> queue;
     /// The currently-playing audio buffer
@@ -245,20 +287,25 @@ private:
     /// Number of buffers waiting to be played
     std::atomic<u32> queued_buffers{};
     /// The ring size for audio out buffers (usually 4, rarely 2 or 8)
+    u32 base_queue_size{};
+    /// Current maximum buffer queue size, grown from the ring size while deadlines are missed
     u32 max_queue_size{};
-    /// Locks access to sample count tracking info
-    std::mutex sample_count_lock;
+    /// Frames and missed deadlines counted in the current adaptation window
+    u32 window_frames{};
+    u32 window_misses{};
+    /// Sequence guarding the sample count tracking info, odd while the callback updates it
+    std::atomic<u32> sample_count_sequence{};
     /// Minimum number of total samples that have been played since the last callback
-    u64 min_played_sample_count{};
+    std::atomic<u64> min_played_sample_count{};
     /// Maximum number of total samples that can be played since the last callback
-    u64 max_played_sample_count{};
-    /// The time the two above tracking variables were last written to
-    std::chrono::nanoseconds last_sample_count_update_time{};
+    std::atomic<u64> max_played_sample_count{};
+    /// The time in nanoseconds the two above tracking variables were last written to
+    std::atomic<s64> last_sample_count_update_time{};
     /// Set by the audio render/in/out system which uses this stream
     f32 system_volume{1.0f};
     /// Set via IAudioDevice service calls
     f32 device_volume{1.0f};
-    /// Signalled when ring buffer entries are consumed
+    /// Signalled when ring buffer entries are consumed, without taking release_mutex
     std::condition_variable_any release_cv;
     std::mutex release_mutex;
 };
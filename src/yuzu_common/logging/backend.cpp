@@ -199,8 +199,9 @@ public:
         void(CreateDir(log_dir));
         Filter filter;
         filter.ParseFilterString(Settings::values.log_filter.GetValue());
-        instance = std::unique_ptr<Impl, decltype(&Deleter)>(new Impl(log_dir / LOG_FILE, filter),
-                                                             Deleter);
+        instance = std::unique_ptr<Impl, decltype(&Deleter)>(
+            new Impl(log_dir / LOG_FILE, filter, Settings::values.log_deferred_format.GetValue()),
+            Deleter);
         initialization_in_progress_suppress_logging = false;
     }
 
@@ -226,18 +227,25 @@ public:
         color_console_backend.SetEnabled(enabled);
     }
 
+    bool CheckMessage(Class log_class, Level log_level) const {
+        return filter.CheckMessage(log_class, log_level);
+    }
+
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-                   const char* function, std::string&& message) {
-        if (!filter.CheckMessage(log_class, log_level)) {
-            return;
+                   const char* function, const char* format, const fmt::format_args& args) {
+        Entry entry = CreateEntry(log_class, log_level, filename, line_num, function);
+        if (deferred_format && PackDeferredArgs(entry.args, args)) {
+            entry.format = format;
+        } else {
+            entry.message = fmt::vformat(format, args);
         }
-        message_queue.EmplaceWait(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+        message_queue.EmplaceWait(std::move(entry));
     }
 
 private:
-    Impl(const std::filesystem::path& file_backend_filename, const Filter& filter_)
-        : filter{filter_}, file_backend{file_backend_filename} {}
+    Impl(const std::filesystem::path& file_backend_filename, const Filter& filter_,
+         bool deferred_format_)
+        : filter{filter_}, file_backend{file_backend_filename}, deferred_format{deferred_format_} {}
 
     ~Impl() = default;
 
@@ -246,6 +254,10 @@ private:
             Common::SetCurrentThreadName("Logger");
             Entry entry;
             const auto write_logs = [this, &entry]() {
+                if (entry.format != nullptr) {
+                    entry.message = FormatDeferredMessage(entry);
+                    entry.format = nullptr;
+                }
                 ForEachBackend([&entry](Backend& backend) { backend.Write(entry); });
             };
             while (!stop_token.stop_requested()) {
@@ -273,7 +285,7 @@ private:
     }
 
     Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
-                      const char* function, std::string&& message) const {
+                      const char* function) const {
         using std::chrono::duration_cast;
         using std::chrono::microseconds;
         using std::chrono::steady_clock;
@@ -285,7 +297,6 @@ private:
             .filename = filename,
             .line_num = line_nr,
             .function = function,
-            .message = std::move(message),
         };
     }
 
@@ -315,6 +326,8 @@ private:
     MPSCQueue<Entry> message_queue{};
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
     std::jthread backend_thread;
+    /// Leave the formatting of messages with plain arguments to the logger thread
+    bool deferred_format;
 };
 } // namespace
 
@@ -345,9 +358,13 @@ void SetColorConsoleBackendEnabled(bool enabled) {
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args) {
-    if (!initialization_in_progress_suppress_logging) {
-        Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function,
-                                   fmt::vformat(format, args));
+    if (initialization_in_progress_suppress_logging) {
+        return;
+    }
+    // Filtered messages are dropped before paying for any formatting
+    auto& instance = Impl::Instance();
+    if (instance.CheckMessage(log_class, log_level)) {
+        instance.PushEntry(log_class, log_level, filename, line_num, function, format, args);
     }
 }
 } // namespace Common::Log
@@ -22,7 +22,10 @@ constexpr const char* TrimSourcePath(std::string_view source) {
     return source.data() + idx;
 }
 
-/// Logs a message to the global logger, using fmt
+/**
+ * Logs a message to the global logger, using fmt. The format string must outlive the logger as
+ * formatting may be deferred to the logger thread.
+ */
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args);
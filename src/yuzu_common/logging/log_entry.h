@@ -4,6 +4,7 @@
 #pragma once
 
 #include <chrono>
+#include <string>
 
 #include "yuzu_common/logging/types.h"
 
@@ -19,8 +20,12 @@ struct Entry {
     Level log_level{};
     const char* filename = nullptr;
     unsigned int line_num = 0;
-    std::string function;
+    const char* function = nullptr;
     std::string message;
+    /// Format string of a message left to be formatted from `args`, null once formatted
+    const char* format = nullptr;
+    /// Arguments of a message left to be formatted, copied by value by PackDeferredArgs
+    std::string args;
 };
 
 } // namespace Common::Log
@@ -1,8 +1,13 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#include <array>
 #include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include <fmt/args.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -20,6 +25,160 @@
 
 namespace Common::Log {
 
+namespace {
+
+/// Tag in front of each packed argument, followed by its value. Strings are followed by their
+/// u32 size and their characters.
+enum class DeferredArgType : u8 {
+    Bool,
+    Char,
+    Signed,
+    Unsigned,
+    Float,
+    Double,
+    Pointer,
+    String,
+};
+
+/// Appends a single format argument, anything that is not a plain value or a string is refused
+class DeferredArgPacker {
+public:
+    explicit DeferredArgPacker(std::string& packed_) : packed{packed_} {}
+
+    template <typename T>
+    bool operator()(T value) {
+        using Type = DeferredArgType;
+        if constexpr (std::is_same_v<T, bool>) {
+            return Push(Type::Bool, static_cast<u8>(value ? 1 : 0));
+        } else if constexpr (std::is_same_v<T, char>) {
+            return Push(Type::Char, value);
+        } else if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(u64)) {
+            if constexpr (std::is_signed_v<T>) {
+                return Push(Type::Signed, static_cast<s64>(value));
+            } else {
+                return Push(Type::Unsigned, static_cast<u64>(value));
+            }
+        } else if constexpr (std::is_same_v<T, float>) {
+            return Push(Type::Float, value);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return Push(Type::Double, value);
+        } else if constexpr (std::is_same_v<T, const char*>) {
+            return value != nullptr && PushString(value);
+        } else if constexpr (std::is_same_v<T, fmt::string_view>) {
+            return PushString(std::string_view{value.data(), value.size()});
+        } else if constexpr (std::is_same_v<T, const void*>) {
+            return Push(Type::Pointer, reinterpret_cast<std::uintptr_t>(value));
+        } else {
+            // Custom formatters, 128-bit integers and long doubles are formatted immediately
+            return false;
+        }
+    }
+
+private:
+    template <typename V>
+    bool Push(DeferredArgType type, V value) {
+        packed.push_back(static_cast<char>(type));
+        packed.append(reinterpret_cast<const char*>(&value), sizeof(V));
+        return true;
+    }
+
+    bool PushString(std::string_view value) {
+        if (value.size() > std::numeric_limits<u32>::max()) {
+            return false;
+        }
+        Push(DeferredArgType::String, static_cast<u32>(value.size()));
+        packed.append(value);
+        return true;
+    }
+
+    std::string& packed;
+};
+
+/// Reads the arguments appended by DeferredArgPacker back in order
+class DeferredArgReader {
+public:
+    explicit DeferredArgReader(std::string_view packed_) : packed{packed_} {}
+
+    bool AtEnd() const {
+        return position == packed.size();
+    }
+
+    template <typename V>
+    V Read() {
+        V value;
+        std::memcpy(&value, packed.data() + position, sizeof(V));
+        position += sizeof(V);
+        return value;
+    }
+
+    std::string_view ReadString() {
+        const auto size = Read<u32>();
+        const auto value = packed.substr(position, size);
+        position += size;
+        return value;
+    }
+
+private:
+    std::string_view packed;
+    std::size_t position = 0;
+};
+
+} // Anonymous namespace
+
+bool PackDeferredArgs(std::string& packed, const fmt::format_args& args) {
+    packed.clear();
+    for (int index = 0;; ++index) {
+        const auto arg = args.get(index);
+        if (!arg) {
+            return true;
+        }
+        // fmt 11 replaces visit_format_arg with the member visit
+#if FMT_VERSION >= 110000
+        if (!arg.visit(DeferredArgPacker{packed})) {
+#else
+        if (!fmt::visit_format_arg(DeferredArgPacker{packed}, arg)) {
+#endif
+            return false;
+        }
+    }
+}
+
+std::string FormatDeferredMessage(const Entry& entry) {
+    using Type = DeferredArgType;
+    DeferredArgReader reader{entry.args};
+
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    while (!reader.AtEnd()) {
+        switch (reader.Read<Type>()) {
+        case Type::Bool:
+            store.push_back(reader.Read<u8>() != 0);
+            break;
+        case Type::Char:
+            store.push_back(reader.Read<char>());
+            break;
+        case Type::Signed:
+            store.push_back(reader.Read<s64>());
+            break;
+        case Type::Unsigned:
+            store.push_back(reader.Read<u64>());
+            break;
+        case Type::Float:
+            store.push_back(reader.Read<float>());
+            break;
+        case Type::Double:
+            store.push_back(reader.Read<double>());
+            break;
+        case Type::Pointer:
+            store.push_back(reinterpret_cast<const void*>(reader.Read<std::uintptr_t>()));
+            break;
+        case Type::String:
+            store.push_back(reader.ReadString());
+            break;
+        }
+    }
+    return fmt::vformat(entry.format, store);
+}
+
 std::string FormatLogMessage(const Entry& entry) {
     unsigned int time_seconds = static_cast<unsigned int>(entry.timestamp.count() / 1000000);
     unsigned int time_fractional = static_cast<unsigned int>(entry.timestamp.count() % 1000000);
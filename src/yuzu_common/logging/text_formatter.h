@@ -5,10 +5,17 @@
 
 #include <string>
 
+#include <fmt/format.h>
+
 namespace Common::Log {
 
 struct Entry;
 
+/// Copies the arguments for later formatting, returns false when one can not be copied by value.
+bool PackDeferredArgs(std::string& packed, const fmt::format_args& args);
+/// Formats the message of an entry whose formatting was deferred.
+std::string FormatDeferredMessage(const Entry& entry);
+
 /// Formats a log entry into the provided text buffer.
 std::string FormatLogMessage(const Entry& entry);
 /// Formats and prints a log entry to stderr.
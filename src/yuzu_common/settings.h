@@ -189,6 +189,16 @@ struct Values {
         linkage, false, "audio_muted", Category::Audio, Specialization::Default, true, true};
     Setting<bool, false> dump_audio_commands{
         linkage, false, "dump_audio_commands", Category::Audio, Specialization::Default, false};
+    Setting<bool, false> audio_command_timing{
+        linkage, false, "audio_command_timing", Category::Audio, Specialization::Default, false};
+    Setting<bool, false> audio_capture_updates{
+        linkage, false, "audio_capture_updates", Category::Audio, Specialization::Default, false};
+    Setting<bool, false> audio_realtime_priority{
+        linkage, false, "audio_realtime_priority", Category::Audio, Specialization::Default, false};
+    SwitchableSetting<u8, true> audio_renderer_workers{
+        linkage, 2, 0, 8, "audio_renderer_workers", Category::Audio};
+    SwitchableSetting<u8, true> audio_opus_decode_ahead{
+        linkage, 8, 0, 32, "audio_opus_decode_ahead", Category::Audio};
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
@@ -390,6 +400,13 @@ struct Values {
                                                            VramUsageMode::Aggressive,
                                                            "vram_usage_mode",
                                                            Category::RendererAdvanced};
+    // Measured in MiB, 0 derives the texture cache budget from the device memory
+    SwitchableSetting<u32, true> texture_memory_budget{linkage,
+                                                       0,
+                                                       0,
+                                                       65536,
+                                                       "texture_memory_budget",
+                                                       Category::RendererAdvanced};
     SwitchableSetting<bool> async_presentation{linkage,
 #ifdef ANDROID
                                                true,
@@ -602,6 +619,8 @@ struct Values {
 
     // Miscellaneous
     Setting<std::string> log_filter{linkage, "*:Info", "log_filter", Category::Miscellaneous};
+    Setting<bool> log_deferred_format{linkage, false, "log_deferred_format",
+                                      Category::Miscellaneous};
     Setting<bool> use_dev_keys{linkage, false, "use_dev_keys", Category::Miscellaneous};
 
     // Network
@@ -2,6 +2,8 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cerrno>
 #include <string>
 
 #include "yuzu_common/error.h"
@@ -23,6 +25,10 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
 
 #ifdef __FreeBSD__
 #define cpu_set_t cpuset_t
@@ -80,6 +86,90 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
 
 #endif
 
+#ifdef __linux__
+
+namespace {
+
+/// Kernel sched_setattr argument, glibc has no wrapper for it
+struct SchedAttr {
+    u32 size;
+    u32 sched_policy;
+    u64 sched_flags;
+    s32 sched_nice;
+    u32 sched_priority;
+    u64 sched_runtime;
+    u64 sched_deadline;
+    u64 sched_period;
+};
+
+constexpr u32 SchedDeadline = 6;
+constexpr u64 SchedFlagResetOnFork = 0x01;
+#ifndef SCHED_RESET_ON_FORK
+#define SCHED_RESET_ON_FORK 0x40000000
+#endif
+
+/// SCHED_FIFO priority requested, kept low so the kernel and sound server threads still win
+constexpr int RealtimeFifoPriority = 10;
+
+bool SetCurrentThreadDeadline(std::chrono::nanoseconds period, std::chrono::nanoseconds runtime) {
+#ifdef SYS_sched_setattr
+    SchedAttr attr{};
+    attr.size = sizeof(attr);
+    attr.sched_policy = SchedDeadline;
+    attr.sched_flags = SchedFlagResetOnFork;
+    attr.sched_runtime = static_cast<u64>(runtime.count());
+    attr.sched_deadline = static_cast<u64>(period.count());
+    attr.sched_period = static_cast<u64>(period.count());
+    return syscall(SYS_sched_setattr, 0, &attr, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+bool SetCurrentThreadFifo() {
+    int priority = RealtimeFifoPriority;
+    rlimit limit{};
+    if (getuid() != 0 && getrlimit(RLIMIT_RTPRIO, &limit) == 0 &&
+        limit.rlim_cur != RLIM_INFINITY) {
+        priority = std::min(priority, static_cast<int>(limit.rlim_cur));
+    }
+    priority = std::max(priority, sched_get_priority_min(SCHED_FIFO));
+
+    sched_param params{};
+    params.sched_priority = priority;
+    if (int e = pthread_setschedparam(pthread_self(), SCHED_FIFO | SCHED_RESET_ON_FORK, &params)) {
+        errno = e;
+        return false;
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+bool SetCurrentThreadRealtime(std::chrono::nanoseconds period, std::chrono::nanoseconds runtime) {
+    if (period.count() > 0 && runtime.count() > 0 && runtime <= period &&
+        SetCurrentThreadDeadline(period, runtime)) {
+        LOG_INFO(Common, "Thread moved to SCHED_DEADLINE, runtime {}us every {}us",
+                 runtime.count() / 1000, period.count() / 1000);
+        return true;
+    }
+    if (SetCurrentThreadFifo()) {
+        LOG_INFO(Common, "Thread moved to SCHED_FIFO");
+        return true;
+    }
+    LOG_WARNING(Common, "Could not move thread to a real-time scheduling class: {}",
+                GetLastErrorMsg());
+    return false;
+}
+
+#else
+
+bool SetCurrentThreadRealtime(std::chrono::nanoseconds, std::chrono::nanoseconds) {
+    return false;
+}
+
+#endif
+
 #ifdef _MSC_VER
 
 // Sets the debugger-visible name of the current thread.
@@ -104,6 +104,19 @@ enum class ThreadPriority : u32 {
 
 void SetCurrentThreadPriority(ThreadPriority new_priority);
 
+/**
+ * Move the current thread to a real-time scheduling class, for threads which have to meet a
+ * deadline every period, like audio rendering. Only implemented on Linux, where SCHED_DEADLINE is
+ * tried first when a period is given, falling back to SCHED_FIFO. Both need CAP_SYS_NICE, or an
+ * RLIMIT_RTPRIO grant for SCHED_FIFO. Threads created afterwards do not inherit the class.
+ *
+ * @param period  - How often the thread has work to do, zero if it is not periodic.
+ * @param runtime - CPU time the thread needs every period.
+ * @return True if the thread now runs in a real-time class, otherwise it is left unchanged.
+ */
+bool SetCurrentThreadRealtime(std::chrono::nanoseconds period = {},
+                              std::chrono::nanoseconds runtime = {});
+
 void SetCurrentThreadName(const char* name);
 
 } // namespace Common
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace Shader {
+
+/// Monotonic memory resource used by the recompiler stages of a single translation.
+/// Deallocations are no-ops, memory is returned in one shot with ReleaseContents.
+class Arena final : public std::pmr::memory_resource {
+public:
+    explicit Arena(size_t chunk_size = 64 * 1024) : new_chunk_size{chunk_size} {
+        node = &chunks.emplace_back(new_chunk_size);
+    }
+
+    Arena& operator=(const Arena&) = delete;
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(Arena&&) = delete;
+    Arena(Arena&&) = delete;
+
+    void ReleaseContents() {
+        Chunk& root{chunks.front()};
+        if (chunks.size() > 1) {
+            // Squash all the memory used by the last translation into the root chunk
+            size_t total_size{};
+            for (const Chunk& chunk : chunks) {
+                total_size += chunk.size;
+            }
+            chunks.clear();
+            chunks.emplace_back(total_size);
+        } else {
+            root.used = 0;
+        }
+        node = &chunks.front();
+        num_allocations = 0;
+        num_bytes = 0;
+    }
+
+    /// Number of allocations served since the last release
+    [[nodiscard]] size_t NumAllocations() const noexcept {
+        return num_allocations;
+    }
+
+    /// Number of bytes served since the last release
+    [[nodiscard]] size_t NumBytes() const noexcept {
+        return num_bytes;
+    }
+
+private:
+    struct Chunk {
+        explicit Chunk(size_t size_) : size{size_}, data{std::make_unique<std::byte[]>(size_)} {}
+
+        size_t used{};
+        size_t size{};
+        std::unique_ptr<std::byte[]> data;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++num_allocations;
+        num_bytes += bytes;
+        void* const memory{TryAllocate(*node, bytes, alignment)};
+        if (memory) {
+            return memory;
+        }
+        node = &chunks.emplace_back(std::max(new_chunk_size, bytes + alignment));
+        return TryAllocate(*node, bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    static void* TryAllocate(Chunk& chunk, size_t bytes, size_t alignment) {
+        void* pointer{chunk.data.get() + chunk.used};
+        size_t space{chunk.size - chunk.used};
+        if (!std::align(alignment, bytes, pointer, space)) {
+            return nullptr;
+        }
+        chunk.used = chunk.size - space + bytes;
+        return pointer;
+    }
+
+    Chunk* node{};
+    std::vector<Chunk> chunks;
+    size_t new_chunk_size{};
+    size_t num_allocations{};
+    size_t num_bytes{};
+};
+
+namespace Detail {
+inline thread_local Arena* current_arena{};
+}
+
+/// Makes an arena the allocation source of the recompiler stages run on this thread
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) : previous{Detail::current_arena} {
+        Detail::current_arena = &arena;
+    }
+
+    ~ArenaScope() {
+        Detail::current_arena = previous;
+    }
+
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ArenaScope(const ArenaScope&) = delete;
+
+private:
+    Arena* previous;
+};
+
+/// Returns the arena of the translation running on this thread, if any
+[[nodiscard]] inline Arena* CurrentArena() noexcept {
+    return Detail::current_arena;
+}
+
+/// Returns the memory resource recompiler stages should allocate their temporaries from
+[[nodiscard]] inline std::pmr::memory_resource* TranslationResource() noexcept {
+    if (Arena* const arena{Detail::current_arena}) {
+        return arena;
+    }
+    return std::pmr::new_delete_resource();
+}
+
+} // namespace Shader
@@ -43,6 +43,10 @@ public:
 
     virtual void Dump(u64 pipeline_hash, u64 shader_hash) = 0;
 
+    /// Hash of the state read from the environment so far (texture types, constant buffer values
+    /// and replacements, memory sizes), which together with the code determines the translation
+    [[nodiscard]] virtual u64 QueriesHash() const = 0;
+
     [[nodiscard]] const ProgramHeader& SPH() const noexcept {
         return sph;
     }
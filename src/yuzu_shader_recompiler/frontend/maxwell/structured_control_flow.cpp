@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -13,6 +14,7 @@
 #include <boost/intrusive/list.hpp>
 
 #include "yuzu_common/polyfill_ranges.h"
+#include "yuzu_shader_recompiler/arena.h"
 #include "yuzu_shader_recompiler/environment.h"
 #include "yuzu_shader_recompiler/frontend/ir/basic_block.h"
 #include "yuzu_shader_recompiler/frontend/ir/ir_emitter.h"
@@ -312,7 +314,7 @@ bool NeedsLift(Node goto_stmt, Node label_stmt) noexcept {
 class GotoPass {
 public:
     explicit GotoPass(Flow::CFG& cfg, ObjectPool<Statement>& stmt_pool) : pool{stmt_pool} {
-        std::vector gotos{BuildTree(cfg)};
+        std::pmr::vector<Node> gotos{BuildTree(cfg)};
         const auto end{gotos.rend()};
         for (auto goto_stmt = gotos.rbegin(); goto_stmt != end; ++goto_stmt) {
             RemoveGoto(*goto_stmt);
@@ -374,20 +376,20 @@ private:
         }
     }
 
-    std::vector<Node> BuildTree(Flow::CFG& cfg) {
+    std::pmr::vector<Node> BuildTree(Flow::CFG& cfg) {
         u32 label_id{0};
-        std::vector<Node> gotos;
+        std::pmr::vector<Node> gotos{TranslationResource()};
         Flow::Function& first_function{cfg.Functions().front()};
         BuildTree(cfg, first_function, label_id, gotos, root_stmt.children.end(), std::nullopt);
         return gotos;
     }
 
     void BuildTree(Flow::CFG& cfg, Flow::Function& function, u32& label_id,
-                   std::vector<Node>& gotos, Node function_insert_point,
+                   std::pmr::vector<Node>& gotos, Node function_insert_point,
                    std::optional<Node> return_label) {
         Statement* const false_stmt{pool.Create(Identity{}, IR::Condition{false}, &root_stmt)};
         Tree& root{root_stmt.children};
-        std::unordered_map<Flow::Block*, Node> local_labels;
+        std::pmr::unordered_map<Flow::Block*, Node> local_labels{TranslationResource()};
         local_labels.reserve(function.blocks.size());
 
         for (Flow::Block& block : function.blocks) {
@@ -867,8 +869,8 @@ private:
 
     void DemoteCombinationPass() {
         using Type = IR::AbstractSyntaxNode::Type;
-        std::vector<IR::Block*> demote_blocks;
-        std::vector<IR::U1> demote_conds;
+        std::pmr::vector<IR::Block*> demote_blocks{TranslationResource()};
+        std::pmr::vector<IR::U1> demote_conds{TranslationResource()};
         u32 num_epilogues{};
         u32 branch_depth{};
         for (const IR::AbstractSyntaxNode& node : syntax_list) {
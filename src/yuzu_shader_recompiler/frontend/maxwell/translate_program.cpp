@@ -6,7 +6,9 @@
 #include <vector>
 #include <queue>
 
+#include "yuzu_common/logging/log.h"
 #include "yuzu_common/settings.h"
+#include "yuzu_shader_recompiler/arena.h"
 #include "yuzu_shader_recompiler/exception.h"
 #include "yuzu_shader_recompiler/frontend/ir/basic_block.h"
 #include "yuzu_shader_recompiler/frontend/ir/ir_emitter.h"
@@ -239,6 +241,10 @@ void LowerGeometryPassthrough(const IR::Program& program, const HostTranslateInf
 
 IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
                              Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info) {
+    const Arena* const arena{CurrentArena()};
+    const size_t arena_allocations{arena ? arena->NumAllocations() : 0};
+    const size_t arena_bytes{arena ? arena->NumBytes() : 0};
+
     IR::Program program;
     program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
     program.blocks = GenerateBlocks(program.syntax_list);
@@ -304,6 +310,7 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
     if (Settings::values.resolution_info.active) {
         Optimization::RescalingPass(program);
     }
+    Optimization::GlobalValueNumberingPass(program);
     Optimization::DeadCodeEliminationPass(program);
     if (Settings::values.renderer_debug) {
         Optimization::VerificationPass(program);
@@ -314,6 +321,11 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
 
     CollectInterpolationInfo(env, program);
     AddNVNStorageBuffers(program);
+
+    if (arena) {
+        LOG_DEBUG(Shader, "Translation arena served {} allocations ({} bytes)",
+                  arena->NumAllocations() - arena_allocations, arena->NumBytes() - arena_bytes);
+    }
     return program;
 }
 
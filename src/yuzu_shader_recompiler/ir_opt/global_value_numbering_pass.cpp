@@ -0,0 +1,414 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file implements dominator-based value numbering over the SSA form, as described in
+//
+//      Value Numbering.
+//      Briggs P., Cooper K. D., Simpson L. T. (1997)
+//      Software: Practice and Experience, vol 27.
+//
+// Dominators are computed with the iterative algorithm from
+//
+//      A Simple, Fast Dominance Algorithm.
+//      Cooper K. D., Harvey T. J., Kennedy K. (2001)
+//
+
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "yuzu_common/bit_cast.h"
+#include "yuzu_common/logging/log.h"
+#include "yuzu_shader_recompiler/arena.h"
+#include "yuzu_shader_recompiler/frontend/ir/basic_block.h"
+#include "yuzu_shader_recompiler/frontend/ir/opcodes.h"
+#include "yuzu_shader_recompiler/frontend/ir/value.h"
+#include "yuzu_shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+constexpr size_t MAX_ARGS{5};
+
+struct Expression {
+    IR::Opcode opcode{};
+    u32 flags{};
+    size_t num_args{};
+    std::array<IR::Value, MAX_ARGS> args{};
+
+    bool operator==(const Expression& other) const noexcept {
+        return opcode == other.opcode && flags == other.flags && num_args == other.num_args &&
+               std::equal(args.begin(), args.begin() + num_args, other.args.begin());
+    }
+};
+
+u64 HashValue(const IR::Value& arg) {
+    const IR::Value value{arg.Resolve()};
+    if (!value.IsImmediate()) {
+        return reinterpret_cast<u64>(value.InstRecursive());
+    }
+    const IR::Type type{value.Type()};
+    const u64 seed{static_cast<u64>(type) << 48};
+    switch (type) {
+    case IR::Type::Void:
+        return seed;
+    case IR::Type::Reg:
+        return seed ^ static_cast<u64>(value.Reg());
+    case IR::Type::Pred:
+        return seed ^ static_cast<u64>(value.Pred());
+    case IR::Type::Attribute:
+        return seed ^ static_cast<u64>(value.Attribute());
+    case IR::Type::Patch:
+        return seed ^ static_cast<u64>(value.Patch());
+    case IR::Type::U1:
+        return seed ^ static_cast<u64>(value.U1());
+    case IR::Type::U8:
+        return seed ^ static_cast<u64>(value.U8());
+    case IR::Type::U16:
+    case IR::Type::F16:
+        return seed ^ static_cast<u64>(value.U16());
+    case IR::Type::U32:
+        return seed ^ static_cast<u64>(value.U32());
+    case IR::Type::F32:
+        return seed ^ static_cast<u64>(Common::BitCast<u32>(value.F32()));
+    case IR::Type::U64:
+        return seed ^ value.U64();
+    case IR::Type::F64:
+        return seed ^ Common::BitCast<u64>(value.F64());
+    default:
+        return seed;
+    }
+}
+
+struct ExpressionHash {
+    size_t operator()(const Expression& expr) const noexcept {
+        u64 hash{static_cast<u64>(expr.opcode) * 0x9E3779B97F4A7C15ULL ^ expr.flags};
+        for (size_t i = 0; i < expr.num_args; ++i) {
+            hash = (hash ^ HashValue(expr.args[i])) * 0x100000001B3ULL;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+bool IsCommutative(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::FPAdd16:
+    case IR::Opcode::FPAdd32:
+    case IR::Opcode::FPAdd64:
+    case IR::Opcode::FPMul16:
+    case IR::Opcode::FPMul32:
+    case IR::Opcode::FPMul64:
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::IAdd64:
+    case IR::Opcode::IMul32:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseOr32:
+    case IR::Opcode::BitwiseXor32:
+    case IR::Opcode::SMin32:
+    case IR::Opcode::UMin32:
+    case IR::Opcode::SMax32:
+    case IR::Opcode::UMax32:
+    case IR::Opcode::IEqual:
+    case IR::Opcode::INotEqual:
+    case IR::Opcode::LogicalOr:
+    case IR::Opcode::LogicalAnd:
+    case IR::Opcode::LogicalXor:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool IsAttributeRead(IR::Opcode opcode) {
+    return opcode == IR::Opcode::GetAttribute || opcode == IR::Opcode::GetAttributeU32;
+}
+
+/// Returns true when two instances of the instruction with equal operands always produce the
+/// same value for an invocation, regardless of where they are placed in the program
+bool IsPure(IR::Opcode opcode) {
+    switch (opcode) {
+    // Reads from state that can change during the execution of the shader
+    case IR::Opcode::Phi:
+    case IR::Opcode::Identity:
+    case IR::Opcode::Void:
+    case IR::Opcode::GetRegister:
+    case IR::Opcode::GetPred:
+    case IR::Opcode::GetGotoVariable:
+    case IR::Opcode::GetIndirectBranchVariable:
+    case IR::Opcode::GetAttributeIndexed:
+    case IR::Opcode::GetPatch:
+    case IR::Opcode::GetZFlag:
+    case IR::Opcode::GetSFlag:
+    case IR::Opcode::GetCFlag:
+    case IR::Opcode::GetOFlag:
+    case IR::Opcode::IsHelperInvocation:
+    case IR::Opcode::UndefU1:
+    case IR::Opcode::UndefU8:
+    case IR::Opcode::UndefU16:
+    case IR::Opcode::UndefU32:
+    case IR::Opcode::UndefU64:
+    case IR::Opcode::LoadGlobalU8:
+    case IR::Opcode::LoadGlobalS8:
+    case IR::Opcode::LoadGlobalU16:
+    case IR::Opcode::LoadGlobalS16:
+    case IR::Opcode::LoadGlobal32:
+    case IR::Opcode::LoadGlobal64:
+    case IR::Opcode::LoadGlobal128:
+    case IR::Opcode::LoadStorageU8:
+    case IR::Opcode::LoadStorageS8:
+    case IR::Opcode::LoadStorageU16:
+    case IR::Opcode::LoadStorageS16:
+    case IR::Opcode::LoadStorage32:
+    case IR::Opcode::LoadStorage64:
+    case IR::Opcode::LoadStorage128:
+    case IR::Opcode::LoadLocal:
+    case IR::Opcode::LoadSharedU8:
+    case IR::Opcode::LoadSharedS8:
+    case IR::Opcode::LoadSharedU16:
+    case IR::Opcode::LoadSharedS16:
+    case IR::Opcode::LoadSharedU32:
+    case IR::Opcode::LoadSharedU64:
+    case IR::Opcode::LoadSharedU128:
+    // Pseudo-operations are tied to their parent instruction
+    case IR::Opcode::GetZeroFromOp:
+    case IR::Opcode::GetSignFromOp:
+    case IR::Opcode::GetCarryFromOp:
+    case IR::Opcode::GetOverflowFromOp:
+    case IR::Opcode::GetSparseFromOp:
+    case IR::Opcode::GetInBoundsFromOp:
+    // Results depend on the set of active invocations or on neighbouring invocations
+    case IR::Opcode::VoteAll:
+    case IR::Opcode::VoteAny:
+    case IR::Opcode::VoteEqual:
+    case IR::Opcode::SubgroupBallot:
+    case IR::Opcode::ShuffleIndex:
+    case IR::Opcode::ShuffleUp:
+    case IR::Opcode::ShuffleDown:
+    case IR::Opcode::ShuffleButterfly:
+    case IR::Opcode::FSwizzleAdd:
+    case IR::Opcode::DPdxFine:
+    case IR::Opcode::DPdyFine:
+    case IR::Opcode::DPdxCoarse:
+    case IR::Opcode::DPdyCoarse:
+        return false;
+    default:
+        break;
+    }
+    // Texture and image instructions are left alone, they read mutable memory or depend on
+    // implicit derivatives
+    return opcode < IR::Opcode::BindlessImageSampleImplicitLod ||
+           opcode > IR::Opcode::ImageAtomicExchange32;
+}
+
+class DominatorTree {
+public:
+    explicit DominatorTree(const IR::Program& program, std::pmr::memory_resource* resource)
+        : rpo{resource}, rpo_index{resource}, idom{resource}, children{resource} {
+        // Reverse post order, the entry block goes first
+        rpo.assign(program.post_order_blocks.rbegin(), program.post_order_blocks.rend());
+        for (size_t index = 0; index < rpo.size(); ++index) {
+            rpo_index.emplace(rpo[index], index);
+        }
+        idom.assign(rpo.size(), UNDEFINED);
+        if (rpo.empty()) {
+            return;
+        }
+        idom[0] = 0;
+        bool changed{true};
+        while (changed) {
+            changed = false;
+            for (size_t index = 1; index < rpo.size(); ++index) {
+                size_t new_idom{UNDEFINED};
+                for (IR::Block* const pred : rpo[index]->ImmPredecessors()) {
+                    const auto it{rpo_index.find(pred)};
+                    if (it == rpo_index.end() || idom[it->second] == UNDEFINED) {
+                        continue;
+                    }
+                    new_idom = new_idom == UNDEFINED ? it->second : Intersect(it->second, new_idom);
+                }
+                if (new_idom != UNDEFINED && idom[index] != new_idom) {
+                    idom[index] = new_idom;
+                    changed = true;
+                }
+            }
+        }
+        children.resize(rpo.size());
+        for (size_t index = 1; index < rpo.size(); ++index) {
+            if (idom[index] != UNDEFINED) {
+                children[idom[index]].push_back(index);
+            }
+        }
+    }
+
+    [[nodiscard]] size_t NumBlocks() const noexcept {
+        return rpo.size();
+    }
+
+    [[nodiscard]] IR::Block* Block(size_t index) const noexcept {
+        return rpo[index];
+    }
+
+    [[nodiscard]] const std::pmr::vector<size_t>& Children(size_t index) const noexcept {
+        return children[index];
+    }
+
+private:
+    static constexpr size_t UNDEFINED{~size_t{0}};
+
+    size_t Intersect(size_t lhs, size_t rhs) const {
+        while (lhs != rhs) {
+            while (lhs > rhs) {
+                lhs = idom[lhs];
+            }
+            while (rhs > lhs) {
+                rhs = idom[rhs];
+            }
+        }
+        return lhs;
+    }
+
+    std::pmr::vector<IR::Block*> rpo;
+    std::pmr::unordered_map<IR::Block*, size_t> rpo_index;
+    std::pmr::vector<size_t> idom;
+    std::pmr::vector<std::pmr::vector<size_t>> children;
+};
+
+class ValueNumbering {
+public:
+    explicit ValueNumbering(const IR::Program& program, std::pmr::memory_resource* resource)
+        : table{resource}, undo{resource}, written_attributes{resource} {
+        // Attributes written by the shader itself can't be assumed constant
+        for (IR::Block* const block : program.blocks) {
+            for (const IR::Inst& inst : block->Instructions()) {
+                switch (inst.GetOpcode()) {
+                case IR::Opcode::SetAttribute:
+                    written_attributes.insert(inst.Arg(0).Attribute());
+                    break;
+                case IR::Opcode::SetAttributeIndexed:
+                    has_indexed_attribute_writes = true;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        allow_attribute_reads =
+            program.stage != Stage::TessellationControl && !has_indexed_attribute_writes;
+    }
+
+    void Run(const DominatorTree& tree) {
+        if (tree.NumBlocks() == 0) {
+            return;
+        }
+        struct Frame {
+            size_t block;
+            size_t scope;
+            size_t next_child;
+        };
+        std::pmr::vector<Frame> stack{undo.get_allocator()};
+        stack.push_back(Frame{0, Visit(tree.Block(0)), 0});
+        while (!stack.empty()) {
+            Frame& frame{stack.back()};
+            const auto& children{tree.Children(frame.block)};
+            if (frame.next_child < children.size()) {
+                const size_t child{children[frame.next_child++]};
+                const size_t scope{Visit(tree.Block(child))};
+                stack.push_back(Frame{child, scope, 0});
+                continue;
+            }
+            PopScope(frame.scope);
+            stack.pop_back();
+        }
+    }
+
+    [[nodiscard]] size_t NumEliminated() const noexcept {
+        return num_eliminated;
+    }
+
+    [[nodiscard]] size_t NumVisited() const noexcept {
+        return num_visited;
+    }
+
+private:
+    /// Numbers the instructions of a block, returns the scope marker to restore when leaving
+    size_t Visit(IR::Block* block) {
+        const size_t scope{undo.size()};
+        for (IR::Inst& inst : block->Instructions()) {
+            ++num_visited;
+            if (!IsCandidate(inst)) {
+                continue;
+            }
+            Expression expr{MakeExpression(inst)};
+            const auto [it, is_new]{table.try_emplace(expr, &inst)};
+            if (is_new) {
+                undo.push_back(std::move(expr));
+                continue;
+            }
+            inst.ReplaceUsesWith(IR::Value{it->second});
+            ++num_eliminated;
+        }
+        return scope;
+    }
+
+    void PopScope(size_t scope) {
+        while (undo.size() > scope) {
+            table.erase(undo.back());
+            undo.pop_back();
+        }
+    }
+
+    bool IsCandidate(const IR::Inst& inst) const {
+        const IR::Opcode opcode{inst.GetOpcode()};
+        if (inst.MayHaveSideEffects() || inst.HasAssociatedPseudoOperation() ||
+            inst.NumArgs() > MAX_ARGS || !IsPure(opcode)) {
+            return false;
+        }
+        if (IsAttributeRead(opcode)) {
+            return allow_attribute_reads && !written_attributes.contains(inst.Arg(0).Attribute());
+        }
+        return true;
+    }
+
+    static Expression MakeExpression(const IR::Inst& inst) {
+        Expression expr{
+            .opcode = inst.GetOpcode(),
+            .flags = inst.Flags<u32>(),
+            .num_args = inst.NumArgs(),
+        };
+        for (size_t i = 0; i < expr.num_args; ++i) {
+            expr.args[i] = inst.Arg(i).Resolve();
+        }
+        if (IsCommutative(expr.opcode) && HashValue(expr.args[0]) > HashValue(expr.args[1])) {
+            std::swap(expr.args[0], expr.args[1]);
+        }
+        return expr;
+    }
+
+    std::pmr::unordered_map<Expression, IR::Inst*, ExpressionHash> table;
+    std::pmr::vector<Expression> undo;
+    std::pmr::unordered_set<IR::Attribute> written_attributes;
+    bool has_indexed_attribute_writes{};
+    bool allow_attribute_reads{};
+    size_t num_eliminated{};
+    size_t num_visited{};
+};
+} // Anonymous namespace
+
+void GlobalValueNumberingPass(IR::Program& program) {
+    std::pmr::memory_resource* const resource{TranslationResource()};
+    const DominatorTree tree{program, resource};
+    ValueNumbering numbering{program, resource};
+    numbering.Run(tree);
+    if (numbering.NumEliminated() != 0) {
+        // Replaced instructions are left as identities of the value they compute again, forward
+        // their uses to that value so the instructions are removed from the program
+        IdentityRemovalPass(program);
+    }
+    LOG_DEBUG(Shader, "Value numbering removed {} of {} instructions",
+              numbering.NumEliminated(), numbering.NumVisited());
+}
+
+} // namespace Shader::Optimization
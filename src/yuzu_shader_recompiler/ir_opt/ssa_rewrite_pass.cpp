@@ -15,11 +15,14 @@
 
 #include <deque>
 #include <map>
+#include <memory_resource>
 #include <span>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "yuzu_shader_recompiler/arena.h"
 #include "yuzu_shader_recompiler/frontend/ir/basic_block.h"
 #include "yuzu_shader_recompiler/frontend/ir/opcodes.h"
 #include "yuzu_shader_recompiler/frontend/ir/pred.h"
@@ -52,9 +55,20 @@ struct IndirectBranchVariable {
 
 using Variant = std::variant<IR::Reg, IR::Pred, ZeroFlagTag, SignFlagTag, CarryFlagTag,
                              OverflowFlagTag, GotoVariable, IndirectBranchVariable>;
-using ValueMap = std::unordered_map<IR::Block*, IR::Value>;
+using ValueMap = std::pmr::unordered_map<IR::Block*, IR::Value>;
+
+template <size_t... indices>
+std::array<ValueMap, sizeof...(indices)> MakeValueMaps(std::pmr::memory_resource* resource,
+                                                       std::index_sequence<indices...>) {
+    return {(static_cast<void>(indices), ValueMap{resource})...};
+}
 
 struct DefTable {
+    explicit DefTable(std::pmr::memory_resource* resource)
+        : preds{MakeValueMaps(resource, std::make_index_sequence<IR::NUM_USER_PREDS>{})},
+          goto_vars{resource}, indirect_branch_var{resource}, zero_flag{resource},
+          sign_flag{resource}, carry_flag{resource}, overflow_flag{resource} {}
+
     const IR::Value& Def(IR::Block* block, IR::Reg variable) {
         return block->SsaRegValue(variable);
     }
@@ -112,7 +126,7 @@ struct DefTable {
     }
 
     std::array<ValueMap, IR::NUM_USER_PREDS> preds;
-    std::unordered_map<u32, ValueMap> goto_vars;
+    std::pmr::unordered_map<u32, ValueMap> goto_vars;
     ValueMap indirect_branch_var;
     ValueMap zero_flag;
     ValueMap sign_flag;
@@ -158,6 +172,9 @@ struct ReadState {
 
 class Pass {
 public:
+    explicit Pass(std::pmr::memory_resource* resource)
+        : incomplete_phis{resource}, current_def{resource} {}
+
     template <typename Type>
     void WriteVariable(Type variable, IR::Block* block, const IR::Value& value) {
         current_def.SetDef(block, variable, value);
@@ -295,7 +312,7 @@ private:
         return same;
     }
 
-    std::unordered_map<IR::Block*, std::map<Variant, IR::Inst*>> incomplete_phis;
+    std::pmr::unordered_map<IR::Block*, std::pmr::map<Variant, IR::Inst*>> incomplete_phis;
     DefTable current_def;
 };
 
@@ -370,7 +387,7 @@ void VisitBlock(Pass& pass, IR::Block* block) {
 }
 
 IR::Type GetConcreteType(IR::Inst* inst) {
-    std::deque<IR::Inst*> queue;
+    std::pmr::deque<IR::Inst*> queue{TranslationResource()};
     queue.push_back(inst);
     while (!queue.empty()) {
         IR::Inst* current = queue.front();
@@ -391,7 +408,7 @@ IR::Type GetConcreteType(IR::Inst* inst) {
 } // Anonymous namespace
 
 void SsaRewritePass(IR::Program& program) {
-    Pass pass;
+    Pass pass{TranslationResource()};
     const auto end{program.post_order_blocks.rend()};
     for (auto block = program.post_order_blocks.rbegin(); block != end; ++block) {
         VisitBlock(pass, *block);
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#include <xbyak/xbyak_util.h>
+#define WORD_MANAGER_HAS_AVX2
+#endif
+
+#include "yuzu_video_core/buffer_cache/word_manager.h"
+
+#if defined(WORD_MANAGER_HAS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define WORD_MANAGER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WORD_MANAGER_TARGET_AVX2
+#endif
+
+namespace VideoCommon {
+
+namespace {
+
+using FindNonZeroWordFn = size_t (*)(const u64*, const u64*, size_t, size_t) noexcept;
+
+size_t FindNonZeroWordScalar(const u64* first, const u64* second, size_t begin,
+                             size_t end) noexcept {
+    if (second) {
+        for (; begin < end; ++begin) {
+            if ((first[begin] | second[begin]) != 0) {
+                return begin;
+            }
+        }
+        return end;
+    }
+    for (; begin < end; ++begin) {
+        if (first[begin] != 0) {
+            return begin;
+        }
+    }
+    return end;
+}
+
+#ifdef WORD_MANAGER_HAS_AVX2
+/// Tests four words per step and leaves the dirty step to the scalar loop to pinpoint the word
+WORD_MANAGER_TARGET_AVX2
+size_t FindNonZeroWordAVX2(const u64* first, const u64* second, size_t begin,
+                           size_t end) noexcept {
+    if (second) {
+        for (; begin + 4 <= end; begin += 4) {
+            const __m256i words = _mm256_or_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + begin)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + begin)));
+            if (!_mm256_testz_si256(words, words)) {
+                break;
+            }
+        }
+    } else {
+        for (; begin + 4 <= end; begin += 4) {
+            const __m256i words =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + begin));
+            if (!_mm256_testz_si256(words, words)) {
+                break;
+            }
+        }
+    }
+    return FindNonZeroWordScalar(first, second, begin, end);
+}
+#endif
+
+FindNonZeroWordFn SelectFindNonZeroWord() {
+#ifdef WORD_MANAGER_HAS_AVX2
+    const Xbyak::util::Cpu cpu;
+    if (cpu.has(Xbyak::util::Cpu::tAVX2)) {
+        return &FindNonZeroWordAVX2;
+    }
+#endif
+    return &FindNonZeroWordScalar;
+}
+
+} // Anonymous namespace
+
+size_t FindNonZeroWord(const u64* first, const u64* second, size_t begin, size_t end) noexcept {
+    static const FindNonZeroWordFn find_non_zero_word = SelectFindNonZeroWord();
+    return find_non_zero_word(first, second, begin, end);
+}
+
+} // namespace VideoCommon
@@ -20,6 +20,7 @@ namespace VideoCommon {
 constexpr u64 PAGES_PER_WORD = 64;
 constexpr u64 BYTES_PER_PAGE = Core::DEVICE_PAGESIZE;
 constexpr u64 BYTES_PER_WORD = PAGES_PER_WORD * BYTES_PER_PAGE;
+constexpr u64 WORDS_PER_SUMMARY_BIT = 64;
 
 enum class Type {
     CPU,
@@ -28,6 +29,14 @@ enum class Type {
     Untracked,
     Preflushable,
 };
+constexpr size_t NUM_TRACKED_TYPES = 5;
+
+/**
+ * Returns the index of the first word in [begin, end) with bits set in either array, end when
+ * all of them are zero. second may be null to scan a single array.
+ */
+[[nodiscard]] size_t FindNonZeroWord(const u64* first, const u64* second, size_t begin,
+                                     size_t end) noexcept;
 
 /// Vector tracking modified pages tightly packed with small vector optimization
 template <size_t stack_words = 1>
@@ -48,9 +57,14 @@ struct WordsArray {
 
 template <size_t stack_words = 1>
 struct Words {
+    static constexpr size_t stack_summary_words =
+        Common::DivCeil(Common::DivCeil(stack_words, WORDS_PER_SUMMARY_BIT), u64{64});
+
     explicit Words() = default;
     explicit Words(u64 size_bytes_) : size_bytes{size_bytes_} {
         num_words = Common::DivCeil(size_bytes, BYTES_PER_WORD);
+        num_summary_words =
+            Common::DivCeil(Common::DivCeil(num_words, WORDS_PER_SUMMARY_BIT), u64{64});
         if (IsShort()) {
             cpu.stack.fill(~u64{0});
             gpu.stack.fill(0);
@@ -59,12 +73,13 @@ struct Words {
             preflushable.stack.fill(0);
         } else {
             // Share allocation between CPU and GPU pages and set their default values
-            u64* const alloc = new u64[num_words * 5];
+            u64* const alloc = new u64[(num_words + num_summary_words) * NUM_TRACKED_TYPES];
             cpu.heap = alloc;
             gpu.heap = alloc + num_words;
             cached_cpu.heap = alloc + num_words * 2;
             untracked.heap = alloc + num_words * 3;
             preflushable.heap = alloc + num_words * 4;
+            summary.heap = alloc + num_words * NUM_TRACKED_TYPES;
             std::fill_n(cpu.heap, num_words, ~u64{0});
             std::fill_n(gpu.heap, num_words, 0);
             std::fill_n(cached_cpu.heap, num_words, 0);
@@ -78,6 +93,14 @@ struct Words {
         const u64 last_word = (~u64{0} << shift) >> shift;
         cpu.Pointer(IsShort())[NumWords() - 1] = last_word;
         untracked.Pointer(IsShort())[NumWords() - 1] = last_word;
+
+        // Only the CPU and untracked states start with bits set
+        std::fill_n(summary.Pointer(IsShort()), num_summary_words * NUM_TRACKED_TYPES, 0);
+        const size_t num_blocks = Common::DivCeil(num_words, WORDS_PER_SUMMARY_BIT);
+        for (size_t block = 0; block < num_blocks; ++block) {
+            Summary<Type::CPU>()[block / 64] |= u64{1} << (block % 64);
+            Summary<Type::Untracked>()[block / 64] |= u64{1} << (block % 64);
+        }
     }
 
     ~Words() {
@@ -88,18 +111,22 @@ struct Words {
         Release();
         size_bytes = rhs.size_bytes;
         num_words = rhs.num_words;
+        num_summary_words = rhs.num_summary_words;
         cpu = rhs.cpu;
         gpu = rhs.gpu;
         cached_cpu = rhs.cached_cpu;
         untracked = rhs.untracked;
         preflushable = rhs.preflushable;
+        summary = rhs.summary;
         rhs.cpu.heap = nullptr;
         return *this;
     }
 
     Words(Words&& rhs) noexcept
-        : size_bytes{rhs.size_bytes}, num_words{rhs.num_words}, cpu{rhs.cpu}, gpu{rhs.gpu},
-          cached_cpu{rhs.cached_cpu}, untracked{rhs.untracked}, preflushable{rhs.preflushable} {
+        : size_bytes{rhs.size_bytes}, num_words{rhs.num_words},
+          num_summary_words{rhs.num_summary_words}, cpu{rhs.cpu}, gpu{rhs.gpu},
+          cached_cpu{rhs.cached_cpu}, untracked{rhs.untracked}, preflushable{rhs.preflushable},
+          summary{rhs.summary} {
         rhs.cpu.heap = nullptr;
     }
 
@@ -154,13 +181,34 @@ struct Words {
         }
     }
 
+    /**
+     * Returns the summary bitmap of a state, bit N is set when any of the words covered by it
+     * may have bits set. Bits are set eagerly and cleared when a clearing pass finds the covered
+     * words empty, so a clear bit always means clean words.
+     */
+    template <Type type>
+    std::span<u64> Summary() noexcept {
+        return std::span<u64>(summary.Pointer(IsShort()) +
+                                  static_cast<size_t>(type) * num_summary_words,
+                              num_summary_words);
+    }
+
+    template <Type type>
+    std::span<const u64> Summary() const noexcept {
+        return std::span<const u64>(summary.Pointer(IsShort()) +
+                                        static_cast<size_t>(type) * num_summary_words,
+                                    num_summary_words);
+    }
+
     u64 size_bytes = 0;
     size_t num_words = 0;
+    size_t num_summary_words = 0;
     WordsArray<stack_words> cpu;
     WordsArray<stack_words> gpu;
     WordsArray<stack_words> cached_cpu;
     WordsArray<stack_words> untracked;
     WordsArray<stack_words> preflushable;
+    WordsArray<stack_summary_words * NUM_TRACKED_TYPES> summary;
 };
 
 template <class DeviceTracker, size_t stack_words = 1>
@@ -194,14 +242,26 @@ public:
         return std::make_pair(word_number, amount_pages / BYTES_PER_PAGE);
     }
 
-    template <typename Func>
-    void IterateWords(size_t offset, size_t size, Func&& func) const {
-        using FuncReturn = std::invoke_result_t<Func, std::size_t, u64>;
-        static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
+    /// Words and page masks covered by a byte range of the buffer
+    struct WordRange {
+        size_t start_word{};
+        size_t end_word{};
+        size_t start_page{};
+        size_t end_page{};
+
+        /// Returns the mask of the pages of a word inside the range
+        [[nodiscard]] u64 Mask(size_t word_index) const noexcept {
+            const size_t word_offset = (word_index - start_word) * PAGES_PER_WORD;
+            return ExtractBits(~0ULL, word_index == start_word ? start_page : 0,
+                               end_page - word_offset);
+        }
+    };
+
+    [[nodiscard]] WordRange GetWordRange(size_t offset, size_t size) const noexcept {
         const size_t start = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset), 0LL));
         const size_t end = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset + size), 0LL));
         if (start >= SizeBytes() || end <= start) {
-            return;
+            return {};
         }
         auto [start_word, start_page] = GetWordPage(start);
         auto [end_word, end_page] = GetWordPage(end + BYTES_PER_PAGE - 1ULL);
@@ -212,11 +272,16 @@ public:
         end_word += (end_page + PAGES_PER_WORD - 1ULL) / PAGES_PER_WORD;
         end_word = std::min(end_word, num_words);
         end_page += diff * PAGES_PER_WORD;
-        constexpr u64 base_mask{~0ULL};
-        for (size_t word_index = start_word; word_index < end_word; word_index++) {
-            const u64 mask = ExtractBits(base_mask, start_page, end_page);
-            start_page = 0;
-            end_page -= PAGES_PER_WORD;
+        return WordRange{start_word, end_word, start_page, end_page};
+    }
+
+    template <typename Func>
+    void IterateWords(size_t offset, size_t size, Func&& func) const {
+        using FuncReturn = std::invoke_result_t<Func, std::size_t, u64>;
+        static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
+        const WordRange range = GetWordRange(offset, size);
+        for (size_t word_index = range.start_word; word_index < range.end_word; word_index++) {
+            const u64 mask = range.Mask(word_index);
             if constexpr (BOOL_BREAK) {
                 if (func(word_index, mask)) {
                     return;
@@ -227,6 +292,42 @@ public:
         }
     }
 
+    /**
+     * Like IterateWords, but only visits the words with bits set in the state of either type.
+     * Clean blocks are rejected through the summary bitmaps and clean words inside a dirty block
+     * are skipped several at a time by FindNonZeroWord.
+     */
+    template <Type type, Type other_type = type, typename Func>
+    void IterateNonZeroWords(size_t offset, size_t size, Func&& func) const {
+        using FuncReturn = std::invoke_result_t<Func, std::size_t, u64>;
+        static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
+        const WordRange range = GetWordRange(offset, size);
+        const u64* const first = Array<type>();
+        const u64* const second = type == other_type ? nullptr : Array<other_type>();
+        size_t word_index = range.start_word;
+        while (word_index < range.end_word) {
+            const size_t block = word_index / WORDS_PER_SUMMARY_BIT;
+            const size_t block_end =
+                std::min<size_t>((block + 1) * WORDS_PER_SUMMARY_BIT, range.end_word);
+            if (!IsSummarySet<type>(block) && !IsSummarySet<other_type>(block)) {
+                word_index = block_end;
+                continue;
+            }
+            word_index = FindNonZeroWord(first, second, word_index, block_end);
+            if (word_index == block_end) {
+                continue;
+            }
+            if constexpr (BOOL_BREAK) {
+                if (func(word_index, range.Mask(word_index))) {
+                    return;
+                }
+            } else {
+                func(word_index, range.Mask(word_index));
+            }
+            ++word_index;
+        }
+    }
+
     template <typename Func>
     void IteratePages(u64 mask, Func&& func) const {
         size_t offset = 0;
@@ -259,8 +360,10 @@ public:
             }
             if constexpr (enable) {
                 state_words[index] |= mask;
+                SetSummary<type>(index);
                 if constexpr (type == Type::CPU || type == Type::CachedCPU) {
                     untracked_words[index] |= mask;
+                    SetSummary<Type::Untracked>(index);
                 }
                 if constexpr (type == Type::CPU) {
                     cached_words[index] &= ~mask;
@@ -276,6 +379,15 @@ public:
                 }
             }
         });
+        if constexpr (!enable) {
+            RefreshSummary<type>(dirty_addr - cpu_addr, size);
+            if constexpr (type == Type::CPU || type == Type::CachedCPU) {
+                RefreshSummary<Type::Untracked>(dirty_addr - cpu_addr, size);
+            }
+            if constexpr (type == Type::CPU) {
+                RefreshSummary<Type::CachedCPU>(dirty_addr - cpu_addr, size);
+            }
+        }
     }
 
     /**
@@ -301,7 +413,11 @@ public:
             func(cpu_addr + pending_offset * BYTES_PER_PAGE,
                  (pending_pointer - pending_offset) * BYTES_PER_PAGE);
         };
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        // Clearing the CPU states also clears untracked pages, so those words must be visited too
+        static constexpr bool visit_untracked =
+            clear && (type == Type::CPU || type == Type::CachedCPU);
+        static constexpr Type other_type = visit_untracked ? Type::Untracked : type;
+        IterateNonZeroWords<type, other_type>(offset, size, [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -340,6 +456,15 @@ public:
         if (pending) {
             release();
         }
+        if constexpr (clear) {
+            RefreshSummary<type>(offset, size);
+            if constexpr (visit_untracked) {
+                RefreshSummary<Type::Untracked>(offset, size);
+            }
+            if constexpr (type == Type::CPU) {
+                RefreshSummary<Type::CachedCPU>(offset, size);
+            }
+        }
     }
 
     /**
@@ -356,7 +481,7 @@ public:
         [[maybe_unused]] const std::span<const u64> untracked_words =
             words.template Span<Type::Untracked>();
         bool result = false;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        IterateNonZeroWords<type>(offset, size, [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -384,7 +509,7 @@ public:
             words.template Span<Type::Untracked>();
         u64 begin = std::numeric_limits<u64>::max();
         u64 end = 0;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        IterateNonZeroWords<type>(offset, size, [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -418,17 +543,19 @@ public:
     }
 
     void FlushCachedWrites() noexcept {
-        const u64 num_words = NumWords();
         u64* const cached_words = Array<Type::CachedCPU>();
         u64* const untracked_words = Array<Type::Untracked>();
         u64* const cpu_words = Array<Type::CPU>();
-        for (u64 word_index = 0; word_index < num_words; ++word_index) {
+        IterateNonZeroWords<Type::CachedCPU>(0, SizeBytes(), [&](size_t word_index, u64) {
             const u64 cached_bits = cached_words[word_index];
             NotifyRasterizer<false>(word_index, untracked_words[word_index], cached_bits);
             untracked_words[word_index] |= cached_bits;
             cpu_words[word_index] |= cached_bits;
             cached_words[word_index] = 0;
-        }
+            SetSummary<Type::Untracked>(word_index);
+            SetSummary<Type::CPU>(word_index);
+        });
+        std::ranges::fill(words.template Summary<Type::CachedCPU>(), 0);
     }
 
 private:
@@ -442,6 +569,8 @@ private:
             return words.cached_cpu.Pointer(IsShort());
         } else if constexpr (type == Type::Untracked) {
             return words.untracked.Pointer(IsShort());
+        } else if constexpr (type == Type::Preflushable) {
+            return words.preflushable.Pointer(IsShort());
         }
     }
 
@@ -455,6 +584,44 @@ private:
             return words.cached_cpu.Pointer(IsShort());
         } else if constexpr (type == Type::Untracked) {
             return words.untracked.Pointer(IsShort());
+        } else if constexpr (type == Type::Preflushable) {
+            return words.preflushable.Pointer(IsShort());
+        }
+    }
+
+    /// Returns true when the words of a summary block may have bits set
+    template <Type type>
+    [[nodiscard]] bool IsSummarySet(size_t block) const noexcept {
+        return ((words.template Summary<type>()[block / 64] >> (block % 64)) & 1) != 0;
+    }
+
+    /// Flags the summary block of a word that may have gained bits
+    template <Type type>
+    void SetSummary(size_t word_index) noexcept {
+        const size_t block = word_index / WORDS_PER_SUMMARY_BIT;
+        words.template Summary<type>()[block / 64] |= u64{1} << (block % 64);
+    }
+
+    /// Recomputes the summary blocks overlapping a byte range after bits have been cleared
+    template <Type type>
+    void RefreshSummary(size_t offset, size_t size) noexcept {
+        const WordRange range = GetWordRange(offset, size);
+        if (range.start_word >= range.end_word) {
+            return;
+        }
+        const u64* const state_words = Array<type>();
+        const std::span<u64> summary = words.template Summary<type>();
+        const size_t first_block = range.start_word / WORDS_PER_SUMMARY_BIT;
+        const size_t last_block = (range.end_word - 1) / WORDS_PER_SUMMARY_BIT;
+        for (size_t block = first_block; block <= last_block; ++block) {
+            const size_t begin = block * WORDS_PER_SUMMARY_BIT;
+            const size_t end = std::min<size_t>(begin + WORDS_PER_SUMMARY_BIT, NumWords());
+            const u64 bit = u64{1} << (block % 64);
+            if (FindNonZeroWord(state_words, nullptr, begin, end) != end) {
+                summary[block / 64] |= bit;
+            } else {
+                summary[block / 64] &= ~bit;
+            }
         }
     }
 
@@ -13,14 +13,13 @@ Scheduler::Scheduler(GPU& gpu_) : gpu{gpu_} {}
 
 Scheduler::~Scheduler() = default;
 
-void Scheduler::Push(s32 channel, CommandList&& entries) {
+void Scheduler::Push(s32 channel, u64 sequence) {
     std::unique_lock lk(scheduling_guard);
     auto it = channels.find(channel);
     ASSERT(it != channels.end());
     auto channel_state = it->second;
     gpu.BindChannel(channel_state->bind_id);
-    channel_state->dma_pusher->Push(std::move(entries));
-    channel_state->dma_pusher->DispatchCalls();
+    channel_state->dma_pusher->DispatchCalls(sequence);
 }
 
 void Scheduler::DeclareChannel(std::shared_ptr<ChannelState> new_channel) {
@@ -22,7 +22,7 @@ public:
     explicit Scheduler(GPU& gpu_);
     ~Scheduler();
 
-    void Push(s32 channel, CommandList&& entries);
+    void Push(s32 channel, u64 sequence);
 
     void DeclareChannel(std::shared_ptr<ChannelState> new_channel);
 
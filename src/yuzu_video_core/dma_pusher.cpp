@@ -1,7 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "yuzu_common/cityhash.h"
+#include "yuzu_common/logging/log.h"
 #include "yuzu_common/microprofile.h"
 #include "yuzu_common/settings.h"
 #include "core/core.h"
@@ -19,18 +22,38 @@ constexpr u32 ComputeInline = 0x6D;
 DmaPusher::DmaPusher(GPU& gpu_, MemoryManager& memory_manager_, Control::ChannelState& channel_state_)
     : gpu{gpu_}, memory_manager{memory_manager_}, puller{gpu_, memory_manager_, *this, channel_state_} {}
 
-DmaPusher::~DmaPusher() = default;
+DmaPusher::~DmaPusher() {
+    const auto stats{dma_pushbuffer.GetStatistics()};
+    if (stats.submitted != 0) {
+        LOG_INFO(HW_GPU, "{} command lists submitted, peak queue depth {}, {} spilled",
+                 stats.submitted, stats.peak_depth, stats.spilled);
+    }
+}
+
+u64 DmaPusher::Push(std::span<const CommandListHeader> command_lists,
+                    std::span<const CommandHeader> prefetch_command_list) {
+    CommandList& entries{dma_pushbuffer.Acquire()};
+    entries.command_lists.resize(command_lists.size(), boost::container::default_init);
+    std::copy(command_lists.begin(), command_lists.end(), entries.command_lists.begin());
+    entries.prefetch_command_list.resize(prefetch_command_list.size(),
+                                         boost::container::default_init);
+    std::copy(prefetch_command_list.begin(), prefetch_command_list.end(),
+              entries.prefetch_command_list.begin());
+    return dma_pushbuffer.Commit();
+}
 
 MICROPROFILE_DEFINE(DispatchCalls, "GPU", "Execute command buffer", MP_RGB(128, 128, 192));
 
-void DmaPusher::DispatchCalls() {
+void DmaPusher::DispatchCalls(u64 sequence) {
     MICROPROFILE_SCOPE(DispatchCalls);
 
     dma_pushbuffer_subindex = 0;
 
     dma_state.is_last_call = true;
 
-    for (;;) {
+    // Lists submitted after the one that was signaled are left for their own dispatch, so they
+    // stay ordered with the rest of the GPU thread commands
+    while (dma_pushbuffer.NumConsumed() < sequence) {
         if (!Step()) {
             break;
         }
@@ -40,18 +63,19 @@ void DmaPusher::DispatchCalls() {
 }
 
 bool DmaPusher::Step() {
-    if (!ib_enable || dma_pushbuffer.empty()) {
+    CommandList* const front{ib_enable ? dma_pushbuffer.Front() : nullptr};
+    if (!front) {
         // pushbuffer empty and IB empty or nonexistent - nothing to do
         return false;
     }
 
-    CommandList& command_list{dma_pushbuffer.front()};
+    CommandList& command_list{*front};
 
     ASSERT_OR_EXECUTE(
         command_list.command_lists.size() || command_list.prefetch_command_list.size(), {
             // Somehow the command_list is empty, in order to avoid a crash
             // We ignore it and assume its size is 0.
-            dma_pushbuffer.pop();
+            dma_pushbuffer.Pop();
             dma_pushbuffer_subindex = 0;
             return true;
         });
@@ -59,7 +83,7 @@ bool DmaPusher::Step() {
     if (command_list.prefetch_command_list.size()) {
         // Prefetched command list from nvdrv, used for things like synchronization
         ProcessCommands(command_list.prefetch_command_list);
-        dma_pushbuffer.pop();
+        dma_pushbuffer.Pop();
     } else {
         const CommandListHeader command_list_header{
             command_list.command_lists[dma_pushbuffer_subindex++]};
@@ -67,7 +91,7 @@ bool DmaPusher::Step() {
 
         if (dma_pushbuffer_subindex >= command_list.command_lists.size()) {
             // We've gone through the current list, remove it from the queue
-            dma_pushbuffer.pop();
+            dma_pushbuffer.Pop();
             dma_pushbuffer_subindex = 0;
         }
 
@@ -129,6 +153,15 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (const u32 run_length{RegisterRunLength(commands.size() - index)};
+                       run_length > 1) {
+                // Plain register writes, hand the whole run to the engine at once
+                subchannels[dma_state.subchannel]->WriteRegisterRun(
+                    dma_state.method, &command_header.argument, run_length);
+                dma_state.method += run_length;
+                dma_state.method_count -= run_length;
+                index += run_length;
+                continue;
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -217,6 +250,20 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+u32 DmaPusher::RegisterRunLength(std::size_t num_words) const {
+    if (dma_increment_once || dma_state.method < non_puller_methods) {
+        return 0;
+    }
+    const Engines::EngineInterface* const subchannel{subchannels[dma_state.subchannel]};
+    const u32 max_length{
+        static_cast<u32>(std::min<std::size_t>(dma_state.method_count, num_words))};
+    u32 length{};
+    while (length < max_length && !subchannel->execution_mask[dma_state.method + length]) {
+        ++length;
+    }
+    return length;
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer) {
     puller.BindRasterizer(rasterizer);
 }
@@ -7,13 +7,13 @@
 #include <span>
 #include <vector>
 #include <boost/container/small_vector.hpp>
-#include <queue>
 
 #include "yuzu_common/bit_field.h"
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/scratch_buffer.h"
 #include "yuzu_video_core/engines/engine_interface.h"
 #include "yuzu_video_core/engines/puller.h"
+#include "yuzu_video_core/submission_ring.h"
 
 namespace Core {
 class System;
@@ -107,6 +107,12 @@ struct CommandList final {
         boost::container::small_vector<CommandHeader, 512>&& prefetch_command_list_)
         : prefetch_command_list{std::move(prefetch_command_list_)} {}
 
+    /// Empties the list while keeping its storage around for reuse
+    void Clear() {
+        command_lists.clear();
+        prefetch_command_list.clear();
+    }
+
     boost::container::small_vector<CommandListHeader, 512> command_lists;
     boost::container::small_vector<CommandHeader, 512> prefetch_command_list;
 };
@@ -123,11 +129,17 @@ public:
     explicit DmaPusher(GPU& gpu_, MemoryManager& memory_manager_, Control::ChannelState& channel_state_);
     ~DmaPusher();
 
-    void Push(CommandList&& entries) {
-        dma_pushbuffer.push(std::move(entries));
-    }
+    /// Copies a GPFIFO submission into recycled command list storage (producer side)
+    /// @returns Sequence number to dispatch up to for the submission to be executed
+    u64 Push(std::span<const CommandListHeader> command_lists,
+             std::span<const CommandHeader> prefetch_command_list);
 
-    void DispatchCalls();
+    /// Executes the pushed command lists up to and including the given sequence number
+    void DispatchCalls(u64 sequence);
+
+    [[nodiscard]] SubmissionRing<CommandList, 64>::Statistics SubmissionStatistics() const noexcept {
+        return dma_pushbuffer.GetStatistics();
+    }
 
     void BindSubchannel(Engines::EngineInterface* engine, u32 subchannel_id,
                         Engines::EngineTypes engine_type) {
@@ -148,11 +160,13 @@ private:
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
+    u32 RegisterRunLength(std::size_t num_words) const;
+
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
 
-    std::queue<CommandList> dma_pushbuffer; ///< Queue of command lists to be processed
-    std::size_t dma_pushbuffer_subindex{};  ///< Index within a command list within the pushbuffer
+    SubmissionRing<CommandList, 64> dma_pushbuffer; ///< Ring of command lists to be processed
+    std::size_t dma_pushbuffer_subindex{};          ///< Index within a command list within the pushbuffer
 
     struct DmaState {
         u32 method;            ///< Current method
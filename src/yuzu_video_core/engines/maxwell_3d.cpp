@@ -324,6 +324,19 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
 }
 
+void Maxwell3D::ProcessDirtyRegisterRun(u32 method, const u32* arguments, u32 amount) {
+    u32* const registers{&regs.reg_array[method]};
+    for (u32 i = 0; i < amount; ++i) {
+        if (registers[i] == arguments[i]) {
+            continue;
+        }
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method + i]] = true;
+        }
+    }
+    std::memcpy(registers, arguments, amount * sizeof(u32));
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -394,7 +407,7 @@ void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argume
     }
 }
 
-void Maxwell3D::CallMacroMethod(u32 method, const std::vector<u32>& parameters) {
+void Maxwell3D::CallMacroMethod(u32 method, std::span<const u32> parameters) {
     // Reset the current macro.
     executing_macro = 0;
 
@@ -470,6 +483,22 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::WriteRegisterRun(u32 method, const u32* base_start, u32 amount) {
+    ASSERT(method + amount <= Regs::NUM_REGS);
+
+    // Keep the order with the writes that are still pending in the sink
+    ConsumeSink();
+
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], base_start, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        base_start = &shadow_state.reg_array[method];
+    }
+    ProcessDirtyRegisterRun(method, base_start, amount);
+}
+
 void Maxwell3D::ProcessMacroUpload(u32 data) {
     macro_engine->AddCode(regs.load_mme.instruction_ptr++, data);
 }
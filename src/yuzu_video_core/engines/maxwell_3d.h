@@ -8,6 +8,7 @@
 #include <cmath>
 #include <limits>
 #include <optional>
+#include <span>
 #include <type_traits>
 #include <vector>
 
@@ -3078,6 +3079,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write an incrementing run of registers without side effects in one go.
+    void WriteRegisterRun(u32 method, const u32* base_start, u32 amount) override;
+
     bool ShouldExecute() const {
         return execute_on;
     }
@@ -3140,6 +3144,8 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    void ProcessDirtyRegisterRun(u32 method, const u32* arguments, u32 amount);
+
     void ConsumeSinkImpl() override;
 
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
@@ -3156,7 +3162,7 @@ private:
      * @param method Method to call
      * @param parameters Arguments to the method call
      */
-    void CallMacroMethod(u32 method, const std::vector<u32>& parameters);
+    void CallMacroMethod(u32 method, std::span<const u32> parameters);
 
     /// Handles writes to the macro uploading register.
     void ProcessMacroUpload(u32 data);
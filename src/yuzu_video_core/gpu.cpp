@@ -7,6 +7,7 @@
 #include <condition_variable>
 #include <list>
 #include <memory>
+#include <mutex>
 
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/microprofile.h"
@@ -27,6 +28,7 @@
 #include "yuzu_video_core/engines/maxwell_dma.h"
 #include "yuzu_video_core/gpu.h"
 #include "yuzu_video_core/gpu_thread.h"
+#include "yuzu_video_core/host1x/ffmpeg/ffmpeg.h"
 #include "yuzu_video_core/host1x/host1x.h"
 #include "yuzu_video_core/host1x/syncpoint_manager.h"
 #include "yuzu_video_core/memory_manager.h"
@@ -47,7 +49,10 @@ struct GPU::Impl :
 
     std::shared_ptr<Control::ChannelState> CreateChannel(s32 channel_id) {
         auto channel_state = std::make_shared<Tegra::Control::ChannelState>(channel_id);
-        channels.emplace(channel_id, channel_state);
+        {
+            std::scoped_lock lock{channel_mutex};
+            channels.emplace(channel_id, channel_state);
+        }
         scheduler->DeclareChannel(channel_state);
         return channel_state;
     }
@@ -56,10 +61,13 @@ struct GPU::Impl :
         if (bound_channel == channel_id) {
             return;
         }
-        auto it = channels.find(channel_id);
-        ASSERT(it != channels.end());
+        {
+            std::scoped_lock lock{channel_mutex};
+            auto it = channels.find(channel_id);
+            ASSERT(it != channels.end());
+            current_channel = it->second.get();
+        }
         bound_channel = channel_id;
-        current_channel = it->second.get();
 
         rasterizer->BindChannel(*current_channel);
     }
@@ -201,6 +209,15 @@ struct GPU::Impl :
         return 0;
     }
 
+    [[nodiscard]] u64 GetFrontendTime() const {
+        return gpu_thread.BusyTime();
+    }
+
+    [[nodiscard]] VideoCommon::TextureCacheStatistics GetTextureCacheStatistics() const {
+        return rasterizer != nullptr ? rasterizer->GetTextureCacheStatistics()
+                                     : VideoCommon::TextureCacheStatistics{};
+    }
+
     [[nodiscard]] bool IsAsync() const {
         return is_async;
     }
@@ -241,8 +258,18 @@ struct GPU::Impl :
     }
 
     /// Push GPU command entries to be processed
-    void PushGPUEntries(s32 channel, Tegra::CommandList&& entries) {
-        gpu_thread.SubmitList(channel, std::move(entries));
+    void PushGPUEntries(s32 channel, std::span<const Tegra::CommandListHeader> command_lists,
+                        std::span<const Tegra::CommandHeader> prefetch_command_list) {
+        Tegra::Control::ChannelState* channel_state;
+        {
+            // Channels are created from the service thread while submissions are pushed
+            std::scoped_lock lock{channel_mutex};
+            const auto it{channels.find(channel)};
+            ASSERT(it != channels.end());
+            channel_state = it->second.get();
+        }
+        const u64 sequence{channel_state->dma_pusher->Push(command_lists, prefetch_command_list)};
+        gpu_thread.SubmitList(channel, sequence);
     }
 
     /// Push GPU command buffer entries to be processed
@@ -251,6 +278,17 @@ struct GPU::Impl :
             return;
         }
 
+        if (!FFmpeg::DecodeApi::IsAvailable()) {
+            // Refuse the channel rather than hand VIC empty frames for the whole session
+            static std::once_flag reported;
+            std::call_once(reported, [] {
+                LOG_CRITICAL(HW_GPU, "NVDEC channels are unavailable, this build has no FFmpeg "
+                                     "support (set FFmpegDir, or build with FFmpeg found). "
+                                     "Video playback will not work.");
+            });
+            return;
+        }
+
         if (!cdma_pushers.contains(id)) {
             cdma_pushers.insert_or_assign(id, std::make_unique<Tegra::CDmaPusher>(host1x));
         }
@@ -394,6 +432,7 @@ struct GPU::Impl :
     std::unique_ptr<Core::Frontend::GraphicsContext> cpu_context;
 
     std::unique_ptr<Tegra::Control::Scheduler> scheduler;
+    std::mutex channel_mutex;
     std::unordered_map<s32, std::shared_ptr<Tegra::Control::ChannelState>> channels;
     Tegra::Control::ChannelState* current_channel;
     s32 bound_channel{-1};
@@ -524,6 +563,14 @@ u64 GPU::GetTicks() const {
     return impl->GetTicks();
 }
 
+u64 GPU::GetFrontendTime() const {
+    return impl->GetFrontendTime();
+}
+
+VideoCommon::TextureCacheStatistics GPU::GetTextureCacheStatistics() const {
+    return impl->GetTextureCacheStatistics();
+}
+
 bool GPU::IsAsync() const {
     return impl->IsAsync();
 }
@@ -552,8 +599,9 @@ void GPU::ReleaseContext() {
     impl->ReleaseContext();
 }
 
-void GPU::PushGPUEntries(s32 channel, Tegra::CommandList&& entries) {
-    impl->PushGPUEntries(channel, std::move(entries));
+void GPU::PushGPUEntries(s32 channel, std::span<const Tegra::CommandListHeader> command_lists,
+                         std::span<const Tegra::CommandHeader> prefetch_command_list) {
+    impl->PushGPUEntries(channel, command_lists, prefetch_command_list);
 }
 
 void GPU::PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries) {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include "yuzu_common/bit_field.h"
 #include "yuzu_common/common_types.h"
@@ -22,9 +23,14 @@ class RendererBase;
 class ShaderNotify;
 } // namespace VideoCore
 
+namespace VideoCommon {
+struct TextureCacheStatistics;
+} // namespace VideoCommon
+
 namespace Tegra {
 class DmaPusher;
-struct CommandList;
+struct CommandListHeader;
+union CommandHeader;
 
 // TODO: Implement the commented ones
 enum class RenderTargetFormat : u32 {
@@ -207,6 +213,12 @@ public:
 
     [[nodiscard]] u64 GetTicks() const;
 
+    /// Returns the time in nanoseconds the GPU thread has spent executing commands.
+    [[nodiscard]] u64 GetFrontendTime() const;
+
+    /// Returns the texture cache statistics published on the last frame.
+    [[nodiscard]] VideoCommon::TextureCacheStatistics GetTextureCacheStatistics() const;
+
     [[nodiscard]] bool IsAsync() const;
 
     [[nodiscard]] bool UseNvdec() const;
@@ -233,7 +245,8 @@ public:
     void ReleaseContext();
 
     /// Push GPU command entries to be processed
-    void PushGPUEntries(s32 channel, Tegra::CommandList&& entries);
+    void PushGPUEntries(s32 channel, std::span<const Tegra::CommandListHeader> command_lists,
+                        std::span<const Tegra::CommandHeader> prefetch_command_list);
 
     /// Push GPU command buffer entries to be processed
     void PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries);
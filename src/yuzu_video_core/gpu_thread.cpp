@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/microprofile.h"
 #include "yuzu_common/scope_exit.h"
@@ -39,8 +41,9 @@ static void RunThread(std::stop_token stop_token, Tegra::GPU & gpu,
         if (stop_token.stop_requested()) {
             break;
         }
+        const auto busy_start = std::chrono::steady_clock::now();
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
-            scheduler.Push(submit_list->channel, std::move(submit_list->entries));
+            scheduler.Push(submit_list->channel, submit_list->sequence);
         } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
             gpu.TickWork();
         } else if (const auto* flush = std::get_if<FlushRegionCommand>(&next.data)) {
@@ -50,6 +53,10 @@ static void RunThread(std::stop_token stop_token, Tegra::GPU & gpu,
         } else {
             ASSERT(false);
         }
+        state.busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now() - busy_start)
+                                    .count(),
+                                std::memory_order_relaxed);
         state.signaled_fence.store(next.fence);
         if (next.block) {
             // We have to lock the write_lock to ensure that the condition_variable wait not get a
@@ -75,8 +82,8 @@ void ThreadManager::StartThread(VideoCore::RendererBase& renderer,
                           std::ref(scheduler), std::ref(state));
 }
 
-void ThreadManager::SubmitList(s32 channel, Tegra::CommandList&& entries) {
-    PushCommand(SubmitListCommand(channel, std::move(entries)));
+void ThreadManager::SubmitList(s32 channel, u64 sequence) {
+    PushCommand(SubmitListCommand(channel, sequence));
 }
 
 void ThreadManager::FlushRegion(DAddr addr, u64 size) {
@@ -36,12 +36,13 @@ class RendererBase;
 namespace VideoCommon::GPUThread {
 
 /// Command to signal to the GPU thread that a command list is ready for processing
+/// The entries themselves are handed over through the submission ring of the channel
 struct SubmitListCommand final {
-    explicit SubmitListCommand(s32 channel_, Tegra::CommandList&& entries_)
-        : channel{channel_}, entries{std::move(entries_)} {}
+    explicit constexpr SubmitListCommand(s32 channel_, u64 sequence_)
+        : channel{channel_}, sequence{sequence_} {}
 
     s32 channel;
-    Tegra::CommandList entries;
+    u64 sequence;
 };
 
 /// Command to signal to the GPU thread to flush a region
@@ -94,6 +95,7 @@ struct SynchState final {
     CommandQueue queue;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
+    std::atomic<u64> busy_ns{};
     std::condition_variable_any cv;
 };
 
@@ -107,8 +109,8 @@ public:
     void StartThread(VideoCore::RendererBase& renderer, Core::Frontend::GraphicsContext& context,
                      Tegra::Control::Scheduler& scheduler);
 
-    /// Push GPU command entries to be processed
-    void SubmitList(s32 channel, Tegra::CommandList&& entries);
+    /// Signal that the command lists of a channel up to a sequence number are ready to be processed
+    void SubmitList(s32 channel, u64 sequence);
 
     /// Notify rasterizer that any caches of the specified region should be flushed to Switch memory
     void FlushRegion(DAddr addr, u64 size);
@@ -121,6 +123,11 @@ public:
 
     void TickGPU();
 
+    /// Returns the time in nanoseconds the GPU thread has spent executing commands
+    [[nodiscard]] u64 BusyTime() const {
+        return state.busy_ns.load(std::memory_order_relaxed);
+    }
+
 private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data, bool block = false);
@@ -2,12 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "yuzu_common/yuzu_assert.h"
+#include "yuzu_common/logging/log.h"
 #include "yuzu_common/settings.h"
 #include "yuzu_video_core/host1x/codecs/codec.h"
 #include "yuzu_video_core/host1x/codecs/h264.h"
 #include "yuzu_video_core/host1x/codecs/vp8.h"
 #include "yuzu_video_core/host1x/codecs/vp9.h"
 #include "yuzu_video_core/host1x/host1x.h"
+#include "yuzu_video_core/host1x/nvdec.h"
 #include "yuzu_video_core/memory_manager.h"
 
 namespace Tegra {
@@ -20,15 +22,83 @@ Codec::Codec(Host1x::Host1x& host1x_, const Host1x::NvdecCommon::NvdecRegisters&
 Codec::~Codec() = default;
 
 void Codec::Initialize() {
-    UNIMPLEMENTED();
-    initialized = false;  // decode_api.Initialize(current_codec);
+    initialized = decode_api.Initialize(current_codec);
+    // Do not retry, and log, on every frame of a stream the decoder can not handle
+    initialize_failed = !initialized;
 }
 
 void Codec::SetTargetCodec(Host1x::NvdecCommon::VideoCodec codec) {
     if (current_codec != codec) {
         current_codec = codec;
         LOG_INFO(Service_NVDRV, "NVDEC video codec initialized to {}", GetCurrentCodecName());
+
+        decode_api.Reset();
+        initialized = false;
+        initialize_failed = false;
+        frames = {};
+    }
+}
+
+void Codec::Decode() {
+    const bool is_first_frame = !initialized;
+    if (is_first_frame) {
+        if (initialize_failed) {
+            return;
+        }
+        Initialize();
+    }
+    if (!initialized) {
+        return;
+    }
+
+    // Assemble bitstream.
+    bool vp9_hidden_frame = false;
+    size_t configuration_size = 0;
+    const auto packet_data = [&]() {
+        switch (current_codec) {
+        case Host1x::NvdecCommon::VideoCodec::H264:
+            return h264_decoder->ComposeFrame(state, &configuration_size, is_first_frame);
+        case Host1x::NvdecCommon::VideoCodec::VP8:
+            return vp8_decoder->ComposeFrame(state);
+        case Host1x::NvdecCommon::VideoCodec::VP9:
+            vp9_decoder->ComposeFrame(state);
+            vp9_hidden_frame = vp9_decoder->WasFrameHidden();
+            return vp9_decoder->GetFrameBytes();
+        default:
+            ASSERT(false);
+            return std::span<const u8>{};
+        }
+    }();
+
+    // Send assembled bitstream to decoder.
+    if (!decode_api.SendPacket(packet_data)) {
+        return;
     }
+
+    // Only receive/store visible frames.
+    if (vp9_hidden_frame) {
+        return;
+    }
+
+    // Receive output frames from decoder. The frames reference pooled decoder buffers, dropping
+    // them hands the buffers back to the decoder.
+    decode_api.ReceiveFrames(frames);
+    while (frames.size() > 10) {
+        LOG_DEBUG(HW_GPU, "ReceiveFrames overflow, dropped frame");
+        frames.pop();
+    }
+}
+
+std::shared_ptr<const Host1x::DecodedFrame> Codec::GetCurrentFrame() {
+    // Sometimes VIC will request more frames than have been decoded,
+    // in this case return nothing so the previous frame is kept.
+    if (frames.empty()) {
+        return {};
+    }
+
+    auto frame = std::move(frames.front());
+    frames.pop();
+    return frame;
 }
 
 Host1x::NvdecCommon::VideoCodec Codec::GetCurrentCodec() const {
@@ -21,6 +21,7 @@ class VP9;
 
 namespace Host1x {
 class Host1x;
+struct DecodedFrame;
 } // namespace Host1x
 
 class Codec {
@@ -34,6 +35,12 @@ public:
     /// Sets NVDEC video stream codec
     void SetTargetCodec(Host1x::NvdecCommon::VideoCodec codec);
 
+    /// Call decoders to construct headers and decode the frame
+    void Decode();
+
+    /// Returns next decoded frame, nullptr if no frame is ready
+    [[nodiscard]] std::shared_ptr<const Host1x::DecodedFrame> GetCurrentFrame();
+
     /// Returns the value of current_codec
     [[nodiscard]] Host1x::NvdecCommon::VideoCodec GetCurrentCodec() const;
 
@@ -42,6 +49,7 @@ public:
 
 private:
     bool initialized{};
+    bool initialize_failed{};
     Host1x::NvdecCommon::VideoCodec current_codec{Host1x::NvdecCommon::VideoCodec::None};
     FFmpeg::DecodeApi decode_api;
 
@@ -50,6 +58,8 @@ private:
     std::unique_ptr<Decoder::H264> h264_decoder;
     std::unique_ptr<Decoder::VP8> vp8_decoder;
     std::unique_ptr<Decoder::VP9> vp9_decoder;
+
+    std::queue<std::shared_ptr<const Host1x::DecodedFrame>> frames{};
 };
 
 } // namespace Tegra
@@ -1,15 +1,371 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/logging/log.h"
-#include "yuzu_common/scope_exit.h"
-#include "yuzu_common/settings.h"
 #include "yuzu_video_core/host1x/ffmpeg/ffmpeg.h"
+#include "yuzu_video_core/host1x/nvdec.h"
 
+#ifdef HAS_FFMPEG
 extern "C" {
-#ifdef LIBVA_FOUND
-// for querying VAAPI driver information
-#include <libavutil/hwcontext_vaapi.h>
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+
+#include <libavcodec/avcodec.h>
+#include <libavutil/buffer.h>
+#include <libavutil/imgutils.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+}
+#endif
+
+namespace FFmpeg {
+
+#ifdef HAS_FFMPEG
+
+namespace {
+
+using Tegra::Host1x::DecodedFrame;
+using Tegra::Host1x::NvdecCommon::VideoCodec;
+
+/// Row alignment of pooled planes, wide enough for the AVX-512 paths of the decoders
+constexpr int LinesizeAlign = 64;
+/// Slack after each plane for decoders that read past the last row
+constexpr std::size_t PlanePadding = 16 + LinesizeAlign - 1;
+/// Upper bound of decoder threads. Frame threading delays output by one frame per extra thread,
+/// so this also bounds the latency added to video playback.
+constexpr unsigned MaxDecodeThreads = 4;
+
+std::string AVError(int errnum) {
+    char errbuf[AV_ERROR_MAX_STRING_SIZE] = {};
+    av_make_error_string(errbuf, sizeof(errbuf) - 1, errnum);
+    return errbuf;
+}
+
+int DecodeThreadCount() {
+    // Leave at least half of the host to the guest CPU and GPU threads
+    return static_cast<int>(std::clamp(std::thread::hardware_concurrency() / 2, 1U,
+                                       MaxDecodeThreads));
+}
+
+std::optional<DecodedFrame::Format> ToFrameFormat(int format) {
+    switch (format) {
+    case AV_PIX_FMT_NV12:
+        return DecodedFrame::Format::NV12;
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUVJ420P:
+        return DecodedFrame::Format::YUV420;
+    default:
+        return std::nullopt;
+    }
+}
+
+/// Owns an AVFrame for as long as a decoded frame references its planes
+class Frame {
+public:
+    YUZU_NON_COPYABLE(Frame);
+    YUZU_NON_MOVEABLE(Frame);
+
+    Frame() : m_frame{av_frame_alloc()} {}
+    ~Frame() {
+        av_frame_free(&m_frame);
+    }
+
+    AVFrame* GetFrame() const {
+        return m_frame;
+    }
+
+private:
+    AVFrame* m_frame{};
+};
+
+/**
+ * Picture buffer allocator installed as get_buffer2 of the codec context. Buffers are taken from
+ * one AVBufferPool per plane and return to it once the last reference to the frame is dropped,
+ * which may happen on the VIC after the decoder has moved on. With frame threading the callback
+ * is invoked from the decoder threads, so pool (re)creation is serialised.
+ */
+class FramePool {
+public:
+    YUZU_NON_COPYABLE(FramePool);
+    YUZU_NON_MOVEABLE(FramePool);
+
+    FramePool() = default;
+    ~FramePool() {
+        Release();
+    }
+
+    void Attach(AVCodecContext* context) {
+        context->opaque = this;
+        context->get_buffer2 = &FramePool::GetBuffer;
+    }
+
+private:
+    static int GetBuffer(AVCodecContext* context, AVFrame* frame, int flags) {
+        return static_cast<FramePool*>(context->opaque)->Allocate(context, frame, flags);
+    }
+
+    int Allocate(AVCodecContext* context, AVFrame* frame, int flags) {
+        if ((context->codec->capabilities & AV_CODEC_CAP_DR1) == 0 ||
+            !ToFrameFormat(frame->format)) {
+            return avcodec_default_get_buffer2(context, frame, flags);
+        }
+
+        std::scoped_lock lock{m_mutex};
+        if (frame->format != m_format || frame->width != m_width || frame->height != m_height) {
+            if (!Reinitialize(context, static_cast<AVPixelFormat>(frame->format), frame->width,
+                              frame->height)) {
+                return AVERROR(ENOMEM);
+            }
+        }
+
+        for (std::size_t plane = 0; plane < m_pools.size() && m_pools[plane]; ++plane) {
+            frame->buf[plane] = av_buffer_pool_get(m_pools[plane]);
+            if (!frame->buf[plane]) {
+                av_frame_unref(frame);
+                return AVERROR(ENOMEM);
+            }
+            frame->data[plane] = frame->buf[plane]->data;
+            frame->linesize[plane] = m_linesizes[plane];
+        }
+        frame->extended_data = frame->data;
+        return 0;
+    }
+
+    bool Reinitialize(AVCodecContext* context, AVPixelFormat format, int width, int height) {
+        Release();
+
+        int aligned_width = width;
+        int aligned_height = height;
+        std::array<int, AV_NUM_DATA_POINTERS> linesize_align{};
+        avcodec_align_dimensions2(context, &aligned_width, &aligned_height,
+                                  linesize_align.data());
+
+        std::array<int, 4> linesizes{};
+        if (av_image_fill_linesizes(linesizes.data(), format, aligned_width) < 0) {
+            return false;
+        }
+        std::array<ptrdiff_t, 4> plane_linesizes{};
+        for (std::size_t plane = 0; plane < linesizes.size(); ++plane) {
+            linesizes[plane] = FFALIGN(linesizes[plane], LinesizeAlign);
+            plane_linesizes[plane] = linesizes[plane];
+        }
+        std::array<size_t, 4> plane_sizes{};
+        if (av_image_fill_plane_sizes(plane_sizes.data(), format, aligned_height,
+                                      plane_linesizes.data()) < 0) {
+            return false;
+        }
+
+        for (std::size_t plane = 0; plane < m_pools.size() && plane_sizes[plane] != 0; ++plane) {
+            m_pools[plane] = av_buffer_pool_init(plane_sizes[plane] + PlanePadding, nullptr);
+            if (!m_pools[plane]) {
+                Release();
+                return false;
+            }
+            m_linesizes[plane] = linesizes[plane];
+        }
+        m_format = format;
+        m_width = width;
+        m_height = height;
+        LOG_DEBUG(HW_GPU, "Decoder frame pool sized for {}x{}", width, height);
+        return true;
+    }
+
+    void Release() {
+        // Buffers still referenced by frames keep their pool alive until they are returned
+        for (AVBufferPool*& pool : m_pools) {
+            av_buffer_pool_uninit(&pool);
+        }
+        m_linesizes = {};
+        m_format = AV_PIX_FMT_NONE;
+        m_width = 0;
+        m_height = 0;
+    }
+
+    std::mutex m_mutex;
+    std::array<AVBufferPool*, 3> m_pools{};
+    std::array<int, 3> m_linesizes{};
+    int m_format{AV_PIX_FMT_NONE};
+    int m_width{};
+    int m_height{};
+};
+
+} // Anonymous namespace
+
+struct DecodeApi::Impl {
+    YUZU_NON_COPYABLE(Impl);
+    YUZU_NON_MOVEABLE(Impl);
+
+    Impl() = default;
+    ~Impl() {
+        avcodec_free_context(&m_codec_context);
+        av_packet_free(&m_packet);
+    }
+
+    bool Initialize(VideoCodec codec) {
+        const AVCodecID av_codec = [&] {
+            switch (codec) {
+            case VideoCodec::H264:
+                return AV_CODEC_ID_H264;
+            case VideoCodec::VP8:
+                return AV_CODEC_ID_VP8;
+            case VideoCodec::VP9:
+                return AV_CODEC_ID_VP9;
+            default:
+                UNIMPLEMENTED_MSG("Unknown codec {}", static_cast<u64>(codec));
+                return AV_CODEC_ID_NONE;
+            }
+        }();
+
+        m_codec = avcodec_find_decoder(av_codec);
+        if (!m_codec) {
+            LOG_ERROR(HW_GPU, "Decoder for codec {} is not available", avcodec_get_name(av_codec));
+            return false;
+        }
+        m_codec_context = avcodec_alloc_context3(m_codec);
+        m_packet = av_packet_alloc();
+        if (!m_codec_context || !m_packet) {
+            LOG_ERROR(HW_GPU, "Failed to allocate the decoder context");
+            return false;
+        }
+
+        // Slice threading splits each picture, frame threading overlaps consecutive pictures.
+        // FFmpeg picks whichever the stream allows.
+        m_codec_context->thread_count = DecodeThreadCount();
+        m_codec_context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+        m_pool.Attach(m_codec_context);
+
+        if (const int ret = avcodec_open2(m_codec_context, m_codec, nullptr); ret < 0) {
+            LOG_ERROR(HW_GPU, "avcodec_open2 error: {}", AVError(ret));
+            return false;
+        }
+        LOG_INFO(HW_GPU, "Using software {} decoder with {} threads", m_codec->name,
+                 m_codec_context->thread_count);
+        return true;
+    }
+
+    bool SendPacket(std::span<const u8> packet_data) {
+        // The bitstream readers of the decoders over-read, so the packet has to be padded
+        m_packet_data.resize(packet_data.size() + AV_INPUT_BUFFER_PADDING_SIZE);
+        std::memcpy(m_packet_data.data(), packet_data.data(), packet_data.size());
+        std::memset(m_packet_data.data() + packet_data.size(), 0, AV_INPUT_BUFFER_PADDING_SIZE);
+        m_packet->data = m_packet_data.data();
+        m_packet->size = static_cast<int>(packet_data.size());
+
+        if (const int ret = avcodec_send_packet(m_codec_context, m_packet); ret < 0) {
+            LOG_DEBUG(HW_GPU, "avcodec_send_packet error: {}", AVError(ret));
+            return false;
+        }
+        return true;
+    }
+
+    void ReceiveFrames(std::queue<std::shared_ptr<const DecodedFrame>>& frame_queue) {
+        while (true) {
+            // An empty frame is kept around so polling a decoder that has nothing ready does
+            // not allocate
+            if (!m_spare_frame) {
+                m_spare_frame = std::make_shared<Frame>();
+            }
+            AVFrame* const av_frame = m_spare_frame->GetFrame();
+            if (const int ret = avcodec_receive_frame(m_codec_context, av_frame); ret < 0) {
+                if (ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
+                    LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
+                }
+                return;
+            }
+
+            const auto format = ToFrameFormat(av_frame->format);
+            if (!format) {
+                LOG_WARNING(HW_GPU, "Dropping frame with unsupported pixel format {}",
+                            av_frame->format);
+                av_frame_unref(av_frame);
+                continue;
+            }
+
+            auto decoded = std::make_shared<DecodedFrame>();
+            decoded->format = *format;
+            decoded->width = static_cast<u32>(av_frame->width);
+            decoded->height = static_cast<u32>(av_frame->height);
+            const std::size_t num_planes = *format == DecodedFrame::Format::NV12 ? 2 : 3;
+            for (std::size_t plane = 0; plane < num_planes; ++plane) {
+                decoded->planes[plane] = av_frame->data[plane];
+                decoded->stride[plane] = static_cast<u32>(av_frame->linesize[plane]);
+            }
+            decoded->owner = std::move(m_spare_frame);
+            frame_queue.push(std::move(decoded));
+        }
+    }
+
+    const AVCodec* m_codec{};
+    AVCodecContext* m_codec_context{};
+    AVPacket* m_packet{};
+    std::vector<u8> m_packet_data;
+    std::shared_ptr<Frame> m_spare_frame;
+    FramePool m_pool;
+};
+
+#else
+
+struct DecodeApi::Impl {
+    bool Initialize(Tegra::Host1x::NvdecCommon::VideoCodec) {
+        // NVDEC channels are refused before a codec is set up, see GPU::PushCommandBuffer
+        return false;
+    }
+
+    bool SendPacket(std::span<const u8>) {
+        return false;
+    }
+
+    void ReceiveFrames(std::queue<std::shared_ptr<const Tegra::Host1x::DecodedFrame>>&) {}
+};
+
+#endif
+
+DecodeApi::DecodeApi() = default;
+
+bool DecodeApi::IsAvailable() {
+#ifdef HAS_FFMPEG
+    return true;
+#else
+    return false;
 #endif
 }
+
+DecodeApi::~DecodeApi() = default;
+
+bool DecodeApi::Initialize(Tegra::Host1x::NvdecCommon::VideoCodec codec) {
+    impl = std::make_unique<Impl>();
+    if (!impl->Initialize(codec)) {
+        impl.reset();
+        return false;
+    }
+    return true;
+}
+
+void DecodeApi::Reset() {
+    impl.reset();
+}
+
+bool DecodeApi::SendPacket(std::span<const u8> packet_data) {
+    return impl && impl->SendPacket(packet_data);
+}
+
+void DecodeApi::ReceiveFrames(
+    std::queue<std::shared_ptr<const Tegra::Host1x::DecodedFrame>>& frame_queue) {
+    if (impl) {
+        impl->ReceiveFrames(frame_queue);
+    }
+}
+
+} // namespace FFmpeg
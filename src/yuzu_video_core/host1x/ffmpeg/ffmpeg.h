@@ -13,31 +13,40 @@
 #include "yuzu_common/common_types.h"
 #include "yuzu_video_core/host1x/nvdec_common.h"
 
-extern "C" {
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
-}
+namespace Tegra::Host1x {
+struct DecodedFrame;
+} // namespace Tegra::Host1x
 
 namespace FFmpeg {
 
+/**
+ * Software video decoder used by NVDEC. Decoding runs frame and slice threaded inside FFmpeg,
+ * picture buffers come from a pool owned by the decoder and decoded frames are handed out
+ * referencing those buffers directly, so steady state decoding neither allocates nor copies
+ * pictures.
+ */
 class DecodeApi {
 public:
     YUZU_NON_COPYABLE(DecodeApi);
     YUZU_NON_MOVEABLE(DecodeApi);
 
-    DecodeApi() = default;
-    ~DecodeApi() = default;
+    DecodeApi();
+    ~DecodeApi();
+
+    /// Returns true when the build includes FFmpeg, without it no stream can be decoded
+    static bool IsAvailable();
 
     bool Initialize(Tegra::Host1x::NvdecCommon::VideoCodec codec);
     void Reset();
 
-    bool SendPacket(std::span<const u8> packet_data, size_t configuration_size);
+    bool SendPacket(std::span<const u8> packet_data);
+
+    /// Appends every frame the decoder has finished to the queue, oldest first
+    void ReceiveFrames(std::queue<std::shared_ptr<const Tegra::Host1x::DecodedFrame>>& frame_queue);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
 };
 
 } // namespace FFmpeg
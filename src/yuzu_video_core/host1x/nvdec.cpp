@@ -23,9 +23,33 @@ void Nvdec::ProcessMethod(u32 method, u32 argument) {
         codec->SetTargetCodec(static_cast<NvdecCommon::VideoCodec>(argument));
         break;
     case NVDEC_REG_INDEX(execute):
-        UNIMPLEMENTED();
+        Execute();
         break;
     }
 }
 
+void Nvdec::Execute() {
+    switch (codec->GetCurrentCodec()) {
+    case NvdecCommon::VideoCodec::H264:
+    case NvdecCommon::VideoCodec::VP8:
+    case NvdecCommon::VideoCodec::VP9:
+        codec->Decode();
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Codec {}", codec->GetCurrentCodecName());
+        return;
+    }
+
+    // Keep showing the previous frame while the decoder is still filling its pipeline
+    if (auto frame = codec->GetCurrentFrame()) {
+        std::scoped_lock lock{frame_mutex};
+        last_frame = std::move(frame);
+    }
+}
+
+std::shared_ptr<const DecodedFrame> Nvdec::GetFrame() {
+    std::scoped_lock lock{frame_mutex};
+    return last_frame;
+}
+
 } // namespace Tegra::Host1x
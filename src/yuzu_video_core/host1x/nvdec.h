@@ -3,8 +3,9 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
-#include <vector>
+#include <mutex>
 #include "yuzu_common/common_types.h"
 #include "yuzu_video_core/host1x/codecs/codec.h"
 
@@ -14,6 +15,27 @@ namespace Host1x {
 
 class Host1x;
 
+/// A decoded 4:2:0 picture handed from Nvdec to Vic for post-processing
+struct DecodedFrame {
+    enum class Format : u32 {
+        NV12,   ///< Luma plane followed by an interleaved UV plane
+        YUV420, ///< Luma, U and V planes
+        YV12,   ///< Luma, V and U planes
+    };
+
+    [[nodiscard]] const u8* Plane(std::size_t index) const {
+        return planes[index];
+    }
+
+    Format format{};
+    u32 width{};
+    u32 height{};
+    std::array<u32, 3> stride{};
+    std::array<const u8*, 3> planes{};
+    /// Keeps the decoder buffer the planes point into alive
+    std::shared_ptr<const void> owner;
+};
+
 class Nvdec {
 public:
     explicit Nvdec(Host1x& host1x);
@@ -22,10 +44,19 @@ public:
     /// Writes the method into the state, Invoke Execute() if encountered
     void ProcessMethod(u32 method, u32 argument);
 
+    /// Returns the most recently decoded frame, nullptr if nothing has been decoded yet
+    [[nodiscard]] std::shared_ptr<const DecodedFrame> GetFrame();
+
 private:
+    /// Invoke codec to decode a frame
+    void Execute();
+
     Host1x& host1x;
     NvdecCommon::NvdecRegisters state;
     std::unique_ptr<Codec> codec;
+
+    std::mutex frame_mutex;
+    std::shared_ptr<const DecodedFrame> last_frame;
 };
 
 } // namespace Host1x
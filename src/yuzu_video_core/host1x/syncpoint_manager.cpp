@@ -10,92 +10,110 @@ namespace Host1x {
 
 MICROPROFILE_DEFINE(GPU_wait, "GPU", "Wait for the GPU", MP_RGB(128, 128, 192));
 
-uint32_t SyncpointManager::RegisterAction(
-    std::atomic<u32>& syncpoint, std::list<RegisteredAction>& action_storage, u32 expected_value,
-    std::function<void()>&& action) {
-    if (syncpoint.load(std::memory_order_acquire) >= expected_value) {
+uint32_t SyncpointManager::RegisterAction(Syncpoint& syncpoint, u32 expected_value,
+                                          std::function<void()>&& action) {
+    if (syncpoint.value.load(std::memory_order_acquire) >= expected_value) {
         action();
         return {};
     }
 
-    std::unique_lock lk(guard);
-    if (syncpoint.load(std::memory_order_relaxed) >= expected_value) {
-        action();
-        return {};
-    }
-    auto it = action_storage.begin();
-    while (it != action_storage.end()) {
+    std::unique_lock lk(syncpoint.guard);
+    auto it = syncpoint.actions.begin();
+    while (it != syncpoint.actions.end()) {
         if (it->expected_value >= expected_value) {
             break;
         }
         ++it;
     }
     u32 action_id = next_action_id.fetch_add(1);
-    action_storage.emplace(it, expected_value, action_id, std::move(action));
+    syncpoint.actions.emplace(it, expected_value, action_id, std::move(action));
+    syncpoint.next_action_value.store(syncpoint.actions.front().expected_value);
+
+    // An increment that did not observe the new threshold yet has to be caught up here
+    if (syncpoint.value.load() >= syncpoint.actions.front().expected_value) {
+        RunReachedActions(syncpoint);
+    }
     return action_id;
 }
 
-void SyncpointManager::DeregisterAction(std::list<RegisteredAction>& action_storage,
-                                        uint32_t handle) {
-    std::unique_lock lk(guard);
-    for (auto it = action_storage.begin(); it != action_storage.end(); it++) {
+void SyncpointManager::DeregisterAction(Syncpoint& syncpoint, uint32_t handle) {
+    std::unique_lock lk(syncpoint.guard);
+    for (auto it = syncpoint.actions.begin(); it != syncpoint.actions.end(); it++) {
         if (it->action_id == handle) {
-            action_storage.erase(it);
+            syncpoint.actions.erase(it);
+            syncpoint.next_action_value.store(syncpoint.actions.empty()
+                                                  ? NO_PENDING_ACTION
+                                                  : syncpoint.actions.front().expected_value);
             return;
         }
     }
 }
 
 void SyncpointManager::DeregisterGuestAction(u32 syncpoint_id, uint32_t handle) {
-    DeregisterAction(guest_action_storage[syncpoint_id], handle);
+    DeregisterAction(syncpoints_guest[syncpoint_id], handle);
 }
 
 void SyncpointManager::DeregisterHostAction(u32 syncpoint_id, uint32_t handle) {
-    DeregisterAction(host_action_storage[syncpoint_id], handle);
+    DeregisterAction(syncpoints_host[syncpoint_id], handle);
 }
 
 void SyncpointManager::IncrementGuest(u32 syncpoint_id) {
-    Increment(syncpoints_guest[syncpoint_id], wait_guest_cv, guest_action_storage[syncpoint_id]);
+    Increment(syncpoints_guest[syncpoint_id]);
 }
 
 void SyncpointManager::IncrementHost(u32 syncpoint_id) {
-    Increment(syncpoints_host[syncpoint_id], wait_host_cv, host_action_storage[syncpoint_id]);
+    Increment(syncpoints_host[syncpoint_id]);
 }
 
 void SyncpointManager::WaitGuest(u32 syncpoint_id, u32 expected_value) {
-    Wait(syncpoints_guest[syncpoint_id], wait_guest_cv, expected_value);
+    Wait(syncpoints_guest[syncpoint_id], expected_value);
 }
 
 void SyncpointManager::WaitHost(u32 syncpoint_id, u32 expected_value) {
     MICROPROFILE_SCOPE(GPU_wait);
-    Wait(syncpoints_host[syncpoint_id], wait_host_cv, expected_value);
+    Wait(syncpoints_host[syncpoint_id], expected_value);
 }
 
-void SyncpointManager::Increment(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
-                                 std::list<RegisteredAction>& action_storage) {
-    auto new_value{syncpoint.fetch_add(1, std::memory_order_acq_rel) + 1};
-
-    std::unique_lock lk(guard);
-    auto it = action_storage.begin();
-    while (it != action_storage.end()) {
-        if (it->expected_value > new_value) {
+void SyncpointManager::RunReachedActions(Syncpoint& syncpoint) {
+    const u32 current_value = syncpoint.value.load(std::memory_order_acquire);
+    auto it = syncpoint.actions.begin();
+    while (it != syncpoint.actions.end()) {
+        if (it->expected_value > current_value) {
             break;
         }
         it->action();
-        it = action_storage.erase(it);
+        it = syncpoint.actions.erase(it);
     }
-    wait_cv.notify_all();
+    syncpoint.next_action_value.store(syncpoint.actions.empty()
+                                          ? NO_PENDING_ACTION
+                                          : syncpoint.actions.front().expected_value);
 }
 
-void SyncpointManager::Wait(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
-                            u32 expected_value) {
-    const auto pred = [&]() { return syncpoint.load(std::memory_order_acquire) >= expected_value; };
-    if (pred()) {
+void SyncpointManager::Increment(Syncpoint& syncpoint) {
+    // Sequentially consistent so that either this increment sees a concurrently published
+    // action threshold or waiter, or the registering thread sees the new value
+    const u32 new_value{syncpoint.value.fetch_add(1) + 1};
+
+    if (new_value >= syncpoint.next_action_value.load()) {
+        std::unique_lock lk(syncpoint.guard);
+        RunReachedActions(syncpoint);
+    }
+    if (syncpoint.num_waiters.load() != 0) {
+        syncpoint.value.notify_all();
+    }
+}
+
+void SyncpointManager::Wait(Syncpoint& syncpoint, u32 expected_value) {
+    u32 current_value = syncpoint.value.load(std::memory_order_acquire);
+    if (current_value >= expected_value) {
         return;
     }
 
-    std::unique_lock lk(guard);
-    wait_cv.wait(lk, pred);
+    syncpoint.num_waiters.fetch_add(1);
+    while ((current_value = syncpoint.value.load()) < expected_value) {
+        syncpoint.value.wait(current_value, std::memory_order_acquire);
+    }
+    syncpoint.num_waiters.fetch_sub(1, std::memory_order_release);
 }
 
 } // namespace Host1x
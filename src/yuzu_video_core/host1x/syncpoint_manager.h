@@ -5,8 +5,8 @@
 
 #include <array>
 #include <atomic>
-#include <condition_variable>
 #include <functional>
+#include <limits>
 #include <list>
 #include <mutex>
 
@@ -19,11 +19,11 @@ namespace Host1x {
 class SyncpointManager {
 public:
     u32 GetGuestSyncpointValue(u32 id) const {
-        return syncpoints_guest[id].load(std::memory_order_acquire);
+        return syncpoints_guest[id].value.load(std::memory_order_acquire);
     }
 
     u32 GetHostSyncpointValue(u32 id) const {
-        return syncpoints_host[id].load(std::memory_order_acquire);
+        return syncpoints_host[id].value.load(std::memory_order_acquire);
     }
 
     struct RegisteredAction {
@@ -36,14 +36,12 @@ public:
 
     template <typename Func>
     uint32_t RegisterGuestAction(u32 syncpoint_id, u32 expected_value, Func&& action) {
-        return RegisterAction(syncpoints_guest[syncpoint_id], guest_action_storage[syncpoint_id],
-                              expected_value, std::move(action));
+        return RegisterAction(syncpoints_guest[syncpoint_id], expected_value, std::move(action));
     }
 
     template <typename Func>
     uint32_t RegisterHostAction(u32 syncpoint_id, u32 expected_value, Func&& action) {
-        return RegisterAction(syncpoints_host[syncpoint_id], host_action_storage[syncpoint_id],
-                              expected_value, std::move(action));
+        return RegisterAction(syncpoints_host[syncpoint_id], expected_value, std::move(action));
     }
 
     void DeregisterGuestAction(u32 syncpoint_id, uint32_t handle);
@@ -59,37 +57,51 @@ public:
     void WaitHost(u32 syncpoint_id, u32 expected_value);
 
     bool IsReadyGuest(u32 syncpoint_id, u32 expected_value) const {
-        return syncpoints_guest[syncpoint_id].load(std::memory_order_acquire) >= expected_value;
+        return syncpoints_guest[syncpoint_id].value.load(std::memory_order_acquire) >=
+               expected_value;
     }
 
     bool IsReadyHost(u32 syncpoint_id, u32 expected_value) const {
-        return syncpoints_host[syncpoint_id].load(std::memory_order_acquire) >= expected_value;
+        return syncpoints_host[syncpoint_id].value.load(std::memory_order_acquire) >=
+               expected_value;
     }
 
 private:
-    void Increment(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
-                   std::list<RegisteredAction>& action_storage);
+    static constexpr u32 NO_PENDING_ACTION = std::numeric_limits<u32>::max();
+
+    /**
+     * State of a single syncpoint. Increments and waits only touch the atomics unless an action
+     * threshold was crossed or a thread is blocked, the lock only guards the pending actions.
+     */
+    struct Syncpoint {
+        std::atomic<u32> value{};
+        /// Expected value of the first pending action, NO_PENDING_ACTION when there is none
+        std::atomic<u32> next_action_value{NO_PENDING_ACTION};
+        /// Threads blocked in Wait, increments skip the wake up when there are none
+        std::atomic<u32> num_waiters{};
+        std::mutex guard;
+        /// Pending actions sorted by expected value
+        std::list<RegisteredAction> actions;
+    };
+
+    void Increment(Syncpoint& syncpoint);
 
-    uint32_t RegisterAction(std::atomic<u32>& syncpoint,
-                                std::list<RegisteredAction>& action_storage, u32 expected_value,
-                                std::function<void()>&& action);
+    uint32_t RegisterAction(Syncpoint& syncpoint, u32 expected_value,
+                            std::function<void()>&& action);
 
-    void DeregisterAction(std::list<RegisteredAction>& action_storage, uint32_t handle);
+    void DeregisterAction(Syncpoint& syncpoint, uint32_t handle);
 
-    void Wait(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv, u32 expected_value);
+    /// Runs and removes the actions whose expected value has been reached, guard must be held
+    void RunReachedActions(Syncpoint& syncpoint);
+
+    void Wait(Syncpoint& syncpoint, u32 expected_value);
 
     static constexpr size_t NUM_MAX_SYNCPOINTS = 192;
 
-    std::array<std::atomic<u32>, NUM_MAX_SYNCPOINTS> syncpoints_guest{};
-    std::array<std::atomic<u32>, NUM_MAX_SYNCPOINTS> syncpoints_host{};
+    std::array<Syncpoint, NUM_MAX_SYNCPOINTS> syncpoints_guest{};
+    std::array<Syncpoint, NUM_MAX_SYNCPOINTS> syncpoints_host{};
 
     std::atomic<uint32_t> next_action_id{ 1 };
-    std::array<std::list<RegisteredAction>, NUM_MAX_SYNCPOINTS> guest_action_storage;
-    std::array<std::list<RegisteredAction>, NUM_MAX_SYNCPOINTS> host_action_storage;
-
-    std::mutex guard;
-    std::condition_variable wait_guest_cv;
-    std::condition_variable wait_host_cv;
 };
 
 } // namespace Host1x
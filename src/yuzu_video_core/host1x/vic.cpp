@@ -1,28 +1,26 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <latch>
 
-extern "C" {
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
-}
-
+#include "yuzu_common/alignment.h"
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/bit_field.h"
+#include "yuzu_common/div_ceil.h"
 #include "yuzu_common/logging/log.h"
+#include "yuzu_common/thread_worker.h"
 
 #include "yuzu_video_core/engines/maxwell_3d.h"
 #include "yuzu_video_core/host1x/host1x.h"
 #include "yuzu_video_core/host1x/nvdec.h"
 #include "yuzu_video_core/host1x/vic.h"
+#include "yuzu_video_core/host1x/vic_convert.h"
 #include "yuzu_video_core/memory_manager.h"
 #include "yuzu_video_core/textures/decoders.h"
+#include "yuzu_video_core/textures/workers.h"
 
 namespace Tegra {
 
@@ -35,6 +33,10 @@ enum class VideoPixelFormat : u64_le {
     RGBX8 = 0x23,
     YUV420 = 0x44,
 };
+
+/// Output rows converted by one worker task
+constexpr u32 RowsPerTask = 32;
+
 } // Anonymous namespace
 
 union VicConfig {
@@ -49,8 +51,7 @@ union VicConfig {
 };
 
 Vic::Vic(Host1x& host1x_, std::shared_ptr<Nvdec> nvdec_processor_)
-    : host1x(host1x_),
-      nvdec_processor(std::move(nvdec_processor_)) {}
+    : host1x(host1x_), nvdec_processor(std::move(nvdec_processor_)) {}
 
 Vic::~Vic() = default;
 
@@ -76,7 +77,172 @@ void Vic::ProcessMethod(Method method, u32 argument) {
 }
 
 void Vic::Execute() {
-    UNIMPLEMENTED();
+    if (output_surface_luma_address == 0) {
+        LOG_ERROR(Service_NVDRV, "VIC Luma address not set.");
+        return;
+    }
+    const VicConfig config{host1x.GMMU().Read<u64>(config_struct_address + 0x20)};
+    const std::shared_ptr<const DecodedFrame> frame = nvdec_processor->GetFrame();
+    if (!frame || frame->width == 0 || frame->height == 0) {
+        LOG_DEBUG(Service_NVDRV, "VIC executed without a decoded frame");
+        return;
+    }
+
+    switch (config.pixel_format) {
+    case VideoPixelFormat::RGBA8:
+    case VideoPixelFormat::BGRA8:
+    case VideoPixelFormat::RGBX8:
+        WriteRGBFrame(*frame, config);
+        break;
+    case VideoPixelFormat::YUV420:
+        WriteYUVFrame(*frame, config);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unknown video pixel format {:X}", config.pixel_format.Value());
+        break;
+    }
+}
+
+void Vic::WriteRGBFrame(const DecodedFrame& frame, const VicConfig& config) {
+    LOG_TRACE(Service_NVDRV, "Writing RGB Frame");
+
+    const u32 width = static_cast<u32>(config.surface_width_minus1) + 1;
+    const u32 height = static_cast<u32>(config.surface_height_minus1) + 1;
+    const u32 pitch = width * 4;
+    const bool swap_rb = config.pixel_format == VideoPixelFormat::BGRA8;
+    const bool block_linear = config.block_linear_kind != 0;
+    const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+
+    const bool interleaved = frame.format == DecodedFrame::Format::NV12;
+    const ConvertRowFn convert_row = SelectConvertRow(interleaved);
+    const std::size_t u_plane = frame.format == DecodedFrame::Format::YV12 ? 2 : 1;
+    const std::size_t v_plane = frame.format == DecodedFrame::Format::YV12 ? 1 : 2;
+    const u8* const luma = frame.Plane(0);
+    const u8* const chroma_u = frame.Plane(u_plane);
+    const u8* const chroma_v = frame.Plane(v_plane);
+    const u32 luma_stride = frame.stride[0];
+    const u32 u_stride = frame.stride[u_plane];
+    const u32 v_stride = frame.stride[v_plane];
+
+    // Nearest neighbour scaling from the frame to the surface, columns are mapped through a
+    // table and rows are converted straight from the matching source row.
+    const bool scaled = frame.width != width;
+    if (scaled) {
+        scale_map.resize_destructive(width);
+        for (u32 x = 0; x < width; ++x) {
+            scale_map[x] = static_cast<u32>(static_cast<u64>(x) * frame.width / width);
+        }
+    }
+
+    // Scaled rows are converted at the frame width first, each task gets its own source row
+    const std::size_t source_row_size = scaled ? static_cast<std::size_t>(frame.width) * 4 : 0;
+    const u32 num_tasks = Common::DivCeil(height, RowsPerTask);
+    row_buffer.resize_destructive(source_row_size * num_tasks);
+
+    const std::size_t linear_size = static_cast<std::size_t>(pitch) * height;
+    rgb_buffer.resize_destructive(linear_size);
+    std::size_t output_size = linear_size;
+    if (block_linear) {
+        output_size = Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
+        luma_buffer.resize_destructive(output_size);
+    }
+
+    u8* const linear = rgb_buffer.data();
+    const std::span<u8> swizzled(luma_buffer.data(), block_linear ? output_size : 0);
+    const u32* const columns = scale_map.data();
+    u8* const source_rows = row_buffer.data();
+
+    const auto convert_rows = [=, &frame](u32 first_row, u32 num_rows) {
+        u8* const source_row = source_rows + (first_row / RowsPerTask) * source_row_size;
+        for (u32 y = first_row; y < first_row + num_rows; ++y) {
+            const u32 src_y = static_cast<u32>(static_cast<u64>(y) * frame.height / height);
+            const u8* const y_row = luma + static_cast<std::size_t>(src_y) * luma_stride;
+            const u8* const u_row = chroma_u + static_cast<std::size_t>(src_y / 2) * u_stride;
+            const u8* const v_row = chroma_v + static_cast<std::size_t>(src_y / 2) * v_stride;
+            u8* const dst = linear + static_cast<std::size_t>(y) * pitch;
+            if (!scaled) {
+                convert_row(dst, y_row, u_row, v_row, width, swap_rb);
+                continue;
+            }
+            convert_row(source_row, y_row, u_row, v_row, frame.width, swap_rb);
+            for (u32 x = 0; x < width; ++x) {
+                std::memcpy(dst + x * 4, source_row + columns[x] * 4, 4);
+            }
+        }
+        if (block_linear) {
+            const std::span<const u8> rows(linear + static_cast<std::size_t>(first_row) * pitch,
+                                           static_cast<std::size_t>(num_rows) * pitch);
+            Texture::SwizzleSubrect(swizzled, rows, 4, width, height, 1, 0, first_row, width,
+                                    num_rows, block_height, 0, pitch);
+        }
+    };
+
+    // The last band is converted here while the texture workers take the others. The latch only
+    // counts this frame's bands, texture decodes queued on the same workers are not waited on.
+    const u32 last_row = (num_tasks - 1) * RowsPerTask;
+    std::latch bands_done{static_cast<std::ptrdiff_t>(num_tasks - 1)};
+    Common::ThreadWorker& workers = Texture::GetThreadWorkers();
+    for (u32 y = 0; y < last_row; y += RowsPerTask) {
+        workers.QueueWork([&convert_rows, &bands_done, y] {
+            convert_rows(y, RowsPerTask);
+            bands_done.count_down();
+        });
+    }
+    convert_rows(last_row, height - last_row);
+    bands_done.wait();
+
+    host1x.GMMU().WriteBlock(output_surface_luma_address,
+                             block_linear ? luma_buffer.data() : rgb_buffer.data(), output_size);
+}
+
+void Vic::WriteYUVFrame(const DecodedFrame& frame, const VicConfig& config) {
+    LOG_TRACE(Service_NVDRV, "Writing YUV420 Frame");
+
+    const std::size_t surface_width = config.surface_width_minus1 + 1;
+    const std::size_t surface_height = config.surface_height_minus1 + 1;
+    const std::size_t aligned_width = Common::AlignUp(surface_width, 0x100);
+    // Use the minimum of surface/frame dimensions to avoid buffer overflow.
+    const std::size_t frame_width = std::min<std::size_t>(surface_width, frame.width);
+    const std::size_t frame_height = std::min<std::size_t>(surface_height, frame.height);
+
+    luma_buffer.resize_destructive(aligned_width * surface_height);
+    chroma_buffer.resize_destructive(aligned_width * surface_height / 2);
+
+    // Populate luma buffer
+    const u8* const luma_src = frame.Plane(0);
+    for (std::size_t y = 0; y < frame_height; ++y) {
+        std::memcpy(luma_buffer.data() + y * aligned_width, luma_src + y * frame.stride[0],
+                    frame_width);
+    }
+    host1x.GMMU().WriteBlock(output_surface_luma_address, luma_buffer.data(), luma_buffer.size());
+
+    // Populate chroma buffer, the output surface is always NV12
+    const std::size_t half_height = frame_height / 2;
+    const std::size_t half_width = frame_width / 2;
+    if (frame.format == DecodedFrame::Format::NV12) {
+        // Already interleaved so just copy
+        const u8* const chroma_src = frame.Plane(1);
+        for (std::size_t y = 0; y < half_height; ++y) {
+            std::memcpy(chroma_buffer.data() + y * aligned_width, chroma_src + y * frame.stride[1],
+                        half_width * 2);
+        }
+    } else {
+        const std::size_t b_plane = frame.format == DecodedFrame::Format::YV12 ? 2 : 1;
+        const std::size_t r_plane = frame.format == DecodedFrame::Format::YV12 ? 1 : 2;
+        const u8* const chroma_b_src = frame.Plane(b_plane);
+        const u8* const chroma_r_src = frame.Plane(r_plane);
+        for (std::size_t y = 0; y < half_height; ++y) {
+            const u8* const b_row = chroma_b_src + y * frame.stride[b_plane];
+            const u8* const r_row = chroma_r_src + y * frame.stride[r_plane];
+            u8* const dst = chroma_buffer.data() + y * aligned_width;
+            for (std::size_t x = 0; x < half_width; ++x) {
+                dst[x * 2] = b_row[x];
+                dst[x * 2 + 1] = r_row[x];
+            }
+        }
+    }
+    host1x.GMMU().WriteBlock(output_surface_chroma_address, chroma_buffer.data(),
+                             chroma_buffer.size());
 }
 
 } // namespace Host1x
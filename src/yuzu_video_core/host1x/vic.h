@@ -8,14 +8,13 @@
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/scratch_buffer.h"
 
-struct SwsContext;
-
 namespace Tegra {
 
 namespace Host1x {
 
 class Host1x;
 class Nvdec;
+struct DecodedFrame;
 union VicConfig;
 
 class Vic {
@@ -39,6 +38,12 @@ public:
 private:
     void Execute();
 
+    /// Converts the frame to RGB and writes it scaled to the output surface
+    void WriteRGBFrame(const DecodedFrame& frame, const VicConfig& config);
+
+    /// Writes the frame as NV12 to the output luma and chroma surfaces
+    void WriteYUVFrame(const DecodedFrame& frame, const VicConfig& config);
+
     Host1x& host1x;
     std::shared_ptr<Tegra::Host1x::Nvdec> nvdec_processor;
 
@@ -46,14 +51,13 @@ private:
     /// size does not change during a stream
     Common::ScratchBuffer<u8> luma_buffer;
     Common::ScratchBuffer<u8> chroma_buffer;
+    Common::ScratchBuffer<u8> rgb_buffer;
+    Common::ScratchBuffer<u32> scale_map;
+    Common::ScratchBuffer<u8> row_buffer;
 
     GPUVAddr config_struct_address{};
     GPUVAddr output_surface_luma_address{};
     GPUVAddr output_surface_chroma_address{};
-
-    SwsContext* scaler_ctx{};
-    s32 scaler_width{};
-    s32 scaler_height{};
 };
 
 } // namespace Host1x
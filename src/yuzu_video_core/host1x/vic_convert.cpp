@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#include <xbyak/xbyak_util.h>
+#define VIC_HAS_X64_KERNELS
+#endif
+
+#include "yuzu_video_core/host1x/vic_convert.h"
+
+#if defined(VIC_HAS_X64_KERNELS) && (defined(__GNUC__) || defined(__clang__))
+#define VIC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define VIC_TARGET(isa)
+#endif
+
+namespace Tegra::Host1x {
+
+namespace {
+
+// BT.601 limited range YUV to RGB with 6 fractional bits. Every intermediate fits a signed 16-bit
+// lane; the only sum that can saturate is blue, and only when the result clamps to 255 anyway, so
+// the scalar and vector kernels produce identical output.
+constexpr s32 CoefY = 75;   // 1.164
+constexpr s32 CoefRV = 102; // 1.596
+constexpr s32 CoefGU = 25;  // 0.391
+constexpr s32 CoefGV = 52;  // 0.813
+constexpr s32 CoefBU = 129; // 2.018
+
+template <bool Interleaved>
+void ConvertPixels(u8* dst, const u8* y_row, const u8* u_row, const u8* v_row, u32 begin,
+                   u32 end, bool swap_rb) {
+    for (u32 x = begin; x < end; ++x) {
+        const u32 c = x / 2;
+        const s32 u = (Interleaved ? u_row[c * 2] : u_row[c]) - 128;
+        const s32 v = (Interleaved ? u_row[c * 2 + 1] : v_row[c]) - 128;
+        const s32 y = (y_row[x] - 16) * CoefY;
+
+        const u8 r = static_cast<u8>(std::clamp((y + v * CoefRV + 32) >> 6, 0, 255));
+        const u8 g = static_cast<u8>(std::clamp((y - u * CoefGU - v * CoefGV + 32) >> 6, 0, 255));
+        const u8 b = static_cast<u8>(std::clamp((y + u * CoefBU + 32) >> 6, 0, 255));
+
+        u8* const pixel = dst + x * 4;
+        pixel[0] = swap_rb ? b : r;
+        pixel[1] = g;
+        pixel[2] = swap_rb ? r : b;
+        pixel[3] = 0xff;
+    }
+}
+
+template <bool Interleaved>
+void ConvertRowScalar(u8* dst, const u8* y_row, const u8* u_row, const u8* v_row, u32 width,
+                      bool swap_rb) {
+    ConvertPixels<Interleaved>(dst, y_row, u_row, v_row, 0, width, swap_rb);
+}
+
+#ifdef VIC_HAS_X64_KERNELS
+
+/// Gathers the U samples into the low quadword and the V samples into the high quadword
+VIC_TARGET("sse4.1") inline __m128i DeinterleaveUV(__m128i uv) {
+    const __m128i shuffle = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    return _mm_shuffle_epi8(uv, shuffle);
+}
+
+VIC_TARGET("sse4.1")
+inline void YUVToRGB(__m128i y, __m128i u, __m128i v, __m128i& r, __m128i& g, __m128i& b) {
+    const __m128i round = _mm_set1_epi16(32);
+    y = _mm_mullo_epi16(_mm_sub_epi16(y, _mm_set1_epi16(16)), _mm_set1_epi16(CoefY));
+    u = _mm_sub_epi16(u, _mm_set1_epi16(128));
+    v = _mm_sub_epi16(v, _mm_set1_epi16(128));
+    r = _mm_adds_epi16(y, _mm_mullo_epi16(v, _mm_set1_epi16(CoefRV)));
+    g = _mm_subs_epi16(y, _mm_mullo_epi16(u, _mm_set1_epi16(CoefGU)));
+    g = _mm_subs_epi16(g, _mm_mullo_epi16(v, _mm_set1_epi16(CoefGV)));
+    b = _mm_adds_epi16(y, _mm_mullo_epi16(u, _mm_set1_epi16(CoefBU)));
+    r = _mm_srai_epi16(_mm_adds_epi16(r, round), 6);
+    g = _mm_srai_epi16(_mm_adds_epi16(g, round), 6);
+    b = _mm_srai_epi16(_mm_adds_epi16(b, round), 6);
+}
+
+/// 16 pixels per iteration
+template <bool Interleaved>
+VIC_TARGET("sse4.1")
+void ConvertRowSSE41(u8* dst, const u8* y_row, const u8* u_row, const u8* v_row, u32 width,
+                     bool swap_rb) {
+    const __m128i alpha = _mm_set1_epi8(-1);
+    u32 x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i y8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y_row + x));
+        __m128i u_half;
+        __m128i v_half;
+        if constexpr (Interleaved) {
+            u_half = DeinterleaveUV(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u_row + x)));
+            v_half = _mm_srli_si128(u_half, 8);
+        } else {
+            u_half = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u_row + x / 2));
+            v_half = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v_row + x / 2));
+        }
+        // Each chroma sample covers two horizontal pixels
+        const __m128i u_pairs = _mm_unpacklo_epi8(u_half, u_half);
+        const __m128i v_pairs = _mm_unpacklo_epi8(v_half, v_half);
+
+        __m128i r_lo, g_lo, b_lo, r_hi, g_hi, b_hi;
+        YUVToRGB(_mm_cvtepu8_epi16(y8), _mm_cvtepu8_epi16(u_pairs), _mm_cvtepu8_epi16(v_pairs),
+                 r_lo, g_lo, b_lo);
+        YUVToRGB(_mm_cvtepu8_epi16(_mm_srli_si128(y8, 8)),
+                 _mm_cvtepu8_epi16(_mm_srli_si128(u_pairs, 8)),
+                 _mm_cvtepu8_epi16(_mm_srli_si128(v_pairs, 8)), r_hi, g_hi, b_hi);
+
+        __m128i r = _mm_packus_epi16(r_lo, r_hi);
+        const __m128i g = _mm_packus_epi16(g_lo, g_hi);
+        __m128i b = _mm_packus_epi16(b_lo, b_hi);
+        if (swap_rb) {
+            std::swap(r, b);
+        }
+
+        const __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+        const __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+        const __m128i ba_lo = _mm_unpacklo_epi8(b, alpha);
+        const __m128i ba_hi = _mm_unpackhi_epi8(b, alpha);
+        __m128i* const out = reinterpret_cast<__m128i*>(dst + x * 4);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rg_hi, ba_hi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rg_hi, ba_hi));
+    }
+    ConvertPixels<Interleaved>(dst, y_row, u_row, v_row, x, width, swap_rb);
+}
+
+VIC_TARGET("avx2")
+inline void YUVToRGB(__m256i y, __m256i u, __m256i v, __m256i& r, __m256i& g, __m256i& b) {
+    const __m256i round = _mm256_set1_epi16(32);
+    y = _mm256_mullo_epi16(_mm256_sub_epi16(y, _mm256_set1_epi16(16)), _mm256_set1_epi16(CoefY));
+    u = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+    v = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+    r = _mm256_adds_epi16(y, _mm256_mullo_epi16(v, _mm256_set1_epi16(CoefRV)));
+    g = _mm256_subs_epi16(y, _mm256_mullo_epi16(u, _mm256_set1_epi16(CoefGU)));
+    g = _mm256_subs_epi16(g, _mm256_mullo_epi16(v, _mm256_set1_epi16(CoefGV)));
+    b = _mm256_adds_epi16(y, _mm256_mullo_epi16(u, _mm256_set1_epi16(CoefBU)));
+    r = _mm256_srai_epi16(_mm256_adds_epi16(r, round), 6);
+    g = _mm256_srai_epi16(_mm256_adds_epi16(g, round), 6);
+    b = _mm256_srai_epi16(_mm256_adds_epi16(b, round), 6);
+}
+
+/// 32 pixels per iteration
+template <bool Interleaved>
+VIC_TARGET("avx2")
+void ConvertRowAVX2(u8* dst, const u8* y_row, const u8* u_row, const u8* v_row, u32 width,
+                    bool swap_rb) {
+    const __m256i alpha = _mm256_set1_epi8(-1);
+    u32 x = 0;
+    for (; x + 32 <= width; x += 32) {
+        const __m256i y8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y_row + x));
+        __m128i u_half;
+        __m128i v_half;
+        if constexpr (Interleaved) {
+            const __m128i uv0 =
+                DeinterleaveUV(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u_row + x)));
+            const __m128i uv1 =
+                DeinterleaveUV(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u_row + x + 16)));
+            u_half = _mm_unpacklo_epi64(uv0, uv1);
+            v_half = _mm_unpackhi_epi64(uv0, uv1);
+        } else {
+            u_half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u_row + x / 2));
+            v_half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v_row + x / 2));
+        }
+
+        __m256i r0, g0, b0, r1, g1, b1;
+        YUVToRGB(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(y8)),
+                 _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(u_half, u_half)),
+                 _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(v_half, v_half)), r0, g0, b0);
+        YUVToRGB(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(y8, 1)),
+                 _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(u_half, u_half)),
+                 _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(v_half, v_half)), r1, g1, b1);
+
+        // Packing works per 128-bit lane, lane 0 holds pixels 0-7 and 16-23, lane 1 holds pixels
+        // 8-15 and 24-31. The interleave below keeps that order and the final permutes undo it.
+        __m256i r = _mm256_packus_epi16(r0, r1);
+        const __m256i g = _mm256_packus_epi16(g0, g1);
+        __m256i b = _mm256_packus_epi16(b0, b1);
+        if (swap_rb) {
+            std::swap(r, b);
+        }
+
+        const __m256i rg_lo = _mm256_unpacklo_epi8(r, g);
+        const __m256i rg_hi = _mm256_unpackhi_epi8(r, g);
+        const __m256i ba_lo = _mm256_unpacklo_epi8(b, alpha);
+        const __m256i ba_hi = _mm256_unpackhi_epi8(b, alpha);
+        const __m256i q0 = _mm256_unpacklo_epi16(rg_lo, ba_lo);
+        const __m256i q1 = _mm256_unpackhi_epi16(rg_lo, ba_lo);
+        const __m256i q2 = _mm256_unpacklo_epi16(rg_hi, ba_hi);
+        const __m256i q3 = _mm256_unpackhi_epi16(rg_hi, ba_hi);
+        __m256i* const out = reinterpret_cast<__m256i*>(dst + x * 4);
+        _mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(q0, q1, 0x20));
+        _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(q0, q1, 0x31));
+        _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(q2, q3, 0x20));
+        _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(q2, q3, 0x31));
+    }
+    ConvertPixels<Interleaved>(dst, y_row, u_row, v_row, x, width, swap_rb);
+}
+
+#endif
+
+std::vector<ConvertRowKernel> DetectConvertRowKernels() {
+    std::vector<ConvertRowKernel> kernels{
+        {"Scalar", &ConvertRowScalar<false>, &ConvertRowScalar<true>},
+    };
+#ifdef VIC_HAS_X64_KERNELS
+    const Xbyak::util::Cpu cpu;
+    if (cpu.has(Xbyak::util::Cpu::tSSE41)) {
+        kernels.push_back({"SSE4.1", &ConvertRowSSE41<false>, &ConvertRowSSE41<true>});
+    }
+    if (cpu.has(Xbyak::util::Cpu::tAVX2)) {
+        kernels.push_back({"AVX2", &ConvertRowAVX2<false>, &ConvertRowAVX2<true>});
+    }
+#endif
+    return kernels;
+}
+
+} // Anonymous namespace
+
+std::span<const ConvertRowKernel> GetConvertRowKernels() {
+    static const std::vector<ConvertRowKernel> kernels = DetectConvertRowKernels();
+    return kernels;
+}
+
+ConvertRowFn SelectConvertRow(bool interleaved) {
+    const ConvertRowKernel& fastest = GetConvertRowKernels().back();
+    return interleaved ? fastest.interleaved : fastest.planar;
+}
+
+} // namespace Tegra::Host1x
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "yuzu_common/common_types.h"
+
+namespace Tegra::Host1x {
+
+/// Converts one row of 4:2:0 pixels to RGBA8 (BT.601 limited range). For interleaved chroma v_row
+/// is unused and u_row points at the UV pairs.
+using ConvertRowFn = void (*)(u8* dst, const u8* y_row, const u8* u_row, const u8* v_row,
+                              u32 width, bool swap_rb);
+
+struct ConvertRowKernel {
+    const char* name;
+    ConvertRowFn planar;
+    ConvertRowFn interleaved;
+};
+
+/// Returns the row kernels the host CPU can run, the scalar kernel first and the fastest last.
+/// Every kernel produces the same output as the scalar one.
+[[nodiscard]] std::span<const ConvertRowKernel> GetConvertRowKernels();
+
+/// Returns the fastest row kernel for planar (YUV420, YV12) or interleaved (NV12) chroma
+[[nodiscard]] ConvertRowFn SelectConvertRow(bool interleaved);
+
+} // namespace Tegra::Host1x
@@ -1,9 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#include <cstring>
+#include <algorithm>
 #include <fstream>
-#include <optional>
 #include <span>
 
 #include "yuzu_common/container_hash.h"
@@ -57,7 +56,25 @@ static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
 MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d_)
     : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {}
 
-MacroEngine::~MacroEngine() = default;
+MacroEngine::~MacroEngine() {
+    // Report how much of the macro work was high level emulated, to guide new HLE programs
+    u64 total_calls{};
+    u64 hle_calls{};
+    for (const auto& [hash, program] : compiled_programs) {
+        total_calls += program->num_calls;
+        if (program->hle_program) {
+            hle_calls += program->num_calls;
+            LOG_DEBUG(HW_GPU, "Macro {:016x}: {} calls, HLE", hash, program->num_calls);
+        } else if (program->num_calls != 0) {
+            LOG_INFO(HW_GPU, "Macro {:016x}: {} calls, no HLE program ({} words)", hash,
+                     program->num_calls, program->code.size());
+        }
+    }
+    if (total_calls != 0) {
+        LOG_INFO(HW_GPU, "Macro HLE covered {} of {} calls over {} programs", hle_calls,
+                 total_calls, compiled_programs.size());
+    }
+}
 
 void MacroEngine::AddCode(u32 method, u32 data) {
     uploaded_macro_code[method].push_back(data);
@@ -68,63 +85,77 @@ void MacroEngine::ClearCode(u32 method) {
     uploaded_macro_code.erase(method);
 }
 
-void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
-    auto compiled_macro = macro_cache.find(method);
+void MacroEngine::Execute(u32 method, std::span<const u32> parameters) {
+    const auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
-        const auto& cache_info = compiled_macro->second;
-        if (cache_info.has_hle_program) {
-            MICROPROFILE_SCOPE(MacroHLE);
-            cache_info.hle_program->Execute(parameters, method);
-        } else {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
-        }
+        ExecuteProgram(*compiled_macro->second.program, parameters, method);
+        return;
+    }
+    // Macro not compiled, check if it's uploaded and if so, compile it
+    std::span<const u32> code;
+    const auto macro_code = uploaded_macro_code.find(method);
+    if (macro_code != uploaded_macro_code.end()) {
+        code = macro_code->second;
     } else {
-        // Macro not compiled, check if it's uploaded and if so, compile it
-        std::optional<u32> mid_method;
-        const auto macro_code = uploaded_macro_code.find(method);
-        if (macro_code == uploaded_macro_code.end()) {
-            for (const auto& [method_base, code] : uploaded_macro_code) {
-                if (method >= method_base && (method - method_base) < code.size()) {
-                    mid_method = method_base;
-                    break;
-                }
-            }
-            if (!mid_method.has_value()) {
-                ASSERT_MSG(false, "Macro 0x{0:x} was not uploaded", method);
-                return;
+        for (const auto& [method_base, base_code] : uploaded_macro_code) {
+            if (method >= method_base && (method - method_base) < base_code.size()) {
+                code = std::span<const u32>(base_code).subspan(method - method_base);
+                break;
             }
         }
-        auto& cache_info = macro_cache[method];
-
-        if (!mid_method.has_value()) {
-            cache_info.lle_program = Compile(macro_code->second);
-            cache_info.hash = Common::HashValue(macro_code->second);
-        } else {
-            const auto& macro_cached = uploaded_macro_code[mid_method.value()];
-            const auto rebased_method = method - mid_method.value();
-            auto& code = uploaded_macro_code[method];
-            code.resize(macro_cached.size() - rebased_method);
-            std::memcpy(code.data(), macro_cached.data() + rebased_method,
-                        code.size() * sizeof(u32));
-            cache_info.hash = Common::HashValue(code);
-            cache_info.lle_program = Compile(code);
+        if (code.empty()) {
+            ASSERT_MSG(false, "Macro 0x{0:x} was not uploaded", method);
+            return;
         }
+    }
+    auto& cache_info = macro_cache[method];
+    cache_info.hash = Common::HashRange(code.begin(), code.end());
+    cache_info.program = &GetProgram(cache_info.hash, code);
 
-        auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
-        if (!hle_program || Settings::values.disable_macro_hle) {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
-        } else {
-            cache_info.has_hle_program = true;
-            cache_info.hle_program = std::move(hle_program);
-            MICROPROFILE_SCOPE(MacroHLE);
-            cache_info.hle_program->Execute(parameters, method);
-        }
+    ExecuteProgram(*cache_info.program, parameters, method);
 
-        if (Settings::values.dump_macros) {
-            Dump(cache_info.hash, macro_code->second, cache_info.has_hle_program);
+    if (Settings::values.dump_macros) {
+        Dump(cache_info.hash, code, cache_info.program->hle_program != nullptr);
+    }
+}
+
+MacroEngine::CompiledProgram& MacroEngine::GetProgram(u64 hash, std::span<const u32> code) {
+    auto& program{compiled_programs[hash]};
+    if (program) {
+        if (std::ranges::equal(program->code, code)) {
+            // Same macro uploaded again, reuse what was compiled for it
+            return *program;
         }
+        LOG_WARNING(HW_GPU, "Macro hash collision on {:016x}", hash);
+        return *colliding_programs.emplace_back(CompileProgram(hash, code));
+    }
+    program = CompileProgram(hash, code);
+    return *program;
+}
+
+std::unique_ptr<MacroEngine::CompiledProgram> MacroEngine::CompileProgram(
+    u64 hash, std::span<const u32> code) {
+    auto program{std::make_unique<CompiledProgram>()};
+    program->code.assign(code.begin(), code.end());
+    if (!Settings::values.disable_macro_hle) {
+        program->hle_program = hle_macros->GetHLEProgram(hash);
+    }
+    if (!program->hle_program) {
+        // Only compile the macro when it is not high level emulated
+        program->lle_program = Compile(program->code);
+    }
+    return program;
+}
+
+void MacroEngine::ExecuteProgram(CompiledProgram& program, std::span<const u32> parameters,
+                                 u32 method) {
+    ++program.num_calls;
+    if (program.hle_program) {
+        MICROPROFILE_SCOPE(MacroHLE);
+        program.hle_program->Execute(parameters, method);
+    } else {
+        maxwell3d.RefreshParameters();
+        program.lle_program->Execute(parameters, method);
     }
 }
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 #include "yuzu_common/bit_field.h"
@@ -106,7 +107,7 @@ public:
      * @param parameters The parameters of the macro
      * @param method     The method to execute
      */
-    virtual void Execute(const std::vector<u32>& parameters, u32 method) = 0;
+    virtual void Execute(std::span<const u32> parameters, u32 method) = 0;
 };
 
 class MacroEngine {
@@ -121,20 +122,35 @@ public:
     void ClearCode(u32 method);
 
     // Compiles the macro if its not in the cache, and executes the compiled macro
-    void Execute(u32 method, const std::vector<u32>& parameters);
+    void Execute(u32 method, std::span<const u32> parameters);
 
 protected:
+    // Compiles macro code, the code outlives the returned program
     virtual std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) = 0;
 
 private:
-    struct CacheInfo {
+    /// Program compiled from a given macro code, shared by every upload of the same code
+    struct CompiledProgram {
+        std::vector<u32> code;
         std::unique_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
+        u64 num_calls{};
+    };
+
+    struct CacheInfo {
+        CompiledProgram* program{};
         u64 hash{};
-        bool has_hle_program{};
     };
 
+    CompiledProgram& GetProgram(u64 hash, std::span<const u32> code);
+
+    std::unique_ptr<CompiledProgram> CompileProgram(u64 hash, std::span<const u32> code);
+
+    void ExecuteProgram(CompiledProgram& program, std::span<const u32> parameters, u32 method);
+
     std::unordered_map<u32, CacheInfo> macro_cache;
+    std::unordered_map<u64, std::unique_ptr<CompiledProgram>> compiled_programs;
+    std::vector<std::unique_ptr<CompiledProgram>> colliding_programs;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
     Engines::Maxwell3D& maxwell3d;
@@ -19,7 +19,7 @@ public:
     explicit MacroInterpreterImpl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_)
         : maxwell3d{maxwell3d_}, code{code_} {}
 
-    void Execute(const std::vector<u32>& params, u32 method) override;
+    void Execute(std::span<const u32> params, u32 method) override;
 
 private:
     /// Resets the execution engine state, zeroing registers, etc.
@@ -89,7 +89,7 @@ private:
     const std::vector<u32>& code;
 };
 
-void MacroInterpreterImpl::Execute(const std::vector<u32>& params, u32 method) {
+void MacroInterpreterImpl::Execute(std::span<const u32> params, u32 method) {
     MICROPROFILE_SCOPE(MacroInterp);
     Reset();
 
@@ -13,6 +13,7 @@
 #include "yuzu_video_core/engines/fermi_2d.h"
 #include "yuzu_video_core/gpu.h"
 #include "yuzu_video_core/query_cache/types.h"
+#include "yuzu_video_core/texture_cache/statistics.h"
 
 namespace Tegra {
 class MemoryManager;
@@ -171,5 +172,10 @@ public:
     virtual bool HasDrawTransformFeedback() {
         return false;
     }
+
+    /// Returns the residency and eviction statistics of the texture cache
+    [[nodiscard]] virtual VideoCommon::TextureCacheStatistics GetTextureCacheStatistics() const {
+        return {};
+    }
 };
 } // namespace VideoCore
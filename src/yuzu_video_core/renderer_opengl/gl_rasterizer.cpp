@@ -698,6 +698,10 @@ void RasterizerOpenGL::TickFrame() {
     }
 }
 
+VideoCommon::TextureCacheStatistics RasterizerOpenGL::GetTextureCacheStatistics() const {
+    return texture_cache.GetStatistics();
+}
+
 bool RasterizerOpenGL::AccelerateConditionalRendering() {
     gpu_memory->FlushCaching();
     if (Settings::IsGPULevelHigh()) {
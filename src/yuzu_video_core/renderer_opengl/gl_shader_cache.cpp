@@ -10,6 +10,7 @@
 
 #include "yuzu_common/alignment.h"
 #include "yuzu_common/yuzu_assert.h"
+#include "yuzu_common/container_hash.h"
 #include "yuzu_common/fs/fs.h"
 #include "yuzu_common/fs/path_util.h"
 #include "yuzu_common/logging/log.h"
@@ -452,6 +453,7 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     bool force_context_flush) try {
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
+    const Shader::ArenaScope arena_scope{pools.arena};
     size_t env_index{};
     u32 total_storage_buffers{};
     std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
@@ -460,6 +462,9 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
 
     // Layer passthrough generation for devices without GL_ARB_shader_viewport_layer_array
     Shader::IR::Program* layer_source_program{};
+    size_t layer_source_index{};
+    // Environment state read by the translation of each stage, part of the translated code key
+    std::array<u64, Maxwell::MaxShaderProgram> env_hashes{};
 
     for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
         const bool is_emulated_stage = layer_source_program != nullptr &&
@@ -468,6 +473,7 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
             auto topology = MaxwellToOutputTopology(key.gs_input_topology);
             programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
                                                           *layer_source_program, topology);
+            env_hashes[index] = env_hashes[layer_source_index];
             continue;
         }
         if (key.unique_hashes[index] == 0) {
@@ -498,8 +504,16 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
             programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
         }
 
+        env_hashes[index] = env.QueriesHash();
+        if (uses_vertex_a && index == 1) {
+            size_t seed{static_cast<size_t>(env_hashes[index])};
+            Common::HashCombine(seed, env_hashes[0]);
+            env_hashes[index] = static_cast<u64>(seed);
+        }
+
         if (programs[index].info.requires_layer_emulation) {
             layer_source_program = &programs[index];
+            layer_source_index = index;
         }
     }
     const u32 glasm_storage_buffer_limit{device.GetMaxGLASMStorageBufferBlocks()};
@@ -527,17 +541,40 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
 
         const auto runtime_info{
             MakeRuntimeInfo(key, program, previous_program, glasm_use_storage_buffers, use_glasm)};
+        const u64 stage_hash{VideoCommon::HashGraphicsStage(key.unique_hashes, index,
+                                                            uses_vertex_a, layer_source_index)};
+        const u64 translation_hash{
+            VideoCommon::HashTranslationInputs(stage_hash, env_hashes[index], runtime_info,
+                                               binding)};
         switch (device.GetShaderBackend()) {
         case Settings::ShaderBackend::Glsl:
             ConvertLegacyToGeneric(program, runtime_info);
+            if (auto cached{source_cache.Find(translation_hash)}) {
+                sources[stage_index] = std::move(cached->code);
+                binding = cached->binding;
+                break;
+            }
             sources[stage_index] = EmitGLSL(profile, runtime_info, program, binding);
+            source_cache.Insert(translation_hash, sources[stage_index], binding);
             break;
         case Settings::ShaderBackend::Glasm:
+            if (auto cached{source_cache.Find(translation_hash)}) {
+                sources[stage_index] = std::move(cached->code);
+                binding = cached->binding;
+                break;
+            }
             sources[stage_index] = EmitGLASM(profile, runtime_info, program, binding);
+            source_cache.Insert(translation_hash, sources[stage_index], binding);
             break;
         case Settings::ShaderBackend::SpirV:
             ConvertLegacyToGeneric(program, runtime_info);
+            if (auto cached{spirv_cache.Find(translation_hash)}) {
+                sources_spirv[stage_index] = std::move(cached->code);
+                binding = cached->binding;
+                break;
+            }
             sources_spirv[stage_index] = EmitSPIRV(profile, runtime_info, program, binding);
+            spirv_cache.Insert(translation_hash, sources_spirv[stage_index], binding);
             break;
         }
         previous_program = &program;
@@ -574,6 +611,7 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     bool force_context_flush) try {
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
+    const Shader::ArenaScope arena_scope{pools.arena};
 
     Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
 
@@ -14,6 +14,7 @@
 #include "yuzu_video_core/renderer_opengl/gl_graphics_pipeline.h"
 #include "yuzu_video_core/renderer_opengl/gl_shader_context.h"
 #include "yuzu_video_core/shader_cache.h"
+#include "yuzu_video_core/shader_translation_cache.h"
 
 namespace Tegra {
 class MemoryManager;
@@ -81,6 +82,9 @@ private:
     std::unordered_map<GraphicsPipelineKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
     std::unordered_map<ComputePipelineKey, std::unique_ptr<ComputePipeline>> compute_cache;
 
+    VideoCommon::ShaderTranslationCache<std::string> source_cache;
+    VideoCommon::ShaderTranslationCache<std::vector<u32>> spirv_cache;
+
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
 
@@ -10,6 +10,7 @@
 
 #include "yuzu_common/bit_cast.h"
 #include "yuzu_common/cityhash.h"
+#include "yuzu_common/container_hash.h"
 #include "yuzu_common/fs/fs.h"
 #include "yuzu_common/fs/path_util.h"
 #include "yuzu_common/microprofile.h"
@@ -61,6 +62,17 @@ auto MakeSpan(Container& container) {
     return std::span(container.data(), container.size());
 }
 
+template <typename Map, typename Key>
+auto TakeTranslated(std::mutex& mutex, Map& map, const Key& key) {
+    std::scoped_lock lock{mutex};
+    typename Map::mapped_type pipeline;
+    if (const auto it{map.find(key)}; it != map.end()) {
+        pipeline = std::move(it->second);
+        map.erase(it);
+    }
+    return pipeline;
+}
+
 Shader::OutputTopology MaxwellToOutputTopology(Maxwell::PrimitiveTopology topology) {
     switch (topology) {
     case Maxwell::PrimitiveTopology::Points:
@@ -312,7 +324,8 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
       use_vulkan_pipeline_cache{Settings::values.use_vulkan_driver_pipeline_cache.GetValue()},
       workers(device.HasBrokenParallelShaderCompiling() ? 1ULL : GetTotalPipelineWorkers(),
               "VkPipelineBuilder"),
-      serialization_thread(1, "VkPipelineSerialization") {
+      serialization_thread(1, "VkPipelineSerialization"),
+      translation_queue(GetTotalPipelineWorkers(), "VkShaderTranslator") {
     const auto& float_control{device.FloatControlProperties()};
     const VkDriverId driver_id{device.GetDriverID()};
     profile = Shader::Profile{
@@ -493,19 +506,25 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         ComputePipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
-        workers.QueueWork([this, key, env_ = std::move(env), &state, &callback]() mutable {
-            ShaderPools pools;
-            auto pipeline{CreateComputePipeline(pools, key, env_, state.statistics.get(), false)};
-            std::scoped_lock lock{state.mutex};
-            if (pipeline) {
-                compute_cache.emplace(key, std::move(pipeline));
-            }
-            ++state.built;
-            if (state.has_loaded) {
-                callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
-            }
-        });
-        ++state.total;
+        const auto queued{translation_queue.QueueWork(
+            key.Hash(), VideoCommon::TranslationPriority::Speculative,
+            [this, key, env_ = std::move(env), &state, &callback](ShaderPools* pools) mutable {
+                pools->ReleaseContents();
+                auto pipeline{
+                    CreateComputePipeline(*pools, key, env_, state.statistics.get(), true)};
+                if (pipeline) {
+                    std::scoped_lock lock{translated_mutex};
+                    translated_compute.emplace(key, std::move(pipeline));
+                }
+                std::scoped_lock lock{state.mutex};
+                ++state.built;
+                if (state.has_loaded) {
+                    callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
+                }
+            })};
+        if (queued) {
+            ++state.total;
+        }
     }};
     const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineCacheKey key;
@@ -524,25 +543,29 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
             (key.state.dynamic_vertex_input != 0) != dynamic_features.has_dynamic_vertex_input) {
             return;
         }
-        workers.QueueWork([this, key, envs_ = std::move(envs), &state, &callback]() mutable {
-            ShaderPools pools;
-            boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
-                env_ptrs.push_back(&env);
-            }
-            auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
-                                                 state.statistics.get(), false)};
-
-            std::scoped_lock lock{state.mutex};
-            if (pipeline) {
-                graphics_cache.emplace(key, std::move(pipeline));
-            }
-            ++state.built;
-            if (state.has_loaded) {
-                callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
-            }
-        });
-        ++state.total;
+        const auto queued{translation_queue.QueueWork(
+            key.Hash(), VideoCommon::TranslationPriority::Speculative,
+            [this, key, envs_ = std::move(envs), &state, &callback](ShaderPools* pools) mutable {
+                boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
+                for (auto& env : envs_) {
+                    env_ptrs.push_back(&env);
+                }
+                pools->ReleaseContents();
+                auto pipeline{CreateGraphicsPipeline(*pools, key, MakeSpan(env_ptrs),
+                                                     state.statistics.get(), true)};
+                if (pipeline) {
+                    std::scoped_lock lock{translated_mutex};
+                    translated_graphics.emplace(key, std::move(pipeline));
+                }
+                std::scoped_lock lock{state.mutex};
+                ++state.built;
+                if (state.has_loaded) {
+                    callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
+                }
+            })};
+        if (queued) {
+            ++state.total;
+        }
     }};
     VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
                                load_graphics);
@@ -554,7 +577,25 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     state.has_loaded = true;
     lock.unlock();
 
+    // Translation runs on its own threads and hands host compilation over to the pipeline
+    // workers, wait for both stages to drain. Stopping only drops the pending disk cache jobs, the
+    // translation threads stay up for draw-time pipelines.
+    translation_queue.WaitForRequests(stop_loading);
     workers.WaitForRequests(stop_loading);
+    {
+        std::scoped_lock translated_lock{translated_mutex};
+        for (auto& [key, pipeline] : translated_compute) {
+            compute_cache.try_emplace(key, std::move(pipeline));
+        }
+        for (auto& [key, pipeline] : translated_graphics) {
+            graphics_cache.try_emplace(key, std::move(pipeline));
+        }
+        translated_compute.clear();
+        translated_graphics.clear();
+    }
+
+    LOG_INFO(Render_Vulkan, "Deduplicated {} pipelines, reused {} translated stages",
+             translation_queue.NumDeduplicated(), spirv_cache.NumHits());
 
     if (use_vulkan_pipeline_cache) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
@@ -610,6 +651,7 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     bool build_in_parallel) try {
     auto hash = key.Hash();
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
+    const Shader::ArenaScope arena_scope{pools.arena};
     size_t env_index{0};
     std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
     const bool uses_vertex_a{key.unique_hashes[0] != 0};
@@ -617,6 +659,9 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
 
     // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
     Shader::IR::Program* layer_source_program{};
+    size_t layer_source_index{};
+    // Environment state read by the translation of each stage, part of the translated code key
+    std::array<u64, Maxwell::MaxShaderProgram> env_hashes{};
 
     for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
         const bool is_emulated_stage = layer_source_program != nullptr &&
@@ -625,6 +670,7 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
             auto topology = MaxwellToOutputTopology(key.state.topology);
             programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
                                                           *layer_source_program, topology);
+            env_hashes[index] = env_hashes[layer_source_index];
             continue;
         }
         if (key.unique_hashes[index] == 0) {
@@ -649,8 +695,16 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
             env.Dump(hash, key.unique_hashes[index]);
         }
 
+        env_hashes[index] = env.QueriesHash();
+        if (uses_vertex_a && index == 1) {
+            size_t seed{static_cast<size_t>(env_hashes[index])};
+            Common::HashCombine(seed, env_hashes[0]);
+            env_hashes[index] = static_cast<u64>(seed);
+        }
+
         if (programs[index].info.requires_layer_emulation) {
             layer_source_program = &programs[index];
+            layer_source_index = index;
         }
     }
     std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
@@ -673,7 +727,21 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
 
         const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
         ConvertLegacyToGeneric(program, runtime_info);
-        const std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
+
+        // Pipeline variants sharing this stage under the same runtime state emit identical code
+        const u64 stage_hash{VideoCommon::HashGraphicsStage(key.unique_hashes, index,
+                                                            uses_vertex_a, layer_source_index)};
+        const u64 translation_hash{
+            VideoCommon::HashTranslationInputs(stage_hash, env_hashes[index], runtime_info,
+                                               binding)};
+        std::vector<u32> code;
+        if (auto cached{spirv_cache.Find(translation_hash)}) {
+            code = std::move(cached->code);
+            binding = cached->binding;
+        } else {
+            code = EmitSPIRV(profile, runtime_info, program, binding);
+            spirv_cache.Insert(translation_hash, code, binding);
+        }
         device.SaveShader(code);
         modules[stage_index] = BuildShader(device, code);
         if (device.HasDebuggingToolAttached()) {
@@ -710,9 +778,26 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     GraphicsEnvironments environments;
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
 
-    main_pools.ReleaseContents();
-    auto pipeline{
-        CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true)};
+    // The draw needs this pipeline now, translate it ahead of any speculative work. The GPU thread
+    // waits for the job, so the environments can keep reading engine state.
+    std::unique_ptr<GraphicsPipeline> pipeline;
+    const u64 hash{graphics_key.Hash()};
+    const bool queued{translation_queue.QueueWork(
+        hash, VideoCommon::TranslationPriority::Current, [&](ShaderPools* pools) {
+            pools->ReleaseContents();
+            pipeline = CreateGraphicsPipeline(*pools, graphics_key, environments.Span(), nullptr,
+                                              true);
+        })};
+    translation_queue.WaitForJob(hash);
+    if (!queued) {
+        // A disk cache job was already translating this pipeline, reuse what it built
+        pipeline = TakeTranslated(translated_mutex, translated_graphics, graphics_key);
+    }
+    if (!queued && !pipeline) {
+        main_pools.ReleaseContents();
+        pipeline =
+            CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true);
+    }
     if (!pipeline || pipeline_cache_filename.empty()) {
         return pipeline;
     }
@@ -736,8 +821,20 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     ComputeEnvironment env{*kepler_compute, *gpu_memory, program_base, qmd.program_start};
     env.SetCachedSize(shader->size_bytes);
 
-    main_pools.ReleaseContents();
-    auto pipeline{CreateComputePipeline(main_pools, key, env, nullptr, true)};
+    std::unique_ptr<ComputePipeline> pipeline;
+    const bool queued{translation_queue.QueueWork(
+        key.Hash(), VideoCommon::TranslationPriority::Current, [&](ShaderPools* pools) {
+            pools->ReleaseContents();
+            pipeline = CreateComputePipeline(*pools, key, env, nullptr, true);
+        })};
+    translation_queue.WaitForJob(key.Hash());
+    if (!queued) {
+        pipeline = TakeTranslated(translated_mutex, translated_compute, key);
+    }
+    if (!queued && !pipeline) {
+        main_pools.ReleaseContents();
+        pipeline = CreateComputePipeline(main_pools, key, env, nullptr, true);
+    }
     if (!pipeline || pipeline_cache_filename.empty()) {
         return pipeline;
     }
@@ -758,6 +855,7 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     }
 
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
+    const Shader::ArenaScope arena_scope{pools.arena};
 
     Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
 
@@ -7,12 +7,14 @@
 #include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/thread_worker.h"
+#include "yuzu_shader_recompiler/arena.h"
 #include "yuzu_shader_recompiler/frontend/ir/basic_block.h"
 #include "yuzu_shader_recompiler/frontend/ir/value.h"
 #include "yuzu_shader_recompiler/frontend/maxwell/control_flow.h"
@@ -27,6 +29,8 @@
 #include "yuzu_video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "yuzu_video_core/renderer_vulkan/vk_texture_cache.h"
 #include "yuzu_video_core/shader_cache.h"
+#include "yuzu_video_core/shader_translation_cache.h"
+#include "yuzu_video_core/shader_translation_queue.h"
 
 namespace Core {
 class System;
@@ -90,11 +94,13 @@ struct ShaderPools {
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
+        arena.ReleaseContents();
     }
 
     Shader::ObjectPool<Shader::IR::Inst> inst{8192};
     Shader::ObjectPool<Shader::IR::Block> block{32};
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+    Shader::Arena arena;
 };
 
 class PipelineCache : public VideoCommon::ShaderCache {
@@ -157,6 +163,14 @@ private:
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<ComputePipeline>> compute_cache;
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
 
+    /// Pipelines built by disk cache jobs, handed to the caches once loading ends or to a draw
+    /// that asked for the same pipeline while its job was in flight
+    std::mutex translated_mutex;
+    std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<ComputePipeline>>
+        translated_compute;
+    std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>>
+        translated_graphics;
+
     ShaderPools main_pools;
 
     Shader::Profile profile;
@@ -167,8 +181,10 @@ private:
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
 
+    VideoCommon::ShaderTranslationCache<std::vector<u32>> spirv_cache;
     Common::ThreadWorker workers;
     Common::ThreadWorker serialization_thread;
+    VideoCommon::ShaderTranslationQueue<ShaderPools> translation_queue;
     DynamicFeatures dynamic_features;
 };
 
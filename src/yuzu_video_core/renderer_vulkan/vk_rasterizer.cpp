@@ -776,6 +776,10 @@ void RasterizerVulkan::TickFrame() {
     }
 }
 
+VideoCommon::TextureCacheStatistics RasterizerVulkan::GetTextureCacheStatistics() const {
+    return texture_cache.GetStatistics();
+}
+
 bool RasterizerVulkan::AccelerateConditionalRendering() {
     gpu_memory->FlushCaching();
     return query_cache.AccelerateHostConditionalRendering();
@@ -11,6 +11,7 @@
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/cityhash.h"
 #include "yuzu_common/common_types.h"
+#include "yuzu_common/container_hash.h"
 #include "yuzu_common/div_ceil.h"
 #include "yuzu_common/fs/fs.h"
 #include "yuzu_common/fs/path_util.h"
@@ -35,6 +36,40 @@ static u64 MakeCbufKey(u32 index, u32 offset) {
     return (static_cast<u64>(index) << 32) | offset;
 }
 
+template <typename Map>
+static void HashQueryMap(size_t& seed, const Map& map) {
+    // Iteration order depends on the insertion history, combine the entries commutatively
+    u64 entries{};
+    for (const auto& [key, value] : map) {
+        size_t entry{static_cast<size_t>(key)};
+        Common::HashCombine(entry, static_cast<u64>(value));
+        entries += entry;
+    }
+    Common::HashCombine(seed, map.size());
+    Common::HashCombine(seed, entries);
+}
+
+static u64 HashQueries(const std::unordered_map<u32, Shader::TextureType>& texture_types,
+                       const std::unordered_map<u32, Shader::TexturePixelFormat>& pixel_formats,
+                       const std::unordered_map<u64, u32>& cbuf_values,
+                       const std::unordered_map<u64, Shader::ReplaceConstant>& cbuf_replacements,
+                       u32 local_memory_size, u32 shared_memory_size, u32 texture_bound,
+                       const std::array<u32, 3>& workgroup_size, u32 viewport_transform_state) {
+    size_t seed{};
+    HashQueryMap(seed, texture_types);
+    HashQueryMap(seed, pixel_formats);
+    HashQueryMap(seed, cbuf_values);
+    HashQueryMap(seed, cbuf_replacements);
+    Common::HashCombine(seed, local_memory_size);
+    Common::HashCombine(seed, shared_memory_size);
+    Common::HashCombine(seed, texture_bound);
+    for (const u32 size : workgroup_size) {
+        Common::HashCombine(seed, size);
+    }
+    Common::HashCombine(seed, viewport_transform_state);
+    return static_cast<u64>(seed);
+}
+
 static Shader::TextureType ConvertTextureType(const Tegra::Texture::TICEntry& entry) {
     switch (entry.texture_type) {
     case Tegra::Texture::TextureType::Texture1D:
@@ -193,6 +228,12 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
+u64 GenericEnvironment::QueriesHash() const {
+    return HashQueries(texture_types, texture_pixel_formats, cbuf_values, cbuf_replacements,
+                       local_memory_size, shared_memory_size, texture_bound, workgroup_size,
+                       viewport_transform_state);
+}
+
 void GenericEnvironment::Serialize(std::ofstream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
@@ -572,6 +613,12 @@ std::array<u32, 3> FileEnvironment::WorkgroupSize() const {
     return workgroup_size;
 }
 
+u64 FileEnvironment::QueriesHash() const {
+    return HashQueries(texture_types, texture_pixel_formats, cbuf_values, cbuf_replacements,
+                       local_memory_size, shared_memory_size, texture_bound, workgroup_size,
+                       viewport_transform_state);
+}
+
 std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u32 bank,
                                                                               u32 offset) {
     const u64 key = (static_cast<u64>(bank) << 32) | static_cast<u64>(offset);
@@ -60,6 +60,8 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
+    [[nodiscard]] u64 QueriesHash() const override;
+
     void Serialize(std::ofstream& file) const;
 
     bool HasHLEMacroState() const override {
@@ -196,6 +198,8 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
+    [[nodiscard]] u64 QueriesHash() const override;
+
 private:
     std::vector<u64> code;
     std::unordered_map<u32, Shader::TextureType> texture_types;
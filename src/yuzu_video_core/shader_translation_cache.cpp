@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "yuzu_common/bit_cast.h"
+#include "yuzu_common/cityhash.h"
+#include "yuzu_common/container_hash.h"
+#include "yuzu_shader_recompiler/runtime_info.h"
+#include "yuzu_video_core/shader_translation_cache.h"
+
+namespace VideoCommon {
+
+namespace {
+template <typename T>
+u64 HashBytes(const T& value) {
+    return Common::CityHash64(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+} // Anonymous namespace
+
+u64 HashGraphicsStage(std::span<const u64> unique_hashes, size_t index, bool uses_vertex_a,
+                      size_t layer_source_index) {
+    if (unique_hashes[index] == 0) {
+        // Emulated stage generated from another program of the pipeline
+        size_t seed{index};
+        Common::HashCombine(
+            seed, HashGraphicsStage(unique_hashes, layer_source_index, uses_vertex_a, 0));
+        return static_cast<u64>(seed);
+    }
+    size_t seed{static_cast<size_t>(unique_hashes[index])};
+    if (index == 1 && uses_vertex_a) {
+        Common::HashCombine(seed, unique_hashes[0]);
+    }
+    return static_cast<u64>(seed);
+}
+
+u64 HashTranslationInputs(u64 stage_hash, u64 env_hash, const Shader::RuntimeInfo& runtime_info,
+                          const Shader::Backend::Bindings& binding) {
+    size_t seed{static_cast<size_t>(stage_hash)};
+    Common::HashCombine(seed, env_hash);
+    Common::HashCombine(seed, HashBytes(runtime_info.generic_input_types));
+    Common::HashCombine(seed, HashBytes(runtime_info.previous_stage_stores.mask));
+    for (const auto& [from, to] : runtime_info.previous_stage_legacy_stores_mapping) {
+        Common::HashCombine(seed, static_cast<u64>(from));
+        Common::HashCombine(seed, static_cast<u64>(to));
+    }
+    Common::HashCombine(seed, runtime_info.convert_depth_mode);
+    Common::HashCombine(seed, runtime_info.force_early_z);
+    Common::HashCombine(seed, static_cast<u32>(runtime_info.tess_primitive));
+    Common::HashCombine(seed, static_cast<u32>(runtime_info.tess_spacing));
+    Common::HashCombine(seed, runtime_info.tess_clockwise);
+    Common::HashCombine(seed, static_cast<u32>(runtime_info.input_topology));
+    Common::HashCombine(seed, runtime_info.fixed_state_point_size.has_value());
+    if (runtime_info.fixed_state_point_size) {
+        Common::HashCombine(seed, Common::BitCast<u32>(*runtime_info.fixed_state_point_size));
+    }
+    Common::HashCombine(seed, runtime_info.alpha_test_func.has_value());
+    if (runtime_info.alpha_test_func) {
+        Common::HashCombine(seed, static_cast<u32>(*runtime_info.alpha_test_func));
+    }
+    Common::HashCombine(seed, Common::BitCast<u32>(runtime_info.alpha_test_reference));
+    Common::HashCombine(seed, runtime_info.y_negate);
+    Common::HashCombine(seed, runtime_info.glasm_use_storage_buffers);
+    Common::HashCombine(seed, runtime_info.xfb_count);
+    if (runtime_info.xfb_count != 0) {
+        Common::HashCombine(seed, HashBytes(runtime_info.xfb_varyings));
+    }
+    Common::HashCombine(seed, HashBytes(binding));
+    return static_cast<u64>(seed);
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+
+#include "yuzu_common/common_types.h"
+#include "yuzu_shader_recompiler/backend/bindings.h"
+
+namespace Shader {
+struct RuntimeInfo;
+}
+
+namespace VideoCommon {
+
+/// Computes the hash of the guest programs a graphics stage is translated from
+/// @param unique_hashes       Unique hashes of the pipeline programs
+/// @param index               Program index of the stage
+/// @param uses_vertex_a       Whether VertexB is merged with VertexA
+/// @param layer_source_index  Program the stage is generated from when it is an emulated stage
+[[nodiscard]] u64 HashGraphicsStage(std::span<const u64> unique_hashes, size_t index,
+                                    bool uses_vertex_a, size_t layer_source_index);
+
+/// Computes the key of a translated stage from everything that feeds the backend emitter
+/// @param stage_hash    Hash of the guest program (or programs, when merged) of the stage
+/// @param env_hash      Hash of the environment queries made while translating the stage
+/// @param runtime_info  Runtime information the stage is emitted with
+/// @param binding       Binding state before the stage is emitted
+[[nodiscard]] u64 HashTranslationInputs(u64 stage_hash, u64 env_hash,
+                                        const Shader::RuntimeInfo& runtime_info,
+                                        const Shader::Backend::Bindings& binding);
+
+/// In-memory cache of emitted host shader code (SPIR-V words, GLSL or GLASM sources).
+/// Pipeline variants that share a stage with the same runtime state reuse the emitted code.
+/// The cache holds at most a fixed number of stages, the least recently used one is evicted.
+template <typename Code>
+class ShaderTranslationCache {
+public:
+    struct Entry {
+        Code code;
+        /// Binding state after the stage was emitted
+        Shader::Backend::Bindings binding;
+    };
+
+    explicit ShaderTranslationCache(size_t max_entries_ = 1024) : max_entries{max_entries_} {}
+
+    [[nodiscard]] std::optional<Entry> Find(u64 hash) {
+        std::scoped_lock lock{mutex};
+        const auto it{entries.find(hash)};
+        if (it == entries.end()) {
+            ++num_misses;
+            return std::nullopt;
+        }
+        ++num_hits;
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->second;
+    }
+
+    void Insert(u64 hash, Code code, const Shader::Backend::Bindings& binding) {
+        std::scoped_lock lock{mutex};
+        if (entries.contains(hash)) {
+            return;
+        }
+        if (entries.size() >= max_entries) {
+            entries.erase(lru.back().first);
+            lru.pop_back();
+        }
+        lru.emplace_front(hash, Entry{std::move(code), binding});
+        entries.emplace(hash, lru.begin());
+    }
+
+    void Clear() {
+        std::scoped_lock lock{mutex};
+        entries.clear();
+        lru.clear();
+    }
+
+    [[nodiscard]] u64 NumHits() const noexcept {
+        return num_hits.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] u64 NumMisses() const noexcept {
+        return num_misses.load(std::memory_order_relaxed);
+    }
+
+private:
+    using EntryList = std::list<std::pair<u64, Entry>>;
+
+    size_t max_entries;
+    std::mutex mutex;
+    EntryList lru;
+    std::unordered_map<u64, typename EntryList::iterator> entries;
+    std::atomic<u64> num_hits{};
+    std::atomic<u64> num_misses{};
+};
+
+} // namespace VideoCommon
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "yuzu_common/common_types.h"
+#include "yuzu_common/polyfill_thread.h"
+#include "yuzu_common/thread.h"
+#include "yuzu_common/unique_function.h"
+
+namespace VideoCommon {
+
+enum class TranslationPriority : u32 {
+    Speculative, ///< Shaders that are not needed yet (disk cache, prefetching)
+    Current,     ///< Shaders needed by the draw or dispatch being processed
+};
+
+/// Job system that runs shader translation (frontend, IR passes and backend emission) on its own
+/// threads, separate from the workers that drive host compilation. Jobs are identified by a hash,
+/// identical hashes in flight are only translated once, and current jobs run ahead of speculative
+/// ones. Each thread owns an instance of StateType (usually the IR object pools).
+template <class StateType>
+class ShaderTranslationQueue {
+    using Task = Common::UniqueFunction<void, StateType*>;
+
+    struct Job {
+        u64 hash;
+        Task task;
+    };
+
+public:
+    explicit ShaderTranslationQueue(size_t num_workers, std::string name)
+        : thread_name{std::move(name)} {
+        const auto lambda = [this](std::stop_token stop_token) {
+            Common::SetCurrentThreadName(thread_name.c_str());
+            {
+                StateType state{};
+                while (!stop_token.stop_requested()) {
+                    Job job;
+                    {
+                        std::unique_lock lock{queue_mutex};
+                        Common::CondvarWait(condition, lock, stop_token,
+                                            [this] { return HasPendingJobs(); });
+                        if (stop_token.stop_requested()) {
+                            break;
+                        }
+                        job = PopJob();
+                    }
+                    job.task(&state);
+                    FinishJob(job.hash);
+                }
+            }
+            {
+                std::scoped_lock lock{queue_mutex};
+                ++workers_stopped;
+            }
+            wait_condition.notify_all();
+        };
+        threads.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i) {
+            threads.emplace_back(lambda);
+        }
+    }
+
+    ShaderTranslationQueue& operator=(const ShaderTranslationQueue&) = delete;
+    ShaderTranslationQueue(const ShaderTranslationQueue&) = delete;
+
+    ShaderTranslationQueue& operator=(ShaderTranslationQueue&&) = delete;
+    ShaderTranslationQueue(ShaderTranslationQueue&&) = delete;
+
+    /// Queues a translation job
+    /// @returns False when a job with the same hash is already in flight and the work was dropped
+    bool QueueWork(u64 hash, TranslationPriority priority, Task work) {
+        {
+            std::unique_lock lock{queue_mutex};
+            if (!in_flight.insert(hash).second) {
+                ++num_deduplicated;
+                if (priority == TranslationPriority::Current) {
+                    PromoteLocked(hash);
+                }
+                return false;
+            }
+            auto& queue{priority == TranslationPriority::Current ? current : speculative};
+            queue.push_back(Job{hash, std::move(work)});
+        }
+        condition.notify_one();
+        return true;
+    }
+
+    /// Moves a pending speculative job to the front of the current queue
+    void Promote(u64 hash) {
+        std::unique_lock lock{queue_mutex};
+        PromoteLocked(hash);
+    }
+
+    /// Returns true when a job with the given hash is pending or running
+    [[nodiscard]] bool IsInFlight(u64 hash) {
+        std::unique_lock lock{queue_mutex};
+        return in_flight.contains(hash);
+    }
+
+    /// Blocks until the job with the given hash is neither pending nor running
+    void WaitForJob(u64 hash) {
+        std::unique_lock lock{queue_mutex};
+        wait_condition.wait(lock, [this, hash] {
+            return workers_stopped >= threads.size() || !in_flight.contains(hash);
+        });
+    }
+
+    /// Blocks until no job is pending or running
+    /// @param stop_token  Discards the pending speculative jobs when requested, the threads keep
+    ///                    running so current jobs queued later are still translated
+    void WaitForRequests(std::stop_token stop_token = {}) {
+        std::stop_callback callback(stop_token, [this] { CancelSpeculative(); });
+        std::unique_lock lock{queue_mutex};
+        wait_condition.wait(
+            lock, [this] { return workers_stopped >= threads.size() || in_flight.empty(); });
+    }
+
+    /// Number of jobs dropped because an identical hash was already in flight
+    [[nodiscard]] size_t NumDeduplicated() const noexcept {
+        return num_deduplicated.load(std::memory_order_relaxed);
+    }
+
+private:
+    bool HasPendingJobs() const noexcept {
+        return !current.empty() || !speculative.empty();
+    }
+
+    Job PopJob() {
+        auto& queue{current.empty() ? speculative : current};
+        Job job{std::move(queue.front())};
+        queue.pop_front();
+        return job;
+    }
+
+    void CancelSpeculative() {
+        {
+            std::unique_lock lock{queue_mutex};
+            for (const Job& job : speculative) {
+                in_flight.erase(job.hash);
+            }
+            speculative.clear();
+        }
+        wait_condition.notify_all();
+    }
+
+    void PromoteLocked(u64 hash) {
+        const auto it{std::ranges::find(speculative, hash, &Job::hash)};
+        if (it == speculative.end()) {
+            return;
+        }
+        current.push_front(std::move(*it));
+        speculative.erase(it);
+    }
+
+    void FinishJob(u64 hash) {
+        {
+            std::unique_lock lock{queue_mutex};
+            in_flight.erase(hash);
+        }
+        wait_condition.notify_all();
+    }
+
+    std::deque<Job> current;
+    std::deque<Job> speculative;
+    std::unordered_set<u64> in_flight;
+    std::mutex queue_mutex;
+    std::condition_variable_any condition;
+    std::condition_variable wait_condition;
+    size_t workers_stopped{};
+    std::atomic<size_t> num_deduplicated{};
+    std::string thread_name;
+    std::vector<std::jthread> threads;
+};
+
+} // namespace VideoCommon
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+#include "yuzu_common/common_types.h"
+
+namespace Tegra {
+
+/**
+ * Single-producer/single-consumer ring of preallocated submission slots.
+ * The producer fills slots in place and the consumer processes them in place, slots are cleared
+ * on pop so their storage is recycled by later submissions. When the consumer falls behind, new
+ * submissions spill into an overflow list instead of blocking the producer, the consumer may be
+ * waiting on guest memory the producer is yet to write.
+ * T must provide Clear(), releasing its contents while keeping its storage.
+ */
+template <typename T, size_t Capacity>
+class SubmissionRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+public:
+    struct Statistics {
+        u64 submitted;  ///< Number of committed submissions
+        u64 spilled;    ///< Number of submissions that did not fit in the ring
+        u64 peak_depth; ///< Largest number of submissions pending at once
+    };
+
+    /// Returns the storage the next submission has to be written to (producer only)
+    [[nodiscard]] T& Acquire() {
+        const size_t write_index{m_write_index.load(std::memory_order::relaxed)};
+        const bool is_full{write_index - m_read_index.load(std::memory_order::acquire) == Capacity};
+        if (is_full || m_num_spilled.load(std::memory_order::acquire) != 0) {
+            // Preserve the submission order, nothing goes into the ring until the overflow drains
+            m_acquired_spill = true;
+            return m_spill_slot;
+        }
+        m_acquired_spill = false;
+        return m_data[write_index % Capacity];
+    }
+
+    /// Publishes the last acquired submission to the consumer, returns its sequence number
+    u64 Commit() {
+        const size_t write_index{m_write_index.load(std::memory_order::relaxed)};
+        const size_t read_index{m_read_index.load(std::memory_order::acquire)};
+        size_t num_spilled;
+        if (m_acquired_spill) {
+            // The consumer decrements the count concurrently, it has to be updated atomically
+            std::scoped_lock lock{m_overflow_mutex};
+            m_overflow.push_back(std::move(m_spill_slot));
+            num_spilled = m_num_spilled.fetch_add(1, std::memory_order::release) + 1;
+            m_spill_slot.Clear();
+            m_spilled.fetch_add(1, std::memory_order::relaxed);
+        } else {
+            num_spilled = m_num_spilled.load(std::memory_order::acquire);
+            m_write_index.store(write_index + 1, std::memory_order::release);
+        }
+        const u64 depth{static_cast<u64>(write_index - read_index + num_spilled) +
+                        (m_acquired_spill ? 0 : 1)};
+        if (depth > m_peak_depth.load(std::memory_order::relaxed)) {
+            m_peak_depth.store(depth, std::memory_order::relaxed);
+        }
+        return m_submitted.fetch_add(1, std::memory_order::relaxed) + 1;
+    }
+
+    /// Returns the oldest pending submission, or nullptr when there is none (consumer only)
+    [[nodiscard]] T* Front() {
+        const size_t read_index{m_read_index.load(std::memory_order::relaxed)};
+        if (read_index != m_write_index.load(std::memory_order::acquire)) {
+            m_front_spilled = false;
+            return &m_data[read_index % Capacity];
+        }
+        if (m_num_spilled.load(std::memory_order::acquire) == 0) {
+            return nullptr;
+        }
+        // Ring submissions are always older than spilled ones, the overflow is only consumed
+        // once the ring is empty
+        std::scoped_lock lock{m_overflow_mutex};
+        if (m_overflow.empty()) {
+            return nullptr;
+        }
+        m_front_spilled = true;
+        return &m_overflow.front();
+    }
+
+    /// Releases the submission returned by the last Front call (consumer only)
+    void Pop() {
+        ++m_num_consumed;
+        if (m_front_spilled) {
+            std::scoped_lock lock{m_overflow_mutex};
+            m_overflow.pop_front();
+            m_num_spilled.fetch_sub(1, std::memory_order::release);
+            return;
+        }
+        const size_t read_index{m_read_index.load(std::memory_order::relaxed)};
+        m_data[read_index % Capacity].Clear();
+        m_read_index.store(read_index + 1, std::memory_order::release);
+    }
+
+    /// Returns the number of submissions released by the consumer (consumer only)
+    [[nodiscard]] u64 NumConsumed() const noexcept {
+        return m_num_consumed;
+    }
+
+    [[nodiscard]] Statistics GetStatistics() const noexcept {
+        return Statistics{
+            .submitted = m_submitted.load(std::memory_order::relaxed),
+            .spilled = m_spilled.load(std::memory_order::relaxed),
+            .peak_depth = m_peak_depth.load(std::memory_order::relaxed),
+        };
+    }
+
+private:
+    alignas(128) std::atomic_size_t m_read_index{0};
+    alignas(128) std::atomic_size_t m_write_index{0};
+    std::atomic_size_t m_num_spilled{0};
+
+    std::array<T, Capacity> m_data;
+
+    // Producer state
+    T m_spill_slot;
+    bool m_acquired_spill{};
+
+    // Consumer state
+    u64 m_num_consumed{};
+    bool m_front_spilled{};
+
+    std::mutex m_overflow_mutex;
+    std::deque<T> m_overflow;
+
+    std::atomic<u64> m_submitted{};
+    std::atomic<u64> m_spilled{};
+    std::atomic<u64> m_peak_depth{};
+};
+
+} // namespace Tegra
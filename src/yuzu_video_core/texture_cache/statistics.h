@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "yuzu_common/common_types.h"
+#include "yuzu_video_core/surface.h"
+
+namespace VideoCommon {
+
+/// Residency and eviction counters of a texture cache, published once per frame
+struct TextureCacheStatistics {
+    /// Estimated bytes of registered images, indexed by pixel format
+    std::array<u64, VideoCore::Surface::MaxPixelFormat> resident_bytes{};
+    /// Memory the garbage collector works against, device reported when available
+    u64 used_memory{};
+    /// Usage above which eviction turns aggressive
+    u64 budget{};
+    /// Images deleted by the garbage collector
+    u64 evictions{};
+    /// Estimated bytes released by those evictions
+    u64 evicted_bytes{};
+    /// Evicted images that had to be created and uploaded again
+    u64 reuploads{};
+    /// Images whose contents were decoded on the CPU and uploaded
+    u64 decodes{};
+    /// Time spent decoding and uploading those images, in nanoseconds
+    u64 decode_ns{};
+};
+
+} // namespace VideoCommon
@@ -68,6 +68,15 @@ TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManag
         critical_memory = DEFAULT_CRITICAL_MEMORY + 1_GiB;
         minimum_memory = 0;
     }
+
+    // An explicit budget keeps residency predictable when several instances share the host
+    const u64 memory_budget =
+        static_cast<u64>(Settings::values.texture_memory_budget.GetValue()) * 1_MiB;
+    if (memory_budget != 0) {
+        critical_memory = memory_budget;
+        expected_memory = (3 * memory_budget) / 4;
+        minimum_memory = memory_budget / 2;
+    }
 }
 
 template <class P>
@@ -83,8 +92,8 @@ void TextureCache<P>::RunGarbageCollector() {
         ticks_to_destroy = aggressive_mode ? 10ULL : high_priority_mode ? 25ULL : 50ULL;
         num_iterations = aggressive_mode ? 40 : (high_priority_mode ? 20 : 10);
     };
-    const auto Cleanup = [this, &num_iterations, &high_priority_mode,
-                          &aggressive_mode](ImageId image_id) {
+    const auto Cleanup = [this, &num_iterations, &high_priority_mode, &aggressive_mode,
+                          &ticks_to_destroy](ImageId image_id) {
         if (num_iterations == 0) {
             return true;
         }
@@ -95,8 +104,16 @@ void TextureCache<P>::RunGarbageCollector() {
             // used by the async decoder thread.
             return false;
         }
-        if (!aggressive_mode && True(image.flags & ImageFlagBits::CostlyLoad)) {
-            return false;
+        if (!aggressive_mode) {
+            if (True(image.flags & ImageFlagBits::CostlyLoad)) {
+                return false;
+            }
+            // Images that took long to decode have to stay unused for longer before they go
+            const u64 retention_ticks =
+                std::min(image.decode_ns / DECODE_NS_PER_RETENTION_TICK, MAX_RETENTION_TICKS);
+            if (frame_tick - image.last_use_tick < ticks_to_destroy + retention_ticks) {
+                return false;
+            }
         }
         const bool must_download =
             image.IsSafeDownload() && False(image.flags & ImageFlagBits::BadOverlap);
@@ -114,6 +131,12 @@ void TextureCache<P>::RunGarbageCollector() {
         if (True(image.flags & ImageFlagBits::Tracked)) {
             UntrackImage(image, image_id);
         }
+        ++statistics.evictions;
+        statistics.evicted_bytes += EstimatedImageSizeBytes(image);
+        const EvictedImage evicted{image.gpu_addr, image.guest_size_bytes, image.info.format};
+        evicted_images.insert_or_assign(evicted, frame_tick);
+        evicted_order.emplace_back(evicted, frame_tick);
+        PruneEvictedImages();
         UnregisterImage(image_id);
         DeleteImage(image_id, image.scale_tick > frame_tick + 5);
         if (total_used_memory < critical_memory) {
@@ -142,6 +165,23 @@ void TextureCache<P>::RunGarbageCollector() {
     }
 }
 
+template <class P>
+void TextureCache<P>::PruneEvictedImages() {
+    while (!evicted_order.empty()) {
+        const auto& [evicted, tick] = evicted_order.front();
+        if (evicted_order.size() <= MAX_TRACKED_EVICTIONS &&
+            tick + MAX_EVICTION_AGE_TICKS >= frame_tick) {
+            break;
+        }
+        // Entries of images evicted again later or already reuploaded are stale
+        const auto it = evicted_images.find(evicted);
+        if (it != evicted_images.end() && it->second == tick) {
+            evicted_images.erase(it);
+        }
+        evicted_order.pop_front();
+    }
+}
+
 template <class P>
 void TextureCache<P>::TickFrame() {
     // If we can obtain the memory info, use it instead of the estimate.
@@ -155,10 +195,18 @@ void TextureCache<P>::TickFrame() {
     sentenced_framebuffers.Tick();
     sentenced_image_view.Tick();
     TickAsyncDecode();
+    PruneEvictedImages();
 
     runtime.TickFrame();
     ++frame_tick;
 
+    {
+        std::scoped_lock lock{statistics_mutex};
+        published_statistics = statistics;
+        published_statistics.used_memory = total_used_memory;
+        published_statistics.budget = critical_memory;
+    }
+
     if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
         for (auto& buffer : async_buffers_death_ring) {
             runtime.FreeDeferredStagingBuffer(buffer);
@@ -167,6 +215,12 @@ void TextureCache<P>::TickFrame() {
     }
 }
 
+template <class P>
+TextureCacheStatistics TextureCache<P>::GetStatistics() const {
+    std::scoped_lock lock{statistics_mutex};
+    return published_statistics;
+}
+
 template <class P>
 const typename P::ImageView& TextureCache<P>::GetImageView(ImageViewId id) const noexcept {
     return slot_image_views[id];
@@ -1064,9 +1118,13 @@ void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
         QueueAsyncDecode(image, image_id);
         return;
     }
+    const auto decode_start = std::chrono::steady_clock::now();
     auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image));
     UploadImageContents(image, staging);
     runtime.InsertUploadMemoryBarrier();
+    RecordDecode(image, static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now() - decode_start)
+                                             .count()));
 }
 
 template <class P>
@@ -1276,6 +1334,24 @@ u64 TextureCache<P>::GetScaledImageSizeBytes(const ImageBase& image) {
     return fitted_size;
 }
 
+template <class P>
+u64 TextureCache<P>::EstimatedImageSizeBytes(const ImageBase& image) const {
+    u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
+    if ((IsPixelFormatASTC(image.info.format) &&
+         True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
+        True(image.flags & ImageFlagBits::Converted)) {
+        tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
+    }
+    return Common::AlignUp(tentative_size, 1024);
+}
+
+template <class P>
+void TextureCache<P>::RecordDecode(ImageBase& image, u64 decode_ns) {
+    image.decode_ns = decode_ns;
+    ++statistics.decodes;
+    statistics.decode_ns += decode_ns;
+}
+
 template <class P>
 void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
     UNIMPLEMENTED_IF(False(image.flags & ImageFlagBits::Converted));
@@ -1299,12 +1375,16 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
     auto func = [out_size, copies, info = image.info,
                  input = std::move(local_unswizzle_data_buffer),
                  async_decode = decode_ptr]() mutable {
+        const auto decode_start = std::chrono::steady_clock::now();
         async_decode->decoded_data.resize_destructive(out_size);
         std::span copies_span{copies.data(), copies.size()};
         ConvertImage(input, info, async_decode->decoded_data, copies_span);
+        const auto decode_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - decode_start);
 
         // TODO: Do we need this lock?
         std::unique_lock lock{async_decode->mutex};
+        async_decode->decode_ns = static_cast<u64>(decode_ns.count());
         async_decode->copies = std::move(copies);
         async_decode->complete = true;
     };
@@ -1328,6 +1408,7 @@ void TextureCache<P>::TickAsyncDecode() {
                     async_decode->decoded_data.size());
         image.UploadMemory(staging, async_decode->copies);
         image.flags &= ~ImageFlagBits::IsDecoding;
+        RecordDecode(image, async_decode->decode_ns);
         has_uploads = true;
         i = async_decodes.erase(i);
     }
@@ -1726,8 +1807,9 @@ std::pair<u32, u32> TextureCache<P>::PrepareDmaImage(ImageId dst_id, GPUVAddr ba
     const auto& image = slot_images[dst_id];
     const auto base = image.TryFindBase(base_addr);
     PrepareImage(dst_id, mark_as_modified, false);
-    const auto& new_image = slot_images[dst_id];
+    auto& new_image = slot_images[dst_id];
     lru_cache.Touch(new_image.lru_index, frame_tick);
+    new_image.last_use_tick = frame_tick;
     return std::make_pair(base->level, base->layer);
 }
 
@@ -1991,14 +2073,14 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered),
                "Trying to register an already registered image");
     image.flags |= ImageFlagBits::Registered;
-    u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
-    if ((IsPixelFormatASTC(image.info.format) &&
-         True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
-        True(image.flags & ImageFlagBits::Converted)) {
-        tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
+    const u64 size_bytes = EstimatedImageSizeBytes(image);
+    total_used_memory += size_bytes;
+    statistics.resident_bytes[static_cast<size_t>(image.info.format)] += size_bytes;
+    if (evicted_images.erase({image.gpu_addr, image.guest_size_bytes, image.info.format}) != 0) {
+        ++statistics.reuploads;
     }
-    total_used_memory += Common::AlignUp(tentative_size, 1024);
     image.lru_index = lru_cache.Insert(image_id, frame_tick);
+    image.last_use_tick = frame_tick;
 
     ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
         (*channel_state->gpu_page_table)[page].push_back(image_id);
@@ -2165,13 +2247,9 @@ void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
     if (image.HasScaled()) {
         total_used_memory -= GetScaledImageSizeBytes(image);
     }
-    u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
-    if ((IsPixelFormatASTC(image.info.format) &&
-         True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
-        True(image.flags & ImageFlagBits::Converted)) {
-        tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
-    }
-    total_used_memory -= Common::AlignUp(tentative_size, 1024);
+    const u64 size_bytes = EstimatedImageSizeBytes(image);
+    total_used_memory -= size_bytes;
+    statistics.resident_bytes[static_cast<size_t>(image.info.format)] -= size_bytes;
     const GPUVAddr gpu_addr = image.gpu_addr;
     const auto alloc_it = image_allocs_table.find(gpu_addr);
     if (alloc_it == image_allocs_table.end()) {
@@ -2358,6 +2436,7 @@ void TextureCache<P>::PrepareImage(ImageId image_id, bool is_modification, bool
         MarkModification(image);
     }
     lru_cache.Touch(image.lru_index, frame_tick);
+    image.last_use_tick = frame_tick;
 }
 
 template <class P>
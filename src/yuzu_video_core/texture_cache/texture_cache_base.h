@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <limits>
 #include <mutex>
@@ -33,6 +34,7 @@
 #include "yuzu_video_core/texture_cache/image_info.h"
 #include "yuzu_video_core/texture_cache/image_view_base.h"
 #include "yuzu_video_core/texture_cache/render_targets.h"
+#include "yuzu_video_core/texture_cache/statistics.h"
 #include "yuzu_video_core/texture_cache/types.h"
 #include "yuzu_video_core/textures/texture.h"
 
@@ -59,6 +61,7 @@ struct AsyncDecodeContext {
     ImageId image_id;
     Common::ScratchBuffer<u8> decoded_data;
     boost::container::small_vector<BufferImageCopy, 16> copies;
+    u64 decode_ns{};
     std::mutex mutex;
     std::atomic_bool complete;
 };
@@ -111,6 +114,13 @@ class TextureCache : public VideoCommon::ChannelSetupCaches<TextureCacheChannelI
     static constexpr s64 DEFAULT_EXPECTED_MEMORY = 1_GiB + 125_MiB;
     static constexpr s64 DEFAULT_CRITICAL_MEMORY = 1_GiB + 625_MiB;
     static constexpr size_t GC_EMERGENCY_COUNTS = 2;
+    /// Decode time that buys an image one more unused frame before regular eviction
+    static constexpr u64 DECODE_NS_PER_RETENTION_TICK = 250'000;
+    static constexpr u64 MAX_RETENTION_TICKS = 120;
+    /// Evicted images remembered to detect images that come back
+    static constexpr size_t MAX_TRACKED_EVICTIONS = 4096;
+    /// Frames an evicted image is remembered for
+    static constexpr u64 MAX_EVICTION_AGE_TICKS = 600;
 
     using Runtime = typename P::Runtime;
     using Image = typename P::Image;
@@ -134,6 +144,9 @@ public:
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
+    /// Return the statistics published on the last frame tick, safe to call from any thread
+    [[nodiscard]] TextureCacheStatistics GetStatistics() const;
+
     /// Return a constant reference to the given image view id
     [[nodiscard]] const ImageView& GetImageView(ImageViewId id) const noexcept;
 
@@ -289,6 +302,9 @@ private:
     /// Runs the Garbage Collector.
     void RunGarbageCollector();
 
+    /// Forgets evicted images that are too old or above the tracking limit
+    void PruneEvictedImages();
+
     /// Fills image_view_ids in the image views in indices
     template <bool has_blacklists>
     void FillImageViews(DescriptorTable<TICEntry>& table,
@@ -419,6 +435,12 @@ private:
     bool ScaleDown(Image& image);
     u64 GetScaledImageSizeBytes(const ImageBase& image);
 
+    /// Estimated host memory of an image, as accounted against the memory thresholds
+    [[nodiscard]] u64 EstimatedImageSizeBytes(const ImageBase& image) const;
+
+    /// Account a CPU decode and upload of the image contents
+    void RecordDecode(ImageBase& image, u64 decode_ns);
+
     void QueueAsyncDecode(Image& image, ImageId image_id);
     void TickAsyncDecode();
 
@@ -454,6 +476,24 @@ private:
         Common::SlotId object_id;
     };
 
+    /// Identifies an evicted image, so an unrelated image at the same address is not a reupload
+    struct EvictedImage {
+        GPUVAddr gpu_addr;
+        u32 guest_size_bytes;
+        PixelFormat format;
+
+        bool operator==(const EvictedImage&) const = default;
+    };
+
+    struct EvictedImageHash {
+        size_t operator()(const EvictedImage& image) const noexcept {
+            size_t seed = std::hash<GPUVAddr>()(image.gpu_addr);
+            boost::hash_combine(seed, image.guest_size_bytes);
+            boost::hash_combine(seed, static_cast<u32>(image.format));
+            return seed;
+        }
+    };
+
     Common::SlotVector<Image> slot_images;
     Common::SlotVector<ImageMapView> slot_map_views;
     Common::SlotVector<ImageView> slot_image_views;
@@ -489,6 +529,13 @@ private:
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
+    TextureCacheStatistics statistics;
+    TextureCacheStatistics published_statistics;
+    mutable std::mutex statistics_mutex;
+    /// Evicted images and the frame they were evicted on, oldest first in evicted_order
+    std::unordered_map<EvictedImage, u64, EvictedImageHash> evicted_images;
+    std::deque<std::pair<EvictedImage, u64>> evicted_order;
+
     Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 